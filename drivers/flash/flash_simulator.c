@@ -170,6 +170,51 @@ static const struct flash_parameters flash_sim_parameters = {
 	},
 };
 
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+/* Block for the simulated duration of a flash operation. */
+static void flash_sim_delay(uint32_t time_us)
+{
+	if (IS_ENABLED(CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING_SLEEP) &&
+	    !k_is_in_isr() && !k_is_pre_kernel()) {
+		k_usleep(time_us);
+	} else {
+		k_busy_wait(time_us);
+	}
+}
+
+static uint32_t flash_sim_read_time_us(size_t len)
+{
+	uint32_t time_us = DIV_ROUND_UP((uint64_t)len *
+					CONFIG_FLASH_SIMULATOR_READ_TIME_PER_KB_US, 1024);
+
+	return MAX(time_us, CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
+}
+
+static uint32_t flash_sim_write_time_us(off_t offset, size_t len)
+{
+	uint32_t pages = 0;
+	uint32_t time_us;
+
+	/* Every program page touched by the write is programmed separately */
+	if (len > 0) {
+		pages = (offset + len - 1) / CONFIG_FLASH_SIMULATOR_PROGRAM_PAGE_SIZE -
+			offset / CONFIG_FLASH_SIMULATOR_PROGRAM_PAGE_SIZE + 1;
+	}
+
+	time_us = pages * CONFIG_FLASH_SIMULATOR_PAGE_PROGRAM_TIME_US;
+
+	return MAX(time_us, CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
+}
+
+static uint32_t flash_sim_erase_time_us(size_t len)
+{
+	uint32_t time_us = (len / FLASH_SIMULATOR_ERASE_UNIT) *
+			   CONFIG_FLASH_SIMULATOR_UNIT_ERASE_TIME_US;
+
+	return MAX(time_us, CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
+}
+#endif /* CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING */
+
 static int flash_range_is_valid(const struct device *dev, off_t offset,
 				size_t len)
 {
@@ -206,9 +251,10 @@ static int flash_sim_read(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_read, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
+	uint32_t time_us = flash_sim_read_time_us(len);
+
+	flash_sim_delay(time_us);
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us, time_us);
 #endif
 
 	return 0;
@@ -289,9 +335,10 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
+	uint32_t time_us = flash_sim_write_time_us(offset, len);
+
+	flash_sim_delay(time_us);
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us, time_us);
 #endif
 
 	return 0;
@@ -341,9 +388,10 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
+	uint32_t time_us = flash_sim_erase_time_us(len);
+
+	flash_sim_delay(time_us);
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us, time_us);
 #endif
 
 	return 0;
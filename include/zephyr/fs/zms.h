@@ -66,6 +66,33 @@ struct zms_fs {
 #endif
 };
 
+/** ZMS transaction entry */
+struct zms_tx_entry {
+	/** ID of the entry */
+	uint32_t id;
+	/** Data to be written, must stay valid until the transaction is committed */
+	const void *data;
+	/** Number of bytes to be written, `0` deletes the entry */
+	size_t len;
+};
+
+/**
+ * @brief ZMS transaction
+ *
+ * Groups several writes that are committed to the storage as a single unit: after a
+ * power loss either all or none of them are visible once the file system is mounted again.
+ */
+struct zms_tx {
+	/** File system the transaction applies to */
+	struct zms_fs *fs;
+	/** Staging area provided by the user */
+	struct zms_tx_entry *entries;
+	/** Number of entries in the staging area */
+	size_t size;
+	/** Number of staged entries */
+	size_t count;
+};
+
 /**
  * @}
  */
@@ -200,6 +227,73 @@ size_t zms_active_sector_free_space(struct zms_fs *fs);
  */
 int zms_sector_use_next(struct zms_fs *fs);
 
+/**
+ * @brief Initialize a transaction.
+ *
+ * Requires @kconfig{CONFIG_ZMS_TRANSACTION}.
+ *
+ * @param tx Pointer to the transaction.
+ * @param fs Pointer to the file system the transaction applies to.
+ * @param entries Staging area for the writes of the transaction.
+ * @param size Number of entries in the staging area.
+ */
+void zms_tx_init(struct zms_tx *tx, struct zms_fs *fs, struct zms_tx_entry *entries,
+		 size_t size);
+
+/**
+ * @brief Stage a write in a transaction.
+ *
+ * Nothing is written to the storage until @ref zms_tx_commit() is called. Staging an ID that
+ * is already part of the transaction replaces the previously staged write.
+ *
+ * @param tx Pointer to the transaction.
+ * @param id ID of the entry to be written.
+ * @param data Pointer to the data to be written, must stay valid until the commit.
+ * @param len Number of bytes to be written (maximum 64 KiB), `0` deletes the entry.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL Invalid ID, length or data pointer.
+ * @retval -ENOMEM The staging area is full.
+ */
+int zms_tx_write(struct zms_tx *tx, uint32_t id, const void *data, size_t len);
+
+/**
+ * @brief Stage the deletion of an entry in a transaction.
+ *
+ * @param tx Pointer to the transaction.
+ * @param id ID of the entry to be deleted.
+ *
+ * @retval 0 Success.
+ * @retval -ENOMEM The staging area is full.
+ */
+int zms_tx_delete(struct zms_tx *tx, uint32_t id);
+
+/**
+ * @brief Commit a transaction to the storage.
+ *
+ * The data of all staged entries is written sequentially followed by their ATEs, framed by
+ * begin and end markers. If the commit is interrupted, the partially written transaction is
+ * rolled back the next time the file system is mounted.
+ * The whole transaction, together with the space needed to roll it back, must fit in one
+ * sector. The staging area is emptied on success.
+ *
+ * @param tx Pointer to the transaction.
+ *
+ * @retval 0 Success.
+ * @retval -EACCES The file system is not mounted.
+ * @retval -EINVAL The transaction does not fit in a sector.
+ * @retval -ENOSPC Not enough free space in the file system.
+ * @retval -ERRNO Other negative errno code on storage error.
+ */
+int zms_tx_commit(struct zms_tx *tx);
+
+/**
+ * @brief Drop all staged writes of a transaction.
+ *
+ * @param tx Pointer to the transaction.
+ */
+void zms_tx_abort(struct zms_tx *tx);
+
 /**
  * @}
  */
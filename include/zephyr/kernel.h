@@ -668,11 +668,54 @@ static inline k_tid_t k_current_get(void)
 	extern Z_THREAD_LOCAL k_tid_t z_tls_current;
 
 	return z_tls_current;
+#elif defined(CONFIG_USERSPACE_SHARED_PAGE) && (CONFIG_MP_MAX_NUM_CPUS == 1)
+	if (k_is_user_context()) {
+		return z_shared_page_current_get(0);
+	}
+
+	return k_sched_current_thread_query();
 #else
 	return k_sched_current_thread_query();
 #endif
 }
 
+/**
+ * @brief Query the CPU the current thread runs on.
+ *
+ * This unconditionally queries the kernel via a system call.
+ *
+ * @note Use k_current_cpu_get() instead.
+ *
+ * @return Index of the current CPU.
+ */
+__syscall int k_sched_current_cpu_query(void);
+
+/**
+ * @brief Get the CPU the current thread runs on.
+ *
+ * Unless the thread is pinned to one CPU, it may have migrated to another
+ * one by the time the value is used.
+ *
+ * @return Index of the current CPU.
+ */
+static inline int k_current_cpu_get(void)
+{
+#if CONFIG_MP_MAX_NUM_CPUS == 1
+	return 0;
+#else
+#if defined(CONFIG_USERSPACE_SHARED_PAGE) && defined(CONFIG_CURRENT_THREAD_USE_TLS)
+	if (k_is_user_context()) {
+		int cpu = z_shared_page_cpu_find(k_current_get());
+
+		if (cpu >= 0) {
+			return cpu;
+		}
+	}
+#endif /* CONFIG_USERSPACE_SHARED_PAGE && CONFIG_CURRENT_THREAD_USE_TLS */
+	return k_sched_current_cpu_query();
+#endif /* CONFIG_MP_MAX_NUM_CPUS == 1 */
+}
+
 /**
  * @brief Abort a thread.
  *
@@ -1807,6 +1850,17 @@ static inline void *z_impl_k_timer_user_data_get(const struct k_timer *timer)
  * @{
  */
 
+/**
+ * @brief Query system uptime, in system ticks.
+ *
+ * This unconditionally queries the kernel via a system call.
+ *
+ * @note Use k_uptime_ticks() instead.
+ *
+ * @return Current uptime in ticks.
+ */
+__syscall int64_t k_uptime_ticks_query(void);
+
 /**
  * @brief Get system uptime, in system ticks.
  *
@@ -1814,9 +1868,21 @@ static inline void *z_impl_k_timer_user_data_get(const struct k_timer *timer)
  * ticks (c.f. @kconfig{CONFIG_SYS_CLOCK_TICKS_PER_SEC}), which is the
  * fundamental unit of resolution of kernel timekeeping.
  *
+ * With @kconfig{CONFIG_USERSPACE_SHARED_PAGE}, user threads read it
+ * without a system call.
+ *
  * @return Current uptime in ticks.
  */
-__syscall int64_t k_uptime_ticks(void);
+static inline int64_t k_uptime_ticks(void)
+{
+#ifdef CONFIG_USERSPACE_SHARED_PAGE
+	if (k_is_user_context()) {
+		return z_shared_page_ticks_get();
+	}
+#endif /* CONFIG_USERSPACE_SHARED_PAGE */
+
+	return k_uptime_ticks_query();
+}
 
 /**
  * @brief Get system uptime.
@@ -3014,6 +3080,14 @@ struct k_mutex {
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	struct k_obj_core obj_core;
 #endif
+
+#ifdef CONFIG_LOCK_STATS_MUTEX
+	/** Contention statistics */
+	struct k_lock_stats lock_stats;
+
+	/** Time (in cycles) when the current owner took the mutex */
+	uint32_t hold_start;
+#endif
 };
 
 /**
@@ -3206,6 +3280,10 @@ struct k_sem {
 #ifdef CONFIG_OBJ_CORE_SEM
 	struct k_obj_core  obj_core;
 #endif
+
+#ifdef CONFIG_LOCK_STATS_SEM
+	struct k_lock_stats lock_stats;
+#endif
 };
 
 #define Z_SEM_INITIALIZER(obj, initial_count, count_limit) \
@@ -3342,6 +3420,8 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 
 struct k_work_delayable;
 struct k_work_sync;
+struct k_work_q_worker;
+struct k_work_q_worker_stats;
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -3606,6 +3686,81 @@ int k_work_queue_drain(struct k_work_q *queue, bool plug);
  */
 int k_work_queue_unplug(struct k_work_q *queue);
 
+#if defined(CONFIG_WORKQUEUE_POOL) || defined(__DOXYGEN__)
+/** @brief Start a work queue served by a pool of worker threads.
+ *
+ * This is an alternative to k_work_queue_start() for queues whose items
+ * should be processed by several threads, e.g. to use more than one CPU on
+ * SMP systems.  Once started the queue is used with the regular API:
+ * k_work_submit_to_queue(), k_work_flush(), k_work_cancel_sync(),
+ * k_work_queue_drain(), delayable work, etc.
+ *
+ * Each worker has its own local queue.  Items submitted from outside the
+ * pool are distributed round-robin over the workers, items submitted from a
+ * worker go to that worker's local queue, and an idle worker steals work
+ * from the local queues of busy workers.  As with a single threaded queue, a
+ * given work item never runs concurrently with itself: an item resubmitted
+ * while it is running is queued to the worker running it, and is not stolen
+ * before that run completes.  Beyond that there is no ordering guarantee
+ * between items.
+ *
+ * The thread embedded in @p queue is not used: k_work_queue_thread_get()
+ * returns the thread of the first worker.
+ *
+ * @param queue pointer to the queue structure. It must be initialized
+ *        in zeroed/bss memory or with @ref k_work_queue_init before
+ *        use.
+ *
+ * @param workers array of @p num_workers worker structures.
+ *
+ * @param stacks first element of a stack array, defined with
+ *        K_THREAD_STACK_ARRAY_DEFINE() with at least @p num_workers elements
+ *        of @p stack_size bytes.
+ *
+ * @param num_workers number of worker threads, between 1 and 255.
+ *
+ * @param stack_size size of each worker stack area, in bytes.
+ *
+ * @param prio initial priority of the worker threads.
+ *
+ * @param cfg optional additional configuration parameters.  Pass @c
+ * NULL if not required, to use the defaults documented in
+ * k_work_queue_config.
+ */
+void k_work_queue_pool_start(struct k_work_q *queue,
+			     struct k_work_q_worker *workers,
+			     k_thread_stack_t *stacks, int num_workers,
+			     size_t stack_size, int prio,
+			     const struct k_work_queue_config *cfg);
+
+#if defined(CONFIG_WORKQUEUE_POOL_STATS) || defined(__DOXYGEN__)
+/** @brief Get the statistics of a work queue pool worker.
+ *
+ * @param queue pointer to a queue started with k_work_queue_pool_start().
+ *
+ * @param worker index of the worker.
+ *
+ * @param stats destination of the statistics.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if @p queue is not a pool or @p worker is out of range
+ */
+int k_work_queue_pool_stats_get(struct k_work_q *queue, int worker,
+				struct k_work_q_worker_stats *stats);
+
+/** @brief Reset the statistics of all the workers of a work queue pool.
+ *
+ * The current queue depths are kept.
+ *
+ * @param queue pointer to a queue started with k_work_queue_pool_start().
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if @p queue is not a pool
+ */
+int k_work_queue_pool_stats_reset(struct k_work_q *queue);
+#endif /* CONFIG_WORKQUEUE_POOL_STATS */
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /** @brief Initialize a delayable work structure.
  *
  * This must be invoked before scheduling a delayable work structure for the
@@ -3981,6 +4136,11 @@ struct k_work {
 	 * It can be RUNNING and CANCELING simultaneously.
 	 */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL_STATS
+	/* Cycle count when the item was last queued to a work queue pool. */
+	uint32_t queued_at;
+#endif
 };
 
 #define Z_WORK_INITIALIZER(work_handler) { \
@@ -4109,7 +4269,76 @@ struct k_work_queue_config {
 	 * essential thread.
 	 */
 	bool essential;
+
+#if defined(CONFIG_WORKQUEUE_POOL) || defined(__DOXYGEN__)
+	/** Pin worker @c i of a work queue pool to CPU
+	 * <tt>i % arch_num_cpus()</tt>.
+	 *
+	 * Only used by k_work_queue_pool_start(), requires
+	 * CONFIG_SCHED_CPU_MASK.
+	 */
+	bool pin_workers;
+#endif
+};
+
+#if defined(CONFIG_WORKQUEUE_POOL_STATS) || defined(__DOXYGEN__)
+/** @brief Statistics of a work queue pool worker.
+ *
+ * Latencies are in hardware cycles, see k_cycle_get_32().
+ */
+struct k_work_q_worker_stats {
+	/** Number of work items run by the worker. */
+	uint32_t executed;
+	/** Number of those items taken from the local queue of another worker. */
+	uint32_t stolen;
+	/** Number of items currently in the local queue. */
+	uint32_t depth;
+	/** Highest number of items seen in the local queue. */
+	uint32_t max_depth;
+	/** Sum of the times items waited between submission and start. */
+	uint64_t total_wait_cycles;
+	/** Longest time an item waited between submission and start. */
+	uint32_t max_wait_cycles;
+	/** Longest time spent in a work handler. */
+	uint32_t max_run_cycles;
+	/** Sum of the times spent in work handlers. */
+	uint64_t total_run_cycles;
+};
+#endif /* CONFIG_WORKQUEUE_POOL_STATS */
+
+#if defined(CONFIG_WORKQUEUE_POOL) || defined(__DOXYGEN__)
+/** @brief A worker thread of a work queue pool.
+ *
+ * See k_work_queue_pool_start().
+ */
+struct k_work_q_worker {
+	/* The thread of the worker. */
+	struct k_thread thread;
+
+	/* All the following fields must be accessed only while the
+	 * work module spinlock is held.
+	 */
+
+	/* Local queue of k_work items. */
+	sys_slist_t pending;
+
+	/* Wait queue for the idle worker thread. */
+	_wait_q_t notifyq;
+
+	/* The pool this worker belongs to. */
+	struct k_work_q *queue;
+
+	/* The item being run by the worker, NULL when not running one. */
+	struct k_work *current;
+
+	/* Set while the worker waits on notifyq. */
+	bool idle;
+
+#ifdef CONFIG_WORKQUEUE_POOL_STATS
+	struct k_work_q_worker_stats stats;
+#endif
 };
+#endif /* CONFIG_WORKQUEUE_POOL */
 
 /** @brief A structure used to hold work until it can be processed. */
 struct k_work_q {
@@ -4131,6 +4360,22 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Workers of a queue started with k_work_queue_pool_start(), NULL
+	 * for a queue served by the thread above.
+	 */
+	struct k_work_q_worker *workers;
+
+	/* Number of entries in workers. */
+	uint8_t num_workers;
+
+	/* Worker receiving the next submission from outside the pool. */
+	uint8_t next_worker;
+
+	/* Number of workers running an item. */
+	uint8_t busy_workers;
+#endif
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4166,6 +4411,11 @@ static inline k_ticks_t k_work_delayable_remaining_get(
 
 static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue)
 {
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue->workers != NULL) {
+		return &queue->workers[0].thread;
+	}
+#endif
 	return &queue->thread;
 }
 
@@ -4525,6 +4775,8 @@ struct k_msgq {
 	char *write_ptr;
 	/** Number of used messages */
 	uint32_t used_msgs;
+	/** Number of messages claimed with k_msgq_get_claim() */
+	uint32_t claimed_msgs;
 
 	Z_DECL_POLL_EVENT
 
@@ -4552,6 +4804,7 @@ struct k_msgq {
 	.read_ptr = q_buffer, \
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
+	.claimed_msgs = 0, \
 	Z_POLL_EVENT_OBJ_INIT(obj) \
 	}
 
@@ -4692,9 +4945,113 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  * @retval 0 Message received.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Messages are claimed with k_msgq_get_claim().
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages from @a data to
+ * message queue @a msgq, taking the message queue lock only once. Messages
+ * are first handed to threads waiting to receive, the remaining ones are
+ * copied to the ring buffer as long as it has free entries.
+ *
+ * If no message can be sent, the routine waits until the first message is
+ * sent or @a timeout expires, like k_msgq_put().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num_msgs Number of messages at @a data.
+ * @param timeout Waiting period to add the first message, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages sent, greater than 0 if @a num_msgs is.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_n(struct k_msgq *msgq, const void *data, uint32_t num_msgs,
+			   k_timeout_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a msgq in a "first in, first out" manner, taking the message queue lock
+ * only once.
+ *
+ * If the queue is empty, the routine waits until one message is received or
+ * @a timeout expires, like k_msgq_get().
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold @a num_msgs messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages received, greater than 0 if @a num_msgs is.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Messages are claimed with k_msgq_get_claim().
+ */
+__syscall int k_msgq_get_n(struct k_msgq *msgq, void *data, uint32_t num_msgs,
+			   k_timeout_t timeout);
+
+/**
+ * @brief Claim messages in place in a message queue.
+ *
+ * This routine removes up to @a max_msgs messages from the head of message
+ * queue @a msgq and gives direct access to them in the ring buffer, so that
+ * they can be processed without being copied out. The claimed messages are
+ * contiguous: fewer than @a max_msgs messages are claimed if the ring buffer
+ * wraps around. Their entries are not reused until they are released with
+ * k_msgq_get_finish().
+ *
+ * Only one claim may be outstanding at a time, and at most one less than
+ * the maximum number of messages of the queue can be claimed. Until the claim
+ * is finished, k_msgq_get() and k_msgq_get_n() fail with -EBUSY, while
+ * messages can still be sent. This routine does not wait: use k_poll() with
+ * K_POLL_TYPE_MSGQ_DATA_AVAILABLE to wait for messages.
+ *
+ * @note Not available from user mode, the ring buffer being kernel memory.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Receives the address of the first claimed message.
+ * @param max_msgs Maximum number of messages to claim.
+ *
+ * @return Number of messages claimed, greater than 0.
+ * @retval -ENOMSG Returned when the queue has no message.
+ * @retval -EBUSY Returned when a claim is already outstanding.
+ * @retval -EINVAL @a max_msgs is 0 or the queue holds a single message.
+ */
+int k_msgq_get_claim(struct k_msgq *msgq, void **data, uint32_t max_msgs);
+
+/**
+ * @brief Release messages claimed in a message queue.
+ *
+ * This routine releases the first @a num_msgs messages claimed with
+ * k_msgq_get_claim(), making their entries available to senders. The other
+ * claimed messages are returned to the head of the queue, to be received
+ * again.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param num_msgs Number of claimed messages that were consumed.
+ *
+ * @retval 0 Messages released.
+ * @retval -EINVAL @a num_msgs is larger than the number of claimed messages.
+ */
+int k_msgq_get_finish(struct k_msgq *msgq, uint32_t num_msgs);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4766,7 +5123,7 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	return msgq->max_msgs - msgq->used_msgs - msgq->claimed_msgs;
 }
 
 /**
@@ -5730,6 +6087,7 @@ enum _poll_states_bits {
 	       + _POLL_NUM_TYPES \
 	       + _POLL_NUM_STATES \
 	       + 1 /* modes */ \
+	       + 1 /* persistent */ \
 	      ))
 
 /* end of polling API - PRIVATE */
@@ -5814,6 +6172,9 @@ struct k_poll_event {
 	/** mode of operation, from enum k_poll_modes */
 	uint32_t mode:1;
 
+	/** PRIVATE - DO NOT TOUCH */
+	uint32_t persistent:1;
+
 	/** unused bits in 32-bit word */
 	uint32_t unused:_POLL_EVENT_NUM_UNUSED_BITS;
 
@@ -5979,6 +6340,119 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Poll set
+ *
+ * A poll set keeps poll events registered on their objects across waits.
+ * When one of those objects changes state, the matching event is moved to
+ * the set's ready list and a thread waiting on the set is woken up. The cost
+ * of waiting on a set is therefore proportional to the number of events that
+ * became ready, not to the number of events in the set.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set The poll set to initialize.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Arm a poll event in a poll set.
+ *
+ * The event is registered on its object and stays registered until it is
+ * either delivered by k_poll_set_wait() or removed with k_poll_set_remove().
+ * If the event condition is already met, the event is queued on the ready
+ * list right away.
+ *
+ * The event state is reset to K_POLL_STATE_NOT_READY. The event must not be
+ * armed in another poll set or passed to k_poll() while it is armed.
+ *
+ * @param set The poll set.
+ * @param event The event to arm, initialized with k_poll_event_init().
+ */
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Arm a poll event in a poll set until it is removed.
+ *
+ * Like k_poll_set_add(), but the event stays armed when k_poll_set_wait()
+ * delivers it: it is registered on its object again right away, and is
+ * reported anew the next time the object signals it, without any further
+ * call. This avoids re-arming events that are waited on over and over.
+ *
+ * Reporting is edge-triggered: an event is queued when its object signals
+ * a change (a semaphore given, data added, a signal raised), not for as long
+ * as its condition holds. State bits keep accumulating in the event while it
+ * is armed: read and clear them with k_poll_set_state_take(), never by
+ * writing the state field of an armed event.
+ *
+ * @param set The poll set.
+ * @param event The event to arm, initialized with k_poll_event_init().
+ */
+void k_poll_set_add_persistent(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Disarm a poll event.
+ *
+ * Removes the event from its object or from the set's ready list, whichever
+ * it is linked on. Removing an event that is not armed has no effect.
+ *
+ * @param set The poll set the event was armed in.
+ * @param event The event to disarm.
+ */
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Take the state of a poll event of a poll set.
+ *
+ * Returns the state bits accumulated by the event and resets them to
+ * K_POLL_STATE_NOT_READY, atomically with respect to the objects signalling
+ * the event. This is how the state of an event armed with
+ * k_poll_set_add_persistent() is consumed once k_poll_set_wait() has
+ * reported it.
+ *
+ * @param set The poll set the event is armed in.
+ * @param event The event.
+ *
+ * @return The state of the event before it was reset.
+ */
+uint32_t k_poll_set_state_take(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to become ready.
+ *
+ * Up to @p num_events ready events are taken off the ready list and stored in
+ * @p events. Events armed with k_poll_set_add() are no longer armed: their
+ * state field can be read directly, and they have to be armed again to be
+ * reported another time. Events armed with k_poll_set_add_persistent() stay
+ * armed, their state is read and cleared with k_poll_set_state_take().
+ *
+ * If @p num_events is 0, the call only waits for the ready list to become
+ * non-empty and leaves the ready events queued.
+ *
+ * @param set The poll set.
+ * @param events Array receiving the ready events.
+ * @param num_events Size of @p events.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @p events.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int num_events, k_timeout_t timeout);
+
 /** @} */
 
 /**
@@ -0,0 +1,113 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel data page readable from user mode
+ *
+ * The kernel publishes the system tick counter and the thread running on
+ * each CPU in a page that user threads can read but not write, so that
+ * k_uptime_ticks(), k_current_get() and k_current_cpu_get() don't need a
+ * system call. This is an implementation detail of those APIs.
+ */
+
+#ifndef ZEPHYR_INCLUDE_KERNEL_SHARED_PAGE_H_
+#define ZEPHYR_INCLUDE_KERNEL_SHARED_PAGE_H_
+
+#ifdef CONFIG_USERSPACE_SHARED_PAGE
+
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/barrier.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct k_thread;
+
+/** @cond INTERNAL_HIDDEN */
+
+struct z_shared_page {
+	/* Odd while ticks is being updated */
+	uint32_t tick_seq;
+
+	/* System tick counter, as of the last sys_clock_announce() */
+	uint64_t ticks;
+
+	/* Thread running on each CPU */
+	struct k_thread *current[CONFIG_MP_MAX_NUM_CPUS];
+};
+
+#ifdef CONFIG_MMU
+/* Rounded up to whole pages, so that mapping it exposes nothing else */
+union z_shared_page_frame {
+	struct z_shared_page page;
+	uint8_t bytes[ROUND_UP(sizeof(struct z_shared_page), CONFIG_MMU_PAGE_SIZE)];
+};
+
+/* Kernel view, and the read-only alias of the same memory mapped for users */
+extern union z_shared_page_frame z_shared_page_frame;
+extern union z_shared_page_frame z_shared_page_user_frame;
+
+#define Z_SHARED_PAGE_KERNEL (&z_shared_page_frame.page)
+#define Z_SHARED_PAGE_USER \
+	((const volatile struct z_shared_page *)&z_shared_page_user_frame.page)
+#else
+/* Memory protection units map it read-only for users through this
+ * partition, which is part of the default memory domain. Applications
+ * defining their own memory domains need to add it to them.
+ */
+extern struct k_mem_partition z_shared_page_partition;
+extern struct z_shared_page z_shared_page;
+
+#define Z_SHARED_PAGE_KERNEL (&z_shared_page)
+#define Z_SHARED_PAGE_USER ((const volatile struct z_shared_page *)&z_shared_page)
+#endif /* CONFIG_MMU */
+
+static inline int64_t z_shared_page_ticks_get(void)
+{
+	const volatile struct z_shared_page *page = Z_SHARED_PAGE_USER;
+	uint32_t seq;
+	uint64_t ticks;
+
+	do {
+		seq = page->tick_seq;
+		barrier_dmem_fence_full();
+		ticks = page->ticks;
+		barrier_dmem_fence_full();
+	} while (((seq & 1U) != 0U) || (seq != page->tick_seq));
+
+	return (int64_t)ticks;
+}
+
+static inline struct k_thread *z_shared_page_current_get(unsigned int cpu)
+{
+	return Z_SHARED_PAGE_USER->current[cpu];
+}
+
+/* Find the CPU running @a thread, -1 if it moved while being looked for */
+static inline int z_shared_page_cpu_find(const struct k_thread *thread)
+{
+	for (unsigned int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		if (z_shared_page_current_get(cpu) == thread) {
+			return (int)cpu;
+		}
+	}
+
+	return -1;
+}
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_USERSPACE_SHARED_PAGE */
+
+#endif /* ZEPHYR_INCLUDE_KERNEL_SHARED_PAGE_H_ */
@@ -8,6 +8,7 @@
 #define ZEPHYR_INCLUDE_KERNEL_SMP_H_
 
 #include <stdbool.h>
+#include <zephyr/kernel/stats.h>
 
 typedef void (*smp_init_fn)(void *arg);
 
@@ -68,4 +69,27 @@ void k_smp_cpu_start(int id, smp_init_fn fn, void *arg);
 void k_smp_cpu_resume(int id, smp_init_fn fn, void *arg,
 		      bool reinit_timer, bool invoke_sched);
 
+/**
+ * @brief Get the scheduler IPI statistics of a CPU.
+ *
+ * The counts are updated without synchronization with this call, so they
+ * may be slightly out of date on return.
+ *
+ * @note Requires CONFIG_IPI_STATS.
+ *
+ * @param id ID of target CPU.
+ * @param stats Pointer to the structure to fill.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if @a id is not a valid CPU ID
+ */
+int k_ipi_stats_get(int id, struct k_ipi_stats *stats);
+
+/**
+ * @brief Reset the scheduler IPI statistics of all CPUs.
+ *
+ * @note Requires CONFIG_IPI_STATS.
+ */
+void k_ipi_stats_reset(void);
+
 #endif /* ZEPHYR_INCLUDE_KERNEL_SMP_H_ */
@@ -10,6 +10,55 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#if defined(CONFIG_SCHED_THREAD_USAGE_LATENCY) || defined(__DOXYGEN__)
+/**
+ * Structure used to track a distribution of scheduling latencies.
+ *
+ * Bucket 0 counts latencies of 0 and 1 cycle and bucket n > 0 counts those
+ * of 2^n up to 2^(n+1) - 1 cycles. The last bucket also counts all the
+ * longer ones.
+ */
+
+struct k_latency_stats {
+	uint64_t  total;        /**< sum of all latencies in cycles */
+	uint32_t  count;        /**< \# of latencies */
+	uint32_t  min;          /**< shortest latency, valid if count != 0 */
+	uint32_t  max;          /**< longest latency */
+	uint32_t  buckets[CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS]; /**< log2 histogram */
+};
+
+/**
+ * @brief Estimate a percentile of a latency distribution
+ *
+ * @param stats Latency distribution
+ * @param percent Percentile, from 0 to 100
+ *
+ * @return Upper bound in cycles of the bucket holding the percentile, capped
+ * by the longest latency, or 0 if no latency was recorded.
+ */
+static inline uint32_t k_latency_stats_percentile(const struct k_latency_stats *stats,
+						  unsigned int percent)
+{
+	uint64_t rank = ((uint64_t)stats->count * percent + 99U) / 100U;
+	uint64_t seen = 0U;
+
+	if (stats->count == 0U) {
+		return 0U;
+	}
+
+	for (unsigned int i = 0; i < CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS - 1; i++) {
+		uint64_t upper = (2ULL << i) - 1U;
+
+		seen += stats->buckets[i];
+		if ((seen >= rank) && (seen != 0U)) {
+			return (upper < stats->max) ? (uint32_t)upper : stats->max;
+		}
+	}
+
+	return stats->max;
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 /**
  * Structure used to track internal statistics about both thread
  * and CPU usage.
@@ -27,7 +76,40 @@ struct k_cycle_stats {
 	uint32_t  num_windows;  /**< \# of usage windows */
 	/** @} */
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#if defined(CONFIG_SCHED_THREAD_USAGE_LATENCY) || defined(__DOXYGEN__)
+	/**
+	 * @name Fields available when CONFIG_SCHED_THREAD_USAGE_LATENCY is selected.
+	 * @{
+	 */
+	struct k_latency_stats wakeup;   /**< from becoming ready to running */
+	struct k_latency_stats preempt;  /**< from being preempted to running again */
+	/** @} */
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
+/**
+ * Structure used to track contention on a lock object.
+ */
+
+struct k_lock_stats {
+	uint64_t  acquired;     /**< \# of acquisitions */
+	uint64_t  contended;    /**< \# of attempts that had to wait */
+	uint64_t  total_wait;   /**< total waiting time in cycles */
+	uint32_t  max_wait;     /**< longest wait in cycles */
+	uint32_t  max_hold;     /**< longest hold in cycles */
+	uint64_t  spun;         /**< \# of attempts that spun before pending */
+	uint64_t  spin_acquired; /**< \# of those that acquired while spinning */
+};
+
+/**
+ * Structure used to count the scheduler IPIs of a CPU.
+ */
+
+struct k_ipi_stats {
+	uint64_t  sent;         /**< \# of IPIs this CPU has sent */
+	uint64_t  received;     /**< \# of IPIs this CPU has handled */
+	uint64_t  coalesced;    /**< \# of IPIs this CPU didn't need to send */
+};
+
 #endif /* ZEPHYR_INCLUDE_KERNEL_STATS_H_ */
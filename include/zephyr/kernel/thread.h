@@ -145,6 +145,14 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif /* CONFIG_SCHED_THREAD_USAGE */
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	/* When the thread became ready to run, 0 if it isn't waiting to */
+	uint32_t ready_at;
+
+	/* Whether it is waiting after being preempted, not woken up */
+	bool ready_preempted;
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
 };
 
 typedef struct _thread_base _thread_base_t;
@@ -237,6 +245,17 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	/*
+	 * Time from becoming ready (started or woken up) to being switched
+	 * in, and from being preempted, by a thread or an interrupt, to
+	 * running again. For CPUs, these cover all the threads switched in.
+	 */
+
+	struct k_latency_stats wakeup_latency;
+	struct k_latency_stats preempt_latency;
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
 	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
@@ -43,6 +43,7 @@
 #include <zephyr/app_memory/mem_domain.h>
 #include <zephyr/sys/kobject.h>
 #include <zephyr/kernel/thread.h>
+#include <zephyr/kernel/shared_page.h>
 /* FIXME This needs to be removed. Exposes some private APIs to SOF */
 #include <zephyr/kernel/internal/smp.h>
 
@@ -190,6 +190,10 @@ struct _cpu {
 	struct k_obj_core  obj_core;
 #endif
 
+#ifdef CONFIG_IPI_STATS
+	struct k_ipi_stats ipi_stats;
+#endif
+
 	/* Per CPU architecture specifics */
 	struct _cpu_arch arch;
 };
@@ -240,6 +244,11 @@ struct z_kernel {
 	/* Identify CPUs to send IPIs to at the next scheduling point */
 	atomic_t pending_ipi;
 #endif
+
+#ifdef CONFIG_IPI_COALESCE
+	/* CPUs that have been sent an IPI they have not handled yet */
+	atomic_t inflight_ipi;
+#endif
 };
 
 typedef struct z_kernel _kernel_t;
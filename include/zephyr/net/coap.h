@@ -34,6 +34,8 @@
 extern "C" {
 #endif
 
+struct net_buf;
+
 /**
  * @brief Set of CoAP packet options we are aware of.
  *
@@ -306,6 +308,17 @@ struct coap_observer {
 	uint8_t tkl;
 };
 
+/** @cond INTERNAL_HIDDEN */
+
+/* Location of an option value in the packet data */
+struct coap_option_index_entry {
+	uint16_t code;
+	uint16_t offset;
+	uint16_t len;
+};
+
+/** @endcond */
+
 /**
  * @brief Representation of a CoAP Packet.
  */
@@ -323,6 +336,17 @@ struct coap_packet {
 	 */
 	void *user_data;
 #endif
+#if defined(CONFIG_COAP_OPTION_INDEX) || defined(DOXYGEN)
+	/**
+	 * Location of the options in the data, to find them without parsing.
+	 * Only available when @kconfig{CONFIG_COAP_OPTION_INDEX} is enabled.
+	 */
+	struct coap_option_index_entry opt_index[CONFIG_COAP_OPTION_INDEX_SIZE];
+	uint8_t opt_index_count;   /**< Number of options in the index */
+	uint8_t opt_index_hdr_len; /**< Header length the index was built for */
+	uint16_t opt_index_len;    /**< Options length the index was built for */
+	bool opt_indexed;          /**< The index covers all the options */
+#endif
 };
 
 /**
@@ -504,6 +528,29 @@ bool coap_uri_path_match(const char * const *path,
 int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 		      struct coap_option *options, uint8_t opt_num);
 
+/**
+ * @brief Parses the CoAP packet held in a network buffer, without copying
+ * it.
+ *
+ * This function works like @ref coap_packet_parse, using the data of @a buf
+ * in place. @a buf must remain valid while @a cpkt is used.
+ *
+ * @param cpkt Packet to be initialized from received @a buf.
+ * @param buf Network buffer containing a CoAP packet, its data pointer is
+ * positioned on the start of the CoAP packet.
+ * @param options Parse options and cache its details.
+ * @param opt_num Number of options
+ *
+ * @retval 0 in case of success.
+ * @retval -EINVAL in case of invalid input args.
+ * @retval -EMSGSIZE if the packet is split over several fragments, use
+ * net_buf_linearize() and @ref coap_packet_parse for those.
+ * @retval -EBADMSG in case of malformed coap packet header.
+ * @retval -EILSEQ in case of malformed coap options.
+ */
+int coap_packet_parse_net_buf(struct coap_packet *cpkt, struct net_buf *buf,
+			      struct coap_option *options, uint8_t opt_num);
+
 /**
  * @brief Parses provided coap path (with/without query) or query and appends
  * that as options to the @a cpkt.
@@ -534,6 +581,40 @@ int coap_packet_init(struct coap_packet *cpkt, uint8_t *data, uint16_t max_len,
 		     uint8_t ver, uint8_t type, uint8_t token_len,
 		     const uint8_t *token, uint8_t code, uint16_t id);
 
+/**
+ * @brief Creates a new CoAP Packet in the tailroom of a network buffer.
+ *
+ * This function works like @ref coap_packet_init, building the packet
+ * directly after the data already in @a buf. Once the packet is complete,
+ * add it to the buffer with @ref coap_packet_net_buf_commit.
+ *
+ * @param cpkt New packet to be initialized using the tailroom of @a buf.
+ * @param buf Network buffer that will contain the CoAP packet
+ * @param ver CoAP header version
+ * @param type CoAP header type
+ * @param token_len CoAP header token length
+ * @param token CoAP header token
+ * @param code CoAP header code
+ * @param id CoAP header message id
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_packet_init_net_buf(struct coap_packet *cpkt, struct net_buf *buf,
+			     uint8_t ver, uint8_t type, uint8_t token_len,
+			     const uint8_t *token, uint8_t code, uint16_t id);
+
+/**
+ * @brief Adds a CoAP Packet built with @ref coap_packet_init_net_buf to the
+ * data of its network buffer.
+ *
+ * @param cpkt Packet built in the tailroom of @a buf.
+ * @param buf Network buffer given to @ref coap_packet_init_net_buf.
+ *
+ * @retval 0 in case of success.
+ * @retval -EINVAL if @a cpkt was not built in the tailroom of @a buf.
+ */
+int coap_packet_net_buf_commit(struct coap_packet *cpkt, struct net_buf *buf);
+
 /**
  * @brief Create a new CoAP Acknowledgment message for given request.
  *
@@ -592,6 +673,9 @@ uint16_t coap_next_id(void);
  * of the options found
  * @param veclen Number of elements in the options array
  *
+ * With @kconfig{CONFIG_COAP_OPTION_INDEX}, the options indexed when the
+ * packet was parsed or built are looked up without parsing the packet again.
+ *
  * @return The number of options found in packet matching code,
  * negative on error.
  */
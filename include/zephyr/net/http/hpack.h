@@ -12,6 +12,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 #define ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -104,6 +105,22 @@ enum http_hpack_static_key {
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE 0
 #endif
 
+/* Size accounted for each dynamic table entry in addition to its name and
+ * value, RFC7541 ch 4.1.
+ */
+#define HTTP_HPACK_ENTRY_OVERHEAD 32
+
+/* A table too small to hold a single entry is not kept at all. */
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE) && \
+	(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE >= HTTP_HPACK_ENTRY_OVERHEAD)
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE
+#else
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE 0
+#endif
+
+/* Dynamic table size the peer allows by default, RFC7540 ch 6.5.2. */
+#define HTTP_HPACK_DEFAULT_TABLE_SIZE 4096
+
 /** @endcond */
 
 /** HTTP2 header field with decoding buffer. */
@@ -127,6 +144,41 @@ struct http_hpack_header_buf {
 	size_t datalen;
 };
 
+/** HPACK dynamic table of the encoder. */
+struct http_hpack_table {
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	/** Names and values of the entries, from the oldest to the newest. */
+	uint8_t data[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE];
+
+	/** Lengths of the entries, from the oldest to the newest. */
+	struct {
+		/** Length of the header field name. */
+		uint16_t name_len;
+
+		/** Length of the header field value. */
+		uint16_t value_len;
+	} entries[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE / HTTP_HPACK_ENTRY_OVERHEAD];
+#endif
+
+	/** Number of entries in the table. */
+	uint16_t count;
+
+	/** Length of the names and values in the data buffer. */
+	uint16_t data_len;
+
+	/** Maximum size of the table, as accounted in RFC7541 ch 4.1. */
+	uint16_t max_size;
+
+	/** Smallest maximum size since the last size update was sent. */
+	uint16_t min_size;
+
+	/** The maximum size shall be sent to the decoder. */
+	bool size_update;
+
+	/** The decoder shall evict all the entries. */
+	bool flush;
+};
+
 /** @cond INTERNAL_HIDDEN */
 
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
@@ -138,6 +190,14 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 			     struct http_hpack_header_buf *header);
 
+void http_hpack_table_init(struct http_hpack_table *table);
+void http_hpack_table_set_max_size(struct http_hpack_table *table,
+				   uint32_t max_size);
+void http_hpack_table_reset(struct http_hpack_table *table);
+int http_hpack_table_encode_header(struct http_hpack_table *table,
+				   uint8_t *buf, size_t buflen,
+				   struct http_hpack_header_buf *header);
+
 /** @endcond */
 
 #ifdef __cplusplus
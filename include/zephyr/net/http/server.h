@@ -333,6 +333,7 @@ enum http1_parser_state {
 
 #define HTTP_SERVER_INITIAL_WINDOW_SIZE 65536
 #define HTTP_SERVER_WS_MAX_SEC_KEY_LEN 32
+#define HTTP_SERVER_HTTP_DATE_LEN sizeof("Sun, 06 Nov 1994 08:49:37 GMT")
 
 /** @endcond */
 
@@ -426,6 +427,9 @@ struct http_client_ctx {
 	/** HTTP/2 header parser context. */
 	struct http_hpack_header_buf header_field;
 
+	/** HTTP/2 response headers compression context. */
+	struct http_hpack_table hpack_table;
+
 	/** HTTP/2 streams context. */
 	struct http2_stream_ctx streams[HTTP_SERVER_MAX_STREAMS];
 
@@ -469,6 +473,14 @@ struct http_client_ctx {
 /** @cond INTERNAL_HIDDEN */
 	/** Websocket security key. */
 	IF_ENABLED(CONFIG_WEBSOCKET, (uint8_t ws_sec_key[HTTP_SERVER_WS_MAX_SEC_KEY_LEN]));
+
+	/** If-None-Match request header, empty if absent. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE,
+		   (char if_none_match[HTTP_SERVER_MAX_HEADER_LEN]));
+
+	/** If-Modified-Since request header, empty if absent. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE,
+		   (char if_modified_since[HTTP_SERVER_HTTP_DATE_LEN]));
 /** @endcond */
 
 	/** Flag indicating that HTTP2 preface was sent. */
@@ -489,6 +501,12 @@ struct http_client_ctx {
 	/** Flag indicating Websocket key is being processed. */
 	bool websocket_sec_key_next : 1;
 
+	/** Flag indicating If-None-Match header is being processed. */
+	bool if_none_match_next : 1;
+
+	/** Flag indicating If-Modified-Since header is being processed. */
+	bool if_modified_since_next : 1;
+
 	/** The next frame on the stream is expectd to be a continuation frame. */
 	bool expect_continuation : 1;
 };
@@ -522,6 +540,17 @@ int http_server_start(void);
  */
 int http_server_stop(void);
 
+/** @brief Drop the files of static filesystem resources cached in memory.
+ *
+ * To be called after changing files served through static filesystem
+ * resources, so that the server reads them again from the filesystem for the
+ * next requests rather than after
+ * @kconfig{CONFIG_HTTP_SERVER_STATIC_FS_CACHE_REVALIDATE_MS}.
+ *
+ * @note Only available with @kconfig{CONFIG_HTTP_SERVER_STATIC_FS_CACHE}.
+ */
+void http_server_fs_cache_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -485,6 +485,30 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_PUBLISH_BATCH)
+	/** Internal. Headers and payloads of the queued publish messages. */
+	struct iovec batch_iov[2 * CONFIG_MQTT_PUBLISH_BATCH_SIZE];
+
+	/** Internal. Length of the queued headers in the TX buffer. */
+	uint32_t batch_len;
+
+	/** Internal. Time the first queued message was queued at. */
+	uint32_t batch_start;
+
+	/** Internal. Number of entries used in batch_iov. */
+	uint8_t batch_iovlen;
+#endif
+
+#if defined(CONFIG_MQTT_PUBLISH_INFLIGHT_MAX) && (CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0)
+	/** Internal. Message IDs of the QoS 1 and QoS 2 messages not
+	 *  acknowledged yet.
+	 */
+	uint16_t inflight[CONFIG_MQTT_PUBLISH_INFLIGHT_MAX];
+
+	/** Internal. Number of messages in flight. */
+	uint8_t inflight_count;
+#endif
 };
 
 /**
@@ -623,10 +647,49 @@ int mqtt_connect(struct mqtt_client *client);
  *                  Shall not be NULL.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *         -EAGAIN if @kconfig{CONFIG_MQTT_PUBLISH_INFLIGHT_MAX} QoS 1 and
+ *         QoS 2 messages are already waiting to be acknowledged.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to queue messages to publish, to send them together.
+ *
+ * The message is encoded in the TX buffer after the messages already queued,
+ * and its payload is referenced rather than copied. Queued messages are sent
+ * with a single transport write by mqtt_publish_flush(), when the batch is
+ * full or there is no room left for the message in the TX buffer, before
+ * any other packet the client sends, and by mqtt_live() once the first of
+ * them has waited for @kconfig{CONFIG_MQTT_PUBLISH_BATCH_TIMEOUT}.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] param Parameters to be used for the publish message.
+ *                  Shall not be NULL. The payload shall remain valid until
+ *                  the message is sent.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *         -EAGAIN if @kconfig{CONFIG_MQTT_PUBLISH_INFLIGHT_MAX} QoS 1 and
+ *         QoS 2 messages are already waiting to be acknowledged.
+ *
+ * @note Requires @kconfig{CONFIG_MQTT_PUBLISH_BATCH}.
+ */
+int mqtt_publish_queue(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param);
+
+/**
+ * @brief API to send the messages queued with mqtt_publish_queue().
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *
+ * @note Requires @kconfig{CONFIG_MQTT_PUBLISH_BATCH}.
+ */
+int mqtt_publish_flush(struct mqtt_client *client);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -765,8 +828,10 @@ int mqtt_live(struct mqtt_client *client);
  * @param[in] client Client instance for which the procedure is requested.
  *
  * @return Time in milliseconds until next keep alive message is expected to
- *         be sent. Function will return -1 if keep alive messages are
- *         not enabled.
+ *         be sent, or until mqtt_live() sends the publish messages queued
+ *         with mqtt_publish_queue() if that comes first. Function will
+ *         return -1 if keep alive messages are not enabled and no
+ *         messages are queued.
  */
 int mqtt_keepalive_time_left(const struct mqtt_client *client);
 
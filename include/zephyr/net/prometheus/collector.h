@@ -100,6 +100,7 @@ struct prometheus_collector {
  * @return 0 if successful, otherwise a negative error code.
  * @retval -EINVAL Invalid arguments.
  * @retval -ENOMEM Not enough memory to register the metric.
+ * @retval -EALREADY The metric is already registered with the collector.
  */
 int prometheus_collector_register_metric(struct prometheus_collector *collector,
 					 struct prometheus_metric *metric);
@@ -19,9 +19,19 @@
 
 #include <stdint.h>
 
+#include <zephyr/spinlock.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/net/prometheus/metric.h>
 
+/** @cond INTERNAL_HIDDEN */
+
+struct prometheus_counter_shard {
+	struct k_spinlock lock;
+	uint64_t value;
+};
+
+/** @endcond */
+
 /**
  * @brief Type used to represent a Prometheus counter metric.
  *
@@ -31,8 +41,17 @@
 struct prometheus_counter {
 	/** Base of the Prometheus counter metric */
 	struct prometheus_metric base;
-	/** Value of the Prometheus counter metric */
+	/** Value of the Prometheus counter metric. With
+	 * CONFIG_PROMETHEUS_PER_CPU_METRICS the increments are kept in
+	 * per-CPU shards instead, use prometheus_counter_get() to read it.
+	 */
 	uint64_t value;
+	/** Lock protecting the value */
+	struct k_spinlock lock;
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS) || defined(__DOXYGEN__)
+	/** Per-CPU increments, summed when the counter is read */
+	struct prometheus_counter_shard shards[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 	/** User data */
 	void *user_data;
 };
@@ -75,6 +94,7 @@ struct prometheus_counter {
 /**
  * @brief Increment the value of a Prometheus counter metric
  * Increments the value of the specified counter metric by arbitrary amount.
+ * The counter can be updated from several threads and CPUs at once.
  * @param counter Pointer to the counter metric to increment.
  * @param value Amount to increment the counter by.
  * @return 0 on success, negative errno on error.
@@ -92,6 +112,13 @@ static inline int prometheus_counter_inc(struct prometheus_counter *counter)
 	return prometheus_counter_add(counter, 1ULL);
 }
 
+/**
+ * @brief Get the value of a Prometheus counter metric
+ * @param counter Pointer to the counter metric to read.
+ * @return Current value of the counter.
+ */
+uint64_t prometheus_counter_get(struct prometheus_counter *counter);
+
 /**
  * @brief Set the counter value to specific value.
  * The new value must be higher than the current value. This function can be used
@@ -49,6 +49,49 @@ int prometheus_format_exposition(struct prometheus_collector *collector, char *b
 int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 				 size_t buffer_size, int *written);
 
+/** @cond INTERNAL_HIDDEN */
+
+struct prometheus_format_context {
+	struct prometheus_collector *collector;
+	struct prometheus_metric *metric;
+	int line;
+	enum prometheus_walk_state state;
+};
+
+/** @endcond */
+
+/**
+ * @brief Initialize a context to format exposition data in chunks
+ *
+ * @param ctx Pointer to the format context.
+ * @param collector Pointer to the collector containing the data to format.
+ *
+ * @return 0 on success, negative errno on error.
+ */
+int prometheus_format_exposition_init(struct prometheus_format_context *ctx,
+				      struct prometheus_collector *collector);
+
+/**
+ * @brief Format the next chunk of exposition data for Prometheus
+ *
+ * Formats as many whole lines of the exposition data of the collector as fit
+ * into the provided buffer, resuming where the previous call stopped. This
+ * allows sending the exposition of any number of metrics, for example as
+ * chunks of an HTTP response, with a buffer that only needs to hold the
+ * longest line. The collector lock is only held during the call.
+ *
+ * @param ctx Pointer to the format context, see prometheus_format_exposition_init().
+ * @param buffer Pointer to the buffer where the chunk will be stored.
+ * @param buffer_size Size of the buffer.
+ * @param len Length of the chunk, the chunk is not NUL-terminated.
+ *
+ * @return 0 if this was the last chunk, -EAGAIN if more chunks follow,
+ *         any other negative errno on error.
+ * @retval -ENOMEM A line does not fit into the buffer.
+ */
+int prometheus_format_exposition_chunk(struct prometheus_format_context *ctx, char *buffer,
+				       size_t buffer_size, size_t *len);
+
 /**
  * @}
  */
@@ -17,6 +17,7 @@
  * @{
  */
 
+#include <zephyr/spinlock.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/net/prometheus/metric.h>
 
@@ -43,7 +44,7 @@ struct prometheus_histogram_bucket {
 struct prometheus_histogram {
 	/** Base of the Prometheus histogram metric */
 	struct prometheus_metric base;
-	/** Array of buckets in the histogram */
+	/** Array of buckets in the histogram, sorted by upper bound */
 	struct prometheus_histogram_bucket *buckets;
 	/** Number of buckets in the histogram */
 	size_t num_buckets;
@@ -51,6 +52,8 @@ struct prometheus_histogram {
 	double sum;
 	/** Total count of observations in the histogram */
 	unsigned long count;
+	/** Lock protecting the sum and the counts */
+	struct k_spinlock lock;
 	/** User data */
 	void *user_data;
 };
@@ -97,7 +100,9 @@ struct prometheus_histogram {
 /**
  * @brief Observe a value in a Prometheus histogram metric
  *
- * Observes the specified value in the given histogram metric.
+ * Observes the specified value in the given histogram metric. The bucket is
+ * found with a binary search, so the buckets must be sorted by upper bound.
+ * The histogram can be updated from several threads and CPUs at once.
  *
  * @param histogram Pointer to the histogram metric to observe.
  * @param value Value to observe in the histogram metric.
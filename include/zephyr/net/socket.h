@@ -76,6 +76,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: do not block once the first message has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -500,6 +502,65 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Receive several messages from an arbitrary network address
+ *
+ * @details
+ * Receives up to @p vlen datagrams with a single call, each one as with
+ * zsock_recvmsg() into the corresponding element of @p msgvec, whose
+ * @c msg_len is set to the number of bytes received. The socket is looked up,
+ * locked and, for user mode callers, the arguments are validated once for the
+ * whole batch. As with zsock_recvmsg(), the @c msg_iov lengths and
+ * @c msg_iovlen of each message are updated in place to describe the
+ * received data, so they must be reset before the headers are used again.
+ *
+ * With @ref ZSOCK_MSG_WAITFORONE, only the first message is waited for and
+ * the call returns as soon as no more datagrams are queued. If @p timeout is
+ * not NULL, it is checked after each received datagram, as on Linux, so it
+ * does not bound the wait for the first one.
+ * No more than @kconfig{CONFIG_NET_SOCKETS_MMSG_VLEN_MAX} messages are
+ * received in one call.
+ * This function is also exposed as `recvmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket to receive from
+ * @param msgvec Array of message headers to fill in
+ * @param vlen Number of elements in @p msgvec
+ * @param flags Receive flags, as for zsock_recvmsg(), and
+ *        @ref ZSOCK_MSG_WAITFORONE
+ * @param timeout Time after which no more messages are received, or NULL
+ *
+ * @return Number of messages received, or -1 with errno set if no message
+ *         could be received
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			     int flags, struct timespec *timeout);
+
+/**
+ * @brief Send several messages to an arbitrary network address
+ *
+ * @details
+ * Sends up to @p vlen messages with a single call, each one as with
+ * zsock_sendmsg() from the corresponding element of @p msgvec, whose
+ * @c msg_len is set to the number of bytes sent. The socket is looked up,
+ * locked and, for user mode callers, the arguments are validated once for the
+ * whole batch. Sending stops at the first message that fails.
+ * No more than @kconfig{CONFIG_NET_SOCKETS_MMSG_VLEN_MAX} messages are sent
+ * in one call.
+ * This function is also exposed as `sendmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket to send to
+ * @param msgvec Array of messages to send
+ * @param vlen Number of elements in @p msgvec
+ * @param flags Send flags, as for zsock_sendmsg()
+ *
+ * @return Number of messages sent, or -1 with errno set if the first message
+ *         could not be sent
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			     int flags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -20,6 +20,13 @@
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/time_units.h>
 
+#ifdef CONFIG_LOCK_STATS_SPINLOCK
+#include <zephyr/kernel/stats.h>
+#ifdef CONFIG_OBJ_CORE_SPINLOCK
+#include <zephyr/kernel/obj_core.h>
+#endif /* CONFIG_OBJ_CORE_SPINLOCK */
+#endif /* CONFIG_LOCK_STATS_SPINLOCK */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -78,6 +85,20 @@ struct k_spinlock {
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_LOCK_STATS_SPINLOCK
+	/* Contention statistics, only updated with the lock held
+	 */
+	struct k_lock_stats stats;
+
+	/* Stores the time (in cycles) when the lock was taken
+	 */
+	uint32_t hold_start;
+
+#ifdef CONFIG_OBJ_CORE_SPINLOCK
+	struct k_obj_core obj_core;
+#endif /* CONFIG_OBJ_CORE_SPINLOCK */
+#endif /* CONFIG_LOCK_STATS_SPINLOCK */
+
 #if defined(CONFIG_CPP) && !defined(CONFIG_SMP) && \
 	!defined(CONFIG_SPIN_VALIDATE)
 	/* If CONFIG_SMP and CONFIG_SPIN_VALIDATE are both not defined
@@ -129,6 +150,61 @@ bool z_spin_lock_mem_coherent(struct k_spinlock *l);
  */
 typedef struct z_spinlock_key k_spinlock_key_t;
 
+/* Tracks the wait of one acquisition, empty without spinlock statistics */
+struct z_spinlock_wait {
+#ifdef CONFIG_LOCK_STATS_SPINLOCK
+	bool waited;
+	uint32_t start;
+#endif /* CONFIG_LOCK_STATS_SPINLOCK */
+};
+
+static ALWAYS_INLINE void z_spinlock_stats_wait(struct k_spinlock *l,
+						struct z_spinlock_wait *w)
+{
+	ARG_UNUSED(l);
+	ARG_UNUSED(w);
+#ifdef CONFIG_LOCK_STATS_SPINLOCK
+	if (!w->waited) {
+		w->waited = true;
+		w->start = sys_clock_cycle_get_32();
+	}
+#endif /* CONFIG_LOCK_STATS_SPINLOCK */
+}
+
+static ALWAYS_INLINE void z_spinlock_stats_acquired(struct k_spinlock *l,
+						    struct z_spinlock_wait *w)
+{
+	ARG_UNUSED(l);
+	ARG_UNUSED(w);
+#ifdef CONFIG_LOCK_STATS_SPINLOCK
+	uint32_t now = sys_clock_cycle_get_32();
+
+	l->stats.acquired++;
+	if (w->waited) {
+		uint32_t wait = now - w->start;
+
+		l->stats.contended++;
+		l->stats.total_wait += wait;
+		if (wait > l->stats.max_wait) {
+			l->stats.max_wait = wait;
+		}
+	}
+	l->hold_start = now;
+#endif /* CONFIG_LOCK_STATS_SPINLOCK */
+}
+
+static ALWAYS_INLINE void z_spinlock_stats_release(struct k_spinlock *l)
+{
+	ARG_UNUSED(l);
+#ifdef CONFIG_LOCK_STATS_SPINLOCK
+	uint32_t hold = sys_clock_cycle_get_32() - l->hold_start;
+
+	if (hold > l->stats.max_hold) {
+		l->stats.max_hold = hold;
+	}
+#endif /* CONFIG_LOCK_STATS_SPINLOCK */
+}
+
 static ALWAYS_INLINE void z_spinlock_validate_pre(struct k_spinlock *l)
 {
 	ARG_UNUSED(l);
@@ -192,6 +268,8 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 
 	z_spinlock_validate_pre(l);
 #ifdef CONFIG_SMP
+	struct z_spinlock_wait w = {};
+
 #ifdef CONFIG_TICKET_SPINLOCKS
 	/*
 	 * Enqueue ourselves to the end of a spinlock waiters queue
@@ -200,13 +278,16 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	atomic_val_t ticket = atomic_inc(&l->tail);
 	/* Spin until our ticket is served */
 	while (atomic_get(&l->owner) != ticket) {
+		z_spinlock_stats_wait(l, &w);
 		arch_spin_relax();
 	}
 #else
 	while (!atomic_cas(&l->locked, 0, 1)) {
+		z_spinlock_stats_wait(l, &w);
 		arch_spin_relax();
 	}
 #endif /* CONFIG_TICKET_SPINLOCKS */
+	z_spinlock_stats_acquired(l, &w);
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
 
@@ -233,6 +314,9 @@ static ALWAYS_INLINE int k_spin_trylock(struct k_spinlock *l, k_spinlock_key_t *
 
 	z_spinlock_validate_pre(l);
 #ifdef CONFIG_SMP
+	/* A failed attempt doesn't wait, it only counts once it succeeds */
+	struct z_spinlock_wait w = {};
+
 #ifdef CONFIG_TICKET_SPINLOCKS
 	/*
 	 * atomic_get and atomic_cas operations below are not executed
@@ -262,6 +346,7 @@ static ALWAYS_INLINE int k_spin_trylock(struct k_spinlock *l, k_spinlock_key_t *
 		goto busy;
 	}
 #endif /* CONFIG_TICKET_SPINLOCKS */
+	z_spinlock_stats_acquired(l, &w);
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
 
@@ -314,6 +399,8 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 #endif /* CONFIG_SPIN_VALIDATE */
 
 #ifdef CONFIG_SMP
+	z_spinlock_stats_release(l);
+
 #ifdef CONFIG_TICKET_SPINLOCKS
 	/* Give the spinlock to the next CPU in a FIFO */
 	(void)atomic_inc(&l->owner);
@@ -363,6 +450,8 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
 #ifdef CONFIG_SMP
+	z_spinlock_stats_release(l);
+
 #ifdef CONFIG_TICKET_SPINLOCKS
 	(void)atomic_inc(&l->owner);
 #else
@@ -439,6 +528,38 @@ static ALWAYS_INLINE void z_spin_onexit(__maybe_unused k_spinlock_key_t *k)
 	for (k_spinlock_key_t __i K_SPINLOCK_ONEXIT = {}, __key = k_spin_lock(lck); !__i.key;      \
 	     k_spin_unlock((lck), __key), __i.key = 1)
 
+#if defined(CONFIG_LOCK_STATS_SPINLOCK) || defined(__DOXYGEN__)
+/**
+ * @brief Get the contention statistics of a spinlock
+ *
+ * The statistics are copied with the lock held, so the copy includes
+ * the acquisition made to read them.
+ *
+ * @param l A pointer to the spinlock
+ * @param stats Where to copy the statistics
+ */
+void k_spin_lock_stats_get(struct k_spinlock *l, struct k_lock_stats *stats);
+
+/**
+ * @brief Reset the contention statistics of a spinlock
+ *
+ * @param l A pointer to the spinlock
+ */
+void k_spin_lock_stats_reset(struct k_spinlock *l);
+
+/**
+ * @brief Make a spinlock visible to the object core framework
+ *
+ * Spinlocks have no initializer, so unlike other kernel objects they are
+ * only listed by the object core framework, and hence by the "kernel locks"
+ * shell command, once registered. The scheduler lock is registered by the
+ * kernel. A registered spinlock must not go out of scope.
+ *
+ * @param l A pointer to the spinlock
+ */
+void k_spin_lock_stats_register(struct k_spinlock *l);
+#endif /* CONFIG_LOCK_STATS_SPINLOCK */
+
 /** @} */
 
 #ifdef __cplusplus
@@ -25,6 +25,7 @@
 
 #include <stdbool.h>
 #include <zephyr/drivers/flash.h>
+#include <zephyr/kernel.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -67,6 +68,16 @@ struct stream_flash_ctx {
 #endif
 	size_t write_block_size;	/* Offset/size device write alignment */
 	uint8_t erase_value;
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	uint8_t *async_buf; /* Buffer programmed in the background */
+	size_t async_buf_bytes; /* Number of bytes in the background buffer */
+	struct k_work_q *async_work_q; /* Work queue doing the programming */
+	struct k_work async_work; /* Background programming work item */
+	struct k_sem async_done; /* Given when background programming ends */
+	int async_rc; /* Result of the last background programming */
+	bool async_busy; /* Background buffer is being programmed */
+	struct k_mutex erase_lock; /* Serializes erases with the background work */
+#endif
 };
 
 /**
@@ -123,6 +134,39 @@ size_t stream_flash_bytes_written(const struct stream_flash_ctx *ctx);
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush);
 
+/**
+ * @brief Enable double-buffered asynchronous writes for a context.
+ *
+ * Once enabled, a write buffer filled by @ref stream_flash_buffered_write is
+ * handed over to @p work_q to be erased and programmed, while the caller
+ * continues filling @p buf. The buffers are swapped each time one fills up,
+ * so the caller only waits for the flash when it fills a buffer before the
+ * previous one has been programmed. A write with flush set waits for all
+ * data to be programmed.
+ *
+ * The verification callback given to @ref stream_flash_init is invoked
+ * from @p work_q, with either of the two buffers. Data programmed in the
+ * background is accounted for in @ref stream_flash_bytes_written when the
+ * next buffer is handed over or on flush.
+ *
+ * Must be called after @ref stream_flash_init and before the first write.
+ * The context must be flushed before it is re-initialized.
+ *
+ * Writes may wait for @p work_q to finish programming a buffer, so they must
+ * not be done from a work item of @p work_q, or of the system work queue if
+ * @p work_q is NULL: that would deadlock.
+ *
+ * @param ctx context
+ * @param buf Second write buffer, of the length given to
+ *            @ref stream_flash_init
+ * @param work_q Work queue programming the flash, or NULL to use the
+ *               system work queue
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_async_enable(struct stream_flash_ctx *ctx, uint8_t *buf,
+			      struct k_work_q *work_q);
+
 /**
  * @brief Erase the flash page to which a given offset belongs.
  *
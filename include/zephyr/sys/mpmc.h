@@ -0,0 +1,207 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Multi producer, multi consumer lock-free ring.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPMC_H_
+#define ZEPHYR_INCLUDE_SYS_MPMC_H_
+
+/*
+ * A sys_mpmc is a bounded queue of fixed size elements, which any number of
+ * threads and ISRs can put to and get from concurrently without taking a
+ * lock. Each slot has a sequence number telling whether it is free or holds
+ * an element for the current lap around the ring, so producers and consumers
+ * only contend on the position they are claiming.
+ *
+ * Threads only enter the kernel to block when the ring is full or empty,
+ * and to wake a blocked thread. When user mode is enabled, the ring can live
+ * in user memory and blocking uses futexes, like sys_sem does.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct z_mpmc_waitq {
+	/* Number of threads blocked, or about to block */
+	atomic_t waiters;
+#ifdef CONFIG_USERSPACE
+	/* Bumped on every wakeup */
+	struct k_futex futex;
+#else
+	struct k_sem sem;
+#endif
+};
+
+#ifdef CONFIG_USERSPACE
+#define Z_MPMC_WAITQ_INITIALIZER(obj) { .futex = { 0 } }
+#else
+#define Z_MPMC_WAITQ_INITIALIZER(obj) { .sem = Z_SEM_INITIALIZER(obj.sem, 0, K_SEM_MAX_LIMIT) }
+#endif
+
+/* Each slot is a sequence number followed by the element */
+#define Z_MPMC_SLOT_SIZE(elem_size) (sizeof(atomic_t) + ROUND_UP(elem_size, sizeof(atomic_t)))
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * sys_mpmc structure
+ */
+struct sys_mpmc {
+	/** @cond INTERNAL_HIDDEN */
+	atomic_t head;
+	atomic_t tail;
+	uint8_t *buffer;
+	size_t elem_size;
+	size_t slot_size;
+	unsigned long mask;
+	struct z_mpmc_waitq not_empty;
+	struct z_mpmc_waitq not_full;
+	/** INTERNAL_HIDDEN @endcond */
+};
+
+/**
+ * @defgroup sys_mpmc_apis MPMC ring APIs
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * @brief Size of the buffer needed by a ring.
+ *
+ * @param _elem_size Size of each element, in bytes.
+ * @param _max_elems Maximum number of elements, a power of two.
+ */
+#define SYS_MPMC_BUF_SIZE(_elem_size, _max_elems) ((_max_elems) * Z_MPMC_SLOT_SIZE(_elem_size))
+
+/**
+ * @brief Statically initialize a sys_mpmc.
+ *
+ * @param _obj Name of the ring.
+ * @param _buf Buffer of SYS_MPMC_BUF_SIZE() bytes, zeroed and aligned for an
+ *             atomic_t.
+ * @param _elem_size Size of each element, in bytes.
+ * @param _max_elems Maximum number of elements, a power of two.
+ */
+#define SYS_MPMC_INITIALIZER(_obj, _buf, _elem_size, _max_elems)                                   \
+	{                                                                                          \
+		.head = ATOMIC_INIT(0),                                                            \
+		.tail = ATOMIC_INIT(0),                                                            \
+		.buffer = (uint8_t *)(_buf),                                                       \
+		.elem_size = (_elem_size),                                                         \
+		.slot_size = Z_MPMC_SLOT_SIZE(_elem_size),                                         \
+		.mask = (_max_elems) - 1,                                                          \
+		.not_empty = Z_MPMC_WAITQ_INITIALIZER(_obj.not_empty),                             \
+		.not_full = Z_MPMC_WAITQ_INITIALIZER(_obj.not_full),                               \
+	}
+
+/**
+ * @brief Statically define and initialize a sys_mpmc.
+ *
+ * The ring can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct sys_mpmc <name>; @endcode
+ *
+ * For user mode threads, define the ring and a buffer in a memory partition
+ * with K_APP_BMEM() instead, and initialize it with sys_mpmc_init().
+ *
+ * @param _name Name of the ring.
+ * @param _elem_size Size of each element, in bytes.
+ * @param _max_elems Maximum number of elements, a power of two.
+ */
+#define SYS_MPMC_DEFINE(_name, _elem_size, _max_elems)                                             \
+	static atomic_t _sys_mpmc_buf_##_name[SYS_MPMC_BUF_SIZE(_elem_size, _max_elems) /          \
+					      sizeof(atomic_t)];                                   \
+	struct sys_mpmc _name =                                                                    \
+		SYS_MPMC_INITIALIZER(_name, _sys_mpmc_buf_##_name, _elem_size, _max_elems);        \
+	BUILD_ASSERT(IS_POWER_OF_TWO(_max_elems), "max_elems must be a power of two")
+
+/**
+ * @brief Initialize a ring.
+ *
+ * The ring must not be in use.
+ *
+ * @param ring Address of the ring.
+ * @param buf Buffer of SYS_MPMC_BUF_SIZE() bytes, aligned for an atomic_t.
+ * @param elem_size Size of each element, in bytes.
+ * @param max_elems Maximum number of elements, a power of two.
+ *
+ * @retval 0 Ring initialized.
+ * @retval -EINVAL Bad parameters.
+ */
+int sys_mpmc_init(struct sys_mpmc *ring, void *buf, size_t elem_size, uint32_t max_elems);
+
+/**
+ * @brief Put an element at the end of a ring.
+ *
+ * This routine copies the element at @a data into the ring, waiting for
+ * room if it is full.
+ *
+ * @funcprops \isr_ok (with @a timeout set to K_NO_WAIT)
+ *
+ * @param ring Address of the ring.
+ * @param data Pointer to the element.
+ * @param timeout Waiting period for room, or one of the special values
+ *                K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Element put.
+ * @retval -ENOMSG Returned without waiting, the ring is full.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int sys_mpmc_put(struct sys_mpmc *ring, const void *data, k_timeout_t timeout);
+
+/**
+ * @brief Get an element from the front of a ring.
+ *
+ * This routine copies the oldest element of the ring to @a data, waiting
+ * for one if it is empty.
+ *
+ * @funcprops \isr_ok (with @a timeout set to K_NO_WAIT)
+ *
+ * @param ring Address of the ring.
+ * @param data Buffer of the ring's element size.
+ * @param timeout Waiting period for an element, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Element retrieved.
+ * @retval -ENOMSG Returned without waiting, the ring is empty.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int sys_mpmc_get(struct sys_mpmc *ring, void *data, k_timeout_t timeout);
+
+/**
+ * @brief Get the number of elements in a ring.
+ *
+ * This is only a snapshot when other threads use the ring concurrently.
+ *
+ * @param ring Address of the ring.
+ *
+ * @return Number of elements.
+ */
+uint32_t sys_mpmc_num_used_get(struct sys_mpmc *ring);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPMC_H_ */
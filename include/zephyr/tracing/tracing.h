@@ -748,6 +748,17 @@
  */
 #define sys_port_trace_k_sem_take_exit(sem, timeout, ret)
 
+/**
+ * @brief Trace the end of a wait on a Semaphore
+ *
+ * Only emitted when CONFIG_LOCK_STATS_SEM is enabled, whether or not
+ * the Semaphore was taken.
+ *
+ * @param sem Semaphore object
+ * @param wait Time spent waiting, in cycles
+ */
+#define sys_port_trace_k_sem_take_contended(sem, wait)
+
 /**
  * @brief Trace resetting a Semaphore
  * @param sem Semaphore object
@@ -791,6 +802,17 @@
  */
 #define sys_port_trace_k_mutex_lock_exit(mutex, timeout, ret)
 
+/**
+ * @brief Trace the end of a wait on a Mutex
+ *
+ * Only emitted when CONFIG_LOCK_STATS_MUTEX is enabled, whether or not
+ * the Mutex was locked.
+ *
+ * @param mutex Mutex object
+ * @param wait Time spent waiting, in cycles
+ */
+#define sys_port_trace_k_mutex_lock_contended(mutex, wait)
+
 /**
  * @brief Trace Mutex unlock entry
  * @param mutex Mutex object
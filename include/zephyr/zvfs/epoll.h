@@ -0,0 +1,104 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+
+#include <stdint.h>
+
+#include <zephyr/sys/fdtable.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZVFS_EPOLL_CTL_ADD 1
+#define ZVFS_EPOLL_CTL_DEL 2
+#define ZVFS_EPOLL_CTL_MOD 3
+
+#define ZVFS_EPOLLIN  ZVFS_POLLIN
+#define ZVFS_EPOLLPRI ZVFS_POLLPRI
+#define ZVFS_EPOLLOUT ZVFS_POLLOUT
+#define ZVFS_EPOLLERR ZVFS_POLLERR
+#define ZVFS_EPOLLHUP ZVFS_POLLHUP
+
+/** Report the file descriptor once, until it is re-armed with ZVFS_EPOLL_CTL_MOD */
+#define ZVFS_EPOLLONESHOT (1U << 30)
+/** Report the file descriptor when it signals a change, not while it is ready */
+#define ZVFS_EPOLLET      (1U << 31)
+
+/** User data returned with each ready file descriptor */
+union zvfs_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+};
+
+/** Interest and readiness description of a file descriptor */
+struct zvfs_epoll_event {
+	/** Requested events on input, ready events on output (ZVFS_EPOLL*) */
+	uint32_t events;
+	/** User data, returned as is by @ref zvfs_epoll_wait */
+	union zvfs_epoll_data data;
+};
+
+/**
+ * @brief Create a ZVFS epoll instance
+ *
+ * An epoll instance holds a persistent interest set of file descriptors.
+ * Unlike @ref zvfs_poll, the file descriptors are registered on their kernel
+ * objects only once, when they are added, and ready file descriptors are
+ * collected on a ready list. A call to @ref zvfs_epoll_wait only looks at the
+ * file descriptors that became ready, so its cost does not grow with the size
+ * of the interest set.
+ *
+ * File descriptors are reported level-triggered, like with poll(), unless
+ * they are added with ZVFS_EPOLLET. Closing a file descriptor removes it from
+ * every epoll instance. Offloaded sockets are not supported.
+ *
+ * The epoll functions wait on kernel poll sets, which have no system calls:
+ * they can only be called from supervisor threads.
+ *
+ * @param flags Must be 0.
+ *
+ * @return New epoll file descriptor on success, -1 on error with errno set
+ */
+int zvfs_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a file descriptor of an epoll interest set
+ *
+ * @param epfd Epoll file descriptor.
+ * @param op One of ZVFS_EPOLL_CTL_ADD, ZVFS_EPOLL_CTL_MOD or ZVFS_EPOLL_CTL_DEL.
+ * @param fd Target file descriptor.
+ * @param event Requested events and user data. Ignored for ZVFS_EPOLL_CTL_DEL.
+ *
+ * @return 0 on success, -1 on error with errno set to:
+ *         EBADF if @p epfd or @p fd is not valid, EEXIST if @p fd is already
+ *         in the set, ENOENT if @p fd is not in the set, ENOMEM if the set is
+ *         full and EPERM if @p fd does not support epoll.
+ */
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event);
+
+/**
+ * @brief Wait for file descriptors of an epoll interest set to become ready
+ *
+ * @param epfd Epoll file descriptor.
+ * @param events Array receiving the ready file descriptors.
+ * @param maxevents Size of @p events, must be greater than 0.
+ * @param timeout Timeout in milliseconds, or -1 to wait forever.
+ *
+ * @return Number of ready file descriptors (0 on timeout), -1 on error
+ *         with errno set
+ */
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_ */
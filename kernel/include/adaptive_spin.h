@@ -0,0 +1,56 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_ADAPTIVE_SPIN_H_
+#define ZEPHYR_KERNEL_INCLUDE_ADAPTIVE_SPIN_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/sys/time_units.h>
+
+#ifdef CONFIG_ADAPTIVE_SPIN
+
+/* Cycles a thread may spin on a busy mutex or semaphore before pending */
+#define ADAPTIVE_SPIN_BUDGET k_ns_to_cyc_ceil32(CONFIG_ADAPTIVE_SPIN_BUDGET_NS)
+
+/*
+ * Pause once while spinning on a busy object, then tell whether it is
+ * worth spinning some more: @a holder, or any thread but an idle one if
+ * NULL, must be running on another CPU, from where it can release the
+ * object. Interrupts are only masked around the pause, so the spinning
+ * thread can still be preempted.
+ */
+static inline bool adaptive_spin_pause(struct k_thread *holder)
+{
+	unsigned int key = arch_irq_lock();
+	unsigned int num_cpus = arch_num_cpus();
+	int currcpu = _current_cpu->id;
+	bool running = false;
+
+	arch_spin_relax();
+
+	for (int i = 0; i < num_cpus; i++) {
+		volatile struct _cpu *cpu = &_kernel.cpus[i];
+
+		if (i == currcpu) {
+			continue;
+		}
+
+		if ((holder != NULL) ? (cpu->current == holder) :
+				       (cpu->current != cpu->idle_thread)) {
+			running = true;
+			break;
+		}
+	}
+
+	arch_irq_unlock(key);
+
+	return running;
+}
+
+#endif /* CONFIG_ADAPTIVE_SPIN */
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_ADAPTIVE_SPIN_H_ */
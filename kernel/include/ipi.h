@@ -27,5 +27,15 @@ atomic_val_t ipi_mask_create(struct k_thread *thread);
 #define signal_pending_ipi() do { } while (false)
 #endif /* CONFIG_SMP */
 
+#ifdef CONFIG_IPI_COALESCE
+/* Forget any IPI sent to a CPU that went down before handling it */
+static inline void ipi_inflight_clear(int id)
+{
+	(void)atomic_and(&_kernel.inflight_ipi, ~(atomic_val_t)BIT(id));
+}
+#else
+#define ipi_inflight_clear(id) do { } while (false)
+#endif /* CONFIG_IPI_COALESCE */
+
 
 #endif /* ZEPHYR_KERNEL_INCLUDE_IPI_H_ */
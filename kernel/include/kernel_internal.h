@@ -210,6 +210,29 @@ void z_thread_mark_switched_out(void);
 
 #endif /* CONFIG_INSTRUMENT_THREAD_SWITCHING */
 
+#ifdef CONFIG_USERSPACE_SHARED_PAGE
+/* Publish the tick counter to user mode, called with the timeout lock held */
+static inline void z_shared_page_ticks_set(uint64_t ticks)
+{
+	struct z_shared_page *page = Z_SHARED_PAGE_KERNEL;
+
+	page->tick_seq++;
+	barrier_dmem_fence_full();
+	page->ticks = ticks;
+	barrier_dmem_fence_full();
+	page->tick_seq++;
+}
+
+/* Publish the thread about to run on the current CPU */
+static inline void z_shared_page_current_set(struct k_thread *thread)
+{
+	Z_SHARED_PAGE_KERNEL->current[arch_curr_cpu()->id] = thread;
+}
+#else
+#define z_shared_page_ticks_set(ticks)
+#define z_shared_page_current_set(thread)
+#endif /* CONFIG_USERSPACE_SHARED_PAGE */
+
 /* Init hook for page frame management, invoked immediately upon entry of
  * main thread, before POST_KERNEL tasks
  */
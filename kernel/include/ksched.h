@@ -340,6 +340,23 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+/**
+ * @brief Marks @a thread as ready to run, starting its wakeup latency
+ *
+ * Called with the scheduler lock held.
+ */
+void z_sched_usage_ready(struct k_thread *thread);
+
+/**
+ * @brief Adds the latencies recorded in @a src to @a dst
+ */
+void z_sched_latency_merge(struct k_latency_stats *dst,
+			   const struct k_latency_stats *src);
+#else
+#define z_sched_usage_ready(thread) do { } while (false)
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
@@ -135,6 +135,7 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 		z_thread_mark_switched_out();
 		z_sched_switch_spin(new_thread);
 		arch_current_thread_set(new_thread);
+		z_shared_page_current_set(new_thread);
 
 #ifdef CONFIG_TIMESLICING
 		z_reset_time_slice(new_thread);
@@ -4,6 +4,7 @@
  */
 
 #include <zephyr/kernel.h>
+#include <zephyr/kernel/smp.h>
 #include <kswap.h>
 #include <ksched.h>
 #include <ipi.h>
@@ -66,6 +67,50 @@ atomic_val_t ipi_mask_create(struct k_thread *thread)
 	return (atomic_val_t)ipi_mask;
 }
 
+#if defined(CONFIG_SCHED_IPI_SUPPORTED)
+static void send_ipi(uint32_t cpu_bitmap)
+{
+#if defined(CONFIG_IPI_COALESCE) || defined(CONFIG_IPI_STATS)
+	/* Stay on this CPU, it owns the counters and its own IPI bit */
+	unsigned int key = arch_irq_lock();
+	struct _cpu *cpu = arch_curr_cpu();
+#endif
+
+#ifdef CONFIG_IPI_COALESCE
+	/* A CPU with an IPI in flight clears its bit before it reschedules,
+	 * which then sees everything that happened before we got here, so
+	 * only the CPUs whose bit we are the first to set need an IPI.
+	 * The sending CPU never interrupts itself.
+	 */
+	uint32_t targets = cpu_bitmap & (uint32_t)BIT_MASK(arch_num_cpus()) &
+			   ~BIT(cpu->id);
+	uint32_t inflight = (uint32_t)atomic_or(&_kernel.inflight_ipi,
+						(atomic_val_t)targets);
+
+	cpu_bitmap = targets & ~inflight;
+
+#ifdef CONFIG_IPI_STATS
+	cpu->ipi_stats.coalesced += POPCOUNT(targets & inflight);
+#endif
+#endif /* CONFIG_IPI_COALESCE */
+
+	if (cpu_bitmap != 0) {
+#ifdef CONFIG_IPI_STATS
+		cpu->ipi_stats.sent++;
+#endif
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+		arch_sched_directed_ipi(cpu_bitmap);
+#else
+		arch_sched_broadcast_ipi();
+#endif
+	}
+
+#if defined(CONFIG_IPI_COALESCE) || defined(CONFIG_IPI_STATS)
+	arch_irq_unlock(key);
+#endif
+}
+#endif /* CONFIG_SCHED_IPI_SUPPORTED */
+
 void signal_pending_ipi(void)
 {
 	/* Synchronization note: you might think we need to lock these
@@ -81,11 +126,7 @@ void signal_pending_ipi(void)
 
 		cpu_bitmap = (uint32_t)atomic_clear(&_kernel.pending_ipi);
 		if (cpu_bitmap != 0) {
-#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
-			arch_sched_directed_ipi(cpu_bitmap);
-#else
-			arch_sched_broadcast_ipi();
-#endif
+			send_ipi(cpu_bitmap);
 		}
 	}
 #endif /* CONFIG_SCHED_IPI_SUPPORTED */
@@ -96,6 +137,17 @@ void z_sched_ipi(void)
 	/* NOTE: When adding code to this, make sure this is called
 	 * at appropriate location when !CONFIG_SCHED_IPI_SUPPORTED.
 	 */
+#ifdef CONFIG_IPI_COALESCE
+	/* Scheduling events from now on need a new IPI, earlier ones are
+	 * handled by the reschedule on the way out of this interrupt.
+	 */
+	(void)atomic_and(&_kernel.inflight_ipi, ~(atomic_val_t)BIT(_current_cpu->id));
+#endif /* CONFIG_IPI_COALESCE */
+
+#ifdef CONFIG_IPI_STATS
+	_current_cpu->ipi_stats.received++;
+#endif /* CONFIG_IPI_STATS */
+
 #ifdef CONFIG_TRACE_SCHED_IPI
 	z_trace_sched_ipi();
 #endif /* CONFIG_TRACE_SCHED_IPI */
@@ -106,3 +158,25 @@ void z_sched_ipi(void)
 	}
 #endif /* CONFIG_TIMESLICING */
 }
+
+#ifdef CONFIG_IPI_STATS
+int k_ipi_stats_get(int id, struct k_ipi_stats *stats)
+{
+	if ((id < 0) || (id >= (int)arch_num_cpus())) {
+		return -EINVAL;
+	}
+
+	*stats = _kernel.cpus[id].ipi_stats;
+
+	return 0;
+}
+
+void k_ipi_stats_reset(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		_kernel.cpus[i].ipi_stats = (struct k_ipi_stats){ 0 };
+	}
+}
+#endif /* CONFIG_IPI_STATS */
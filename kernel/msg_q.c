@@ -36,6 +36,77 @@ static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 }
 #endif /* CONFIG_POLL */
 
+/* Copy messages to the ring buffer, which must have room for them.
+ *
+ * Invoked with the message queue lock held.
+ */
+static void msgq_write_locked(struct k_msgq *msgq, const char *data, uint32_t num_msgs)
+{
+	size_t len = num_msgs * msgq->msg_size;
+	size_t to_end = msgq->buffer_end - msgq->write_ptr;
+
+	if (len < to_end) {
+		(void)memcpy(msgq->write_ptr, data, len);
+		msgq->write_ptr += len;
+	} else {
+		(void)memcpy(msgq->write_ptr, data, to_end);
+		(void)memcpy(msgq->buffer_start, data + to_end, len - to_end);
+		msgq->write_ptr = msgq->buffer_start + (len - to_end);
+	}
+
+	msgq->used_msgs += num_msgs;
+}
+
+/* Copy messages out of the ring buffer, which must hold them.
+ *
+ * Invoked with the message queue lock held.
+ */
+static void msgq_read_locked(struct k_msgq *msgq, char *data, uint32_t num_msgs)
+{
+	size_t len = num_msgs * msgq->msg_size;
+	size_t to_end = msgq->buffer_end - msgq->read_ptr;
+
+	if (len < to_end) {
+		(void)memcpy(data, msgq->read_ptr, len);
+		msgq->read_ptr += len;
+	} else {
+		(void)memcpy(data, msgq->read_ptr, to_end);
+		(void)memcpy(data + to_end, msgq->buffer_start, len - to_end);
+		msgq->read_ptr = msgq->buffer_start + (len - to_end);
+	}
+
+	msgq->used_msgs -= num_msgs;
+}
+
+/* Move the messages of threads waiting to send into free ring buffer entries.
+ *
+ * Must only be invoked when the threads waiting on the queue, if any, are
+ * senders, i.e. when the queue was full.
+ *
+ * Invoked with the message queue lock held.
+ *
+ * @return true if a thread was readied.
+ */
+static bool msgq_take_senders_locked(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	bool woken = false;
+
+	while (msgq->used_msgs + msgq->claimed_msgs < msgq->max_msgs) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		msgq_write_locked(msgq, pending_thread->base.swap_data, 1);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		woken = true;
+	}
+
+	return woken;
+}
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -46,6 +117,7 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->read_ptr = buffer;
 	msgq->write_ptr = buffer;
 	msgq->used_msgs = 0;
+	msgq->claimed_msgs = 0;
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
 	msgq->lock = (struct k_spinlock) {};
@@ -133,7 +205,7 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
 
-	if (msgq->used_msgs < msgq->max_msgs) {
+	if (msgq->used_msgs + msgq->claimed_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
 		if (unlikely(pending_thread != NULL)) {
@@ -225,7 +297,10 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
 
-	if (msgq->used_msgs > 0U) {
+	if (unlikely(msgq->claimed_msgs != 0U)) {
+		/* messages are being processed in place */
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
 		/* take first available message from queue */
 		(void)memcpy((char *)data, msgq->read_ptr, msgq->msg_size);
 		msgq->read_ptr += msgq->msg_size;
@@ -293,6 +368,253 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <zephyr/syscalls/k_msgq_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_k_msgq_put_n(struct k_msgq *msgq, const void *data, uint32_t num_msgs,
+			k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t sent = 0U;
+	uint32_t num_free;
+	int result;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+	num_free = msgq->max_msgs - msgq->used_msgs - msgq->claimed_msgs;
+	if (num_free > 0U) {
+		/* threads waiting to receive means an empty queue: give them
+		 * the first messages
+		 */
+		while ((sent < num_msgs) && (msgq->used_msgs == 0U)) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+
+			(void)memcpy(pending_thread->base.swap_data, src, msgq->msg_size);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			src += msgq->msg_size;
+			sent++;
+			woken = true;
+		}
+
+		/* put the other ones in the queue */
+		num_free = MIN(num_free, num_msgs - sent);
+		if (num_free > 0U) {
+			msgq_write_locked(msgq, src, num_free);
+			sent += num_free;
+#ifdef CONFIG_POLL
+			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+		}
+		result = (int)sent;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for message space to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+
+		/* wait for the first message to be taken */
+		arch_current_thread()->base.swap_data = (void *)data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+		return (result == 0) ? 1 : result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_n(struct k_msgq *msgq, const void *data,
+				      uint32_t num_msgs, k_timeout_t timeout)
+{
+	size_t size;
+
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_VERIFY(!size_mul_overflow(msgq->msg_size, num_msgs, &size)));
+	K_OOPS(K_SYSCALL_MEMORY_READ(data, size));
+
+	return z_impl_k_msgq_put_n(msgq, data, num_msgs, timeout);
+}
+#include <zephyr/syscalls/k_msgq_put_n_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_msgq_get_n(struct k_msgq *msgq, void *data, uint32_t num_msgs,
+			k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key;
+	bool woken;
+	int result;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+	if (unlikely(msgq->claimed_msgs != 0U)) {
+		/* messages are being processed in place */
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
+		/* take the first available messages from queue */
+		num_msgs = MIN(num_msgs, msgq->used_msgs);
+		msgq_read_locked(msgq, data, num_msgs);
+
+		/* the queue wasn't empty, so only senders can be waiting */
+		woken = msgq_take_senders_locked(msgq);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, 0);
+
+		if (woken) {
+			z_reschedule(&msgq->lock, key);
+		} else {
+			k_spin_unlock(&msgq->lock, key);
+		}
+
+		return (int)num_msgs;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+
+		/* wait for the first message */
+		arch_current_thread()->base.swap_data = data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+		return (result == 0) ? 1 : result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_n(struct k_msgq *msgq, void *data,
+				      uint32_t num_msgs, k_timeout_t timeout)
+{
+	size_t size;
+
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_VERIFY(!size_mul_overflow(msgq->msg_size, num_msgs, &size)));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(data, size));
+
+	return z_impl_k_msgq_get_n(msgq, data, num_msgs, timeout);
+}
+#include <zephyr/syscalls/k_msgq_get_n_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int k_msgq_get_claim(struct k_msgq *msgq, void **data, uint32_t max_msgs)
+{
+	k_spinlock_key_t key;
+	uint32_t num_msgs;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->claimed_msgs != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs == 0U) {
+		result = -ENOMSG;
+	} else {
+		/* Claimed messages must be contiguous. Claiming all the
+		 * entries would let the queue be full and empty at once, with
+		 * senders and receivers waiting on it together.
+		 */
+		num_msgs = (msgq->buffer_end - msgq->read_ptr) / msgq->msg_size;
+		num_msgs = MIN(num_msgs, msgq->used_msgs);
+		num_msgs = MIN(num_msgs, max_msgs);
+		num_msgs = MIN(num_msgs, msgq->max_msgs - 1U);
+
+		if (num_msgs == 0U) {
+			result = -EINVAL;
+		} else {
+			*data = msgq->read_ptr;
+			msgq->read_ptr += num_msgs * msgq->msg_size;
+			if (msgq->read_ptr == msgq->buffer_end) {
+				msgq->read_ptr = msgq->buffer_start;
+			}
+			msgq->used_msgs -= num_msgs;
+			msgq->claimed_msgs = num_msgs;
+			result = (int)num_msgs;
+		}
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_get_finish(struct k_msgq *msgq, uint32_t num_msgs)
+{
+	k_spinlock_key_t key;
+	uint32_t returned;
+	bool woken;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (num_msgs > msgq->claimed_msgs) {
+		k_spin_unlock(&msgq->lock, key);
+
+		return -EINVAL;
+	}
+
+	/* Give the unconsumed messages back. They are right before the read
+	 * pointer, as claims never wrap around and k_msgq_get() is refused
+	 * while a claim is outstanding.
+	 */
+	returned = msgq->claimed_msgs - num_msgs;
+	if (returned > 0U) {
+		if (msgq->read_ptr == msgq->buffer_start) {
+			msgq->read_ptr = msgq->buffer_end;
+		}
+		msgq->read_ptr -= returned * msgq->msg_size;
+		msgq->used_msgs += returned;
+#ifdef CONFIG_POLL
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+	msgq->claimed_msgs = 0U;
+
+	/* receivers can't wait while a claim is outstanding */
+	woken = msgq_take_senders_locked(msgq);
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -390,7 +712,12 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 	}
 
 	msgq->used_msgs = 0;
-	msgq->read_ptr = msgq->write_ptr;
+	if (msgq->claimed_msgs == 0U) {
+		msgq->read_ptr = msgq->write_ptr;
+	} else {
+		/* keep the free entries right after the claimed ones */
+		msgq->write_ptr = msgq->read_ptr;
+	}
 
 	z_reschedule(&msgq->lock, key);
 }
@@ -31,6 +31,7 @@
 #include <zephyr/toolchain.h>
 #include <ksched.h>
 #include <kthread.h>
+#include <adaptive_spin.h>
 #include <wait_q.h>
 #include <errno.h>
 #include <zephyr/init.h>
@@ -39,6 +40,7 @@
 #include <zephyr/sys/check.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/llext/symbol.h>
+#include <string.h>
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 
 /* We use a global spinlock here because some of the synchronization
@@ -50,8 +52,130 @@ static struct k_spinlock lock;
 
 #ifdef CONFIG_OBJ_CORE_MUTEX
 static struct k_obj_type obj_type_mutex;
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+static int k_mutex_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_mutex *mutex;
+	k_spinlock_key_t key;
+
+	mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+	key = k_spin_lock(&lock);
+	memcpy(stats, &mutex->lock_stats, sizeof(mutex->lock_stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static int k_mutex_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_mutex *mutex;
+	k_spinlock_key_t key;
+
+	mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+	key = k_spin_lock(&lock);
+	memset(&mutex->lock_stats, 0, sizeof(mutex->lock_stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc mutex_stats_desc = {
+	.raw_size = sizeof(struct k_lock_stats),
+	.query_size = sizeof(struct k_lock_stats),
+	.raw   = k_mutex_stats_raw,
+	.query = k_mutex_stats_raw,
+	.reset = k_mutex_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 #endif /* CONFIG_OBJ_CORE_MUTEX */
 
+#ifdef CONFIG_LOCK_STATS_MUTEX
+/* Called with the lock held when the mutex gets a new owner */
+static inline void lock_stats_acquired(struct k_mutex *mutex)
+{
+	mutex->lock_stats.acquired++;
+	mutex->hold_start = k_cycle_get_32();
+}
+
+/* Called with the lock held when the owner gives the mutex up */
+static inline void lock_stats_released(struct k_mutex *mutex)
+{
+	uint32_t hold = k_cycle_get_32() - mutex->hold_start;
+
+	if (hold > mutex->lock_stats.max_hold) {
+		mutex->lock_stats.max_hold = hold;
+	}
+}
+
+/* Called once a thread that pended on the mutex is back, owner or not */
+static void lock_stats_waited(struct k_mutex *mutex, uint32_t wait_start)
+{
+	uint32_t wait = k_cycle_get_32() - wait_start;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	mutex->lock_stats.total_wait += wait;
+	if (wait > mutex->lock_stats.max_wait) {
+		mutex->lock_stats.max_wait = wait;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_mutex, lock_contended, mutex, wait);
+}
+#else
+#define lock_stats_acquired(mutex) do { } while (false)
+#define lock_stats_released(mutex) do { } while (false)
+#endif /* CONFIG_LOCK_STATS_MUTEX */
+
+#ifdef CONFIG_ADAPTIVE_SPIN
+/*
+ * Called with the lock held when the mutex is owned by another thread.
+ * If nobody waits for it yet, spin without the lock for as long as the
+ * owner runs on another CPU, within the spin budget. Returns with the lock
+ * held again, the caller then has another look at the mutex. The time
+ * spent spinning is taken off @a timeout, the remaining time is returned.
+ */
+static k_timeout_t mutex_adaptive_spin(struct k_mutex *mutex, k_spinlock_key_t *key,
+				       k_timeout_t timeout)
+{
+	volatile struct k_mutex *vmutex = mutex;
+	struct k_thread *owner = mutex->owner;
+	k_timepoint_t end;
+	uint32_t start;
+
+	if (z_waitq_head(&mutex->wait_q) != NULL) {
+		return timeout;
+	}
+
+	k_spin_unlock(&lock, *key);
+
+	end = sys_timepoint_calc(timeout);
+
+	start = k_cycle_get_32();
+	while ((vmutex->owner == owner) && adaptive_spin_pause(owner) &&
+	       ((k_cycle_get_32() - start) < ADAPTIVE_SPIN_BUDGET)) {
+	}
+
+	*key = k_spin_lock(&lock);
+
+#ifdef CONFIG_LOCK_STATS_MUTEX
+	mutex->lock_stats.spun++;
+	if (mutex->lock_count == 0U) {
+		mutex->lock_stats.spin_acquired++;
+	}
+#endif /* CONFIG_LOCK_STATS_MUTEX */
+
+	return sys_timepoint_timeout(end);
+}
+#endif /* CONFIG_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
@@ -61,8 +185,16 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 
 	k_object_init(mutex);
 
+#ifdef CONFIG_LOCK_STATS_MUTEX
+	memset(&mutex->lock_stats, 0, sizeof(mutex->lock_stats));
+#endif /* CONFIG_LOCK_STATS_MUTEX */
+
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->lock_stats,
+				  sizeof(struct k_lock_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 #endif /* CONFIG_OBJ_CORE_MUTEX */
 
 	SYS_PORT_TRACING_OBJ_INIT(k_mutex, mutex, 0);
@@ -114,8 +246,28 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
+#ifdef CONFIG_ADAPTIVE_SPIN
+	if ((mutex->lock_count != 0U) && (mutex->owner != arch_current_thread()) &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		timeout = mutex_adaptive_spin(mutex, &key, timeout);
+
+		if ((mutex->lock_count != 0U) && K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			/* Spun for the whole timeout */
+			k_spin_unlock(&lock, key);
+
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EAGAIN);
+
+			return -EAGAIN;
+		}
+	}
+#endif /* CONFIG_ADAPTIVE_SPIN */
+
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == arch_current_thread()))) {
 
+		if (mutex->lock_count == 0U) {
+			lock_stats_acquired(mutex);
+		}
+
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
 					arch_current_thread()->base.prio :
 					mutex->owner_orig_prio;
@@ -153,8 +305,18 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
+#ifdef CONFIG_LOCK_STATS_MUTEX
+	uint32_t wait_start = k_cycle_get_32();
+
+	mutex->lock_stats.contended++;
+#endif /* CONFIG_LOCK_STATS_MUTEX */
+
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
+#ifdef CONFIG_LOCK_STATS_MUTEX
+	lock_stats_waited(mutex, wait_start);
+#endif /* CONFIG_LOCK_STATS_MUTEX */
+
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
 
 	LOG_DBG("%p got mutex %p (y/n): %c", arch_current_thread(), mutex,
@@ -251,6 +413,8 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
+	lock_stats_released(mutex);
+
 	adjust_owner_prio(mutex, mutex->owner_orig_prio);
 
 	/* Get the new owner, if any */
@@ -268,6 +432,7 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		 * adjust its priority
 		 */
 		mutex->owner_orig_prio = new_owner->base.prio;
+		lock_stats_acquired(mutex);
 		arch_thread_return_value_set(new_owner, 0);
 		z_ready_thread(new_owner);
 		z_reschedule(&lock, key);
@@ -299,11 +464,18 @@ static int init_mutex_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_mutex, K_OBJ_TYPE_MUTEX_ID,
 			offsetof(struct k_mutex, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_obj_type_stats_init(&obj_type_mutex, &mutex_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 
 	/* Initialize and link statically defined mutexes */
 
 	STRUCT_SECTION_FOREACH(k_mutex, mutex) {
 		k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+		k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->lock_stats,
+					  sizeof(struct k_lock_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 	}
 
 	return 0;
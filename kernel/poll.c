@@ -35,10 +35,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_poll_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -53,6 +54,7 @@ void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 	event->type = type;
 	event->state = K_POLL_STATE_NOT_READY;
 	event->mode = mode;
+	event->persistent = 0U;
 	event->unused = 0U;
 	event->obj = obj;
 
@@ -114,17 +116,28 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 {
 	struct k_poll_event *pending;
 
+	/* Poll sets have no thread priority to order by, their registrations
+	 * always go after the ones of the threads waiting on the object, and
+	 * are all signalled along with the first thread.
+	 */
+	if (poller->mode == MODE_SET) {
+		sys_dlist_append(events, &event->_node);
+		return;
+	}
+
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
 	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+		((pending->poller->mode != MODE_SET) &&
+		 (z_sched_prio_cmp(poller_thread(pending->poller),
+							   poller_thread(poller)) > 0))) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if ((pending->poller->mode == MODE_SET) ||
+		    (z_sched_prio_cmp(poller_thread(poller),
+					poller_thread(pending->poller)) > 0)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -443,6 +456,11 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
+	if ((poller != NULL) && (poller->mode == MODE_SET)) {
+		/* Set registrations stay owned by the set until delivered */
+		return signal_poll_set(event, state);
+	}
+
 	if (poller != NULL) {
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
@@ -464,16 +482,39 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	return retcode;
 }
 
-void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
+/* must be called with interrupts locked
+ *
+ * Signals the first thread or work item polling the object, along with all
+ * the poll sets registered on it. Sets are queued after the threads, so a
+ * thread polling the object over and over would otherwise starve them.
+ */
+static int signal_obj_poll_events(sys_dlist_t *events, uint32_t state)
 {
 	struct k_poll_event *poll_event;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_poll_event *next;
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(events, poll_event, next, _node) {
+		if ((poll_event->poller != NULL) &&
+		    (poll_event->poller->mode == MODE_SET)) {
+			sys_dlist_remove(&poll_event->_node);
+			(void)signal_poll_set(poll_event, state);
+		}
+	}
 
 	poll_event = (struct k_poll_event *)sys_dlist_get(events);
-	if (poll_event != NULL) {
-		(void) signal_poll_event(poll_event, state);
+	if (poll_event == NULL) {
+		return 0;
 	}
 
+	return signal_poll_event(poll_event, state);
+}
+
+void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	(void)signal_obj_poll_events(events, state);
+
 	k_spin_unlock(&lock, key);
 }
 
@@ -527,13 +568,11 @@ void z_vrfy_k_poll_signal_check(struct k_poll_signal *sig,
 int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
-	struct k_poll_event *poll_event;
 
 	sig->result = result;
 	sig->signaled = 1U;
 
-	poll_event = (struct k_poll_event *)sys_dlist_get(&sig->poll_events);
-	if (poll_event == NULL) {
+	if (sys_dlist_is_empty(&sig->poll_events)) {
 		k_spin_unlock(&lock, key);
 
 		SYS_PORT_TRACING_FUNC(k_poll_api, signal_raise, sig, 0);
@@ -541,7 +580,7 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 		return 0;
 	}
 
-	int rc = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
+	int rc = signal_obj_poll_events(&sig->poll_events, K_POLL_STATE_SIGNALED);
 
 	SYS_PORT_TRACING_FUNC(k_poll_api, signal_raise, sig, rc);
 
@@ -813,3 +852,140 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+/* must be called with interrupts locked */
+static int signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller, struct k_poll_set,
+					      poller);
+
+	event->state |= state;
+	sys_dlist_append(&set->ready, &event->_node);
+	(void)z_sched_wake(&set->wait_q, 0, NULL);
+
+	return 0;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	z_waitq_init(&set->wait_q);
+}
+
+static void poll_set_add(struct k_poll_set *set, struct k_poll_event *event,
+			 bool persistent)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t state;
+
+	event->state = K_POLL_STATE_NOT_READY;
+	event->persistent = persistent ? 1U : 0U;
+	event->poller = &set->poller;
+
+	if (is_condition_met(event, &state)) {
+		(void)signal_poll_set(event, state);
+		z_reschedule(&lock, key);
+		return;
+	}
+
+	register_event(event, &set->poller);
+	k_spin_unlock(&lock, key);
+}
+
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	poll_set_add(set, event, false);
+}
+
+void k_poll_set_add_persistent(struct k_poll_set *set, struct k_poll_event *event)
+{
+	poll_set_add(set, event, true);
+}
+
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	__ASSERT((event->poller == NULL) || (event->poller == &set->poller),
+		 "event armed in another poll set\n");
+
+	/* The node is either on the object, on the ready list or nowhere */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+
+	event->poller = NULL;
+	event->persistent = 0U;
+
+	k_spin_unlock(&lock, key);
+}
+
+uint32_t k_poll_set_state_take(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t state = event->state;
+
+	ARG_UNUSED(set);
+
+	/* Objects OR their state in under the lock, the bitfield shares its
+	 * word with the other event flags.
+	 */
+	event->state = K_POLL_STATE_NOT_READY;
+
+	k_spin_unlock(&lock, key);
+
+	return state;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int num_events, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct k_poll_event *event;
+	k_spinlock_key_t key;
+	int count = 0;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+	__ASSERT(num_events >= 0, "<0 events\n");
+
+	key = k_spin_lock(&lock);
+
+	while (sys_dlist_is_empty(&set->ready)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		ret = z_pend_curr(&lock, key, &set->wait_q, timeout);
+		if (ret != 0) {
+			return ret;
+		}
+
+		/* Another waiter may have drained the list in the meantime */
+		key = k_spin_lock(&lock);
+		timeout = sys_timepoint_timeout(end);
+	}
+
+	while (count < num_events) {
+		event = (struct k_poll_event *)sys_dlist_get(&set->ready);
+		if (event == NULL) {
+			break;
+		}
+
+		if (event->persistent != 0U) {
+			/* Back on the object, for its next change */
+			register_event(event, &set->poller);
+		} else {
+			event->poller = NULL;
+		}
+
+		events[count++] = event;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return count;
+}
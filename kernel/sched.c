@@ -382,6 +382,7 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+		z_sched_usage_ready(thread);
 		queue_thread(thread);
 		update_cache(0);
 
@@ -839,6 +840,7 @@ static inline void set_current(struct k_thread *new_thread)
 {
 	z_thread_mark_switched_out();
 	arch_current_thread_set(new_thread);
+	z_shared_page_current_set(new_thread);
 }
 
 /**
@@ -1241,6 +1243,24 @@ static inline k_tid_t z_vrfy_k_sched_current_thread_query(void)
 #include <zephyr/syscalls/k_sched_current_thread_query_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_k_sched_current_cpu_query(void)
+{
+	unsigned int key = arch_irq_lock();
+	int ret = arch_curr_cpu()->id;
+
+	arch_irq_unlock(key);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_sched_current_cpu_query(void)
+{
+	return z_impl_k_sched_current_cpu_query();
+}
+#include <zephyr/syscalls/k_sched_current_cpu_query_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static inline void unpend_all(_wait_q_t *wait_q)
 {
 	struct k_thread *thread;
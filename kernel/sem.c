@@ -24,10 +24,12 @@
 #include <wait_q.h>
 #include <zephyr/sys/dlist.h>
 #include <ksched.h>
+#include <adaptive_spin.h>
 #include <zephyr/init.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/sys/check.h>
+#include <string.h>
 
 /* We use a system-wide lock to synchronize semaphores, which has
  * unfortunate performance impact vs. using a per-object lock
@@ -40,8 +42,71 @@ static struct k_spinlock lock;
 
 #ifdef CONFIG_OBJ_CORE_SEM
 static struct k_obj_type obj_type_sem;
+
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+static int k_sem_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_sem *sem;
+	k_spinlock_key_t key;
+
+	sem = CONTAINER_OF(obj_core, struct k_sem, obj_core);
+	key = k_spin_lock(&lock);
+	memcpy(stats, &sem->lock_stats, sizeof(sem->lock_stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static int k_sem_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_sem *sem;
+	k_spinlock_key_t key;
+
+	sem = CONTAINER_OF(obj_core, struct k_sem, obj_core);
+	key = k_spin_lock(&lock);
+	memset(&sem->lock_stats, 0, sizeof(sem->lock_stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc sem_stats_desc = {
+	.raw_size = sizeof(struct k_lock_stats),
+	.query_size = sizeof(struct k_lock_stats),
+	.raw   = k_sem_stats_raw,
+	.query = k_sem_stats_raw,
+	.reset = k_sem_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 #endif /* CONFIG_OBJ_CORE_SEM */
 
+#ifdef CONFIG_LOCK_STATS_SEM
+/* Called once a thread that pended on the semaphore is back */
+static void lock_stats_waited(struct k_sem *sem, uint32_t wait_start, int ret)
+{
+	uint32_t wait = k_cycle_get_32() - wait_start;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (ret == 0) {
+		sem->lock_stats.acquired++;
+	}
+	sem->lock_stats.total_wait += wait;
+	if (wait > sem->lock_stats.max_wait) {
+		sem->lock_stats.max_wait = wait;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_sem, take_contended, sem, wait);
+}
+#endif /* CONFIG_LOCK_STATS_SEM */
+
 int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 		      unsigned int limit)
 {
@@ -65,8 +130,16 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 #endif /* CONFIG_POLL */
 	k_object_init(sem);
 
+#ifdef CONFIG_LOCK_STATS_SEM
+	memset(&sem->lock_stats, 0, sizeof(sem->lock_stats));
+#endif /* CONFIG_LOCK_STATS_SEM */
+
 #ifdef CONFIG_OBJ_CORE_SEM
 	k_obj_core_init_and_link(K_OBJ_CORE(sem), &obj_type_sem);
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	k_obj_core_stats_register(K_OBJ_CORE(sem), &sem->lock_stats,
+				  sizeof(struct k_lock_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 #endif /* CONFIG_OBJ_CORE_SEM */
 
 	return 0;
@@ -129,9 +202,54 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 #include <zephyr/syscalls/k_sem_give_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_ADAPTIVE_SPIN
+/*
+ * Called with the lock held when the semaphore is not available. If
+ * nobody waits for it yet, spin without the lock for as long as a thread
+ * that could give it runs on another CPU, within the spin budget. Returns
+ * with the lock held again, the caller then has another look at the count.
+ * The time spent spinning is taken off @a timeout, the remaining time is
+ * returned.
+ */
+static k_timeout_t sem_adaptive_spin(struct k_sem *sem, k_spinlock_key_t *key,
+				     k_timeout_t timeout)
+{
+	volatile struct k_sem *vsem = sem;
+	k_timepoint_t end;
+	uint32_t start;
+
+	if (z_waitq_head(&sem->wait_q) != NULL) {
+		return timeout;
+	}
+
+	k_spin_unlock(&lock, *key);
+
+	end = sys_timepoint_calc(timeout);
+
+	start = k_cycle_get_32();
+	while ((vsem->count == 0U) && adaptive_spin_pause(NULL) &&
+	       ((k_cycle_get_32() - start) < ADAPTIVE_SPIN_BUDGET)) {
+	}
+
+	*key = k_spin_lock(&lock);
+
+#ifdef CONFIG_LOCK_STATS_SEM
+	sem->lock_stats.spun++;
+	if (sem->count > 0U) {
+		sem->lock_stats.spin_acquired++;
+	}
+#endif /* CONFIG_LOCK_STATS_SEM */
+
+	return sys_timepoint_timeout(end);
+}
+#endif /* CONFIG_ADAPTIVE_SPIN */
+
 int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
 	int ret;
+#ifdef CONFIG_LOCK_STATS_SEM
+	uint32_t wait_start;
+#endif /* CONFIG_LOCK_STATS_SEM */
 
 	__ASSERT(((arch_is_in_isr() == false) ||
 		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
@@ -140,8 +258,24 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, take, sem, timeout);
 
+#ifdef CONFIG_ADAPTIVE_SPIN
+	if ((sem->count == 0U) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		timeout = sem_adaptive_spin(sem, &key, timeout);
+
+		if ((sem->count == 0U) && K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			/* Spun for the whole timeout */
+			k_spin_unlock(&lock, key);
+			ret = -EAGAIN;
+			goto out;
+		}
+	}
+#endif /* CONFIG_ADAPTIVE_SPIN */
+
 	if (likely(sem->count > 0U)) {
 		sem->count--;
+#ifdef CONFIG_LOCK_STATS_SEM
+		sem->lock_stats.acquired++;
+#endif /* CONFIG_LOCK_STATS_SEM */
 		k_spin_unlock(&lock, key);
 		ret = 0;
 		goto out;
@@ -155,8 +289,17 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
+#ifdef CONFIG_LOCK_STATS_SEM
+	wait_start = k_cycle_get_32();
+	sem->lock_stats.contended++;
+#endif /* CONFIG_LOCK_STATS_SEM */
+
 	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
 
+#ifdef CONFIG_LOCK_STATS_SEM
+	lock_stats_waited(sem, wait_start, ret);
+#endif /* CONFIG_LOCK_STATS_SEM */
+
 out:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, take, sem, timeout, ret);
 
@@ -216,11 +359,18 @@ static int init_sem_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_sem, K_OBJ_TYPE_SEM_ID,
 			offsetof(struct k_sem, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	k_obj_type_stats_init(&obj_type_sem, &sem_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 
 	/* Initialize and link statically defined semaphores */
 
 	STRUCT_SECTION_FOREACH(k_sem, sem) {
 		k_obj_core_init_and_link(K_OBJ_CORE(sem), &obj_type_sem);
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+		k_obj_core_stats_register(K_OBJ_CORE(sem), &sem->lock_stats,
+					  sizeof(struct k_lock_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 	}
 
 	return 0;
@@ -0,0 +1,61 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/app_memory/app_memdomain.h>
+#include <zephyr/linker/section_tags.h>
+#include <kernel_internal.h>
+
+#ifdef CONFIG_MMU
+#include <zephyr/kernel/mm.h>
+#include <zephyr/kernel/internal/mm.h>
+
+/* There is no page permission for "kernel writes, user reads": the kernel
+ * writes the page through its own mapping, and the frame below is remapped
+ * at boot as a read-only user alias of it.
+ */
+__pinned_bss __aligned(CONFIG_MMU_PAGE_SIZE)
+union z_shared_page_frame z_shared_page_frame;
+
+__pinned_bss __aligned(CONFIG_MMU_PAGE_SIZE)
+union z_shared_page_frame z_shared_page_user_frame;
+#else
+#ifndef K_MEM_PARTITION_P_RW_U_RO
+#error "CONFIG_USERSPACE_SHARED_PAGE needs K_MEM_PARTITION_P_RW_U_RO"
+#endif
+
+K_APPMEM_PARTITION_DEFINE(z_shared_page_partition);
+K_APP_BMEM(z_shared_page_partition) struct z_shared_page z_shared_page;
+#endif /* CONFIG_MMU */
+
+static int shared_page_init(void)
+{
+#ifdef CONFIG_MMU
+	size_t size = sizeof(z_shared_page_user_frame);
+
+	arch_mem_unmap(&z_shared_page_user_frame, size);
+	arch_mem_map(&z_shared_page_user_frame, k_mem_phys_addr(&z_shared_page_frame),
+		     size, K_MEM_PERM_USER | K_MEM_CACHE_WB);
+#else
+	int ret;
+
+	z_shared_page_partition.attr = K_MEM_PARTITION_P_RW_U_RO;
+
+	ret = k_mem_domain_add_partition(&k_mem_domain_default,
+					 &z_shared_page_partition);
+	__ASSERT(ret == 0, "failed to add shared page partition");
+	ARG_UNUSED(ret);
+#endif /* CONFIG_MMU */
+
+	/* Other CPUs publish their thread on their next context switch */
+	z_shared_page_current_set(arch_current_thread());
+
+	return 0;
+}
+
+/* Before any thread can enter user mode */
+SYS_INIT(shared_page_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -8,6 +8,7 @@
 #include <zephyr/spinlock.h>
 #include <kswap.h>
 #include <kernel_internal.h>
+#include <ipi.h>
 
 static atomic_t global_lock;
 
@@ -155,6 +156,9 @@ static void start_cpu(int id, struct cpu_start_cb *csc)
 	 */
 	(void)atomic_clear(&ready_flag);
 
+	/* It can't still be handling an IPI sent before it went down */
+	ipi_inflight_clear(id);
+
 	/* Power up the CPU */
 	arch_cpu_start(id, z_interrupt_stacks[id], CONFIG_ISR_STACK_SIZE,
 		       smp_init_top, csc);
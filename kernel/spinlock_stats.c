@@ -0,0 +1,107 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/spinlock.h>
+#include <ksched.h>
+#include <string.h>
+
+void k_spin_lock_stats_get(struct k_spinlock *l, struct k_lock_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(l);
+
+	memcpy(stats, &l->stats, sizeof(l->stats));
+	k_spin_unlock(l, key);
+}
+
+void k_spin_lock_stats_reset(struct k_spinlock *l)
+{
+	k_spinlock_key_t key = k_spin_lock(l);
+
+	memset(&l->stats, 0, sizeof(l->stats));
+	k_spin_unlock(l, key);
+}
+
+#ifdef CONFIG_OBJ_CORE_SPINLOCK
+static struct k_obj_type obj_type_spinlock;
+
+#ifdef CONFIG_OBJ_CORE_STATS_SPINLOCK
+/* These are called with the object core lock held, which nests inside the
+ * scheduler lock when a thread is aborted. Taking the spinlock here could
+ * thus deadlock, so the statistics are accessed without it and a copy may
+ * mix values from before and after a concurrent update.
+ */
+static int k_spinlock_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_spinlock *l;
+
+	l = CONTAINER_OF(obj_core, struct k_spinlock, obj_core);
+	memcpy(stats, &l->stats, sizeof(l->stats));
+
+	return 0;
+}
+
+static int k_spinlock_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_spinlock *l;
+
+	l = CONTAINER_OF(obj_core, struct k_spinlock, obj_core);
+	memset(&l->stats, 0, sizeof(l->stats));
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc spinlock_stats_desc = {
+	.raw_size = sizeof(struct k_lock_stats),
+	.query_size = sizeof(struct k_lock_stats),
+	.raw   = k_spinlock_stats_raw,
+	.query = k_spinlock_stats_raw,
+	.reset = k_spinlock_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif /* CONFIG_OBJ_CORE_STATS_SPINLOCK */
+#endif /* CONFIG_OBJ_CORE_SPINLOCK */
+
+void k_spin_lock_stats_register(struct k_spinlock *l)
+{
+#ifdef CONFIG_OBJ_CORE_SPINLOCK
+	k_obj_core_init_and_link(K_OBJ_CORE(l), &obj_type_spinlock);
+#ifdef CONFIG_OBJ_CORE_STATS_SPINLOCK
+	k_obj_core_stats_register(K_OBJ_CORE(l), &l->stats,
+				  sizeof(struct k_lock_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_SPINLOCK */
+#else
+	ARG_UNUSED(l);
+#endif /* CONFIG_OBJ_CORE_SPINLOCK */
+}
+
+#ifdef CONFIG_OBJ_CORE_SPINLOCK
+static int init_spinlock_obj_core_list(void)
+{
+	/* Initialize spinlock object type */
+
+	z_obj_type_init(&obj_type_spinlock, K_OBJ_TYPE_SPINLOCK_ID,
+			offsetof(struct k_spinlock, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_SPINLOCK
+	k_obj_type_stats_init(&obj_type_spinlock, &spinlock_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_SPINLOCK */
+
+	/* The scheduler lock is the one most worth watching */
+
+	k_spin_lock_stats_register(&_sched_spinlock);
+
+	return 0;
+}
+
+SYS_INIT(init_spinlock_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_OBJ_CORE_SPINLOCK */
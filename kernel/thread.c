@@ -641,6 +641,10 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 		CONFIG_SCHED_THREAD_USAGE_AUTO_ENABLE;
 #endif /* CONFIG_SCHED_THREAD_USAGE */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	new_thread->base.ready_at = 0U;
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 	SYS_PORT_TRACING_OBJ_FUNC(k_thread, create, new_thread);
 
 	return stack_ptr;
@@ -918,6 +922,10 @@ void z_thread_mark_switched_in(void)
 	z_sched_usage_start(arch_current_thread());
 #endif /* CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
 
+#if defined(CONFIG_USERSPACE_SHARED_PAGE) && !defined(CONFIG_USE_SWITCH)
+	z_shared_page_current_set(arch_current_thread());
+#endif /* CONFIG_USERSPACE_SHARED_PAGE && !CONFIG_USE_SWITCH */
+
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
 #endif /* CONFIG_TRACING */
@@ -985,6 +993,12 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 		stats->average_cycles   += tmp_stats.average_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 		stats->idle_cycles      += tmp_stats.idle_cycles;
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+		z_sched_latency_merge(&stats->wakeup_latency,
+				      &tmp_stats.wakeup_latency);
+		z_sched_latency_merge(&stats->preempt_latency,
+				      &tmp_stats.preempt_latency);
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
 	}
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
@@ -249,6 +249,8 @@ void sys_clock_announce(int32_t ticks)
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
 
+	z_shared_page_ticks_set(curr_tick);
+
 	sys_clock_set_timeout(next_timeout(), false);
 
 	k_spin_unlock(&timeout_lock, key);
@@ -277,17 +279,17 @@ uint32_t sys_clock_tick_get_32(void)
 #endif /* CONFIG_TICKLESS_KERNEL */
 }
 
-int64_t z_impl_k_uptime_ticks(void)
+int64_t z_impl_k_uptime_ticks_query(void)
 {
 	return sys_clock_tick_get();
 }
 
 #ifdef CONFIG_USERSPACE
-static inline int64_t z_vrfy_k_uptime_ticks(void)
+static inline int64_t z_vrfy_k_uptime_ticks_query(void)
 {
-	return z_impl_k_uptime_ticks();
+	return z_impl_k_uptime_ticks_query();
 }
-#include <zephyr/syscalls/k_uptime_ticks_mrsh.c>
+#include <zephyr/syscalls/k_uptime_ticks_query_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 k_timepoint_t sys_timepoint_calc(k_timeout_t timeout)
@@ -330,7 +332,11 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
-	curr_tick = tick;
+	/* The tick seqlock of the shared page expects a single writer */
+	K_SPINLOCK(&timeout_lock) {
+		curr_tick = tick;
+		z_shared_page_ticks_set(curr_tick);
+	}
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
@@ -10,6 +10,7 @@
 #include <ksched.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
 
 /* Need one of these for this to work */
 #if !defined(CONFIG_USE_SWITCH) && !defined(CONFIG_INSTRUMENT_THREAD_SWITCHING)
@@ -58,6 +59,83 @@ static void sched_cpu_update_usage(struct _cpu *cpu, uint32_t cycles)
 #define sched_cpu_update_usage(cpu, cycles)   do { } while (0)
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+static void latency_record(struct k_latency_stats *stats, uint32_t cycles)
+{
+	unsigned int bucket = 0U;
+
+	if (cycles > 1U) {
+		bucket = 31U - u32_count_leading_zeros(cycles);
+	}
+
+	stats->buckets[MIN(bucket, CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS - 1U)]++;
+
+	if ((stats->count == 0U) || (cycles < stats->min)) {
+		stats->min = cycles;
+	}
+	if (cycles > stats->max) {
+		stats->max = cycles;
+	}
+	stats->count++;
+	stats->total += cycles;
+}
+
+void z_sched_latency_merge(struct k_latency_stats *dst,
+			   const struct k_latency_stats *src)
+{
+	if (src->count == 0U) {
+		return;
+	}
+
+	for (unsigned int i = 0; i < CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS; i++) {
+		dst->buckets[i] += src->buckets[i];
+	}
+
+	if ((dst->count == 0U) || (src->min < dst->min)) {
+		dst->min = src->min;
+	}
+	if (src->max > dst->max) {
+		dst->max = src->max;
+	}
+	dst->count += src->count;
+	dst->total += src->total;
+}
+
+/* Called with the usage lock held when @a thread is switched in */
+static void sched_update_latency(struct _cpu *cpu, struct k_thread *thread,
+				 uint32_t now)
+{
+	uint32_t cycles = now - thread->base.ready_at;
+	bool preempted = thread->base.ready_preempted;
+
+	if (thread->base.ready_at == 0U) {
+		return;
+	}
+
+	thread->base.ready_at = 0U;
+
+	if (thread->base.usage.track_usage) {
+		latency_record(preempted ? &thread->base.usage.preempt :
+					   &thread->base.usage.wakeup, cycles);
+	}
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	if (cpu->usage->track_usage) {
+		latency_record(preempted ? &cpu->usage->preempt :
+					   &cpu->usage->wakeup, cycles);
+	}
+#else
+	ARG_UNUSED(cpu);
+#endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
+}
+
+void z_sched_usage_ready(struct k_thread *thread)
+{
+	thread->base.ready_at = usage_now();
+	thread->base.ready_preempted = false;
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 {
 	thread->base.usage.total += cycles;
@@ -73,17 +151,23 @@ static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 
 void z_sched_usage_start(struct k_thread *thread)
 {
-#ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
+#if defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) || defined(CONFIG_SCHED_THREAD_USAGE_LATENCY)
 	k_spinlock_key_t  key;
 
 	key = k_spin_lock(&usage_lock);
 
 	_current_cpu->usage0 = usage_now();   /* Always update */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
 	if (thread->base.usage.track_usage) {
 		thread->base.usage.num_windows++;
 		thread->base.usage.current = 0;
 	}
+#endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	sched_update_latency(_current_cpu, thread, _current_cpu->usage0);
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
 
 	k_spin_unlock(&usage_lock, key);
 #else
@@ -114,6 +198,20 @@ void z_sched_usage_stop(void)
 		sched_cpu_update_usage(cpu, cycles);
 	}
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	struct k_thread *thread = cpu->current;
+
+	/* Still runnable: it is being preempted, by a thread or an
+	 * interrupt. An interrupt may itself end in a switch, that
+	 * preemption began when the interrupt did.
+	 */
+	if (!z_is_idle_thread_object(thread) && z_is_thread_ready(thread) &&
+	    (thread->base.ready_at == 0U)) {
+		thread->base.ready_at = usage_now();
+		thread->base.ready_preempted = true;
+	}
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 	cpu->usage0 = 0;
 	k_spin_unlock(&usage_lock, k);
 }
@@ -166,6 +264,11 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 
 	stats->execution_cycles = stats->total_cycles + stats->idle_cycles;
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	stats->wakeup_latency = cpu->usage->wakeup;
+	stats->preempt_latency = cpu->usage->preempt;
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 	k_spin_unlock(&usage_lock, key);
 }
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
@@ -221,6 +324,11 @@ void z_sched_thread_usage(struct k_thread *thread,
 	stats->idle_cycles = 0;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	stats->wakeup_latency = thread->base.usage.wakeup;
+	stats->preempt_latency = thread->base.usage.preempt;
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 	k_spin_unlock(&usage_lock, key);
 }
 
@@ -382,6 +490,10 @@ int z_thread_stats_reset(struct k_obj_core *obj_core)
 	stats->longest = 0ULL;
 	stats->num_windows = (thread->base.usage.track_usage) ?  1U : 0U;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	stats->wakeup = (struct k_latency_stats) {};
+	stats->preempt = (struct k_latency_stats) {};
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
 
 	if (thread != _current_cpu->current) {
 
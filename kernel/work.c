@@ -173,6 +173,280 @@ int k_work_busy_get(const struct k_work *work)
 	return ret;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+
+static inline bool queue_is_pool(const struct k_work_q *queue)
+{
+	return queue->workers != NULL;
+}
+
+/* Account for an item added to the local queue of a pool worker.
+ *
+ * Invoked with work lock held.
+ */
+static inline void worker_pushed_locked(struct k_work_q_worker *worker)
+{
+#ifdef CONFIG_WORKQUEUE_POOL_STATS
+	worker->stats.depth++;
+	worker->stats.max_depth = MAX(worker->stats.max_depth, worker->stats.depth);
+#endif
+}
+
+/* Account for an item removed from the local queue of a pool worker.
+ *
+ * Invoked with work lock held.
+ */
+static inline void worker_popped_locked(struct k_work_q_worker *worker)
+{
+#ifdef CONFIG_WORKQUEUE_POOL_STATS
+	worker->stats.depth--;
+#endif
+}
+
+/* Find the pool worker whose local queue holds a work item.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the worker, or NULL if the item is not queued on the pool
+ */
+static struct k_work_q_worker *pool_find_queued_locked(struct k_work_q *queue,
+							const struct k_work *work)
+{
+	for (int i = 0; i < queue->num_workers; i++) {
+		struct k_work_q_worker *worker = &queue->workers[i];
+		sys_snode_t *node;
+
+		SYS_SLIST_FOR_EACH_NODE(&worker->pending, node) {
+			if (node == &work->node) {
+				return worker;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the pool worker running a work item.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the worker, or NULL if the item is not running on the pool
+ */
+static struct k_work_q_worker *pool_find_running_locked(struct k_work_q *queue,
+							 const struct k_work *work)
+{
+	for (int i = 0; i < queue->num_workers; i++) {
+		if (queue->workers[i].current == work) {
+			return &queue->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the pool worker animated by the current thread.
+ *
+ * @return the worker, or NULL if not invoked from a worker of the pool
+ */
+static struct k_work_q_worker *pool_current_worker(struct k_work_q *queue)
+{
+	if (k_is_in_isr()) {
+		return NULL;
+	}
+
+	for (int i = 0; i < queue->num_workers; i++) {
+		if (arch_current_thread() == &queue->workers[i].thread) {
+			return &queue->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Check whether all the local queues of a pool are empty.
+ *
+ * Invoked with work lock held.
+ */
+static bool pool_is_empty_locked(struct k_work_q *queue)
+{
+	for (int i = 0; i < queue->num_workers; i++) {
+		if (!sys_slist_is_empty(&queue->workers[i].pending)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Wake an idle pool worker.
+ *
+ * Invoked with work lock held.
+ *
+ * @return true if and only if the worker was woken.
+ */
+static inline bool worker_wake_locked(struct k_work_q_worker *worker)
+{
+	if (!worker->idle) {
+		return false;
+	}
+
+	worker->idle = false;
+
+	return z_sched_wake(&worker->notifyq, 0, NULL);
+}
+
+/* Notify a pool of new work for @p worker.
+ *
+ * Wakes @p worker if it is idle, otherwise an idle worker so that it can
+ * steal the work.  @p worker may be NULL if the work can run on any worker.
+ *
+ * Invoked with work lock held.
+ *
+ * @return true if and only if a worker was woken.
+ */
+static bool pool_notify_locked(struct k_work_q *queue,
+			       struct k_work_q_worker *worker)
+{
+	if ((worker != NULL) && worker_wake_locked(worker)) {
+		return true;
+	}
+
+	for (int i = 0; i < queue->num_workers; i++) {
+		if (worker_wake_locked(&queue->workers[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Queue a work item on a pool.
+ *
+ * An item that is running must be queued on the worker running it, so
+ * that it can't run concurrently with itself.  Items submitted by a worker
+ * stay local to that worker, other ones are spread over the workers.
+ *
+ * Invoked with work lock held.
+ * Notifies the pool.
+ */
+static void pool_submit_locked(struct k_work_q *queue,
+			       struct k_work *work)
+{
+	struct k_work_q_worker *worker = NULL;
+
+	if (flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		worker = pool_find_running_locked(queue, work);
+		__ASSERT_NO_MSG(worker != NULL);
+	}
+
+	if (worker == NULL) {
+		worker = pool_current_worker(queue);
+	}
+
+	if (worker == NULL) {
+		worker = &queue->workers[queue->next_worker];
+		queue->next_worker = (queue->next_worker + 1U) % queue->num_workers;
+	}
+
+	sys_slist_append(&worker->pending, &work->node);
+	worker_pushed_locked(worker);
+#ifdef CONFIG_WORKQUEUE_POOL_STATS
+	work->queued_at = k_cycle_get_32();
+#endif
+
+	(void)pool_notify_locked(queue, worker);
+}
+
+/* Steal a work item from the local queue of another pool worker.
+ *
+ * Only the head of a local queue is considered.  It is left alone if it is
+ * a flusher, which must run on the worker holding it, or an item that was
+ * resubmitted while running on its worker.  The flushers queued right behind
+ * a stolen item are moved along with it.
+ *
+ * Invoked with work lock held.
+ *
+ * @param thief the worker looking for work, its local queue is empty.
+ *
+ * @return the stolen item, or NULL if there was nothing to steal
+ */
+static struct k_work *pool_steal_locked(struct k_work_q *queue,
+					struct k_work_q_worker *thief)
+{
+	int self = thief - queue->workers;
+
+	for (int i = 1; i < queue->num_workers; i++) {
+		struct k_work_q_worker *victim
+			= &queue->workers[(self + i) % queue->num_workers];
+		sys_snode_t *node = sys_slist_peek_head(&victim->pending);
+		struct k_work *work;
+
+		if (node == NULL) {
+			continue;
+		}
+
+		work = CONTAINER_OF(node, struct k_work, node);
+		if ((flags_get(&work->flags)
+		     & (K_WORK_FLUSHING | K_WORK_RUNNING)) != 0U) {
+			continue;
+		}
+
+		(void)sys_slist_get(&victim->pending);
+		worker_popped_locked(victim);
+
+		while ((node = sys_slist_peek_head(&victim->pending)) != NULL) {
+			struct k_work *next = CONTAINER_OF(node, struct k_work, node);
+
+			if (!flag_test(&next->flags, K_WORK_FLUSHING_BIT)) {
+				break;
+			}
+
+			(void)sys_slist_get(&victim->pending);
+			worker_popped_locked(victim);
+			sys_slist_append(&thief->pending, node);
+			worker_pushed_locked(thief);
+		}
+
+#ifdef CONFIG_WORKQUEUE_POOL_STATS
+		thief->stats.stolen++;
+#endif
+
+		return work;
+	}
+
+	return NULL;
+}
+
+/* Add a flusher work item to a pool.
+ *
+ * The flusher goes right behind the item on the local queue holding it, or
+ * at the head of the local queue of the worker running it, so that it is
+ * completed by the worker that completes the item.
+ *
+ * Invoked with work lock held.
+ */
+static void pool_queue_flusher_locked(struct k_work_q *queue,
+				      struct k_work *work,
+				      struct z_work_flusher *flusher)
+{
+	struct k_work_q_worker *worker;
+
+	if ((flags_get(&work->flags) & K_WORK_QUEUED) != 0U) {
+		worker = pool_find_queued_locked(queue, work);
+		__ASSERT_NO_MSG(worker != NULL);
+		sys_slist_insert(&worker->pending, &work->node,
+				 &flusher->work.node);
+	} else {
+		worker = pool_find_running_locked(queue, work);
+		__ASSERT_NO_MSG(worker != NULL);
+		sys_slist_prepend(&worker->pending, &flusher->work.node);
+	}
+
+	worker_pushed_locked(worker);
+}
+
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /* Add a flusher work item to the queue.
  *
  * Invoked with work lock held.
@@ -190,6 +464,13 @@ static void queue_flusher_locked(struct k_work_q *queue,
 {
 	init_flusher(flusher);
 
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue_is_pool(queue)) {
+		pool_queue_flusher_locked(queue, work, flusher);
+		return;
+	}
+#endif
+
 	if ((flags_get(&work->flags) & K_WORK_QUEUED) != 0U) {
 		sys_slist_insert(&queue->pending, &work->node,
 				 &flusher->work.node);
@@ -209,10 +490,51 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (queue_is_pool(queue)) {
+			struct k_work_q_worker *worker
+				= pool_find_queued_locked(queue, work);
+
+			__ASSERT_NO_MSG(worker != NULL);
+			(void)sys_slist_find_and_remove(&worker->pending, &work->node);
+			worker_popped_locked(worker);
+			return;
+		}
+#endif
 		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
 	}
 }
 
+/* Check whether a queue has no pending work item.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool queue_is_empty_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue_is_pool(queue)) {
+		return pool_is_empty_locked(queue);
+	}
+#endif
+
+	return sys_slist_is_empty(&queue->pending);
+}
+
+/* Check whether the current thread animates a queue.
+ *
+ * For a pool this is true from any of its workers.
+ */
+static inline bool queue_thread_is_current(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue_is_pool(queue)) {
+		return pool_current_worker(queue) != NULL;
+	}
+#endif
+
+	return (arch_current_thread() == &queue->thread) && !k_is_in_isr();
+}
+
 /* Potentially notify a queue that it needs to look for pending work.
  *
  * This may make the work queue thread ready, but as the lock is held it
@@ -229,6 +551,11 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	bool rv = false;
 
 	if (queue != NULL) {
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (queue_is_pool(queue)) {
+			return pool_notify_locked(queue, NULL);
+		}
+#endif
 		rv = z_sched_wake(&queue->notifyq, 0, NULL);
 	}
 
@@ -262,7 +589,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret;
-	bool chained = (arch_current_thread() == &queue->thread) && !k_is_in_isr();
+	bool chained = queue_thread_is_current(queue);
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -280,6 +607,12 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
 	} else {
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (queue_is_pool(queue)) {
+			pool_submit_locked(queue, work);
+			return 1;
+		}
+#endif
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
 		(void)notify_queue_locked(queue);
@@ -774,7 +1107,7 @@ int k_work_queue_drain(struct k_work_q *queue,
 	if (((flags_get(&queue->flags)
 	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
 	    || plug
-	    || !sys_slist_is_empty(&queue->pending)) {
+	    || !queue_is_empty_locked(queue)) {
 		flag_set(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 		if (plug) {
 			flag_set(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
@@ -812,6 +1145,240 @@ int k_work_queue_unplug(struct k_work_q *queue)
 	return ret;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+
+/* Loop executed by a work queue pool worker thread.
+ *
+ * Same as work_queue_main(), except that work is taken from the local queue
+ * of the worker or stolen from other workers, and that the queue is only
+ * drained once no worker is busy.
+ *
+ * @param worker_ptr pointer to the worker structure
+ */
+static void pool_worker_main(void *worker_ptr, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct k_work_q_worker *worker = (struct k_work_q_worker *)worker_ptr;
+	struct k_work_q *queue = worker->queue;
+
+	while (true) {
+		sys_snode_t *node;
+		struct k_work *work = NULL;
+		k_work_handler_t handler;
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		bool yield;
+#ifdef CONFIG_WORKQUEUE_POOL_STATS
+		bool flusher;
+		uint32_t start;
+#endif
+
+		node = sys_slist_get(&worker->pending);
+		if (node != NULL) {
+			worker_popped_locked(worker);
+			work = CONTAINER_OF(node, struct k_work, node);
+		} else {
+			work = pool_steal_locked(queue, worker);
+		}
+
+		if (work == NULL) {
+			/* Nothing to run or steal.  If no other worker is
+			 * busy either, the queue is drained.
+			 */
+			if ((queue->busy_workers == 0U)
+			    && pool_is_empty_locked(queue)
+			    && flag_test_and_clear(&queue->flags,
+						   K_WORK_QUEUE_DRAIN_BIT)) {
+				(void)z_sched_wake_all(&queue->drainq, 1, NULL);
+			}
+
+			worker->idle = true;
+			(void)z_sched_wait(&lock, key, &worker->notifyq,
+					   K_FOREVER, NULL);
+			continue;
+		}
+
+		flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		queue->busy_workers++;
+		worker->current = work;
+		flag_set(&work->flags, K_WORK_RUNNING_BIT);
+		flag_clear(&work->flags, K_WORK_QUEUED_BIT);
+		handler = work->handler;
+
+#ifdef CONFIG_WORKQUEUE_POOL_STATS
+		/* Flushers are internal, keep them out of the statistics. */
+		flusher = flag_test(&work->flags, K_WORK_FLUSHING_BIT);
+		start = k_cycle_get_32();
+		if (!flusher) {
+			uint32_t wait = start - work->queued_at;
+
+			worker->stats.executed++;
+			worker->stats.total_wait_cycles += wait;
+			worker->stats.max_wait_cycles = MAX(worker->stats.max_wait_cycles, wait);
+		}
+#endif
+
+		k_spin_unlock(&lock, key);
+
+		__ASSERT_NO_MSG(handler != NULL);
+		handler(work);
+
+		key = k_spin_lock(&lock);
+
+#ifdef CONFIG_WORKQUEUE_POOL_STATS
+		if (!flusher) {
+			uint32_t run = k_cycle_get_32() - start;
+
+			worker->stats.total_run_cycles += run;
+			worker->stats.max_run_cycles = MAX(worker->stats.max_run_cycles, run);
+		}
+#endif
+
+		flag_clear(&work->flags, K_WORK_RUNNING_BIT);
+		if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+			finalize_flush_locked(work);
+		}
+		if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
+			finalize_cancel_locked(work);
+		}
+
+		worker->current = NULL;
+		if (--queue->busy_workers == 0U) {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
+		k_spin_unlock(&lock, key);
+
+		if (yield) {
+			k_yield();
+		}
+	}
+}
+
+void k_work_queue_pool_start(struct k_work_q *queue,
+			     struct k_work_q_worker *workers,
+			     k_thread_stack_t *stacks, int num_workers,
+			     size_t stack_size, int prio,
+			     const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(workers);
+	__ASSERT_NO_MSG(stacks);
+	__ASSERT_NO_MSG((num_workers > 0) && (num_workers <= UINT8_MAX));
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+	uint32_t flags = K_WORK_QUEUE_STARTED;
+	size_t stack_len = K_THREAD_STACK_LEN(stack_size);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	sys_slist_init(&queue->pending);
+	z_waitq_init(&queue->notifyq);
+	z_waitq_init(&queue->drainq);
+
+	queue->workers = workers;
+	queue->num_workers = num_workers;
+	queue->next_worker = 0U;
+	queue->busy_workers = 0U;
+
+	if ((cfg != NULL) && cfg->no_yield) {
+		flags |= K_WORK_QUEUE_NO_YIELD;
+	}
+
+	flags_set(&queue->flags, flags);
+
+	for (int i = 0; i < num_workers; i++) {
+		struct k_work_q_worker *worker = &workers[i];
+		k_thread_stack_t *stack
+			= (k_thread_stack_t *)((uint8_t *)stacks + i * stack_len);
+
+		*worker = (struct k_work_q_worker) {
+			.queue = queue,
+		};
+		sys_slist_init(&worker->pending);
+		z_waitq_init(&worker->notifyq);
+
+		(void)k_thread_create(&worker->thread, stack, stack_size,
+				      pool_worker_main, worker, NULL, NULL,
+				      prio, 0, K_FOREVER);
+
+#ifdef CONFIG_THREAD_NAME
+		if ((cfg != NULL) && (cfg->name != NULL)) {
+			char name[CONFIG_THREAD_MAX_NAME_LEN];
+
+			snprintk(name, sizeof(name), "%s.%d", cfg->name, i);
+			k_thread_name_set(&worker->thread, name);
+		}
+#endif
+
+		if ((cfg != NULL) && (cfg->essential)) {
+			worker->thread.base.user_options |= K_ESSENTIAL;
+		}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((cfg != NULL) && cfg->pin_workers) {
+			(void)k_thread_cpu_pin(&worker->thread, i % arch_num_cpus());
+		}
+#endif
+	}
+
+	for (int i = 0; i < num_workers; i++) {
+		k_thread_start(&workers[i].thread);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
+}
+
+#ifdef CONFIG_WORKQUEUE_POOL_STATS
+
+int k_work_queue_pool_stats_get(struct k_work_q *queue, int worker,
+				struct k_work_q_worker_stats *stats)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(stats);
+
+	if ((queue->workers == NULL) || (worker < 0)
+	    || (worker >= queue->num_workers)) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = queue->workers[worker].stats;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int k_work_queue_pool_stats_reset(struct k_work_q *queue)
+{
+	__ASSERT_NO_MSG(queue);
+
+	if (queue->workers == NULL) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (int i = 0; i < queue->num_workers; i++) {
+		struct k_work_q_worker_stats *stats = &queue->workers[i].stats;
+
+		*stats = (struct k_work_q_worker_stats) {
+			.depth = stats->depth,
+			.max_depth = stats->depth,
+		};
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+#endif /* CONFIG_WORKQUEUE_POOL_STATS */
+
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 
 /* Timeout handler for delayable work.
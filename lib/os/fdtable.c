@@ -27,6 +27,10 @@
 
 struct stat;
 
+#ifdef CONFIG_ZVFS_EPOLL
+void zvfs_epoll_fd_closed(int fd);
+#endif
+
 struct fd_entry {
 	void *obj;
 	const struct fd_op_vtable *vtable;
@@ -386,6 +390,11 @@ int zvfs_close(int fd)
 		return -1;
 	}
 
+#ifdef CONFIG_ZVFS_EPOLL
+	/* Drop the fd from every epoll interest set before its object is gone */
+	zvfs_epoll_fd_closed(fd);
+#endif
+
 	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
 	if (fdtable[fd].vtable->close != NULL) {
 		/* close() is optional - e.g. stdinout_fd_op_vtable */
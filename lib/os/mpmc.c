@@ -0,0 +1,269 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/mpmc.h>
+#include <limits.h>
+#include <string.h>
+
+/* This is Dmitry Vyukov's bounded MPMC queue. Each slot has a sequence
+ * number, which is stored relative to the first position of the lap around
+ * the ring (position & ~mask) so that a zeroed buffer is an empty ring.
+ * For the position a thread is claiming, a slot reading:
+ *
+ * - 0 is free, for a producer to fill,
+ * - 1 holds an element, for a consumer to take,
+ * - anything lower still belongs to the previous lap (full or empty),
+ * - anything higher was claimed by another thread, reload the position.
+ *
+ * This needs at least two slots, to tell the laps apart.
+ */
+
+typedef bool (*mpmc_op_t)(struct sys_mpmc *ring, void *data);
+
+static inline atomic_t *slot_get(struct sys_mpmc *ring, unsigned long pos)
+{
+	return (atomic_t *)&ring->buffer[(pos & ring->mask) * ring->slot_size];
+}
+
+static inline long slot_state(struct sys_mpmc *ring, atomic_t *slot, unsigned long pos)
+{
+	return (long)((unsigned long)atomic_get(slot) - (pos & ~ring->mask));
+}
+
+static bool try_put(struct sys_mpmc *ring, void *data)
+{
+	unsigned long pos = (unsigned long)atomic_get(&ring->head);
+	atomic_t *slot;
+	long state;
+
+	while (true) {
+		slot = slot_get(ring, pos);
+		state = slot_state(ring, slot, pos);
+
+		if (state < 0) {
+			return false;
+		}
+
+		if ((state == 0) &&
+		    atomic_cas(&ring->head, (atomic_val_t)pos, (atomic_val_t)(pos + 1))) {
+			break;
+		}
+
+		pos = (unsigned long)atomic_get(&ring->head);
+	}
+
+	memcpy(slot + 1, data, ring->elem_size);
+	(void)atomic_set(slot, (atomic_val_t)((pos & ~ring->mask) + 1));
+
+	return true;
+}
+
+static bool try_get(struct sys_mpmc *ring, void *data)
+{
+	unsigned long pos = (unsigned long)atomic_get(&ring->tail);
+	atomic_t *slot;
+	long state;
+
+	while (true) {
+		slot = slot_get(ring, pos);
+		state = slot_state(ring, slot, pos) - 1;
+
+		if (state < 0) {
+			return false;
+		}
+
+		if ((state == 0) &&
+		    atomic_cas(&ring->tail, (atomic_val_t)pos, (atomic_val_t)(pos + 1))) {
+			break;
+		}
+
+		pos = (unsigned long)atomic_get(&ring->tail);
+	}
+
+	memcpy(data, slot + 1, ring->elem_size);
+
+	/* Free it for the next lap */
+	(void)atomic_set(slot, (atomic_val_t)((pos & ~ring->mask) + ring->mask + 1));
+
+	return true;
+}
+
+#ifdef CONFIG_USERSPACE
+static void waitq_init(struct z_mpmc_waitq *wq)
+{
+	(void)atomic_set(&wq->futex.val, 0);
+}
+
+static atomic_val_t waitq_key(struct z_mpmc_waitq *wq)
+{
+	return atomic_get(&wq->futex.val);
+}
+
+static int waitq_wait(struct z_mpmc_waitq *wq, atomic_val_t key, k_timeout_t timeout)
+{
+	int ret = k_futex_wait(&wq->futex, (int)key, timeout);
+
+	if (ret == -ETIMEDOUT) {
+		return -EAGAIN;
+	}
+
+	/* Changed since the key was taken, have another look */
+	return (ret == -EAGAIN) ? 0 : ret;
+}
+
+static void waitq_wake(struct z_mpmc_waitq *wq)
+{
+	atomic_val_t val;
+
+	/* Kept within what k_futex_wait() can be told to expect */
+	do {
+		val = atomic_get(&wq->futex.val);
+	} while (!atomic_cas(&wq->futex.val, val, (val + 1) & INT_MAX));
+
+	(void)k_futex_wake(&wq->futex, false);
+}
+#else
+static void waitq_init(struct z_mpmc_waitq *wq)
+{
+	k_sem_init(&wq->sem, 0, K_SEM_MAX_LIMIT);
+}
+
+static atomic_val_t waitq_key(struct z_mpmc_waitq *wq)
+{
+	ARG_UNUSED(wq);
+
+	return 0;
+}
+
+static int waitq_wait(struct z_mpmc_waitq *wq, atomic_val_t key, k_timeout_t timeout)
+{
+	ARG_UNUSED(key);
+
+	/* Gives left over from wakeups that were not needed in the end
+	 * just make us have another look.
+	 */
+	int ret = k_sem_take(&wq->sem, timeout);
+
+	return (ret == -EBUSY) ? -EAGAIN : ret;
+}
+
+static void waitq_wake(struct z_mpmc_waitq *wq)
+{
+	k_sem_give(&wq->sem);
+}
+#endif /* CONFIG_USERSPACE */
+
+/* Registering as a waiter before having the last look at the ring means
+ * that whoever changes it next either is seen by that look, or sees us
+ * and wakes us up.
+ */
+static int op_wait(struct sys_mpmc *ring, struct z_mpmc_waitq *wq, mpmc_op_t op, void *data,
+		   k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	atomic_val_t key;
+	int ret;
+
+	(void)atomic_inc(&wq->waiters);
+
+	do {
+		key = waitq_key(wq);
+
+		if (op(ring, data)) {
+			ret = 0;
+			break;
+		}
+
+		ret = waitq_wait(wq, key, sys_timepoint_timeout(end));
+	} while (ret == 0);
+
+	(void)atomic_dec(&wq->waiters);
+
+	return ret;
+}
+
+static inline void op_wake(struct z_mpmc_waitq *wq)
+{
+	if (atomic_get(&wq->waiters) != 0) {
+		waitq_wake(wq);
+	}
+}
+
+int sys_mpmc_init(struct sys_mpmc *ring, void *buf, size_t elem_size, uint32_t max_elems)
+{
+	if ((ring == NULL) || (buf == NULL) || (elem_size == 0U) || (max_elems < 2U) ||
+	    !IS_POWER_OF_TWO(max_elems) || (((uintptr_t)buf % sizeof(atomic_t)) != 0U)) {
+		return -EINVAL;
+	}
+
+	memset(buf, 0, SYS_MPMC_BUF_SIZE(elem_size, max_elems));
+
+	(void)atomic_set(&ring->head, 0);
+	(void)atomic_set(&ring->tail, 0);
+	ring->buffer = buf;
+	ring->elem_size = elem_size;
+	ring->slot_size = Z_MPMC_SLOT_SIZE(elem_size);
+	ring->mask = max_elems - 1U;
+
+	(void)atomic_set(&ring->not_empty.waiters, 0);
+	(void)atomic_set(&ring->not_full.waiters, 0);
+	waitq_init(&ring->not_empty);
+	waitq_init(&ring->not_full);
+
+	return 0;
+}
+
+int sys_mpmc_put(struct sys_mpmc *ring, const void *data, k_timeout_t timeout)
+{
+	int ret = 0;
+
+	if (!try_put(ring, (void *)data)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		ret = op_wait(ring, &ring->not_full, try_put, (void *)data, timeout);
+	}
+
+	if (ret == 0) {
+		op_wake(&ring->not_empty);
+	}
+
+	return ret;
+}
+
+int sys_mpmc_get(struct sys_mpmc *ring, void *data, k_timeout_t timeout)
+{
+	int ret = 0;
+
+	if (!try_get(ring, data)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		ret = op_wait(ring, &ring->not_empty, try_get, data, timeout);
+	}
+
+	if (ret == 0) {
+		op_wake(&ring->not_full);
+	}
+
+	return ret;
+}
+
+uint32_t sys_mpmc_num_used_get(struct sys_mpmc *ring)
+{
+	unsigned long tail = (unsigned long)atomic_get(&ring->tail);
+	unsigned long head = (unsigned long)atomic_get(&ring->head);
+	unsigned long used = head - tail;
+
+	/* The positions were read at different times */
+	if ((long)used < 0) {
+		return 0;
+	}
+
+	return (uint32_t)MIN(used, ring->mask + 1U);
+}
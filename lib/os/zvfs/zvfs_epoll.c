@@ -0,0 +1,609 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/zvfs/epoll.h>
+
+/* Enough for a native socket polled for input and output, plus the extra
+ * event the TLS layer adds while a DTLS handshake is in progress.
+ */
+#define ZVFS_EPOLL_EVENTS_PER_FD 3
+
+/* Batch of ready events taken from the poll set at once */
+#define ZVFS_EPOLL_READY_BATCH 8
+
+#define ZVFS_EPOLL_ALWAYS (ZVFS_POLLERR | ZVFS_POLLHUP | ZVFS_POLLNVAL)
+
+#define ZVFS_EPOLL_FLAGS (ZVFS_EPOLLET | ZVFS_EPOLLONESHOT)
+
+struct zvfs_epoll_entry {
+	/* On the pending list while in use, on the free list otherwise */
+	sys_dnode_t node;
+	struct k_poll_event pev[ZVFS_EPOLL_EVENTS_PER_FD];
+	union zvfs_epoll_data data;
+	int fd;
+	uint16_t events;
+	uint8_t num_pev;
+	/* ZVFS_EPOLLET: stays armed, reported on new signals only */
+	bool edge;
+	/* ZVFS_EPOLLONESHOT: disarmed once reported */
+	bool oneshot;
+};
+
+struct zvfs_epoll {
+	struct k_poll_set set;
+	/* Entries to look at on the next wait: signalled by the poll set, or
+	 * reported ready by the file descriptor without a kernel object.
+	 */
+	sys_dlist_t pending;
+	sys_dlist_t free;
+	struct zvfs_epoll_entry entries[CONFIG_ZVFS_EPOLL_ENTRIES_MAX];
+	/* Entry index + 1 of each file descriptor, 0 if not in the set */
+	uint16_t fd_map[CONFIG_ZVFS_OPEN_MAX];
+	bool in_use;
+};
+
+BUILD_ASSERT(CONFIG_ZVFS_EPOLL_ENTRIES_MAX < UINT16_MAX);
+
+SYS_BITARRAY_DEFINE_STATIC(epolls_bitarray, CONFIG_ZVFS_EPOLL_MAX);
+static struct zvfs_epoll epolls[CONFIG_ZVFS_EPOLL_MAX];
+static const struct fd_op_vtable zvfs_epoll_fd_vtable;
+
+/* Protects the interest sets and pending lists of all instances. It is never
+ * held while blocking on a poll set. When both are needed, the mutex of the
+ * target file descriptor is taken first: zvfs_close() may run with the mutex
+ * of another descriptor held (e.g. TLS closing its underlying socket).
+ */
+static K_MUTEX_DEFINE(epoll_lock);
+
+static struct zvfs_epoll_entry *zvfs_epoll_event_entry(struct zvfs_epoll *ep,
+						       struct k_poll_event *event)
+{
+	size_t idx = ((uintptr_t)event - (uintptr_t)ep->entries) / sizeof(ep->entries[0]);
+
+	__ASSERT_NO_MSG(idx < ARRAY_SIZE(ep->entries));
+
+	return &ep->entries[idx];
+}
+
+static struct zvfs_epoll_entry *zvfs_epoll_find(struct zvfs_epoll *ep, int fd)
+{
+	uint16_t idx = ep->fd_map[fd];
+
+	return (idx == 0) ? NULL : &ep->entries[idx - 1];
+}
+
+static void zvfs_epoll_disarm(struct zvfs_epoll *ep, struct zvfs_epoll_entry *e)
+{
+	for (int i = 0; i < e->num_pev; i++) {
+		k_poll_set_remove(&ep->set, &e->pev[i]);
+	}
+
+	e->num_pev = 0;
+}
+
+/* must be called with the mutex of the target fd held */
+static int zvfs_epoll_arm(struct zvfs_epoll *ep, struct zvfs_epoll_entry *e,
+			  const struct fd_op_vtable *vtable, void *ctx)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = e->fd,
+		.events = e->events,
+	};
+	struct k_poll_event *pev = e->pev;
+	int ret;
+
+	ret = zvfs_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				      e->pev + ARRAY_SIZE(e->pev));
+	if (ret != 0 && ret != -EALREADY) {
+		return ret;
+	}
+
+	e->num_pev = pev - e->pev;
+	for (int i = 0; i < e->num_pev; i++) {
+		if (e->edge) {
+			k_poll_set_add_persistent(&ep->set, &e->pev[i]);
+		} else {
+			k_poll_set_add(&ep->set, &e->pev[i]);
+		}
+	}
+
+	return ret;
+}
+
+static void zvfs_epoll_mark_pending(struct zvfs_epoll *ep, struct zvfs_epoll_entry *e)
+{
+	if (!sys_dnode_is_linked(&e->node)) {
+		sys_dlist_append(&ep->pending, &e->node);
+	}
+}
+
+static void zvfs_epoll_free_entry(struct zvfs_epoll *ep, struct zvfs_epoll_entry *e)
+{
+	zvfs_epoll_disarm(ep, e);
+
+	if (sys_dnode_is_linked(&e->node)) {
+		sys_dlist_remove(&e->node);
+	}
+
+	ep->fd_map[e->fd] = 0;
+	e->fd = -1;
+	sys_dlist_append(&ep->free, &e->node);
+}
+
+/* Edge-triggered entries stay armed: their objects are only sampled through
+ * a copy of the events, the armed events belong to the poll set.
+ *
+ * must be called with the mutex of the target fd held
+ */
+static uint32_t zvfs_epoll_update_edge(struct zvfs_epoll_entry *e,
+				       const struct fd_op_vtable *vtable, void *ctx)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = e->fd,
+		.events = e->events,
+	};
+	struct k_poll_event sample[ZVFS_EPOLL_EVENTS_PER_FD];
+	struct k_poll_event *pev = sample;
+	int ret;
+
+	for (int i = 0; i < e->num_pev; i++) {
+		k_poll_event_init(&sample[i], e->pev[i].type, K_POLL_MODE_NOTIFY_ONLY,
+				  e->pev[i].obj);
+	}
+
+	(void)k_poll(sample, e->num_pev, K_NO_WAIT);
+
+	ret = zvfs_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_UPDATE, &pfd, &pev);
+	if (ret != 0) {
+		pfd.revents = (ret == -EAGAIN) ? 0 : ZVFS_POLLERR;
+	}
+
+	return pfd.revents & (e->events | ZVFS_EPOLL_ALWAYS);
+}
+
+/* Collect the poll result of an entry and register it again. Sets @p again
+ * if the fd reports itself ready without any kernel object to wait on.
+ *
+ * must be called with the mutex of the target fd held
+ */
+static uint32_t zvfs_epoll_update(struct zvfs_epoll *ep, struct zvfs_epoll_entry *e,
+				  const struct fd_op_vtable *vtable, void *ctx, bool *again)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = e->fd,
+		.events = e->events,
+	};
+	struct k_poll_event *pev = e->pev;
+	int num_pev = e->num_pev;
+	int ret;
+
+	*again = false;
+
+	if (e->edge) {
+		return zvfs_epoll_update_edge(e, vtable, ctx);
+	}
+
+	zvfs_epoll_disarm(ep, e);
+
+	/* A state delivered by the poll set may be stale by now, e.g. if the
+	 * data was consumed after the fd got re-armed, so sample the objects
+	 * again before asking the fd for its poll result.
+	 */
+	for (int i = 0; i < num_pev; i++) {
+		e->pev[i].state = K_POLL_STATE_NOT_READY;
+	}
+
+	(void)k_poll(e->pev, num_pev, K_NO_WAIT);
+
+	ret = zvfs_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_UPDATE, &pfd, &pev);
+	if (ret != 0) {
+		/* -EAGAIN: woken up, but nothing to report yet */
+		pfd.revents = (ret == -EAGAIN) ? 0 : ZVFS_POLLERR;
+	}
+
+	ret = zvfs_epoll_arm(ep, e, vtable, ctx);
+	if (ret == -EALREADY) {
+		*again = true;
+	} else if (ret < 0) {
+		pfd.revents |= ZVFS_POLLERR;
+	}
+
+	return pfd.revents & (e->events | ZVFS_EPOLL_ALWAYS);
+}
+
+/* must be called with the mutex of the target fd held */
+static int zvfs_epoll_add(struct zvfs_epoll *ep, int fd, struct zvfs_epoll_event *event,
+			  const struct fd_op_vtable *vtable, void *ctx)
+{
+	struct zvfs_epoll_entry *e;
+	int ret;
+
+	if (zvfs_epoll_find(ep, fd) != NULL) {
+		return -EEXIST;
+	}
+
+	e = (struct zvfs_epoll_entry *)sys_dlist_get(&ep->free);
+	if (e == NULL) {
+		return -ENOMEM;
+	}
+
+	e->fd = fd;
+	e->events = event->events & ~ZVFS_EPOLL_FLAGS;
+	e->edge = (event->events & ZVFS_EPOLLET) != 0U;
+	e->oneshot = (event->events & ZVFS_EPOLLONESHOT) != 0U;
+	e->data = event->data;
+	e->num_pev = 0;
+
+	ret = zvfs_epoll_arm(ep, e, vtable, ctx);
+	if (ret == -EXDEV) {
+		/* Offloaded sockets only implement their own poll() */
+		ret = -EPERM;
+	}
+
+	if (ret != 0 && ret != -EALREADY) {
+		e->fd = -1;
+		sys_dlist_append(&ep->free, &e->node);
+		return ret;
+	}
+
+	ep->fd_map[fd] = (e - ep->entries) + 1;
+
+	if (ret == -EALREADY) {
+		zvfs_epoll_mark_pending(ep, e);
+	}
+
+	return 0;
+}
+
+/* must be called with the mutex of the target fd held */
+static int zvfs_epoll_mod(struct zvfs_epoll *ep, int fd, struct zvfs_epoll_event *event,
+			  const struct fd_op_vtable *vtable, void *ctx)
+{
+	struct zvfs_epoll_entry *e;
+	int ret;
+
+	e = zvfs_epoll_find(ep, fd);
+	if (e == NULL) {
+		return -ENOENT;
+	}
+
+	/* Also re-enables an entry disabled by ZVFS_EPOLLONESHOT */
+	zvfs_epoll_disarm(ep, e);
+	e->events = event->events & ~ZVFS_EPOLL_FLAGS;
+	e->edge = (event->events & ZVFS_EPOLLET) != 0U;
+	e->oneshot = (event->events & ZVFS_EPOLLONESHOT) != 0U;
+	e->data = event->data;
+
+	ret = zvfs_epoll_arm(ep, e, vtable, ctx);
+	if (ret == -EALREADY) {
+		zvfs_epoll_mark_pending(ep, e);
+		ret = 0;
+	}
+
+	return ret;
+}
+
+static int zvfs_epoll_close_op(void *obj)
+{
+	struct zvfs_epoll *ep = obj;
+	int err;
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(ep->entries); i++) {
+		if (ep->entries[i].fd >= 0) {
+			zvfs_epoll_disarm(ep, &ep->entries[i]);
+		}
+	}
+
+	ep->in_use = false;
+
+	k_mutex_unlock(&epoll_lock);
+
+	err = sys_bitarray_free(&epolls_bitarray, 1, ep - epolls);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+
+	return 0;
+}
+
+static ssize_t zvfs_epoll_rw_op(void *obj, const void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t zvfs_epoll_read_op(void *obj, void *buf, size_t sz)
+{
+	return zvfs_epoll_rw_op(obj, buf, sz);
+}
+
+static int zvfs_epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable = {
+	.read = zvfs_epoll_read_op,
+	.write = zvfs_epoll_rw_op,
+	.close = zvfs_epoll_close_op,
+	.ioctl = zvfs_epoll_ioctl_op,
+};
+
+/* Called by zvfs_close() before a file descriptor goes away */
+void zvfs_epoll_fd_closed(int fd)
+{
+	struct zvfs_epoll_entry *e;
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (!epolls[i].in_use) {
+			continue;
+		}
+
+		e = zvfs_epoll_find(&epolls[i], fd);
+		if (e != NULL) {
+			zvfs_epoll_free_entry(&epolls[i], e);
+		}
+	}
+
+	k_mutex_unlock(&epoll_lock);
+}
+
+/*
+ * Public-facing API
+ */
+
+int zvfs_epoll_create(int flags)
+{
+	struct zvfs_epoll *ep;
+	size_t offset;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sys_bitarray_alloc(&epolls_bitarray, 1, &offset) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		sys_bitarray_free(&epolls_bitarray, 1, offset);
+		return -1;
+	}
+
+	ep = &epolls[offset];
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	k_poll_set_init(&ep->set);
+	sys_dlist_init(&ep->pending);
+	sys_dlist_init(&ep->free);
+
+	for (size_t i = 0; i < ARRAY_SIZE(ep->entries); i++) {
+		ep->entries[i].fd = -1;
+		ep->entries[i].num_pev = 0;
+		sys_dnode_init(&ep->entries[i].node);
+		sys_dlist_append(&ep->free, &ep->entries[i].node);
+	}
+
+	memset(ep->fd_map, 0, sizeof(ep->fd_map));
+	ep->in_use = true;
+
+	k_mutex_unlock(&epoll_lock);
+
+	zvfs_finalize_fd(fd, ep, &zvfs_epoll_fd_vtable);
+
+	return fd;
+}
+
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable = NULL;
+	struct k_mutex *lock = NULL;
+	struct zvfs_epoll_entry *e;
+	struct zvfs_epoll *ep;
+	void *ctx = NULL;
+	int ret;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EBADF);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (fd < 0 || fd >= ARRAY_SIZE(ep->fd_map) || fd == epfd) {
+		errno = (fd == epfd) ? EINVAL : EBADF;
+		return -1;
+	}
+
+	if (op != ZVFS_EPOLL_CTL_DEL) {
+		if (event == NULL) {
+			errno = EFAULT;
+			return -1;
+		}
+
+		ctx = zvfs_get_fd_obj_and_vtable(fd, &vtable, &lock);
+		if (ctx == NULL) {
+			return -1;
+		}
+
+		(void)k_mutex_lock(lock, K_FOREVER);
+	}
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	switch (op) {
+	case ZVFS_EPOLL_CTL_ADD:
+		ret = zvfs_epoll_add(ep, fd, event, vtable, ctx);
+		break;
+	case ZVFS_EPOLL_CTL_MOD:
+		ret = zvfs_epoll_mod(ep, fd, event, vtable, ctx);
+		break;
+	case ZVFS_EPOLL_CTL_DEL:
+		e = zvfs_epoll_find(ep, fd);
+		if (e == NULL) {
+			ret = -ENOENT;
+		} else {
+			zvfs_epoll_free_entry(ep, e);
+			ret = 0;
+		}
+		break;
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	if (lock != NULL) {
+		k_mutex_unlock(lock);
+	}
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout)
+{
+	struct k_poll_event *ready[ZVFS_EPOLL_READY_BATCH];
+	const struct fd_op_vtable *vtable;
+	struct zvfs_epoll_entry *e;
+	struct zvfs_epoll *ep;
+	struct k_mutex *lock;
+	k_timeout_t wait_timeout;
+	k_timepoint_t end;
+	sys_dlist_t again;
+	uint32_t revents;
+	bool still_ready;
+	int count = 0;
+	void *ctx;
+	int fd;
+	int n;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EBADF);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	while (true) {
+		/* Only the fds signalled since the last call are looked at */
+		do {
+			n = k_poll_set_wait(&ep->set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+			for (int i = 0; i < n; i++) {
+				zvfs_epoll_mark_pending(ep, zvfs_epoll_event_entry(ep, ready[i]));
+			}
+		} while (n == ARRAY_SIZE(ready));
+
+		sys_dlist_init(&again);
+
+		while (count < maxevents) {
+			e = (struct zvfs_epoll_entry *)sys_dlist_get(&ep->pending);
+			if (e == NULL) {
+				break;
+			}
+
+			fd = e->fd;
+			ctx = zvfs_get_fd_obj_and_vtable(fd, &vtable, &lock);
+			if (ctx == NULL) {
+				continue;
+			}
+
+			/* Respect the lock order, then make sure the entry was
+			 * neither removed nor queued again in the meantime.
+			 */
+			k_mutex_unlock(&epoll_lock);
+			(void)k_mutex_lock(lock, K_FOREVER);
+			(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+			if (zvfs_epoll_find(ep, fd) != e || sys_dnode_is_linked(&e->node)) {
+				k_mutex_unlock(lock);
+				continue;
+			}
+
+			revents = zvfs_epoll_update(ep, e, vtable, ctx, &still_ready);
+
+			k_mutex_unlock(lock);
+
+			if (revents != 0) {
+				events[count].events = revents;
+				events[count].data = e->data;
+				count++;
+
+				if (e->oneshot) {
+					/* Disabled until ZVFS_EPOLL_CTL_MOD */
+					zvfs_epoll_disarm(ep, e);
+					still_ready = false;
+				}
+			}
+
+			/* Level-triggered: an fd that stays ready on an object is
+			 * queued again by the poll set when it is re-armed, the
+			 * others have to be looked at again on the next call.
+			 * Edge-triggered fds are only reported on a new signal.
+			 */
+			if (still_ready) {
+				sys_dlist_append(&again, &e->node);
+			}
+		}
+
+		while (!sys_dlist_is_empty(&again)) {
+			sys_dlist_append(&ep->pending, sys_dlist_get(&again));
+		}
+
+		if (count > 0) {
+			break;
+		}
+
+		wait_timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(wait_timeout, K_NO_WAIT)) {
+			break;
+		}
+
+		k_mutex_unlock(&epoll_lock);
+		n = k_poll_set_wait(&ep->set, NULL, 0, wait_timeout);
+		(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+		if (n == -EAGAIN && sys_dlist_is_empty(&ep->pending)) {
+			break;
+		}
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	return count;
+}
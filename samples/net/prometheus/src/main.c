@@ -46,28 +46,44 @@ static int dyn_handler(struct http_client_ctx *client, enum http_data_status sta
 		       const struct http_request_ctx *request_ctx,
 		       struct http_response_ctx *response_ctx, void *user_data)
 {
-	int ret;
+	static struct prometheus_format_context format_ctx;
 	static uint8_t prom_buffer[256];
+	static bool formatting;
+	size_t len;
+	int ret;
+
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		formatting = false;
+		return 0;
+	}
 
 	if (status == HTTP_SERVER_DATA_FINAL) {
 
-		/* incrase counter per request */
-		prometheus_counter_inc(prom_context.counter);
+		if (!formatting) {
+			/* incrase counter per request */
+			prometheus_counter_inc(prom_context.counter);
 
-		/* clear buffer */
-		(void)memset(prom_buffer, 0, sizeof(prom_buffer));
+			(void)prometheus_format_exposition_init(&format_ctx,
+								prom_context.collector);
+			formatting = true;
+		}
 
-		/* format exposition data */
-		ret = prometheus_format_exposition(prom_context.collector, prom_buffer,
-						   sizeof(prom_buffer));
-		if (ret < 0) {
+		/* format exposition data, one chunk per call */
+		ret = prometheus_format_exposition_chunk(&format_ctx, prom_buffer,
+							 sizeof(prom_buffer), &len);
+		if (ret < 0 && ret != -EAGAIN) {
 			LOG_ERR("Cannot format exposition data (%d)", ret);
+			formatting = false;
 			return ret;
 		}
 
 		response_ctx->body = prom_buffer;
-		response_ctx->body_len = strlen(prom_buffer);
-		response_ctx->final_chunk = true;
+		response_ctx->body_len = len;
+
+		if (ret == 0) {
+			response_ctx->final_chunk = true;
+			formatting = false;
+		}
 	}
 
 	return 0;
@@ -30,39 +30,51 @@ extern struct http_service_desc test_http_service;
 
 static struct prometheus_counter *http_request_counter;
 static struct prometheus_collector *stats_collector;
-static struct prometheus_collector_walk_context walk_ctx;
+static struct prometheus_format_context format_ctx;
 
 static int stats_handler(struct http_client_ctx *client, enum http_data_status status,
 			 const struct http_request_ctx *request_ctx,
 			 struct http_response_ctx *response_ctx, void *user_data)
 {
 	int ret;
-	static uint8_t prom_buffer[1024];
+	size_t len;
+	static uint8_t prom_buffer[256];
+	static bool formatting;
+
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		formatting = false;
+		return 0;
+	}
 
 	if (status == HTTP_SERVER_DATA_FINAL) {
 
-		/* incrase counter per request */
-		prometheus_counter_inc(http_request_counter);
+		if (!formatting) {
+			/* incrase counter per request */
+			prometheus_counter_inc(http_request_counter);
 
-		(void)memset(prom_buffer, 0, sizeof(prom_buffer));
+			ret = prometheus_format_exposition_init(user_data, stats_collector);
+			if (ret < 0) {
+				LOG_ERR("Cannot initialize format context (%d)", ret);
+				return ret;
+			}
 
-		ret = prometheus_collector_walk_metrics(user_data,
-							prom_buffer,
-							sizeof(prom_buffer));
+			formatting = true;
+		}
+
+		ret = prometheus_format_exposition_chunk(user_data, prom_buffer,
+							 sizeof(prom_buffer), &len);
 		if (ret < 0 && ret != -EAGAIN) {
 			LOG_ERR("Cannot format exposition data (%d)", ret);
+			formatting = false;
 			return ret;
 		}
 
 		response_ctx->body = prom_buffer;
-		response_ctx->body_len = strlen(prom_buffer);
+		response_ctx->body_len = len;
 
 		if (ret == 0) {
 			response_ctx->final_chunk = true;
-			ret = prometheus_collector_walk_init(&walk_ctx, stats_collector);
-			if (ret < 0) {
-				LOG_ERR("Cannot initialize walk context (%d)", ret);
-			}
+			formatting = false;
 		}
 	}
 
@@ -76,7 +88,7 @@ struct http_resource_detail_dynamic stats_resource_detail = {
 			.content_type = "text/plain",
 	},
 	.cb = stats_handler,
-	.user_data = &walk_ctx,
+	.user_data = &format_ctx,
 };
 
 HTTP_RESOURCE_DEFINE(stats_resource, test_http_service, "/statistics", &stats_resource_detail);
@@ -90,8 +102,6 @@ int init_stats(struct prometheus_counter *counter)
 		return -EINVAL;
 	}
 
-	(void)prometheus_collector_walk_init(&walk_ctx, stats_collector);
-
 	http_request_counter = counter;
 
 	return 0;
@@ -171,13 +171,142 @@ static int errno_to_lfs(int error)
 
 #ifdef CONFIG_FS_LITTLEFS_FMP_DEV
 
+#ifdef CONFIG_FS_LITTLEFS_READ_AHEAD
+/* Read-ahead buffers, shared by all open files of all mounted file systems.
+ * littlefs reads files through the per-file cache, one cache_size chunk at
+ * a time. A buffer also tracks where the last read it saw ended, so a read
+ * starting there is recognized as sequential and the buffer is refilled
+ * with a larger chunk that serves the following reads from RAM.
+ */
+struct lfs_ra_buf {
+	const struct flash_area *fa;
+	/* Partition offset of the buffered data */
+	size_t offset;
+	/* Number of valid bytes in data */
+	size_t len;
+	/* End of the last read served by or recorded in this buffer */
+	size_t next_offset;
+	uint32_t last_use;
+	uint8_t data[CONFIG_FS_LITTLEFS_READ_AHEAD_SIZE] __aligned(4);
+};
+
+static struct lfs_ra_buf lfs_ra_bufs[CONFIG_FS_LITTLEFS_READ_AHEAD_BUFFERS];
+static uint32_t lfs_ra_use_cnt;
+static K_MUTEX_DEFINE(lfs_ra_lock);
+
+static struct lfs_ra_buf *lfs_ra_find(const struct flash_area *fa, size_t offset,
+				      size_t size)
+{
+	struct lfs_ra_buf *victim = &lfs_ra_bufs[0];
+
+	/* Look for a buffer holding the data or expecting this read, else
+	 * return the least recently used buffer.
+	 */
+	for (size_t i = 0; i < ARRAY_SIZE(lfs_ra_bufs); i++) {
+		struct lfs_ra_buf *rab = &lfs_ra_bufs[i];
+
+		if ((rab->fa == fa) &&
+		    (((offset >= rab->offset) && (offset + size <= rab->offset + rab->len)) ||
+		     (offset == rab->next_offset))) {
+			return rab;
+		}
+
+		if (rab->last_use < victim->last_use) {
+			victim = rab;
+		}
+	}
+
+	return victim;
+}
+
+static int lfs_ra_read(const struct lfs_config *c, const struct flash_area *fa,
+		       size_t offset, void *buffer, size_t size)
+{
+	struct lfs_ra_buf *rab;
+	size_t block_end;
+	int rc = 0;
+
+	k_mutex_lock(&lfs_ra_lock, K_FOREVER);
+
+	rab = lfs_ra_find(fa, offset, size);
+	rab->last_use = ++lfs_ra_use_cnt;
+
+	if ((rab->fa == fa) && (offset >= rab->offset) &&
+	    (offset + size <= rab->offset + rab->len)) {
+		/* Hit */
+		memcpy(buffer, &rab->data[offset - rab->offset], size);
+	} else if ((rab->fa == fa) && (offset == rab->next_offset) &&
+		   (size < sizeof(rab->data))) {
+		/* Sequential read, fetch ahead up to the end of the block */
+		block_end = ROUND_DOWN(offset, c->block_size) + c->block_size;
+
+		rab->len = 0;
+		rab->offset = offset;
+		rc = flash_area_read(fa, offset, rab->data,
+				     MIN(sizeof(rab->data), block_end - offset));
+		if (rc == 0) {
+			rab->len = MIN(sizeof(rab->data), block_end - offset);
+			memcpy(buffer, rab->data, size);
+		}
+	} else {
+		/* Random read, only remember where it ended */
+		rc = flash_area_read(fa, offset, buffer, size);
+		rab->fa = fa;
+		rab->len = 0;
+	}
+
+	rab->next_offset = offset + size;
+
+	k_mutex_unlock(&lfs_ra_lock);
+
+	return rc;
+}
+
+static void lfs_ra_invalidate(const struct flash_area *fa, size_t offset, size_t size)
+{
+	k_mutex_lock(&lfs_ra_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(lfs_ra_bufs); i++) {
+		struct lfs_ra_buf *rab = &lfs_ra_bufs[i];
+
+		if ((rab->fa == fa) && (offset < rab->offset + rab->len) &&
+		    (rab->offset < offset + size)) {
+			rab->len = 0;
+		}
+	}
+
+	k_mutex_unlock(&lfs_ra_lock);
+}
+
+/* Drop everything buffered for a partition that is no longer mounted, it
+ * may be modified behind our back.
+ */
+static void lfs_ra_release(const struct flash_area *fa)
+{
+	k_mutex_lock(&lfs_ra_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(lfs_ra_bufs); i++) {
+		if (lfs_ra_bufs[i].fa == fa) {
+			lfs_ra_bufs[i].fa = NULL;
+			lfs_ra_bufs[i].len = 0;
+		}
+	}
+
+	k_mutex_unlock(&lfs_ra_lock);
+}
+#endif /* CONFIG_FS_LITTLEFS_READ_AHEAD */
+
 static int lfs_api_read(const struct lfs_config *c, lfs_block_t block,
 			lfs_off_t off, void *buffer, lfs_size_t size)
 {
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
 
+#ifdef CONFIG_FS_LITTLEFS_READ_AHEAD
+	int rc = lfs_ra_read(c, fa, offset, buffer, size);
+#else
 	int rc = flash_area_read(fa, offset, buffer, size);
+#endif
 
 	return errno_to_lfs(rc);
 }
@@ -188,6 +317,10 @@ static int lfs_api_prog(const struct lfs_config *c, lfs_block_t block,
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
 
+#ifdef CONFIG_FS_LITTLEFS_READ_AHEAD
+	lfs_ra_invalidate(fa, offset, size);
+#endif
+
 	int rc = flash_area_write(fa, offset, buffer, size);
 
 	return errno_to_lfs(rc);
@@ -198,6 +331,10 @@ static int lfs_api_erase(const struct lfs_config *c, lfs_block_t block)
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size;
 
+#ifdef CONFIG_FS_LITTLEFS_READ_AHEAD
+	lfs_ra_invalidate(fa, offset, c->block_size);
+#endif
+
 	int rc = flash_area_flatten(fa, offset, c->block_size);
 
 	return errno_to_lfs(rc);
@@ -1015,6 +1152,9 @@ static int littlefs_unmount(struct fs_mount_t *mountp)
 
 #ifdef CONFIG_FS_LITTLEFS_FMP_DEV
 	if (!littlefs_on_blkdev(mountp->flags)) {
+#ifdef CONFIG_FS_LITTLEFS_READ_AHEAD
+		lfs_ra_release(fs->backend);
+#endif
 		flash_area_close(fs->backend);
 	}
 #endif /* CONFIG_FS_LITTLEFS_FMP_DEV */
@@ -745,6 +745,262 @@ gc_done:
 	return rc;
 }
 
+#ifdef CONFIG_NVS_TRANSACTION
+/* Transactions: the data of all entries is written back to back, followed by
+ * their ATEs. The whole is framed by a begin and an end marker ATE, both
+ * stored in the same sector. A begin marker that is not followed by an end
+ * marker identifies an interrupted transaction: it is rolled back by writing
+ * again, for every id it touched, the value that id had before the begin
+ * marker. Restoring that value does not depend on what was written after the
+ * begin marker, so an interrupted roll back can simply be restarted.
+ */
+
+/* add a transaction begin or end marker */
+static int nvs_add_tx_marker_ate(struct nvs_fs *fs, uint8_t part)
+{
+	struct nvs_ate tx_ate;
+
+	tx_ate.id = 0xffff;
+	tx_ate.len = 0U;
+	tx_ate.part = part;
+	tx_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(&tx_ate);
+
+	return nvs_flash_ate_wrt(fs, &tx_ate);
+}
+
+static bool nvs_tx_marker_valid(struct nvs_fs *fs, const struct nvs_ate *entry, uint8_t part)
+{
+	return (nvs_ate_valid(fs, entry) && (entry->id == 0xffff) && (entry->len == 0U) &&
+		(entry->part == part));
+}
+
+/* size of the data of a transaction entry once stored in flash */
+static size_t nvs_tx_data_size(struct nvs_fs *fs, size_t len)
+{
+	if (!len) {
+		return 0;
+	}
+
+	return nvs_al_size(fs, len + NVS_DATA_CRC_SIZE);
+}
+
+/* program consecutive ATEs with a single flash write, entries[0] is stored
+ * at the current ate write address and the next ones below it.
+ */
+static int nvs_flash_ate_wrt_multi(struct nvs_fs *fs, const struct nvs_ate *entries,
+				   size_t count)
+{
+	int rc;
+	size_t ate_size;
+	uint8_t buf[NVS_TX_ATE_CHUNK * NVS_BLOCK_SIZE];
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	(void)memset(buf, fs->flash_parameters->erase_value, count * ate_size);
+	for (size_t i = 0; i < count; i++) {
+		memcpy(&buf[(count - 1 - i) * ate_size], &entries[i], sizeof(struct nvs_ate));
+	}
+
+	rc = nvs_flash_al_wrt(fs, fs->ate_wra - (count - 1) * ate_size, buf,
+			      count * ate_size);
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	for (size_t i = 0; i < count; i++) {
+		fs->lookup_cache[nvs_lookup_cache_pos(entries[i].id)] =
+			fs->ate_wra - i * ate_size;
+	}
+#endif
+	fs->ate_wra -= count * ate_size;
+
+	return rc;
+}
+
+/* search the most recent valid ATE with id, walking from addr towards the
+ * oldest entries. On success ate_addr is the location of the found ATE.
+ * returns 1 if found, 0 if not found, errcode on error
+ */
+static int nvs_find_ate(struct nvs_fs *fs, uint16_t id, uint32_t addr,
+			struct nvs_ate *ate, uint32_t *ate_addr)
+{
+	int rc;
+	uint32_t rd_addr;
+
+	while (1) {
+		rd_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, ate);
+		if (rc) {
+			return rc;
+		}
+		if ((ate->id == id) && (nvs_ate_valid(fs, ate))) {
+			*ate_addr = rd_addr;
+			return 1;
+		}
+		if (addr == fs->ate_wra) {
+			return 0;
+		}
+	}
+}
+
+/* space needed to restore the current value of id when rolling back */
+static int nvs_tx_undo_size(struct nvs_fs *fs, uint16_t id, size_t *size)
+{
+	int rc;
+	struct nvs_ate ate;
+	uint32_t addr, ate_addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	*size = ate_size;
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+
+	if (addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		return 0;
+	}
+#else
+	addr = fs->ate_wra;
+#endif
+
+	rc = nvs_find_ate(fs, id, addr, &ate, &ate_addr);
+	if (rc < 0) {
+		return rc;
+	}
+	if (rc) {
+		*size += nvs_al_size(fs, ate.len);
+	}
+
+	return 0;
+}
+
+/* write again the value id had before the transaction begin marker at
+ * begin_addr, or delete id if it did not exist.
+ */
+static int nvs_tx_restore(struct nvs_fs *fs, uint16_t id, uint32_t begin_addr)
+{
+	int rc;
+	struct nvs_ate ate;
+	uint32_t ate_addr, data_addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	rc = nvs_find_ate(fs, id, begin_addr, &ate, &ate_addr);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if ((!rc) || (!ate.len)) {
+		ate.len = 0U;
+	}
+
+	/* keep room for the end marker and the ATE reserved for deletion */
+	if (fs->ate_wra < (fs->data_wra + nvs_al_size(fs, ate.len) + 2 * ate_size)) {
+		return -ENOSPC;
+	}
+
+	if (!ate.len) {
+		return nvs_flash_wrt_entry(fs, id, NULL, 0);
+	}
+
+	data_addr = (ate_addr & ADDR_SECT_MASK);
+	data_addr += ate.offset;
+
+	ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(&ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, ate.len);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_flash_ate_wrt(fs, &ate);
+}
+
+/* roll back the transaction whose begin marker is stored at begin_addr */
+static int nvs_tx_rollback(struct nvs_fs *fs, uint32_t begin_addr)
+{
+	int rc;
+	struct nvs_ate ate, dup_ate;
+	uint32_t addr, dup_addr, end_addr;
+	size_t ate_size;
+	bool dup;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	end_addr = fs->ate_wra;
+
+	for (addr = begin_addr - ate_size; addr > end_addr; addr -= ate_size) {
+		rc = nvs_flash_ate_rd(fs, addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (!nvs_ate_valid(fs, &ate) || (ate.id == 0xffff)) {
+			continue;
+		}
+
+		/* restore every id only once */
+		dup = false;
+		for (dup_addr = begin_addr - ate_size; dup_addr > addr; dup_addr -= ate_size) {
+			rc = nvs_flash_ate_rd(fs, dup_addr, &dup_ate);
+			if (rc) {
+				return rc;
+			}
+			if ((dup_ate.id == ate.id) && nvs_ate_valid(fs, &dup_ate)) {
+				dup = true;
+				break;
+			}
+		}
+		if (dup) {
+			continue;
+		}
+
+		rc = nvs_tx_restore(fs, ate.id, begin_addr);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return nvs_add_tx_marker_ate(fs, NVS_ATE_PART_TX_END);
+}
+
+/* look in the write sector for a transaction that was interrupted and roll
+ * it back. Only the most recent marker matters: a transaction always ends
+ * before the next one begins.
+ */
+static int nvs_tx_recover(struct nvs_fs *fs)
+{
+	int rc = 0;
+	struct nvs_ate tx_ate;
+	uint32_t addr;
+	size_t ate_size;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	addr = fs->ate_wra + ate_size;
+	while ((addr & ADDR_OFFS_MASK) < (fs->sector_size - ate_size)) {
+		rc = nvs_flash_ate_rd(fs, addr, &tx_ate);
+		if (rc) {
+			break;
+		}
+		if (nvs_tx_marker_valid(fs, &tx_ate, NVS_ATE_PART_TX_END)) {
+			break;
+		}
+		if (nvs_tx_marker_valid(fs, &tx_ate, NVS_ATE_PART_TX_BEGIN)) {
+			LOG_INF("Rolling back interrupted transaction");
+			rc = nvs_tx_rollback(fs, addr);
+			break;
+		}
+		addr += ate_size;
+	}
+
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+#endif /* CONFIG_NVS_TRANSACTION */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -881,7 +1137,8 @@ static int nvs_startup(struct nvs_fs *fs)
 			}
 			if (nvs_ate_valid(fs, &gc_done_ate) &&
 			    (gc_done_ate.id == 0xffff) &&
-			    (gc_done_ate.len == 0U)) {
+			    (gc_done_ate.len == 0U) &&
+			    (gc_done_ate.part == NVS_ATE_PART_NONE)) {
 				gc_done_marker = true;
 				break;
 			}
@@ -1034,6 +1291,14 @@ int nvs_mount(struct nvs_fs *fs)
 		return rc;
 	}
 
+#ifdef CONFIG_NVS_TRANSACTION
+	rc = nvs_tx_recover(fs);
+	if (rc) {
+		LOG_ERR("Transaction recovery failed, returned = %d", rc);
+		return rc;
+	}
+#endif
+
 	/* nvs is ready for use */
 	fs->ready = true;
 
@@ -1387,3 +1652,177 @@ end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return ret;
 }
+
+#ifdef CONFIG_NVS_TRANSACTION
+void nvs_tx_init(struct nvs_tx *tx, struct nvs_fs *fs, struct nvs_tx_entry *entries,
+		 size_t size)
+{
+	tx->fs = fs;
+	tx->entries = entries;
+	tx->size = size;
+	tx->count = 0U;
+}
+
+int nvs_tx_write(struct nvs_tx *tx, uint16_t id, const void *data, size_t len)
+{
+	struct nvs_tx_entry *entry = NULL;
+
+	/* 0xFFFF is a special-purpose identifier */
+	if ((id == 0xFFFF) || (len > UINT16_MAX) || ((len > 0) && (data == NULL))) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < tx->count; i++) {
+		if (tx->entries[i].id == id) {
+			entry = &tx->entries[i];
+			break;
+		}
+	}
+
+	if (entry == NULL) {
+		if (tx->count == tx->size) {
+			return -ENOMEM;
+		}
+		entry = &tx->entries[tx->count++];
+		entry->id = id;
+	}
+
+	entry->data = data;
+	entry->len = len;
+
+	return 0;
+}
+
+int nvs_tx_delete(struct nvs_tx *tx, uint16_t id)
+{
+	return nvs_tx_write(tx, id, NULL, 0);
+}
+
+void nvs_tx_abort(struct nvs_tx *tx)
+{
+	tx->count = 0U;
+}
+
+int nvs_tx_commit(struct nvs_tx *tx)
+{
+	int rc, gc_count;
+	struct nvs_fs *fs = tx->fs;
+	const struct nvs_tx_entry *entry;
+	struct nvs_ate ates[NVS_TX_ATE_CHUNK];
+	uint32_t begin_addr, data_addr;
+	size_t ate_size, required_space, undo_size, chunk;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	if (tx->count == 0U) {
+		return 0;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	/* Besides the entries and the begin and end markers, keep room to roll
+	 * back the transaction in the same sector.
+	 */
+	required_space = 2 * ate_size;
+	for (size_t i = 0; i < tx->count; i++) {
+		entry = &tx->entries[i];
+		required_space += nvs_tx_data_size(fs, entry->len) + ate_size;
+
+		rc = nvs_tx_undo_size(fs, entry->id, &undo_size);
+		if (rc) {
+			goto end;
+		}
+		required_space += undo_size;
+	}
+
+	/* An empty sector also holds the close ate, the gc done ate and the ate
+	 * reserved for deletion.
+	 */
+	if (required_space > (fs->sector_size - 3 * ate_size)) {
+		rc = -EINVAL;
+		goto end;
+	}
+
+	gc_count = 0;
+	while (fs->ate_wra < (fs->data_wra + required_space)) {
+		if (gc_count == fs->sector_count) {
+			/* gc'ed all sectors, no extra space will be created
+			 * by extra gc.
+			 */
+			rc = -ENOSPC;
+			goto end;
+		}
+
+		rc = nvs_sector_close(fs);
+		if (rc) {
+			goto end;
+		}
+
+		rc = nvs_gc(fs);
+		if (rc) {
+			goto end;
+		}
+		gc_count++;
+	}
+
+	begin_addr = fs->ate_wra;
+	rc = nvs_add_tx_marker_ate(fs, NVS_ATE_PART_TX_BEGIN);
+	if (rc) {
+		goto rollback;
+	}
+
+	/* program the data of all entries back to back... */
+	data_addr = fs->data_wra;
+	for (size_t i = 0; i < tx->count; i++) {
+		entry = &tx->entries[i];
+		rc = nvs_flash_data_wrt(fs, entry->data, entry->len, true);
+		if (rc) {
+			goto rollback;
+		}
+	}
+
+	/* ...followed by their ATEs, several at a time */
+	for (size_t i = 0; i < tx->count; i += chunk) {
+		chunk = MIN(tx->count - i, NVS_TX_ATE_CHUNK);
+
+		for (size_t j = 0; j < chunk; j++) {
+			entry = &tx->entries[i + j];
+			ates[j].id = entry->id;
+			ates[j].offset = (uint16_t)(data_addr & ADDR_OFFS_MASK);
+			ates[j].len = (uint16_t)entry->len;
+			if (entry->len) {
+				ates[j].len += NVS_DATA_CRC_SIZE;
+			}
+			ates[j].part = NVS_ATE_PART_NONE;
+			nvs_ate_crc8_update(&ates[j]);
+
+			data_addr += nvs_tx_data_size(fs, entry->len);
+		}
+
+		rc = nvs_flash_ate_wrt_multi(fs, ates, chunk);
+		if (rc) {
+			goto rollback;
+		}
+	}
+
+	rc = nvs_add_tx_marker_ate(fs, NVS_ATE_PART_TX_END);
+	if (rc) {
+		goto rollback;
+	}
+
+	tx->count = 0U;
+	goto end;
+
+rollback:
+	/* Best effort, the transaction is rolled back at the next mount otherwise */
+	(void)nvs_tx_rollback(fs, begin_addr);
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+#endif /* CONFIG_NVS_TRANSACTION */
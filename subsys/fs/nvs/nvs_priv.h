@@ -30,6 +30,17 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+/*
+ * Transaction markers are special ATEs (id 0xFFFF, len 0) that use the part
+ * field to frame the entries of a transaction. Regular ATEs keep part 0xff.
+ */
+#define NVS_ATE_PART_NONE     0xff
+#define NVS_ATE_PART_TX_BEGIN 0x01
+#define NVS_ATE_PART_TX_END   0x02
+
+/* Number of transaction ATEs programmed with a single flash write */
+#define NVS_TX_ATE_CHUNK 8
+
 /*
  * Allow to use the NVS_DATA_CRC_SIZE macro in computations whether data CRC is enabled or not
  */
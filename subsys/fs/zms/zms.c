@@ -471,12 +471,13 @@ static bool zms_empty_ate_valid(struct zms_fs *fs, const struct zms_ate *entry)
  * - valid ate
  * - len = 0
  * - id = 0xffffffff
+ * - metadata = 0xffffffff
  * return true if valid, false otherwise
  */
 static bool zms_gc_done_ate_valid(struct zms_fs *fs, const struct zms_ate *entry)
 {
 	return (zms_ate_valid_different_sector(fs, entry, entry->cycle_cnt) && (!entry->len) &&
-		(entry->id == ZMS_HEAD_ID));
+		(entry->id == ZMS_HEAD_ID) && (entry->metadata == ZMS_GC_DONE_METADATA));
 }
 
 /* Read empty and close ATE of the sector where belongs address "addr" and
@@ -714,7 +715,7 @@ static int zms_add_gc_done_ate(struct zms_fs *fs)
 	gc_done_ate.id = ZMS_HEAD_ID;
 	gc_done_ate.len = 0U;
 	gc_done_ate.offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
-	gc_done_ate.metadata = 0xffffffff;
+	gc_done_ate.metadata = ZMS_GC_DONE_METADATA;
 	gc_done_ate.cycle_cnt = fs->sector_cycle;
 
 	zms_ate_crc8_update(&gc_done_ate);
@@ -1028,6 +1029,249 @@ gc_done:
 	return rc;
 }
 
+#ifdef CONFIG_ZMS_TRANSACTION
+/* Transactions: the data of all entries is written back to back, followed by
+ * their ATEs. The whole is framed by a begin and an end marker ATE, both
+ * stored in the same sector. A begin marker that is not followed by an end
+ * marker identifies an interrupted transaction: it is rolled back by writing
+ * again, for every ID it touched, the value that ID had before the begin
+ * marker. Restoring that value does not depend on what was written after the
+ * begin marker, so an interrupted roll back can simply be restarted.
+ * The offset of a marker is the end of the data of the transaction, so that
+ * data written without its ATE is never programmed again.
+ */
+
+/* add a transaction begin or end marker */
+static int zms_add_tx_marker_ate(struct zms_fs *fs, uint32_t metadata, uint64_t data_end)
+{
+	struct zms_ate tx_ate;
+
+	tx_ate.id = ZMS_HEAD_ID;
+	tx_ate.len = 0U;
+	tx_ate.offset = (uint32_t)SECTOR_OFFSET(data_end);
+	tx_ate.metadata = metadata;
+	tx_ate.cycle_cnt = fs->sector_cycle;
+
+	zms_ate_crc8_update(&tx_ate);
+
+	return zms_flash_ate_wrt(fs, &tx_ate);
+}
+
+static bool zms_tx_marker_valid(struct zms_fs *fs, const struct zms_ate *entry,
+				uint32_t metadata)
+{
+	return (zms_ate_valid(fs, entry) && (!entry->len) && (entry->id == ZMS_HEAD_ID) &&
+		(entry->metadata == metadata));
+}
+
+/* size of the data of a transaction entry once stored outside of its ATE */
+static size_t zms_tx_data_size(struct zms_fs *fs, size_t len)
+{
+	if (len <= ZMS_DATA_IN_ATE_SIZE) {
+		return 0;
+	}
+
+	return zms_al_size(fs, len);
+}
+
+/* program consecutive ATEs with a single flash write, entries[0] is stored
+ * at the current ate write address and the next ones below it.
+ */
+static int zms_flash_ate_wrt_multi(struct zms_fs *fs, const struct zms_ate *entries,
+				   size_t count)
+{
+	int rc;
+	uint8_t buf[ZMS_TX_ATE_CHUNK * ZMS_BLOCK_SIZE];
+
+	(void)memset(buf, fs->flash_parameters->erase_value, count * fs->ate_size);
+	for (size_t i = 0; i < count; i++) {
+		memcpy(&buf[(count - 1 - i) * fs->ate_size], &entries[i], sizeof(struct zms_ate));
+	}
+
+	rc = zms_flash_al_wrt(fs, fs->ate_wra - (count - 1) * fs->ate_size, buf,
+			      count * fs->ate_size);
+	if (rc) {
+		return rc;
+	}
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+	for (size_t i = 0; i < count; i++) {
+		fs->lookup_cache[zms_lookup_cache_pos(entries[i].id)] =
+			fs->ate_wra - i * fs->ate_size;
+	}
+#endif
+	fs->ate_wra -= count * fs->ate_size;
+
+	return 0;
+}
+
+/* space needed to restore the current value of id when rolling back */
+static int zms_tx_undo_size(struct zms_fs *fs, uint32_t id, size_t *size)
+{
+	int rc;
+	struct zms_ate ate;
+	uint64_t wlk_addr;
+	uint64_t ate_addr;
+
+	*size = fs->ate_size;
+
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(id)];
+
+	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		return 0;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+
+	rc = zms_find_ate_with_id(fs, id, wlk_addr, fs->ate_wra, &ate, &ate_addr);
+	if (rc < 0) {
+		return rc;
+	}
+	if (rc) {
+		*size += zms_tx_data_size(fs, ate.len);
+	}
+
+	return 0;
+}
+
+/* write again the value id had before the transaction begin marker at
+ * begin_addr, or delete id if it did not exist.
+ */
+static int zms_tx_restore(struct zms_fs *fs, uint32_t id, uint64_t begin_addr)
+{
+	int rc;
+	struct zms_ate ate;
+	uint64_t ate_addr;
+	uint64_t data_addr;
+
+	rc = zms_find_ate_with_id(fs, id, begin_addr, fs->ate_wra, &ate, &ate_addr);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (!rc) {
+		ate.len = 0U;
+	}
+
+	/* keep room for the end marker and the ATE reserved for deletion */
+	if (fs->ate_wra < (fs->data_wra + zms_tx_data_size(fs, ate.len) + 2 * fs->ate_size)) {
+		return -ENOSPC;
+	}
+
+	if (!ate.len) {
+		return zms_flash_write_entry(fs, id, NULL, 0);
+	}
+
+	if (ate.len > ZMS_DATA_IN_ATE_SIZE) {
+		data_addr = (ate_addr & ADDR_SECT_MASK);
+		data_addr += ate.offset;
+		ate.offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
+
+		rc = zms_flash_block_move(fs, data_addr, ate.len);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	ate.cycle_cnt = fs->sector_cycle;
+	zms_ate_crc8_update(&ate);
+
+	return zms_flash_ate_wrt(fs, &ate);
+}
+
+/* roll back the transaction whose begin marker is stored at begin_addr */
+static int zms_tx_rollback(struct zms_fs *fs, uint64_t begin_addr)
+{
+	int rc;
+	struct zms_ate ate;
+	struct zms_ate dup_ate;
+	uint64_t addr;
+	uint64_t dup_addr;
+	uint64_t end_addr;
+	bool dup;
+
+	end_addr = fs->ate_wra;
+
+	for (addr = begin_addr - fs->ate_size; addr > end_addr; addr -= fs->ate_size) {
+		rc = zms_flash_ate_rd(fs, addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (!zms_ate_valid(fs, &ate) || (ate.id == ZMS_HEAD_ID)) {
+			continue;
+		}
+
+		/* restore every ID only once */
+		dup = false;
+		for (dup_addr = begin_addr - fs->ate_size; dup_addr > addr;
+		     dup_addr -= fs->ate_size) {
+			rc = zms_flash_ate_rd(fs, dup_addr, &dup_ate);
+			if (rc) {
+				return rc;
+			}
+			if ((dup_ate.id == ate.id) && zms_ate_valid(fs, &dup_ate)) {
+				dup = true;
+				break;
+			}
+		}
+		if (dup) {
+			continue;
+		}
+
+		rc = zms_tx_restore(fs, ate.id, begin_addr);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return zms_add_tx_marker_ate(fs, ZMS_TX_END_METADATA, fs->data_wra);
+}
+
+/* look in the write sector for a transaction that was interrupted and roll
+ * it back. Only the most recent marker matters: a transaction always ends
+ * before the next one begins.
+ */
+static int zms_tx_recover(struct zms_fs *fs)
+{
+	int rc = 0;
+	struct zms_ate tx_ate;
+	uint64_t addr;
+	uint64_t data_end;
+	bool tx_begin;
+
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+
+	addr = fs->ate_wra + fs->ate_size;
+	while (SECTOR_OFFSET(addr) < (fs->sector_size - 2 * fs->ate_size)) {
+		rc = zms_flash_ate_rd(fs, addr, &tx_ate);
+		if (rc) {
+			break;
+		}
+
+		tx_begin = zms_tx_marker_valid(fs, &tx_ate, ZMS_TX_BEGIN_METADATA);
+		if (tx_begin || zms_tx_marker_valid(fs, &tx_ate, ZMS_TX_END_METADATA)) {
+			/* The data write address is only recovered from ATEs that
+			 * have data, skip the data of the transaction as well.
+			 */
+			data_end = (addr & ADDR_SECT_MASK) + tx_ate.offset;
+			fs->data_wra = MAX(fs->data_wra, data_end);
+
+			if (tx_begin) {
+				LOG_INF("Rolling back interrupted transaction");
+				rc = zms_tx_rollback(fs, addr);
+			}
+			break;
+		}
+		addr += fs->ate_size;
+	}
+
+	k_mutex_unlock(&fs->zms_lock);
+	return rc;
+}
+#endif /* CONFIG_ZMS_TRANSACTION */
+
 int zms_clear(struct zms_fs *fs)
 {
 	int rc;
@@ -1378,6 +1622,14 @@ int zms_mount(struct zms_fs *fs)
 		return rc;
 	}
 
+#ifdef CONFIG_ZMS_TRANSACTION
+	rc = zms_tx_recover(fs);
+	if (rc) {
+		LOG_ERR("Transaction recovery failed, returned = %d", rc);
+		return rc;
+	}
+#endif
+
 	/* zms is ready for use */
 	fs->ready = true;
 
@@ -1800,3 +2052,197 @@ end:
 	k_mutex_unlock(&fs->zms_lock);
 	return ret;
 }
+
+#ifdef CONFIG_ZMS_TRANSACTION
+void zms_tx_init(struct zms_tx *tx, struct zms_fs *fs, struct zms_tx_entry *entries,
+		 size_t size)
+{
+	tx->fs = fs;
+	tx->entries = entries;
+	tx->size = size;
+	tx->count = 0U;
+}
+
+int zms_tx_write(struct zms_tx *tx, uint32_t id, const void *data, size_t len)
+{
+	struct zms_tx_entry *entry = NULL;
+
+	/* ZMS_HEAD_ID is a special-purpose identifier */
+	if ((id == ZMS_HEAD_ID) || (len > UINT16_MAX) || ((len > 0) && (data == NULL))) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < tx->count; i++) {
+		if (tx->entries[i].id == id) {
+			entry = &tx->entries[i];
+			break;
+		}
+	}
+
+	if (entry == NULL) {
+		if (tx->count == tx->size) {
+			return -ENOMEM;
+		}
+		entry = &tx->entries[tx->count++];
+		entry->id = id;
+	}
+
+	entry->data = data;
+	entry->len = len;
+
+	return 0;
+}
+
+int zms_tx_delete(struct zms_tx *tx, uint32_t id)
+{
+	return zms_tx_write(tx, id, NULL, 0);
+}
+
+void zms_tx_abort(struct zms_tx *tx)
+{
+	tx->count = 0U;
+}
+
+int zms_tx_commit(struct zms_tx *tx)
+{
+	int rc;
+	struct zms_fs *fs = tx->fs;
+	const struct zms_tx_entry *entry;
+	struct zms_ate ates[ZMS_TX_ATE_CHUNK];
+	uint64_t begin_addr;
+	uint64_t data_addr;
+	uint64_t data_end;
+	size_t required_space;
+	size_t data_size;
+	size_t undo_size;
+	size_t chunk;
+	uint32_t gc_count;
+
+	if (!fs->ready) {
+		LOG_ERR("zms not initialized");
+		return -EACCES;
+	}
+
+	if (tx->count == 0U) {
+		return 0;
+	}
+
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+
+	/* Besides the entries and the begin and end markers, keep room to roll
+	 * back the transaction in the same sector. One more ATE is accounted so
+	 * that the first position of the sector is never used.
+	 */
+	required_space = 3 * fs->ate_size;
+	data_size = 0;
+	for (size_t i = 0; i < tx->count; i++) {
+		entry = &tx->entries[i];
+		data_size += zms_tx_data_size(fs, entry->len);
+		required_space += zms_tx_data_size(fs, entry->len) + fs->ate_size;
+
+		rc = zms_tx_undo_size(fs, entry->id, &undo_size);
+		if (rc) {
+			goto end;
+		}
+		required_space += undo_size;
+	}
+
+	/* An empty sector also holds the empty ATE, the close ATE, the gc done ATE
+	 * and the ATE reserved for deletion.
+	 */
+	if (required_space > (fs->sector_size - 4 * fs->ate_size)) {
+		rc = -EINVAL;
+		goto end;
+	}
+
+	gc_count = 0;
+	while (fs->ate_wra < (fs->data_wra + required_space)) {
+		if (gc_count == fs->sector_count) {
+			/* gc'ed all sectors, no extra space will be created
+			 * by extra gc.
+			 */
+			rc = -ENOSPC;
+			goto end;
+		}
+
+		rc = zms_sector_close(fs);
+		if (rc) {
+			LOG_ERR("Failed to close the sector, returned = %d", rc);
+			goto end;
+		}
+		rc = zms_gc(fs);
+		if (rc) {
+			LOG_ERR("Garbage collection failed, returned = %d", rc);
+			goto end;
+		}
+		gc_count++;
+	}
+
+	begin_addr = fs->ate_wra;
+	data_end = fs->data_wra + data_size;
+	rc = zms_add_tx_marker_ate(fs, ZMS_TX_BEGIN_METADATA, data_end);
+	if (rc) {
+		goto rollback;
+	}
+
+	/* program the data of all entries back to back... */
+	data_addr = fs->data_wra;
+	for (size_t i = 0; i < tx->count; i++) {
+		entry = &tx->entries[i];
+		if (entry->len <= ZMS_DATA_IN_ATE_SIZE) {
+			continue;
+		}
+		rc = zms_flash_data_wrt(fs, entry->data, entry->len);
+		if (rc) {
+			goto rollback;
+		}
+	}
+
+	/* ...followed by their ATEs, several at a time */
+	for (size_t i = 0; i < tx->count; i += chunk) {
+		chunk = MIN(tx->count - i, ZMS_TX_ATE_CHUNK);
+
+		for (size_t j = 0; j < chunk; j++) {
+			entry = &tx->entries[i + j];
+
+			memset(&ates[j], 0, sizeof(struct zms_ate));
+			ates[j].id = entry->id;
+			ates[j].len = (uint16_t)entry->len;
+			ates[j].cycle_cnt = fs->sector_cycle;
+
+			if (entry->len > ZMS_DATA_IN_ATE_SIZE) {
+				if (IS_ENABLED(CONFIG_ZMS_DATA_CRC)) {
+					ates[j].data_crc = crc32_ieee(entry->data, entry->len);
+				}
+				ates[j].offset = (uint32_t)SECTOR_OFFSET(data_addr);
+				data_addr += zms_tx_data_size(fs, entry->len);
+			} else if (entry->len > 0) {
+				memcpy(&ates[j].data, entry->data, entry->len);
+			}
+
+			zms_ate_crc8_update(&ates[j]);
+		}
+
+		rc = zms_flash_ate_wrt_multi(fs, ates, chunk);
+		if (rc) {
+			goto rollback;
+		}
+	}
+
+	rc = zms_add_tx_marker_ate(fs, ZMS_TX_END_METADATA, fs->data_wra);
+	if (rc) {
+		goto rollback;
+	}
+
+	tx->count = 0U;
+	goto end;
+
+rollback:
+	/* Best effort, the transaction is rolled back at the next mount otherwise */
+	fs->data_wra = MAX(fs->data_wra, data_end);
+	(void)zms_tx_rollback(fs, begin_addr);
+end:
+	k_mutex_unlock(&fs->zms_lock);
+	return rc;
+}
+#endif /* CONFIG_ZMS_TRANSACTION */
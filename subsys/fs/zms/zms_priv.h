@@ -44,6 +44,17 @@ extern "C" {
 #define ZMS_INVALID_SECTOR_NUM -1
 #define ZMS_DATA_IN_ATE_SIZE   8
 
+/*
+ * Transaction markers are ATEs with id = ZMS_HEAD_ID and len = 0, like the GC done
+ * ATE, and are told apart by their metadata.
+ */
+#define ZMS_GC_DONE_METADATA  0xffffffff
+#define ZMS_TX_BEGIN_METADATA 0x54580001
+#define ZMS_TX_END_METADATA   0x54580002
+
+/* Number of transaction ATEs programmed with a single flash write */
+#define ZMS_TX_ATE_CHUNK MAX(1, 256 / ZMS_BLOCK_SIZE)
+
 struct zms_ate {
 	uint8_t crc8;      /* crc8 check of the entry */
 	uint8_t cycle_cnt; /* cycle counter for non erasable devices */
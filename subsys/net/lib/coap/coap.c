@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_coap, CONFIG_COAP_LOG_LEVEL);
 #include <zephyr/sys/util.h>
 
 #include <zephyr/types.h>
+#include <zephyr/net_buf.h>
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/math_extras.h>
 
@@ -68,6 +69,66 @@ static struct coap_transmission_parameters coap_transmission_params = {
 static int insert_option(struct coap_packet *cpkt, uint16_t code, const uint8_t *value,
 			 uint16_t len);
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+/* Start an empty index of the options */
+static void option_index_reset(struct coap_packet *cpkt)
+{
+	cpkt->opt_index_count = 0U;
+	cpkt->opt_indexed = true;
+}
+
+/* Options are only added in ascending order, which keeps the index sorted */
+static void option_index_add(struct coap_packet *cpkt, uint16_t code, uint16_t offset,
+			     uint16_t len)
+{
+	struct coap_option_index_entry *entry;
+
+	if (!cpkt->opt_indexed) {
+		return;
+	}
+
+	if (cpkt->opt_index_count >= ARRAY_SIZE(cpkt->opt_index)) {
+		cpkt->opt_indexed = false;
+		return;
+	}
+
+	entry = &cpkt->opt_index[cpkt->opt_index_count++];
+	entry->code = code;
+	entry->offset = offset;
+	entry->len = len;
+}
+
+/* Record the layout the index is valid for. Users changing the header or the
+ * options behind the back of the library make the index invalid this way.
+ */
+static void option_index_sync(struct coap_packet *cpkt)
+{
+	cpkt->opt_index_hdr_len = cpkt->hdr_len;
+	cpkt->opt_index_len = cpkt->opt_len;
+}
+
+static void option_index_invalidate(struct coap_packet *cpkt)
+{
+	cpkt->opt_indexed = false;
+}
+
+static bool option_index_valid(const struct coap_packet *cpkt)
+{
+	return cpkt->opt_indexed && cpkt->opt_index_hdr_len == cpkt->hdr_len &&
+	       cpkt->opt_index_len == cpkt->opt_len;
+}
+#else
+static inline void option_index_reset(struct coap_packet *cpkt) {}
+static inline void option_index_add(struct coap_packet *cpkt, uint16_t code, uint16_t offset,
+				    uint16_t len) {}
+static inline void option_index_sync(struct coap_packet *cpkt) {}
+static inline void option_index_invalidate(struct coap_packet *cpkt) {}
+static inline bool option_index_valid(const struct coap_packet *cpkt)
+{
+	return false;
+}
+#endif /* CONFIG_COAP_OPTION_INDEX */
+
 static inline void encode_u8(struct coap_packet *cpkt, uint16_t offset, uint8_t data)
 {
 	cpkt->data[offset] = data;
@@ -213,6 +274,34 @@ int coap_packet_init(struct coap_packet *cpkt, uint8_t *data, uint16_t max_len,
 	/* Header length : (version + type + tkl) + code + id + [token] */
 	cpkt->hdr_len = 1 + 1 + 2 + token_len;
 
+	option_index_reset(cpkt);
+	option_index_sync(cpkt);
+
+	return 0;
+}
+
+int coap_packet_init_net_buf(struct coap_packet *cpkt, struct net_buf *buf,
+			     uint8_t ver, uint8_t type, uint8_t token_len,
+			     const uint8_t *token, uint8_t code, uint16_t id)
+{
+	if (!buf) {
+		return -EINVAL;
+	}
+
+	return coap_packet_init(cpkt, net_buf_tail(buf),
+				MIN(net_buf_tailroom(buf), UINT16_MAX),
+				ver, type, token_len, token, code, id);
+}
+
+int coap_packet_net_buf_commit(struct coap_packet *cpkt, struct net_buf *buf)
+{
+	if (!cpkt || !buf || cpkt->data != net_buf_tail(buf) ||
+	    cpkt->offset > net_buf_tailroom(buf)) {
+		return -EINVAL;
+	}
+
+	net_buf_add(buf, cpkt->offset);
+
 	return 0;
 }
 
@@ -344,6 +433,7 @@ static int encode_option(struct coap_packet *cpkt, uint16_t code, const uint8_t
 int coap_packet_append_option(struct coap_packet *cpkt, uint16_t code,
 			      const uint8_t *value, uint16_t len)
 {
+	bool indexed;
 	int r;
 
 	if (!cpkt) {
@@ -359,6 +449,8 @@ int coap_packet_append_option(struct coap_packet *cpkt, uint16_t code,
 		return insert_option(cpkt, code, value, len);
 	}
 
+	indexed = option_index_valid(cpkt);
+
 	/* Calculate delta, if this option is not the first one */
 	if (cpkt->opt_len) {
 		code = (code == cpkt->delta) ? 0 : code - cpkt->delta;
@@ -366,12 +458,21 @@ int coap_packet_append_option(struct coap_packet *cpkt, uint16_t code,
 
 	r = encode_option(cpkt, code, value, len, cpkt->hdr_len + cpkt->opt_len);
 	if (r < 0) {
+		option_index_invalidate(cpkt);
 		return -EINVAL;
 	}
 
 	cpkt->opt_len += r;
 	cpkt->delta += code;
 
+	if (indexed) {
+		/* The value ends the encoded option */
+		option_index_add(cpkt, cpkt->delta, cpkt->hdr_len + cpkt->opt_len - len, len);
+		option_index_sync(cpkt);
+	} else {
+		option_index_invalidate(cpkt);
+	}
+
 	return 0;
 }
 
@@ -532,7 +633,7 @@ static int decode_delta(uint8_t *data, uint16_t offset, uint16_t *pos, uint16_t
 
 static int parse_option(uint8_t *data, uint16_t offset, uint16_t *pos,
 			uint16_t max_len, uint16_t *opt_delta, uint16_t *opt_len,
-			struct coap_option *option)
+			struct coap_option *option, struct coap_option_index_entry *entry)
 {
 	uint16_t hdr_len;
 	uint16_t delta;
@@ -603,6 +704,13 @@ static int parse_option(uint8_t *data, uint16_t offset, uint16_t *pos,
 		return -EINVAL;
 	}
 
+	/* Location of the value, for the option index */
+	if (entry) {
+		entry->code = *opt_delta;
+		entry->offset = *pos;
+		entry->len = len;
+	}
+
 	if (option) {
 		/*
 		 * Make sure the option data will fit into the value field of
@@ -663,7 +771,7 @@ static int remove_middle_option(struct coap_packet *cpkt,
 
 	/* get the option after the removed one */
 	r = parse_option(cpkt->data, offset, &offset, cpkt->hdr_len + cpkt->opt_len,
-			 &opt_delta, &opt_len, &option);
+			 &opt_delta, &opt_len, &option, NULL);
 	if (r < 0) {
 		return -EILSEQ;
 	}
@@ -709,7 +817,7 @@ int coap_packet_remove_option(struct coap_packet *cpkt, uint16_t code)
 	/* Find the requested option */
 	while (offset < cpkt->hdr_len + cpkt->opt_len) {
 		r = parse_option(cpkt->data, offset, &offset, cpkt->hdr_len + cpkt->opt_len,
-				 &opt_delta, &opt_len, &option);
+				 &opt_delta, &opt_len, &option, NULL);
 		if (r < 0) {
 			return -EILSEQ;
 		}
@@ -726,6 +834,8 @@ int coap_packet_remove_option(struct coap_packet *cpkt, uint16_t code)
 		previous_offset = offset;
 	}
 
+	option_index_invalidate(cpkt);
+
 	/* Check if the found option is the last option */
 	if (cpkt->opt_len > opt_len) {
 		/* not last option */
@@ -771,6 +881,8 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	cpkt->hdr_len = 0U;
 	cpkt->delta = 0U;
 
+	option_index_invalidate(cpkt);
+
 	/* Token lengths 9-15 are reserved. */
 	tkl = cpkt->data[0] & 0x0f;
 	if (tkl > 8) {
@@ -782,7 +894,10 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 		return -EBADMSG;
 	}
 
+	option_index_reset(cpkt);
+
 	if (cpkt->hdr_len == len) {
+		option_index_sync(cpkt);
 		return 0;
 	}
 
@@ -792,14 +907,24 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	num = 0U;
 
 	while (1) {
+		struct coap_option_index_entry entry = { 0 };
 		struct coap_option *option;
 
 		option = num < opt_num ? &options[num++] : NULL;
 		ret = parse_option(cpkt->data, offset, &offset, cpkt->max_len,
-				   &delta, &opt_len, option);
+				   &delta, &opt_len, option,
+				   IS_ENABLED(CONFIG_COAP_OPTION_INDEX) ? &entry : NULL);
 		if (ret < 0) {
+			option_index_invalidate(cpkt);
 			return -EILSEQ;
-		} else if (ret == 0) {
+		}
+
+		/* The payload marker has no entry */
+		if (entry.offset != 0U) {
+			option_index_add(cpkt, entry.code, entry.offset, entry.len);
+		}
+
+		if (ret == 0) {
 			break;
 		}
 	}
@@ -807,9 +932,26 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	cpkt->opt_len = opt_len;
 	cpkt->delta = delta;
 
+	option_index_sync(cpkt);
+
 	return 0;
 }
 
+int coap_packet_parse_net_buf(struct coap_packet *cpkt, struct net_buf *buf,
+			      struct coap_option *options, uint8_t opt_num)
+{
+	if (!buf) {
+		return -EINVAL;
+	}
+
+	/* The packet is used in place, so it has to be contiguous */
+	if (net_buf_frags_len(buf) != buf->len) {
+		return -EMSGSIZE;
+	}
+
+	return coap_packet_parse(cpkt, buf->data, buf->len, options, opt_num);
+}
+
 int coap_packet_set_path(struct coap_packet *cpkt, const char *path)
 {
 	int ret = 0;
@@ -912,6 +1054,48 @@ out:
 	return ret;
 }
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+static int find_indexed_options(const struct coap_packet *cpkt, uint16_t code,
+				struct coap_option *options, uint16_t veclen)
+{
+	const struct coap_option_index_entry *entry;
+	uint8_t low = 0U;
+	uint8_t high = cpkt->opt_index_count;
+	uint16_t num = 0U;
+
+	/* Find the first option with the code, the index is sorted */
+	while (low < high) {
+		uint8_t mid = low + (high - low) / 2U;
+
+		if (cpkt->opt_index[mid].code < code) {
+			low = mid + 1U;
+		} else {
+			high = mid;
+		}
+	}
+
+	for (entry = &cpkt->opt_index[low];
+	     entry < &cpkt->opt_index[cpkt->opt_index_count] && num < veclen; entry++) {
+		if (entry->code != code) {
+			break;
+		}
+
+		if (entry->len > sizeof(options[num].value)) {
+			NET_ERR("%u is > sizeof(coap_option->value)(%zu)!",
+				entry->len, sizeof(options[num].value));
+			return -EINVAL;
+		}
+
+		options[num].delta = code;
+		options[num].len = entry->len;
+		memcpy(options[num].value, cpkt->data + entry->offset, entry->len);
+		num++;
+	}
+
+	return num;
+}
+#endif /* CONFIG_COAP_OPTION_INDEX */
+
 int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 		      struct coap_option *options, uint16_t veclen)
 {
@@ -926,6 +1110,12 @@ int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 		return 0;
 	}
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	if (option_index_valid(cpkt)) {
+		return find_indexed_options(cpkt, code, options, veclen);
+	}
+#endif
+
 	offset = cpkt->hdr_len;
 	opt_len = 0U;
 	delta = 0U;
@@ -934,7 +1124,7 @@ int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 	while (delta <= code && num < veclen) {
 		r = parse_option(cpkt->data, offset, &offset,
 				 cpkt->max_len, &delta, &opt_len,
-				 &options[num]);
+				 &options[num], NULL);
 		if (r < 0) {
 			return -EINVAL;
 		}
@@ -1397,9 +1587,11 @@ int insert_option(struct coap_packet *cpkt, uint16_t code, const uint8_t *value,
 	struct coap_option option;
 	int r;
 
+	option_index_invalidate(cpkt);
+
 	while (offset < cpkt->hdr_len + cpkt->opt_len) {
 		r = parse_option(cpkt->data, offset, &offset, cpkt->hdr_len + cpkt->opt_len,
-				 &opt_delta, &opt_len, &option);
+				 &opt_delta, &opt_len, &option, NULL);
 		if (r < 0) {
 			return -EILSEQ;
 		}
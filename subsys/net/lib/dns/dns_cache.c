@@ -5,18 +5,135 @@
  */
 
 #include <zephyr/net/dns_resolve.h>
+#include <zephyr/sys/hash_function.h>
 #include "dns_cache.h"
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+static void dns_cache_clean(struct dns_cache *cache);
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_init(struct dns_cache *cache)
+{
+	sys_slist_init(&cache->free_list);
+	sys_dlist_init(&cache->expiry_queue);
+
+	for (size_t i = 0; i < cache->size; i++) {
+		sys_slist_init(&cache->buckets[i]);
+		sys_slist_append(&cache->free_list, &cache->entries[i].node);
+	}
+
+	cache->initialized = true;
+}
+
+static void dns_cache_lock(struct dns_cache *cache)
+{
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	if (!cache->initialized) {
+		dns_cache_init(cache);
+	}
+}
+
+static inline sys_slist_t *dns_cache_bucket(struct dns_cache *cache, uint32_t hash)
+{
+	return &cache->buckets[hash % cache->size];
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_release(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	sys_slist_find_and_remove(dns_cache_bucket(cache, entry->hash), &entry->node);
+	sys_dlist_remove(&entry->expiry_node);
+	sys_slist_prepend(&cache->free_list, &entry->node);
+}
+
+/* Needs to be called when lock is already acquired. Keeps the expiry queue
+ * sorted, looking from its end as most entries get similar TTLs.
+ */
+static void dns_cache_expiry_insert(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	sys_dnode_t *node = sys_dlist_peek_tail(&cache->expiry_queue);
+	struct dns_cache_entry *prev;
+
+	while (node != NULL) {
+		prev = CONTAINER_OF(node, struct dns_cache_entry, expiry_node);
+		if (sys_timepoint_cmp(prev->expiry, entry->expiry) <= 0) {
+			break;
+		}
+
+		node = sys_dlist_peek_prev(&cache->expiry_queue, node);
+	}
+
+	if (node == NULL) {
+		sys_dlist_prepend(&cache->expiry_queue, &entry->expiry_node);
+	} else if (sys_dlist_is_tail(&cache->expiry_queue, node)) {
+		sys_dlist_append(&cache->expiry_queue, &entry->expiry_node);
+	} else {
+		sys_dlist_insert(sys_dlist_peek_next_no_check(&cache->expiry_queue, node),
+				 &entry->expiry_node);
+	}
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
 	k_mutex_lock(cache->lock, K_FOREVER);
-	for (size_t i = 0; i < cache->size; i++) {
-		cache->entries[i].in_use = false;
+	dns_cache_init(cache);
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+/* Add an entry for query, a negative one if addrinfo is NULL */
+static int dns_cache_insert(struct dns_cache *cache, char const *query,
+			    struct dns_addrinfo const *addrinfo, uint32_t ttl)
+{
+	uint32_t hash = sys_hash32(query, strlen(query));
+	struct dns_cache_entry *entry, *tmp;
+	sys_snode_t *node;
+
+	dns_cache_lock(cache);
+
+	NET_DBG("Add \"%s\" with TTL %" PRIu32 "%s", query, ttl,
+		addrinfo == NULL ? " (negative)" : "");
+
+	dns_cache_clean(cache);
+
+	/* A negative entry replaces all the entries of the query, and an
+	 * address replaces a negative entry.
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, hash), entry, tmp, node) {
+		if (entry->hash == hash && (addrinfo == NULL || entry->negative) &&
+		    strcmp(entry->query, query) == 0) {
+			dns_cache_release(cache, entry);
+		}
 	}
+
+	node = sys_slist_get(&cache->free_list);
+	if (node != NULL) {
+		entry = CONTAINER_OF(node, struct dns_cache_entry, node);
+	} else {
+		/* Replace the entry closest to expiry */
+		entry = CONTAINER_OF(sys_dlist_peek_head_not_empty(&cache->expiry_queue),
+				     struct dns_cache_entry, expiry_node);
+
+		NET_DBG("Overwrite \"%s\"", entry->query);
+
+		sys_slist_find_and_remove(dns_cache_bucket(cache, entry->hash), &entry->node);
+		sys_dlist_remove(&entry->expiry_node);
+	}
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->hash = hash;
+	entry->negative = (addrinfo == NULL);
+	if (addrinfo != NULL) {
+		entry->data = *addrinfo;
+	}
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+
+	sys_slist_append(dns_cache_bucket(cache, hash), &entry->node);
+	dns_cache_expiry_insert(cache, entry);
+
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -25,10 +142,6 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
-
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
@@ -40,40 +153,30 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 		return -EINVAL;
 	}
 
-	k_mutex_lock(cache->lock, K_FOREVER);
-
-	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
-
-	dns_cache_clean(cache);
+	return dns_cache_insert(cache, query, addrinfo, ttl);
+}
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, uint32_t ttl)
+{
+	if (cache == NULL || query == NULL || ttl == 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
-
-	k_mutex_unlock(cache->lock);
-
-	return 0;
+	return dns_cache_insert(cache, query, NULL, ttl);
 }
 
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
+	struct dns_cache_entry *entry, *tmp;
+	uint32_t hash;
+
 	NET_DBG("Remove all entries with query \"%s\"", query);
 	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
 		NET_WARN("Query string to big to be processed %u >= "
@@ -82,13 +185,15 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 		return -EINVAL;
 	}
 
-	k_mutex_lock(cache->lock, K_FOREVER);
+	hash = sys_hash32(query, strlen(query));
+
+	dns_cache_lock(cache);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, hash), entry, tmp, node) {
+		if (entry->hash == hash && strcmp(entry->query, query) == 0) {
+			dns_cache_release(cache, entry);
 		}
 	}
 
@@ -97,10 +202,13 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
 		   size_t addrinfo_array_len)
 {
+	struct dns_cache_entry *entry;
+	bool negative = false;
 	size_t found = 0;
+	uint32_t hash;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
@@ -113,22 +221,25 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 		return -EINVAL;
 	}
 
-	k_mutex_lock(cache->lock, K_FOREVER);
+	hash = sys_hash32(query, strlen(query));
+
+	dns_cache_lock(cache);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	SYS_SLIST_FOR_EACH_CONTAINER(dns_cache_bucket(cache, hash), entry, node) {
+		if (entry->hash != hash || strcmp(entry->query, query) != 0) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
-			continue;
+		if (entry->negative) {
+			negative = true;
+			break;
 		}
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
@@ -136,6 +247,11 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 
 	k_mutex_unlock(cache->lock);
 
+	if (negative) {
+		NET_DBG("\"%s\" does not exist", query);
+		return -ENOENT;
+	}
+
 	if (found > addrinfo_array_len) {
 		return -ENOSR;
 	}
@@ -147,16 +263,19 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 }
 
 /* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+static void dns_cache_clean(struct dns_cache *cache)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
-		}
+	struct dns_cache_entry *entry;
+	sys_dnode_t *node;
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
+	/* Only the entries at the head of the expiry queue can be expired */
+	while ((node = sys_dlist_peek_head(&cache->expiry_queue)) != NULL) {
+		entry = CONTAINER_OF(node, struct dns_cache_entry, expiry_node);
+		if (!sys_timepoint_expired(entry->expiry)) {
+			break;
 		}
+
+		NET_DBG("Remove \"%s\"", entry->query);
+		dns_cache_release(cache, entry);
 	}
 }
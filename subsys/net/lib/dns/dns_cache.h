@@ -16,19 +16,32 @@
 #include <stdint.h>
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/slist.h>
 #include <zephyr/sys_clock.h>
 
 struct dns_cache_entry {
+	/* Hash bucket of the query, or free list */
+	sys_snode_t node;
+	/* Expiry queue, sorted by expiry */
+	sys_dnode_t expiry_node;
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
-	bool in_use;
+	uint32_t hash;
+	/* The query name does not exist, data is not used */
+	bool negative;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	/* Entries hashed by query, size buckets */
+	sys_slist_t *buckets;
+	sys_slist_t free_list;
+	sys_dlist_t expiry_queue;
 	struct k_mutex *lock;
+	bool initialized;
 };
 
 /**
@@ -43,8 +56,11 @@ struct dns_cache {
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
-	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+	static sys_slist_t name##_buckets[cache_size];                                             \
+	static struct dns_cache name = {.entries = name##_entries,                                 \
+					.buckets = name##_buckets,                                 \
+					.size = cache_size,                                        \
+					.lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -71,6 +87,21 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Adds a negative entry to the dns cache, recording that the query
+ * name does not exist.
+ *
+ * Entries of the query are replaced, and later lookups of the query fail
+ * with -ENOENT until the entry expires.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param ttl Time to live for the entry in seconds.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -93,8 +124,9 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * @retval On error a negative value is returned.
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
+ * -ENOENT means the query is cached as a name that does not exist.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
 		   size_t addrinfo_array_len);
 
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
@@ -981,6 +981,16 @@ query_known:
 	}
 
 	if (items == 0) {
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+		/* Remember that the name does not exist, so that it is not
+		 * queried again for a while.
+		 */
+		if (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR &&
+		    CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL > 0) {
+			dns_cache_add_negative(&dns_cache, ctx->queries[*query_idx].query,
+					       CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+		}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
 		ret = DNS_EAI_NODATA;
 	} else {
 		ret = DNS_EAI_ALLDONE;
@@ -1417,6 +1427,13 @@ try_resolve:
 		}
 		cb(DNS_EAI_ALLDONE, NULL, user_data);
 
+		return 0;
+	} else if (ret == -ENOENT) {
+		/* The name is cached as not existing, report it like
+		 * an answer from the server.
+		 */
+		cb(DNS_EAI_NODATA, NULL, user_data);
+
 		return 0;
 	}
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
@@ -10,6 +10,7 @@
 
 #include <stdbool.h>
 
+#include <zephyr/sys/dlist.h>
 #include <zephyr/net/http/server.h>
 #include <zephyr/net/http/service.h>
 #include <zephyr/net/http/status.h>
@@ -38,14 +39,61 @@ int enter_http_done_state(struct http_client_ctx *client);
 
 /* Others */
 struct http_resource_detail *get_resource_detail(const char *path, int *len, bool is_ws);
+void http_server_route_table_build(void);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
 void http_server_get_content_type_from_extension(char *url, char *content_type,
 						 size_t content_type_size);
 int http_server_find_file(char *fname, size_t fname_size, size_t *file_size, bool *gzipped);
 void http_client_timer_restart(struct http_client_ctx *client);
+bool http_server_resource_claim(struct http_resource_detail_dynamic *detail,
+				struct http_client_ctx *client);
+bool http_server_resource_release(struct http_resource_detail_dynamic *detail,
+				  struct http_client_ctx *client);
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status);
 bool http_response_is_provided(struct http_response_ctx *rsp);
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+/* File of a static filesystem resource held in memory */
+struct http_server_fs_cache_entry {
+	sys_dnode_t node;
+	struct http_resource_detail_static_fs *detail;
+	const char *url;
+	const uint8_t *data;
+	size_t data_len;
+	uint32_t crc;
+	bool gzipped;
+
+	/* Validators, last_modified is NULL without a clock */
+	const char *etag;
+	const char *last_modified;
+
+	/* Pre-rendered HTTP/1 responses, up to the body */
+	const char *http1_ok;
+	size_t http1_ok_len;
+	const char *http1_not_modified;
+	size_t http1_not_modified_len;
+
+	/* HTTP/2 response headers, the validators come first */
+	struct http_header http2_headers[4];
+	uint8_t http2_header_count;
+	uint8_t http2_validator_count;
+
+	/* Heap block holding the strings and the data */
+	void *block;
+	/* Uptime of the last check for changes */
+	int64_t checked;
+	uint16_t users;
+	/* Dropped from the cache but still being sent */
+	bool stale;
+};
+
+int http_server_fs_cache_get(struct http_resource_detail_static_fs *detail, char *url,
+			     struct http_server_fs_cache_entry **entry);
+void http_server_fs_cache_put(struct http_server_fs_cache_entry *entry);
+bool http_server_fs_cache_not_modified(const struct http_server_fs_cache_entry *entry,
+				       const struct http_client_ctx *client);
+#endif
+
 /* TODO Could be static, but currently used in tests. */
 int parse_http_frame_header(struct http_client_ctx *client, const uint8_t *buffer,
 			    size_t buflen);
@@ -470,7 +470,7 @@ static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
 			return -ENOBUFS;
 		}
 
-		*buf = (uint8_t)((value % 128) + 128);
+		*buf++ = (uint8_t)((value % 128) + 128);
 		len++;
 		value /= 128;
 	}
@@ -534,14 +534,13 @@ static int hpack_string_encode(uint8_t *buf, size_t buflen,
 	return len;
 }
 
-static int hpack_encode_literal(uint8_t *buf, size_t buflen,
+static int hpack_encode_literal(uint8_t *buf, size_t buflen, int index,
+				uint8_t prefix, uint8_t prefix_len,
 				struct http_hpack_header_buf *header)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, 0,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
+	ret = hpack_integer_encode(buf, buflen, index, prefix, prefix_len);
 	if (ret < 0) {
 		return ret;
 	}
@@ -550,41 +549,18 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 	buflen -= ret;
 	len += ret;
 
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
-	if (ret < 0) {
-		return ret;
-	}
-
-	buf += ret;
-	buflen -= ret;
-	len += ret;
-
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
-	if (ret < 0) {
-		return ret;
-	}
-
-	len += ret;
-
-	return len;
-}
-
-static int hpack_encode_literal_value(uint8_t *buf, size_t buflen, int index,
-				      struct http_hpack_header_buf *header)
-{
-	int ret, len = 0;
+	if (index == 0) {
+		/* Literal name. */
+		ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+		if (ret < 0) {
+			return ret;
+		}
 
-	ret = hpack_integer_encode(buf, buflen, index,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
-	if (ret < 0) {
-		return ret;
+		buf += ret;
+		buflen -= ret;
+		len += ret;
 	}
 
-	buf += ret;
-	buflen -= ret;
-	len += ret;
-
 	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
 	if (ret < 0) {
 		return ret;
@@ -620,10 +596,16 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 	ret = http_hpack_find_index(header, &name_only);
 	if (ret < 0) {
 		/* All literal */
-		len = hpack_encode_literal(buf, buflen, header);
+		len = hpack_encode_literal(buf, buflen, 0,
+					   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+					   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED,
+					   header);
 	} else if (name_only) {
 		/* Literal value */
-		len = hpack_encode_literal_value(buf, buflen, ret, header);
+		len = hpack_encode_literal(buf, buflen, ret,
+					   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+					   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED,
+					   header);
 	} else {
 		/* Indexed */
 		len = hpack_encode_indexed(buf, buflen, ret);
@@ -631,3 +613,301 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 
 	return len;
 }
+
+/* Headers which values change with most of the responses, or which shall not
+ * be stored by the peer.
+ */
+static const char * const hpack_no_indexing_names[] = {
+	"content-length",
+	"date",
+	"etag",
+	"last-modified",
+	"set-cookie",
+};
+
+static bool hpack_header_is_cacheable(struct http_hpack_header_buf *header)
+{
+	ARRAY_FOR_EACH(hpack_no_indexing_names, i) {
+		const char *name = hpack_no_indexing_names[i];
+
+		if (strlen(name) == header->name_len &&
+		    memcmp(name, header->name, header->name_len) == 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+static size_t hpack_table_size(struct http_hpack_table *table)
+{
+	return table->data_len + table->count * HTTP_HPACK_ENTRY_OVERHEAD;
+}
+
+/* Evict the oldest entries until an entry of the given size fits, RFC7541
+ * ch 4.4.
+ */
+static void hpack_table_evict(struct http_hpack_table *table, size_t size)
+{
+	size_t table_size = hpack_table_size(table);
+	size_t data_len = 0;
+	uint16_t count = 0;
+
+	while (count < table->count && table_size + size > table->max_size) {
+		size_t len = table->entries[count].name_len +
+			     table->entries[count].value_len;
+
+		data_len += len;
+		table_size -= len + HTTP_HPACK_ENTRY_OVERHEAD;
+		count++;
+	}
+
+	if (count == 0) {
+		return;
+	}
+
+	table->count -= count;
+	table->data_len -= data_len;
+
+	memmove(table->data, table->data + data_len, table->data_len);
+	memmove(table->entries, table->entries + count,
+		table->count * sizeof(table->entries[0]));
+}
+
+static void hpack_table_add(struct http_hpack_table *table,
+			    struct http_hpack_header_buf *header)
+{
+	uint8_t *data;
+
+	hpack_table_evict(table, header->name_len + header->value_len +
+				 HTTP_HPACK_ENTRY_OVERHEAD);
+
+	data = table->data + table->data_len;
+	memcpy(data, header->name, header->name_len);
+	memcpy(data + header->name_len, header->value, header->value_len);
+
+	table->entries[table->count].name_len = header->name_len;
+	table->entries[table->count].value_len = header->value_len;
+	table->data_len += header->name_len + header->value_len;
+	table->count++;
+}
+
+/* Look up the dynamic table from the newest entry, which has the lowest
+ * index.
+ */
+static int hpack_table_find_index(struct http_hpack_table *table,
+				  struct http_hpack_header_buf *header,
+				  bool *name_only)
+{
+	size_t offset = table->data_len;
+	int candidate = -ENOENT;
+
+	for (int i = table->count - 1; i >= 0; i--) {
+		uint16_t name_len = table->entries[i].name_len;
+		uint16_t value_len = table->entries[i].value_len;
+		const uint8_t *name;
+		int index;
+
+		offset -= name_len + value_len;
+		name = table->data + offset;
+
+		if (name_len != header->name_len ||
+		    memcmp(name, header->name, name_len) != 0) {
+			continue;
+		}
+
+		index = HTTP_SERVER_HPACK_WWW_AUTHENTICATE + table->count - i;
+
+		if (value_len == header->value_len &&
+		    memcmp(name + name_len, header->value, value_len) == 0) {
+			/* Got exact match. */
+			*name_only = false;
+			return index;
+		}
+
+		if (candidate < 0) {
+			candidate = index;
+		}
+	}
+
+	if (candidate > 0) {
+		/* Matched name only. */
+		*name_only = true;
+	}
+
+	return candidate;
+}
+
+#else
+static void hpack_table_evict(struct http_hpack_table *table, size_t size)
+{
+	ARG_UNUSED(table);
+	ARG_UNUSED(size);
+}
+
+static void hpack_table_add(struct http_hpack_table *table,
+			    struct http_hpack_header_buf *header)
+{
+	ARG_UNUSED(table);
+	ARG_UNUSED(header);
+}
+
+static int hpack_table_find_index(struct http_hpack_table *table,
+				  struct http_hpack_header_buf *header,
+				  bool *name_only)
+{
+	ARG_UNUSED(table);
+	ARG_UNUSED(header);
+	ARG_UNUSED(name_only);
+
+	return -ENOENT;
+}
+#endif /* HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0 */
+
+void http_hpack_table_init(struct http_hpack_table *table)
+{
+	table->count = 0;
+	table->data_len = 0;
+	table->max_size = MIN(HTTP_HPACK_DEFAULT_TABLE_SIZE,
+			      HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+	table->flush = false;
+
+	/* The decoder starts with the default size, which only matters once
+	 * entries are added.
+	 */
+	table->size_update = (table->max_size > 0 &&
+			      table->max_size != HTTP_HPACK_DEFAULT_TABLE_SIZE);
+	table->min_size = table->max_size;
+}
+
+void http_hpack_table_set_max_size(struct http_hpack_table *table,
+				   uint32_t max_size)
+{
+	if (max_size > HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE) {
+		max_size = HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE;
+	}
+
+	if (max_size == table->max_size) {
+		return;
+	}
+
+	/* The decoder must also see the smallest size the table went through
+	 * before the next header block, RFC7541 ch 4.2.
+	 */
+	if (!table->size_update || max_size < table->min_size) {
+		table->min_size = max_size;
+	}
+
+	table->max_size = max_size;
+	table->size_update = true;
+
+	hpack_table_evict(table, 0);
+}
+
+void http_hpack_table_reset(struct http_hpack_table *table)
+{
+	/* The peer may have missed some of the entries added to the table,
+	 * have it evict all of them.
+	 */
+	if (table->count > 0) {
+		table->flush = true;
+	}
+
+	table->count = 0;
+	table->data_len = 0;
+}
+
+int http_hpack_table_encode_header(struct http_hpack_table *table,
+				   uint8_t *buf, size_t buflen,
+				   struct http_hpack_header_buf *header)
+{
+	bool name_only = false;
+	int ret, index, len = 0;
+
+	if (table == NULL || buf == NULL || header == NULL ||
+	    header->name == NULL || header->name_len == 0 ||
+	    header->value == NULL || header->value_len == 0) {
+		return -EINVAL;
+	}
+
+	if (buflen == 0) {
+		return -ENOBUFS;
+	}
+
+	/* Table size changes are signaled at the beginning of the next header
+	 * block, RFC7541 ch 4.2.
+	 */
+	if (table->flush ||
+	    (table->size_update && table->min_size < table->max_size)) {
+		ret = hpack_integer_encode(buf, buflen,
+					   table->flush ? 0 : table->min_size,
+					   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+					   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	if (table->flush || table->size_update) {
+		ret = hpack_integer_encode(buf, buflen, table->max_size,
+					   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+					   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	index = hpack_table_find_index(table, header, &name_only);
+	if (index < 0 || name_only) {
+		bool static_name_only;
+
+		ret = http_hpack_find_index(header, &static_name_only);
+		if (ret > 0) {
+			index = ret;
+			name_only = static_name_only;
+		}
+	}
+
+	if (index > 0 && !name_only) {
+		/* Indexed */
+		ret = hpack_encode_indexed(buf, buflen, index);
+	} else if (hpack_header_is_cacheable(header) &&
+		   header->name_len + header->value_len +
+		   HTTP_HPACK_ENTRY_OVERHEAD <= table->max_size) {
+		/* Literal, added to the table */
+		ret = hpack_encode_literal(buf, buflen, MAX(index, 0),
+					   HPACK_PREFIX_LITERAL_INDEXING,
+					   HPACK_PREFIX_LEN_LITERAL_INDEXING,
+					   header);
+		if (ret >= 0) {
+			hpack_table_add(table, header);
+		}
+	} else {
+		/* Literal, never indexed */
+		ret = hpack_encode_literal(buf, buflen, MAX(index, 0),
+					   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+					   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED,
+					   header);
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	len += ret;
+
+	table->flush = false;
+	table->size_update = false;
+	table->min_size = table->max_size;
+
+	return len;
+}
@@ -20,6 +20,7 @@
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/tls_credentials.h>
+#include <zephyr/posix/fcntl.h>
 #include <zephyr/posix/sys/eventfd.h>
 #include <zephyr/posix/fnmatch.h>
 
@@ -40,21 +41,33 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
-#define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
+#define HTTP_SERVER_NUM_WORKERS  CONFIG_HTTP_SERVER_NUM_WORKERS
+#define HTTP_SERVER_WORKER_MAX_CLIENTS \
+	DIV_ROUND_UP(HTTP_SERVER_MAX_CLIENTS, HTTP_SERVER_NUM_WORKERS)
+#define HTTP_SERVER_SOCK_COUNT \
+	(1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_WORKER_MAX_CLIENTS)
 
 struct http_server_ctx {
 	int num_clients;
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
 
-	/* First pollfd is eventfd that can be used to stop the server,
-	 * then we have the server listen sockets,
-	 * and then the accepted sockets.
+	/* First pollfd is eventfd that can be used to stop the worker,
+	 * then we have the server listen sockets, shared by all workers,
+	 * and then the sockets accepted by this worker.
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
-	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
+	struct http_client_ctx clients[HTTP_SERVER_WORKER_MAX_CLIENTS];
 };
 
-static struct http_server_ctx server_ctx;
+/* One context per worker. The first worker is the server thread, which
+ * owns the listening sockets and starts and stops the other workers.
+ */
+static struct http_server_ctx server_ctx[HTTP_SERVER_NUM_WORKERS];
+/* Clients of all the workers. The per-worker limit is rounded up, this
+ * keeps the total within CONFIG_HTTP_SERVER_MAX_CLIENTS.
+ */
+static atomic_t total_clients;
+static struct k_spinlock holder_lock;
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
 
@@ -64,6 +77,8 @@ static const char *const alpn_list[] = {"h2", "http/1.1"};
 
 static void close_client_connection(struct http_client_ctx *client);
 
+extern const k_tid_t http_server_tid;
+
 HTTP_SERVER_CONTENT_TYPE(html, "text/html")
 HTTP_SERVER_CONTENT_TYPE(css, "text/css")
 HTTP_SERVER_CONTENT_TYPE(js, "text/javascript")
@@ -89,6 +104,10 @@ int http_server_init(struct http_server_ctx *ctx)
 
 	HTTP_SERVICE_COUNT(&svc_count);
 
+#if defined(CONFIG_HTTP_SERVER_ROUTE_TABLE)
+	http_server_route_table_build();
+#endif
+
 	/* Initialize fds */
 	memset(ctx->fds, 0, sizeof(ctx->fds));
 	memset(ctx->clients, 0, sizeof(ctx->clients));
@@ -234,6 +253,17 @@ int http_server_init(struct http_server_ctx *ctx)
 			continue;
 		}
 
+		/* All workers are woken up by a new connection, the ones that
+		 * don't get it must not block in accept().
+		 */
+		if (HTTP_SERVER_NUM_WORKERS > 1 &&
+		    zsock_fcntl(fd, F_SETFL, O_NONBLOCK) < 0) {
+			LOG_ERR("fcntl: %d", errno);
+			failed++;
+			zsock_close(fd);
+			continue;
+		}
+
 		LOG_DBG("Initialized HTTP Service %s:%u",
 			svc->host ? svc->host : "<any>", *svc->port);
 
@@ -251,6 +281,7 @@ int http_server_init(struct http_server_ctx *ctx)
 
 	ctx->listen_fds = count;
 	ctx->num_clients = 0;
+	(void)atomic_set(&total_clients, 0);
 
 	return 0;
 }
@@ -280,19 +311,21 @@ static int accept_new_client(int server_fd)
 
 static void close_all_sockets(struct http_server_ctx *ctx)
 {
-	zsock_close(ctx->fds[0].fd); /* close eventfd */
-	ctx->fds[0].fd = -1;
+	/* The eventfd and the listen sockets of the other workers are
+	 * closed by the server thread, once they are done.
+	 */
+	int first = (ctx == &server_ctx[0]) ? 0 : ctx->listen_fds;
 
-	for (int i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
+	for (int i = first; i < ARRAY_SIZE(ctx->fds); i++) {
 		if (ctx->fds[i].fd < 0) {
 			continue;
 		}
 
 		if (i < ctx->listen_fds) {
-			zsock_close(ctx->fds[i].fd);
+			zsock_close(ctx->fds[i].fd); /* eventfd or listen socket */
 		} else {
 			struct http_client_ctx *client =
-				&server_ctx.clients[i - ctx->listen_fds];
+				&ctx->clients[i - ctx->listen_fds];
 
 			close_client_connection(client);
 		}
@@ -301,6 +334,66 @@ static void close_all_sockets(struct http_server_ctx *ctx)
 	}
 }
 
+static struct http_server_ctx *client_server_ctx(struct http_client_ctx *client)
+{
+	ARRAY_FOR_EACH(server_ctx, i) {
+		if (IS_ARRAY_ELEMENT(server_ctx[i].clients, client)) {
+			return &server_ctx[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* A full worker stops polling the listen sockets, leaving new connections
+ * to the other workers instead of accepting and closing them.
+ */
+static void listeners_poll_update(struct http_server_ctx *ctx)
+{
+	short events;
+
+	if (HTTP_SERVER_NUM_WORKERS == 1) {
+		return;
+	}
+
+	events = (ctx->num_clients < HTTP_SERVER_WORKER_MAX_CLIENTS) ? ZSOCK_POLLIN : 0;
+
+	for (int i = 1; i < ctx->listen_fds; i++) {
+		ctx->fds[i].events = events;
+	}
+}
+
+bool http_server_resource_claim(struct http_resource_detail_dynamic *detail,
+				struct http_client_ctx *client)
+{
+	bool claimed = false;
+
+	/* Clients of different workers may go for the same resource */
+	K_SPINLOCK(&holder_lock) {
+		if (detail->holder == NULL || detail->holder == client) {
+			detail->holder = client;
+			claimed = true;
+		}
+	}
+
+	return claimed;
+}
+
+bool http_server_resource_release(struct http_resource_detail_dynamic *detail,
+				  struct http_client_ctx *client)
+{
+	bool released = false;
+
+	K_SPINLOCK(&holder_lock) {
+		if (detail->holder == client) {
+			detail->holder = NULL;
+			released = true;
+		}
+	}
+
+	return released;
+}
+
 static void client_release_resources(struct http_client_ctx *client)
 {
 	struct http_resource_detail *detail;
@@ -318,15 +411,13 @@ static void client_release_resources(struct http_client_ctx *client)
 
 			dynamic_detail = (struct http_resource_detail_dynamic *)detail;
 
-			if (dynamic_detail->holder != client) {
-				continue;
-			}
-
 			/* If the client still holds the resource at this point,
 			 * it means the transaction was not complete. Release
 			 * the resource and notify application.
 			 */
-			dynamic_detail->holder = NULL;
+			if (!http_server_resource_release(dynamic_detail, client)) {
+				continue;
+			}
 
 			if (dynamic_detail->cb == NULL) {
 				continue;
@@ -344,21 +435,25 @@ void http_server_release_client(struct http_client_ctx *client)
 {
 	int i;
 	struct k_work_sync sync;
+	struct http_server_ctx *ctx = client_server_ctx(client);
 
-	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
+	__ASSERT_NO_MSG(ctx != NULL);
 
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
 
-	server_ctx.num_clients--;
+	ctx->num_clients--;
+	(void)atomic_dec(&total_clients);
 
-	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
-		if (server_ctx.fds[i].fd == client->fd) {
-			server_ctx.fds[i].fd = INVALID_SOCK;
+	for (i = ctx->listen_fds; i < ARRAY_SIZE(ctx->fds); i++) {
+		if (ctx->fds[i].fd == client->fd) {
+			ctx->fds[i].fd = INVALID_SOCK;
 			break;
 		}
 	}
 
+	listeners_poll_update(ctx);
+
 	memset(client, 0, sizeof(struct http_client_ctx));
 	client->fd = INVALID_SOCK;
 }
@@ -388,7 +483,7 @@ static void client_timeout(struct k_work *work)
 
 void http_client_timer_restart(struct http_client_ctx *client)
 {
-	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
+	__ASSERT_NO_MSG(client_server_ctx(client) != NULL);
 
 	k_work_reschedule(&client->inactivity_timer, INACTIVITY_TIMEOUT);
 }
@@ -402,6 +497,8 @@ static void init_client_ctx(struct http_client_ctx *client, int new_socket)
 	client->preface_sent = false;
 	client->window_size = HTTP_SERVER_INITIAL_WINDOW_SIZE;
 
+	http_hpack_table_init(&client->hpack_table);
+
 	memset(client->buffer, 0, sizeof(client->buffer));
 	memset(client->url_buffer, 0, sizeof(client->url_buffer));
 	k_work_init_delayable(&client->inactivity_timer, client_timeout);
@@ -520,6 +617,96 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
+#if HTTP_SERVER_NUM_WORKERS > 1
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, HTTP_SERVER_NUM_WORKERS - 1,
+				   CONFIG_HTTP_SERVER_STACK_SIZE);
+static struct k_thread worker_threads[HTTP_SERVER_NUM_WORKERS - 1];
+
+static int http_server_run(struct http_server_ctx *ctx);
+
+static void http_server_worker(void *p1, void *p2, void *p3)
+{
+	struct http_server_ctx *ctx = p1;
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	ret = http_server_run(ctx);
+	if (ret < 0) {
+		/* Have the server thread restart all the workers */
+		eventfd_write(server_ctx[0].fds[0].fd, 1);
+	}
+}
+
+/* Stop the workers started after the server thread, up to @a count */
+static void workers_stop(int count)
+{
+	for (int i = 1; i < count; i++) {
+		eventfd_write(server_ctx[i].fds[0].fd, 1);
+	}
+
+	for (int i = 1; i < count; i++) {
+		k_thread_join(&worker_threads[i - 1], K_FOREVER);
+
+		zsock_close(server_ctx[i].fds[0].fd);
+		server_ctx[i].fds[0].fd = INVALID_SOCK;
+	}
+}
+
+/* Start the other workers on the listen sockets of the server thread */
+static int workers_start(void)
+{
+	struct http_server_ctx *ctx;
+	int fd;
+
+	for (int i = 1; i < HTTP_SERVER_NUM_WORKERS; i++) {
+		ctx = &server_ctx[i];
+
+		memset(ctx->fds, 0, sizeof(ctx->fds));
+		memset(ctx->clients, 0, sizeof(ctx->clients));
+
+		for (int j = 0; j < ARRAY_SIZE(ctx->fds); j++) {
+			ctx->fds[j].fd = INVALID_SOCK;
+		}
+
+		fd = eventfd(0, 0);
+		if (fd < 0) {
+			fd = -errno;
+			LOG_ERR("eventfd failed (%d)", fd);
+			workers_stop(i);
+			return fd;
+		}
+
+		ctx->fds[0].fd = fd;
+		ctx->fds[0].events = ZSOCK_POLLIN;
+
+		for (int j = 1; j < server_ctx[0].listen_fds; j++) {
+			ctx->fds[j].fd = server_ctx[0].fds[j].fd;
+			ctx->fds[j].events = ZSOCK_POLLIN;
+		}
+
+		ctx->listen_fds = server_ctx[0].listen_fds;
+		ctx->num_clients = 0;
+
+		k_thread_create(&worker_threads[i - 1], worker_stacks[i - 1],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i - 1]),
+				http_server_worker, ctx, NULL, NULL,
+				THREAD_PRIORITY, 0, K_FOREVER);
+		k_thread_name_set(&worker_threads[i - 1], "http_server_worker");
+#if defined(CONFIG_HTTP_SERVER_WORKER_PER_CPU)
+		(void)k_thread_cpu_pin(&worker_threads[i - 1], i % arch_num_cpus());
+#endif
+		k_thread_start(&worker_threads[i - 1]);
+	}
+
+	return 0;
+}
+#else
+#define workers_start() 0
+#define workers_stop(count) do { } while (false)
+#endif /* HTTP_SERVER_NUM_WORKERS > 1 */
+
 static int http_server_run(struct http_server_ctx *ctx)
 {
 	struct http_client_ctx *client;
@@ -602,6 +789,13 @@ static int http_server_run(struct http_server_ctx *ctx)
 
 				found_slot = false;
 
+				if (atomic_inc(&total_clients) >= HTTP_SERVER_MAX_CLIENTS) {
+					LOG_DBG("Too many clients.");
+					(void)atomic_dec(&total_clients);
+					zsock_close(new_socket);
+					continue;
+				}
+
 				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
 					if (ctx->fds[j].fd != INVALID_SOCK) {
 						continue;
@@ -612,6 +806,7 @@ static int http_server_run(struct http_server_ctx *ctx)
 					ctx->fds[j].revents = 0;
 
 					ctx->num_clients++;
+					listeners_poll_update(ctx);
 
 					LOG_DBG("Init client #%d", j - ctx->listen_fds);
 
@@ -623,6 +818,7 @@ static int http_server_run(struct http_server_ctx *ctx)
 
 				if (!found_slot) {
 					LOG_DBG("No free slot found.");
+					(void)atomic_dec(&total_clients);
 					zsock_close(new_socket);
 				}
 
@@ -673,6 +869,10 @@ static int http_server_run(struct http_server_ctx *ctx)
 	return 0;
 
 closing:
+	if (ctx == &server_ctx[0]) {
+		workers_stop(HTTP_SERVER_NUM_WORKERS);
+	}
+
 	/* Close all client connections and the server socket */
 	close_all_sockets(ctx);
 	return ret;
@@ -713,10 +913,210 @@ static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
 	return false;
 }
 
+#if defined(CONFIG_HTTP_SERVER_ROUTE_TABLE)
+
+/* Each resource has an exact entry and, with wildcards, a prefix entry */
+#define ROUTE_MAX_ENTRIES (2 * CONFIG_HTTP_SERVER_ROUTE_TABLE_MAX_RESOURCES)
+#define ROUTE_BUCKETS     ROUTE_MAX_ENTRIES
+#define ROUTE_NONE        UINT16_MAX
+
+/* How a path matches the resource of a route entry whose key it contains */
+#define ROUTE_EXACT       BIT(0) /* the key is the whole path, see compare_strings() */
+#define ROUTE_LEADING_DIR BIT(1) /* the path goes on with a '/' after the literal key */
+#define ROUTE_GLOB        BIT(2) /* fnmatch() the pattern, the key is its leading dir */
+
+#define ROUTE_HASH_INIT 2166136261U
+
+struct route_entry {
+	struct http_resource_desc *resource;
+	uint32_t hash;
+	uint16_t key_len;
+	/* Position of the resource when going through all of them */
+	uint16_t order;
+	uint16_t next;
+	uint8_t flags;
+};
+
+static struct {
+	struct route_entry entries[ROUTE_MAX_ENTRIES];
+	uint16_t buckets[ROUTE_BUCKETS];
+	uint16_t count;
+	bool built;
+} routes;
+
+/* FNV-1a, fed one character at a time so that every prefix of a path is
+ * hashed in a single pass.
+ */
+static inline uint32_t route_hash_step(uint32_t hash, char c)
+{
+	return (hash ^ (uint8_t)c) * 16777619U;
+}
+
+static int route_add(struct http_resource_desc *resource, uint16_t order,
+		     size_t key_len, uint8_t flags)
+{
+	struct route_entry *entry;
+	uint32_t hash = ROUTE_HASH_INIT;
+
+	if (routes.count == ROUTE_MAX_ENTRIES) {
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i < key_len; i++) {
+		hash = route_hash_step(hash, resource->resource[i]);
+	}
+
+	entry = &routes.entries[routes.count];
+	entry->resource = resource;
+	entry->hash = hash;
+	entry->key_len = key_len;
+	entry->order = order;
+	entry->flags = flags;
+	entry->next = routes.buckets[hash % ROUTE_BUCKETS];
+
+	routes.buckets[hash % ROUTE_BUCKETS] = routes.count++;
+
+	return 0;
+}
+
+void http_server_route_table_build(void)
+{
+	uint16_t order = 0;
+	int ret;
+
+	if (routes.built) {
+		return;
+	}
+
+	routes.count = 0;
+
+	for (int i = 0; i < ROUTE_BUCKETS; i++) {
+		routes.buckets[i] = ROUTE_NONE;
+	}
+
+	HTTP_SERVICE_FOREACH(service) {
+		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+			const char *str = resource->resource;
+			size_t key_len = strcspn(str, "?");
+			size_t literal_len = strcspn(str, "*?[\\");
+
+			if (!IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+				ret = route_add(resource, order, key_len, ROUTE_EXACT);
+			} else if (str[literal_len] == '\0') {
+				ret = route_add(resource, order, key_len,
+						ROUTE_EXACT | ROUTE_LEADING_DIR);
+			} else {
+				ret = route_add(resource, order, key_len, ROUTE_EXACT);
+				if (ret == 0) {
+					/* Only a whole leading directory is needed
+					 * to find the pattern, keep its '/'.
+					 */
+					while (literal_len > 0 && str[literal_len - 1] != '/') {
+						literal_len--;
+					}
+
+					ret = route_add(resource, order, literal_len, ROUTE_GLOB);
+				}
+			}
+
+			if (ret < 0) {
+				LOG_WRN("Too many resources for the route table (max %d)",
+					CONFIG_HTTP_SERVER_ROUTE_TABLE_MAX_RESOURCES);
+				return;
+			}
+
+			order++;
+		}
+	}
+
+	routes.built = true;
+}
+
+/* Look for a resource matching the path through the entries keyed by its
+ * first len characters, better than the one found so far.
+ */
+static void route_scan(const char *path, size_t len, uint32_t hash, uint8_t flags,
+		       bool is_websocket, struct route_entry **match)
+{
+	uint16_t best = (*match != NULL) ? (*match)->order : ROUTE_NONE;
+	struct route_entry *entry;
+
+	for (uint16_t i = routes.buckets[hash % ROUTE_BUCKETS]; i != ROUTE_NONE;
+	     i = entry->next) {
+		entry = &routes.entries[i];
+
+		if ((entry->flags & flags) == 0 || entry->order >= best ||
+		    entry->hash != hash || entry->key_len != len ||
+		    memcmp(entry->resource->resource, path, len) != 0 ||
+		    skip_this(entry->resource, is_websocket)) {
+			continue;
+		}
+
+		if (flags == ROUTE_GLOB &&
+		    fnmatch(entry->resource->resource, path,
+			    (FNM_PATHNAME | FNM_LEADING_DIR)) != 0) {
+			continue;
+		}
+
+		best = entry->order;
+		*match = entry;
+	}
+}
+
+static struct http_resource_desc *route_lookup(const char *path, bool is_websocket)
+{
+	struct route_entry *match = NULL;
+	uint32_t hash = ROUTE_HASH_INIT;
+	size_t len = strcspn(path, "?");
+
+	for (size_t i = 0; i < len; i++) {
+		if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+			if (i == 0 || path[i - 1] == '/') {
+				route_scan(path, i, hash, ROUTE_GLOB, is_websocket, &match);
+			}
+
+			if (path[i] == '/') {
+				route_scan(path, i, hash, ROUTE_LEADING_DIR, is_websocket,
+					   &match);
+			}
+		}
+
+		hash = route_hash_step(hash, path[i]);
+	}
+
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) &&
+	    (len == 0 || path[len - 1] == '/')) {
+		route_scan(path, len, hash, ROUTE_GLOB, is_websocket, &match);
+	}
+
+	route_scan(path, len, hash, ROUTE_EXACT, is_websocket, &match);
+
+	return (match != NULL) ? match->resource : NULL;
+}
+
+#endif /* CONFIG_HTTP_SERVER_ROUTE_TABLE */
+
 struct http_resource_detail *get_resource_detail(const char *path,
 						 int *path_len,
 						 bool is_websocket)
 {
+#if defined(CONFIG_HTTP_SERVER_ROUTE_TABLE)
+	if (routes.built) {
+		struct http_resource_desc *resource = route_lookup(path, is_websocket);
+
+		if (resource != NULL) {
+			NET_DBG("Got match for %s", resource->resource);
+
+			*path_len = strlen(resource->resource);
+			return resource->detail;
+		}
+
+		NET_DBG("No match for %s", path);
+
+		return NULL;
+	}
+#endif
+
 	HTTP_SERVICE_FOREACH(service) {
 		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
 			if (skip_this(resource, is_websocket)) {
@@ -859,6 +1259,14 @@ int http_server_start(void)
 	server_running = true;
 	k_sem_give(&server_start);
 
+#if defined(CONFIG_HTTP_SERVER_WORKER_PER_CPU)
+	/* The server thread is the first worker, it waits to be pinned to
+	 * the first CPU before starting.
+	 */
+	(void)k_thread_cpu_pin(http_server_tid, 0);
+	k_thread_start(http_server_tid);
+#endif
+
 	LOG_DBG("Starting HTTP server");
 
 	return 0;
@@ -873,7 +1281,7 @@ int http_server_stop(void)
 
 	server_running = false;
 	k_sem_reset(&server_start);
-	eventfd_write(server_ctx.fds[0].fd, 1);
+	eventfd_write(server_ctx[0].fds[0].fd, 1);
 
 	LOG_DBG("Stopping HTTP server");
 
@@ -892,13 +1300,19 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 		k_sem_take(&server_start, K_FOREVER);
 
 		while (server_running) {
-			ret = http_server_init(&server_ctx);
+			ret = http_server_init(&server_ctx[0]);
 			if (ret < 0) {
 				LOG_ERR("Failed to initialize HTTP2 server");
 				goto again;
 			}
 
-			ret = http_server_run(&server_ctx);
+			ret = workers_start();
+			if (ret < 0) {
+				close_all_sockets(&server_ctx[0]);
+				goto again;
+			}
+
+			ret = http_server_run(&server_ctx[0]);
 			if (!server_running) {
 				continue;
 			}
@@ -910,5 +1324,13 @@ again:
 	}
 }
 
+#if defined(CONFIG_HTTP_SERVER_WORKER_PER_CPU)
+/* Started by http_server_start() */
+#define SERVER_THREAD_DELAY SYS_FOREVER_MS
+#else
+#define SERVER_THREAD_DELAY 0
+#endif
+
 K_THREAD_DEFINE(http_server_tid, CONFIG_HTTP_SERVER_STACK_SIZE,
-		http_server_thread, NULL, NULL, NULL, THREAD_PRIORITY, 0, 0);
+		http_server_thread, NULL, NULL, NULL, THREAD_PRIORITY, 0,
+		SERVER_THREAD_DELAY);
@@ -0,0 +1,475 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/dlist.h>
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE_LAST_MODIFIED)
+#include <zephyr/posix/time.h>
+#endif
+
+LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
+
+#include "headers/server_internal.h"
+
+#define FS_CACHE_ETAG_LEN sizeof("\"01234567-0123456789abcdef\"")
+
+#define FS_CACHE_HTTP1_OK                                                                          \
+	"HTTP/1.1 200 OK\r\n"                                                                      \
+	"Content-Type: %s\r\n"                                                                     \
+	"Content-Length: %zu\r\n"                                                                  \
+	"%s"                                                                                       \
+	"ETag: %s\r\n"                                                                             \
+	"%s\r\n"
+#define FS_CACHE_HTTP1_NOT_MODIFIED                                                                \
+	"HTTP/1.1 304 Not Modified\r\n"                                                            \
+	"ETag: %s\r\n"                                                                             \
+	"%s\r\n"
+#define FS_CACHE_CONTENT_ENCODING_GZIP "Content-Encoding: gzip\r\n"
+#define FS_CACHE_LAST_MODIFIED         "Last-Modified: %s\r\n"
+
+#define FS_CACHE_LAST_MODIFIED_LEN (sizeof(FS_CACHE_LAST_MODIFIED) + HTTP_SERVER_HTTP_DATE_LEN)
+
+/* Room taken by the strings of an entry, besides its URL and content type */
+#define FS_CACHE_STRINGS_LEN                                                                       \
+	(FS_CACHE_ETAG_LEN + HTTP_SERVER_HTTP_DATE_LEN +                                           \
+	 sizeof(FS_CACHE_HTTP1_OK) + sizeof("18446744073709551615") +                              \
+	 sizeof(FS_CACHE_CONTENT_ENCODING_GZIP) + FS_CACHE_ETAG_LEN + FS_CACHE_LAST_MODIFIED_LEN + \
+	 sizeof(FS_CACHE_HTTP1_NOT_MODIFIED) + FS_CACHE_ETAG_LEN + FS_CACHE_LAST_MODIFIED_LEN)
+
+static K_HEAP_DEFINE(fs_cache_heap, CONFIG_HTTP_SERVER_STATIC_FS_CACHE_SIZE);
+static struct http_server_fs_cache_entry
+	fs_cache_entries[CONFIG_HTTP_SERVER_STATIC_FS_CACHE_ENTRIES];
+/* Entries that can be looked up, most recently used first */
+static sys_dlist_t fs_cache_lru = SYS_DLIST_STATIC_INIT(&fs_cache_lru);
+/* The cache is shared by the server workers */
+static K_MUTEX_DEFINE(fs_cache_lock);
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE_LAST_MODIFIED)
+/* Format an IMF-fixdate, as used by the Last-Modified and If-Modified-Since
+ * headers.
+ */
+static void fs_cache_http_date(time_t t, char *buf, size_t size)
+{
+	static const char *const wdays[] = {
+		"Thu", "Fri", "Sat", "Sun", "Mon", "Tue", "Wed",
+	};
+	static const char *const months[] = {
+		"Mar", "Apr", "May", "Jun", "Jul", "Aug",
+		"Sep", "Oct", "Nov", "Dec", "Jan", "Feb",
+	};
+	uint32_t days = t / 86400;
+	uint32_t secs = t % 86400;
+	/* Civil date from the days since the epoch, with years starting in
+	 * March so that leap days come last.
+	 */
+	uint32_t z = days + 719468;
+	uint32_t era = z / 146097;
+	uint32_t doe = z - era * 146097;
+	uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	uint32_t mp = (5 * doy + 2) / 153;
+	uint32_t year = yoe + era * 400 + (mp >= 10 ? 1 : 0);
+
+	snprintk(buf, size, "%s, %02u %s %04u %02u:%02u:%02u GMT", wdays[days % 7],
+		 doy - (153 * mp + 2) / 5 + 1, months[mp], year, secs / 3600,
+		 (secs / 60) % 60, secs % 60);
+}
+#endif
+
+static struct http_server_fs_cache_entry *fs_cache_find(
+	struct http_resource_detail_static_fs *detail, const char *url)
+{
+	struct http_server_fs_cache_entry *entry;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&fs_cache_lru, entry, node) {
+		if (entry->detail == detail && strcmp(entry->url, url) == 0) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void fs_cache_free(struct http_server_fs_cache_entry *entry)
+{
+	k_heap_free(&fs_cache_heap, entry->block);
+	entry->block = NULL;
+	entry->stale = false;
+}
+
+/* Remove @a entry from the cache, its memory is freed once no client is
+ * being sent its file anymore.
+ */
+static void fs_cache_drop(struct http_server_fs_cache_entry *entry)
+{
+	sys_dlist_remove(&entry->node);
+
+	if (entry->users == 0) {
+		fs_cache_free(entry);
+	} else {
+		entry->stale = true;
+	}
+}
+
+/* Drop the least recently used entry that is not being sent */
+static bool fs_cache_evict(void)
+{
+	sys_dnode_t *node;
+
+	for (node = sys_dlist_peek_tail(&fs_cache_lru); node != NULL;
+	     node = sys_dlist_peek_prev(&fs_cache_lru, node)) {
+		struct http_server_fs_cache_entry *entry =
+			CONTAINER_OF(node, struct http_server_fs_cache_entry, node);
+
+		if (entry->users == 0) {
+			LOG_DBG("Evicting %s", entry->url);
+			fs_cache_drop(entry);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static struct http_server_fs_cache_entry *fs_cache_slot(void)
+{
+	do {
+		ARRAY_FOR_EACH_PTR(fs_cache_entries, entry) {
+			if (entry->block == NULL) {
+				return entry;
+			}
+		}
+	} while (fs_cache_evict());
+
+	return NULL;
+}
+
+static void *fs_cache_alloc(size_t size)
+{
+	void *block;
+	bool evicted;
+
+	while (true) {
+		block = k_heap_alloc(&fs_cache_heap, size, K_NO_WAIT);
+		if (block != NULL) {
+			return block;
+		}
+
+		k_mutex_lock(&fs_cache_lock, K_FOREVER);
+		evicted = fs_cache_evict();
+		k_mutex_unlock(&fs_cache_lock);
+
+		if (!evicted) {
+			return NULL;
+		}
+	}
+}
+
+static int fs_cache_read(const char *fname, uint8_t *data, size_t len)
+{
+	struct fs_file_t file;
+	ssize_t ret;
+
+	fs_file_t_init(&file);
+
+	ret = fs_open(&file, fname, FS_O_READ);
+	if (ret < 0) {
+		LOG_ERR("fs_open %s: %d", fname, (int)ret);
+		return ret;
+	}
+
+	while (len > 0) {
+		ret = fs_read(&file, data, len);
+		if (ret <= 0) {
+			LOG_ERR("Filesystem read error (%d)", (int)ret);
+			ret = (ret == 0) ? -EIO : ret;
+			break;
+		}
+
+		data += ret;
+		len -= ret;
+	}
+
+	fs_close(&file);
+
+	return (len == 0) ? 0 : ret;
+}
+
+/* Read the file served for @a url into a new entry, without inserting it */
+static int fs_cache_load(struct http_resource_detail_static_fs *detail, char *url,
+			 struct http_server_fs_cache_entry *entry)
+{
+	char fname[HTTP_SERVER_MAX_URL_LENGTH];
+	char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN] = "text/html";
+	char last_modified[FS_CACHE_LAST_MODIFIED_LEN] = "";
+	size_t url_len = strlen(url);
+	size_t file_size;
+	size_t size;
+	bool gzipped = false;
+	char *str;
+	char *end;
+	int ret;
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE_LAST_MODIFIED)
+	struct timespec now;
+#endif
+
+	/* get filename and content-type from url */
+	if (url_len == 1) {
+		/* url is just the leading slash, use index.html as filename */
+		snprintk(fname, sizeof(fname), "%s/index.html", detail->fs_path);
+	} else {
+		http_server_get_content_type_from_extension(url, content_type,
+							    sizeof(content_type));
+		snprintk(fname, sizeof(fname), "%s%s", detail->fs_path, url);
+	}
+
+	ret = http_server_find_file(fname, sizeof(fname), &file_size, &gzipped);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (file_size > CONFIG_HTTP_SERVER_STATIC_FS_CACHE_MAX_FILE_SIZE) {
+		return -EFBIG;
+	}
+
+	/* The content type is both on its own and in the HTTP/1 response */
+	size = file_size + url_len + 1 + 2 * (strlen(content_type) + 1) + FS_CACHE_STRINGS_LEN;
+	if (size > CONFIG_HTTP_SERVER_STATIC_FS_CACHE_SIZE) {
+		return -EFBIG;
+	}
+
+	memset(entry, 0, sizeof(*entry));
+
+	entry->block = fs_cache_alloc(size);
+	if (entry->block == NULL) {
+		LOG_DBG("No room to cache %s", fname);
+		return -ENOMEM;
+	}
+
+	ret = fs_cache_read(fname, entry->block, file_size);
+	if (ret < 0) {
+		k_heap_free(&fs_cache_heap, entry->block);
+		return ret;
+	}
+
+	entry->detail = detail;
+	entry->data = entry->block;
+	entry->data_len = file_size;
+	entry->crc = crc32_ieee(entry->data, file_size);
+	entry->gzipped = gzipped;
+	entry->checked = k_uptime_get();
+
+	str = (char *)entry->block + file_size;
+	end = (char *)entry->block + size;
+
+	entry->url = memcpy(str, url, url_len + 1);
+	str += url_len + 1;
+
+	entry->etag = str;
+	str += snprintk(str, end - str, "\"%08x-%zx\"", entry->crc, file_size) + 1;
+	entry->http2_headers[entry->http2_header_count++] =
+		(struct http_header){"etag", entry->etag};
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE_LAST_MODIFIED)
+	if (clock_gettime(CLOCK_REALTIME, &now) == 0) {
+		fs_cache_http_date(now.tv_sec, str, end - str);
+		entry->last_modified = str;
+		str += strlen(str) + 1;
+
+		snprintk(last_modified, sizeof(last_modified), FS_CACHE_LAST_MODIFIED,
+			 entry->last_modified);
+		entry->http2_headers[entry->http2_header_count++] =
+			(struct http_header){"last-modified", entry->last_modified};
+	}
+#endif
+
+	entry->http2_validator_count = entry->http2_header_count;
+
+	entry->http2_headers[entry->http2_header_count++] =
+		(struct http_header){"content-type", strcpy(str, content_type)};
+	str += strlen(str) + 1;
+
+	if (gzipped) {
+		entry->http2_headers[entry->http2_header_count++] =
+			(struct http_header){"content-encoding", "gzip"};
+	}
+
+	entry->http1_ok = str;
+	entry->http1_ok_len = snprintk(str, end - str, FS_CACHE_HTTP1_OK, content_type, file_size,
+				       gzipped ? FS_CACHE_CONTENT_ENCODING_GZIP : "",
+				       entry->etag, last_modified);
+	str += entry->http1_ok_len + 1;
+
+	entry->http1_not_modified = str;
+	entry->http1_not_modified_len = snprintk(str, end - str, FS_CACHE_HTTP1_NOT_MODIFIED,
+						 entry->etag, last_modified);
+
+	__ASSERT_NO_MSG(str + entry->http1_not_modified_len < end);
+
+	return 0;
+}
+
+static bool fs_cache_expired(struct http_server_fs_cache_entry *entry)
+{
+	const int64_t interval = CONFIG_HTTP_SERVER_STATIC_FS_CACHE_REVALIDATE_MS;
+
+	return (interval > 0) && (k_uptime_get() - entry->checked >= interval);
+}
+
+static void fs_cache_use(struct http_server_fs_cache_entry *entry)
+{
+	sys_dlist_remove(&entry->node);
+	sys_dlist_prepend(&fs_cache_lru, &entry->node);
+	entry->users++;
+}
+
+int http_server_fs_cache_get(struct http_resource_detail_static_fs *detail, char *url,
+			     struct http_server_fs_cache_entry **entry)
+{
+	struct http_server_fs_cache_entry *cached;
+	struct http_server_fs_cache_entry loaded;
+	int ret;
+
+	k_mutex_lock(&fs_cache_lock, K_FOREVER);
+
+	cached = fs_cache_find(detail, url);
+	if (cached != NULL && !fs_cache_expired(cached)) {
+		fs_cache_use(cached);
+		k_mutex_unlock(&fs_cache_lock);
+
+		*entry = cached;
+		return 0;
+	}
+
+	k_mutex_unlock(&fs_cache_lock);
+
+	/* Not cached, or time to check the cached copy for changes. The file is
+	 * read without the lock held so that the other workers can still be
+	 * served from the cache meanwhile.
+	 */
+	ret = fs_cache_load(detail, url, &loaded);
+
+	k_mutex_lock(&fs_cache_lock, K_FOREVER);
+
+	cached = fs_cache_find(detail, url);
+
+	if (ret < 0) {
+		/* Whatever the reason, the cached copy cannot be trusted anymore */
+		if (cached != NULL) {
+			fs_cache_drop(cached);
+		}
+
+		k_mutex_unlock(&fs_cache_lock);
+		return ret;
+	}
+
+	if (cached != NULL) {
+		if (cached->crc == loaded.crc && cached->data_len == loaded.data_len &&
+		    cached->gzipped == loaded.gzipped) {
+			/* Unchanged, keep the cached copy and its validators */
+			cached->checked = loaded.checked;
+			fs_cache_use(cached);
+			k_mutex_unlock(&fs_cache_lock);
+
+			k_heap_free(&fs_cache_heap, loaded.block);
+
+			*entry = cached;
+			return 0;
+		}
+
+		LOG_DBG("%s changed", url);
+		fs_cache_drop(cached);
+	}
+
+	cached = fs_cache_slot();
+	if (cached == NULL) {
+		k_mutex_unlock(&fs_cache_lock);
+
+		k_heap_free(&fs_cache_heap, loaded.block);
+		return -ENOMEM;
+	}
+
+	*cached = loaded;
+	sys_dlist_prepend(&fs_cache_lru, &cached->node);
+	cached->users++;
+
+	k_mutex_unlock(&fs_cache_lock);
+
+	*entry = cached;
+	return 0;
+}
+
+void http_server_fs_cache_put(struct http_server_fs_cache_entry *entry)
+{
+	k_mutex_lock(&fs_cache_lock, K_FOREVER);
+
+	entry->users--;
+	if (entry->users == 0 && entry->stale) {
+		fs_cache_free(entry);
+	}
+
+	k_mutex_unlock(&fs_cache_lock);
+}
+
+static bool fs_cache_etag_match(const char *etag, const char *list)
+{
+	size_t etag_len = strlen(etag);
+	size_t len;
+
+	while (true) {
+		list += strspn(list, " \t,");
+		if (*list == '\0') {
+			return false;
+		}
+
+		/* If-None-Match uses the weak comparison */
+		if (strncmp(list, "W/", 2) == 0) {
+			list += 2;
+		}
+
+		len = strcspn(list, " \t,");
+		if ((len == 1 && list[0] == '*') ||
+		    (len == etag_len && memcmp(list, etag, len) == 0)) {
+			return true;
+		}
+
+		list += len;
+	}
+}
+
+bool http_server_fs_cache_not_modified(const struct http_server_fs_cache_entry *entry,
+				       const struct http_client_ctx *client)
+{
+	/* If-Modified-Since is ignored when If-None-Match is present */
+	if (client->if_none_match[0] != '\0') {
+		return fs_cache_etag_match(entry->etag, client->if_none_match);
+	}
+
+	return entry->last_modified != NULL && client->if_modified_since[0] != '\0' &&
+	       strcmp(client->if_modified_since, entry->last_modified) == 0;
+}
+
+void http_server_fs_cache_flush(void)
+{
+	struct http_server_fs_cache_entry *entry;
+	struct http_server_fs_cache_entry *next;
+
+	k_mutex_lock(&fs_cache_lock, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&fs_cache_lru, entry, next, node) {
+		fs_cache_drop(entry);
+	}
+
+	k_mutex_unlock(&fs_cache_lock);
+}
@@ -287,7 +287,7 @@ static int dynamic_get_req(struct http_resource_detail_dynamic *dynamic_detail,
 		len = 0;
 	} while (!http_response_is_final(&response_ctx, status));
 
-	dynamic_detail->holder = NULL;
+	(void)http_server_resource_release(dynamic_detail, client);
 
 	ret = http_server_sendall(client, final_chunk,
 				  sizeof(final_chunk) - 1);
@@ -375,7 +375,7 @@ static int dynamic_post_req(struct http_resource_detail_dynamic *dynamic_detail,
 			return ret;
 		}
 
-		dynamic_detail->holder = NULL;
+		(void)http_server_resource_release(dynamic_detail, client);
 	}
 
 	return 0;
@@ -383,6 +383,26 @@ static int dynamic_post_req(struct http_resource_detail_dynamic *dynamic_detail,
 
 #if defined(CONFIG_FILE_SYSTEM)
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+static int send_http1_cached_fs_resource(struct http_server_fs_cache_entry *entry,
+					 struct http_client_ctx *client)
+{
+	int ret;
+
+	if (http_server_fs_cache_not_modified(entry, client)) {
+		return http_server_sendall(client, entry->http1_not_modified,
+					   entry->http1_not_modified_len);
+	}
+
+	ret = http_server_sendall(client, entry->http1_ok, entry->http1_ok_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return http_server_sendall(client, entry->data, entry->data_len);
+}
+#endif
+
 int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *static_fs_detail,
 				    struct http_client_ctx *client)
 {
@@ -404,6 +424,9 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 	 */
 	char http_response[sizeof(RESPONSE_TEMPLATE_STATIC_FS) + HTTP_SERVER_MAX_CONTENT_TYPE_LEN +
 			   sizeof(CONTENT_ENCODING_GZIP)];
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	struct http_server_fs_cache_entry *entry;
+#endif
 
 	if (!(static_fs_detail->common.bitmask_of_supported_http_methods & BIT(HTTP_GET))) {
 		ret = http_server_sendall(client, not_allowed_response,
@@ -414,6 +437,27 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 		return ret;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	ret = http_server_fs_cache_get(static_fs_detail, client->url_buffer, &entry);
+	if (ret == 0) {
+		ret = send_http1_cached_fs_resource(entry, client);
+		http_server_fs_cache_put(entry);
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+		}
+		return ret;
+	} else if (ret == -ENOENT) {
+		ret = http_server_sendall(client, not_found_response,
+					  sizeof(not_found_response) - 1);
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+		}
+		return ret;
+	}
+
+	/* Not cacheable, read it from the filesystem */
+#endif
+
 	/* get filename and content-type from url */
 	len = strlen(client->url_buffer);
 	if (len == 1) {
@@ -498,7 +542,7 @@ static int handle_http1_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_resource_claim(dynamic_detail, client)) {
 		ret = http_server_sendall(client, conflict_response,
 					  sizeof(conflict_response) - 1);
 		if (ret < 0) {
@@ -509,8 +553,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
@@ -520,7 +562,7 @@ static int handle_http1_dynamic_resource(
 				return ret;
 			}
 
-			dynamic_detail->holder = NULL;
+			(void)http_server_resource_release(dynamic_detail, client);
 
 			return 0;
 		}
@@ -619,6 +661,12 @@ static int on_header_field(struct http_parser *parser, const char *at,
 				ctx->has_upgrade_header = true;
 			} else if (strcasecmp(ctx->header_buffer, "Sec-WebSocket-Key") == 0) {
 				ctx->websocket_sec_key_next = true;
+			} else if (IS_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE) &&
+				   strcasecmp(ctx->header_buffer, "If-None-Match") == 0) {
+				ctx->if_none_match_next = true;
+			} else if (IS_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE) &&
+				   strcasecmp(ctx->header_buffer, "If-Modified-Since") == 0) {
+				ctx->if_modified_since_next = true;
 			}
 
 			ctx->header_buffer[0] = '\0';
@@ -706,6 +754,20 @@ static int on_header_value(struct http_parser *parser,
 				ctx->websocket_sec_key_next = false;
 			}
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+			if (ctx->if_none_match_next) {
+				strncpy(ctx->if_none_match, ctx->header_buffer,
+					sizeof(ctx->if_none_match) - 1);
+				ctx->if_none_match_next = false;
+			}
+
+			if (ctx->if_modified_since_next) {
+				strncpy(ctx->if_modified_since, ctx->header_buffer,
+					sizeof(ctx->if_modified_since) - 1);
+				ctx->if_modified_since_next = false;
+			}
+#endif
+
 			ctx->header_buffer[0] = '\0';
 		}
 	}
@@ -792,6 +854,11 @@ int enter_http1_request(struct http_client_ctx *client)
 	memset(client->header_buffer, 0, sizeof(client->header_buffer));
 	memset(client->url_buffer, 0, sizeof(client->url_buffer));
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	memset(client->if_none_match, 0, sizeof(client->if_none_match));
+	memset(client->if_modified_since, 0, sizeof(client->if_modified_since));
+#endif
+
 	return 0;
 }
 
@@ -116,9 +116,12 @@ static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 	client->header_field.value = value;
 	client->header_field.value_len = strlen(value);
 
-	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field);
+	ret = http_hpack_table_encode_header(&client->hpack_table, *buf, *buflen,
+					     &client->header_field);
 	if (ret < 0) {
 		LOG_DBG("Failed to encode header, err %d", ret);
+		/* The header block will not be sent */
+		http_hpack_table_reset(&client->hpack_table);
 		return ret;
 	}
 
@@ -393,6 +396,50 @@ out:
 	return ret;
 }
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+static int send_http2_cached_fs_resource(struct http_server_fs_cache_entry *entry,
+					 struct http2_frame *frame,
+					 struct http_client_ctx *client)
+{
+	int ret;
+
+	if (http_server_fs_cache_not_modified(entry, client)) {
+		ret = send_headers_frame(client, HTTP_304_NOT_MODIFIED, frame->stream_identifier,
+					 NULL, HTTP2_FLAG_END_STREAM, entry->http2_headers,
+					 entry->http2_validator_count);
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+			return ret;
+		}
+
+		client->current_stream->headers_sent = true;
+		client->current_stream->end_stream_sent = true;
+
+		return 0;
+	}
+
+	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier, NULL, 0,
+				 entry->http2_headers, entry->http2_header_count);
+	if (ret < 0) {
+		LOG_DBG("Cannot write to socket (%d)", ret);
+		return ret;
+	}
+
+	client->current_stream->headers_sent = true;
+
+	ret = send_data_frame(client, entry->data, entry->data_len, frame->stream_identifier,
+			      HTTP2_FLAG_END_STREAM);
+	if (ret < 0) {
+		LOG_DBG("Cannot write to socket (%d)", ret);
+		return ret;
+	}
+
+	client->current_stream->end_stream_sent = true;
+
+	return 0;
+}
+#endif
+
 static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs *static_fs_detail,
 					   struct http2_frame *frame,
 					   struct http_client_ctx *client)
@@ -412,6 +459,9 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 	int len;
 	int remaining;
 	char tmp[64];
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	struct http_server_fs_cache_entry *entry;
+#endif
 
 	if (!(static_fs_detail->common.bitmask_of_supported_http_methods & BIT(HTTP_GET))) {
 		return -ENOTSUP;
@@ -421,6 +471,19 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	ret = http_server_fs_cache_get(static_fs_detail, client->url_buffer, &entry);
+	if (ret == 0) {
+		ret = send_http2_cached_fs_resource(entry, frame, client);
+		http_server_fs_cache_put(entry);
+		return ret;
+	} else if (ret == -ENOENT) {
+		return send_http2_404(client, frame);
+	}
+
+	/* Not cacheable, read it from the filesystem */
+#endif
+
 	/* get filename and content-type from url */
 	len = strlen(client->url_buffer);
 	if (len == 1) {
@@ -603,7 +666,7 @@ static int dynamic_get_req_v2(struct http_resource_detail_dynamic *dynamic_detai
 		}
 	}
 
-	dynamic_detail->holder = NULL;
+	(void)http_server_resource_release(dynamic_detail, client);
 
 	return ret;
 }
@@ -699,7 +762,7 @@ static int dynamic_post_req_v2(struct http_resource_detail_dynamic *dynamic_deta
 		}
 
 		client->current_stream->end_stream_sent = true;
-		dynamic_detail->holder = NULL;
+		(void)http_server_resource_release(dynamic_detail, client);
 	}
 
 	return ret;
@@ -722,7 +785,7 @@ static int handle_http2_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_resource_claim(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -731,8 +794,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 		if (user_method & BIT(HTTP_GET)) {
@@ -863,6 +924,11 @@ static int enter_http_frame_headers_state(struct http_client_ctx *client)
 		client->expect_continuation = false;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	client->if_none_match[0] = '\0';
+	client->if_modified_since[0] = '\0';
+#endif
+
 	if (IS_ENABLED(CONFIG_HTTP_SERVER_CAPTURE_HEADERS)) {
 		/* Reset header capture state for new headers frame */
 		client->header_capture_ctx.count = 0;
@@ -1292,6 +1358,21 @@ static int process_header(struct http_client_ctx *client,
 
 		memcpy(client->content_type, header->value, header->value_len);
 		client->content_type[header->value_len] = '\0';
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	} else if (header->name_len == (sizeof("if-none-match") - 1) &&
+		   memcmp(header->name, "if-none-match", header->name_len) == 0) {
+		/* Too long to be evaluated, serve the resource anyway */
+		if (header->value_len < sizeof(client->if_none_match)) {
+			memcpy(client->if_none_match, header->value, header->value_len);
+			client->if_none_match[header->value_len] = '\0';
+		}
+	} else if (header->name_len == (sizeof("if-modified-since") - 1) &&
+		   memcmp(header->name, "if-modified-since", header->name_len) == 0) {
+		if (header->value_len < sizeof(client->if_modified_since)) {
+			memcpy(client->if_modified_since, header->value, header->value_len);
+			client->if_modified_since[header->value_len] = '\0';
+		}
+#endif
 	} else if (header->name_len == (sizeof("content-length") - 1) &&
 		   memcmp(header->name, "content-length", header->name_len) == 0) {
 		char len_str[16] = { 0 };
@@ -1396,7 +1477,7 @@ static int handle_http_frame_headers_end_stream(struct http_client_ctx *client)
 		ret = dynamic_detail->cb(client, HTTP_SERVER_DATA_FINAL, &request_ctx,
 					 &response_ctx, dynamic_detail->user_data);
 		if (ret < 0) {
-			dynamic_detail->holder = NULL;
+			(void)http_server_resource_release(dynamic_detail, client);
 			goto out;
 		}
 
@@ -1405,7 +1486,7 @@ static int handle_http_frame_headers_end_stream(struct http_client_ctx *client)
 
 		ret = http2_dynamic_response(client, frame, &response_ctx, HTTP_SERVER_DATA_FINAL,
 					     dynamic_detail);
-		dynamic_detail->holder = NULL;
+		(void)http_server_resource_release(dynamic_detail, client);
 
 		if (ret < 0) {
 			goto out;
@@ -1623,6 +1704,21 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 	}
 
 	bytes_consumed = client->current_frame.length;
+
+	if (!is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
+		struct http2_settings_field *setting =
+			(struct http2_settings_field *)client->cursor;
+
+		for (size_t i = 0; i < frame->length / sizeof(*setting); i++) {
+			if (ntohs(UNALIGNED_GET(&setting[i].id)) ==
+			    HTTP2_SETTINGS_HEADER_TABLE_SIZE) {
+				http_hpack_table_set_max_size(
+					&client->hpack_table,
+					ntohl(UNALIGNED_GET(&setting[i].value)));
+			}
+		}
+	}
+
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
 
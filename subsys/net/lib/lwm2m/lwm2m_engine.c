@@ -71,11 +71,6 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #define ENGINE_SLEEP_MS 500
 
-#ifdef CONFIG_LWM2M_VERSION_1_1
-#define LWM2M_ENGINE_MAX_OBSERVER_PATH CONFIG_LWM2M_ENGINE_MAX_OBSERVER * 3
-#else
-#define LWM2M_ENGINE_MAX_OBSERVER_PATH CONFIG_LWM2M_ENGINE_MAX_OBSERVER
-#endif
 static struct lwm2m_obj_path_list observe_paths[LWM2M_ENGINE_MAX_OBSERVER_PATH];
 #define MAX_PERIODIC_SERVICE 10
 
@@ -548,6 +543,7 @@ int lwm2m_socket_add(struct lwm2m_ctx *ctx)
 	sock_fds[sock_nfds].fd = ctx->sock_fd;
 	sock_fds[sock_nfds].events = ZSOCK_POLLIN;
 	sock_nfds++;
+	engine_observe_index_invalidate();
 
 	lwm2m_engine_wake_up();
 
@@ -586,6 +582,7 @@ void lwm2m_socket_del(struct lwm2m_ctx *ctx)
 		/* Remove the last entry. */
 		sock_ctx[sock_nfds] = NULL;
 		sock_fds[sock_nfds].fd = -1;
+		engine_observe_index_invalidate();
 		break;
 	}
 	lwm2m_engine_wake_up();
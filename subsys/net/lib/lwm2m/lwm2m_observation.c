@@ -87,6 +87,27 @@ static const uint8_t LWM2M_ATTR_LEN[] = {4, 4, 2, 2, 2};
 
 static struct lwm2m_attr write_attr_pool[CONFIG_LWM2M_NUM_ATTR];
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+/* Observed path, hashed by its object and object instance IDs */
+struct observe_index_entry {
+	sys_snode_t node;
+	const struct lwm2m_obj_path *path;
+	struct observe_node *obs;
+	struct lwm2m_ctx *ctx;
+};
+
+/* Bucket of the paths observed above the object instance level */
+#define OBSERVE_INDEX_ANY_INST UINT16_MAX
+
+static K_MUTEX_DEFINE(observe_index_lock);
+static struct observe_index_entry observe_index_entries[LWM2M_ENGINE_MAX_OBSERVER_PATH];
+static sys_slist_t observe_index[CONFIG_LWM2M_ENGINE_INDEX_BUCKETS];
+static bool observe_index_dirty = true;
+/* Lookup that last matched each observer, to visit observers only once */
+static uint32_t observe_index_seq[CONFIG_LWM2M_ENGINE_MAX_OBSERVER];
+static uint32_t observe_index_lookups;
+#endif
+
 /* Forward declarations */
 
 void lwm2m_engine_free_list(sys_slist_t *path_list, sys_slist_t *free_list);
@@ -203,6 +224,111 @@ static bool lwm2m_notify_observer_list(sys_slist_t *path_list, const struct lwm2
 	return false;
 }
 
+void engine_observe_index_invalidate(void)
+{
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	observe_index_dirty = true;
+#endif
+}
+
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+typedef int (*observe_index_cb_t)(struct lwm2m_ctx *ctx, struct observe_node *obs,
+				  const struct lwm2m_obj_path *path);
+
+static sys_slist_t *observe_index_bucket(uint16_t obj_id, uint16_t obj_inst_id)
+{
+	uint32_t hash = (((uint32_t)obj_id << 16) | obj_inst_id) * 2654435761U;
+
+	return &observe_index[hash % CONFIG_LWM2M_ENGINE_INDEX_BUCKETS];
+}
+
+static void observe_index_rebuild(void)
+{
+	struct observe_index_entry *entry = observe_index_entries;
+	struct lwm2m_ctx **sock_ctx = lwm2m_sock_ctx();
+	struct lwm2m_obj_path_list *o_p;
+	struct observe_node *obs;
+	uint16_t obj_inst_id;
+	int i;
+
+	observe_index_dirty = false;
+
+	for (i = 0; i < ARRAY_SIZE(observe_index); i++) {
+		sys_slist_init(&observe_index[i]);
+	}
+
+	for (i = 0; i < lwm2m_sock_nfds(); ++i) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
+			SYS_SLIST_FOR_EACH_CONTAINER(&obs->path_list, o_p, node) {
+				/* Paths all come from a pool of the same size */
+				__ASSERT_NO_MSG(entry < observe_index_entries +
+							ARRAY_SIZE(observe_index_entries));
+
+				obj_inst_id = o_p->path.level >= LWM2M_PATH_LEVEL_OBJECT_INST
+						      ? o_p->path.obj_inst_id
+						      : OBSERVE_INDEX_ANY_INST;
+
+				entry->path = &o_p->path;
+				entry->obs = obs;
+				entry->ctx = sock_ctx[i];
+				sys_slist_append(observe_index_bucket(o_p->path.obj_id, obj_inst_id),
+						 &entry->node);
+				entry++;
+			}
+		}
+	}
+}
+
+/* Call @a cb once for each observer with a path matching @a path, which must
+ * be at least at the object instance level. Observers of other instances are
+ * never visited. Returns the sum of the callback results, or the first error.
+ */
+static int observe_index_foreach(const struct lwm2m_obj_path *path, observe_index_cb_t cb)
+{
+	const uint16_t obj_inst_ids[] = {path->obj_inst_id, OBSERVE_INDEX_ANY_INST};
+	struct observe_index_entry *entry;
+	int count = 0;
+	int ret = 0;
+	uint32_t seq;
+	size_t obs_idx;
+
+	k_mutex_lock(&observe_index_lock, K_FOREVER);
+
+	if (observe_index_dirty) {
+		observe_index_rebuild();
+	}
+
+	seq = ++observe_index_lookups;
+
+	for (int i = 0; i < ARRAY_SIZE(obj_inst_ids); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(observe_index_bucket(path->obj_id, obj_inst_ids[i]),
+					     entry, node) {
+			obs_idx = entry->obs - observe_node_data;
+
+			if (observe_index_seq[obs_idx] == seq ||
+			    !lwm2m_observer_path_compare(entry->path, path)) {
+				continue;
+			}
+
+			observe_index_seq[obs_idx] = seq;
+
+			ret = cb(entry->ctx, entry->obs, path);
+			if (ret < 0) {
+				goto out;
+			}
+
+			count += ret;
+		}
+	}
+
+	ret = count;
+out:
+	k_mutex_unlock(&observe_index_lock);
+
+	return ret;
+}
+#endif /* CONFIG_LWM2M_ENGINE_INDEX */
+
 int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id)
 {
 	struct lwm2m_obj_path path;
@@ -221,8 +347,9 @@ static int engine_observe_get_attributes(const struct lwm2m_obj_path *path,
 	struct lwm2m_engine_obj *obj;
 	struct lwm2m_engine_obj_field *obj_field = NULL;
 	struct lwm2m_engine_obj_inst *obj_inst = NULL;
+	struct lwm2m_engine_res *res;
 	struct lwm2m_engine_res_inst *res_inst = NULL;
-	int ret, i;
+	int ret;
 
 	/* defaults from server object */
 	attrs->pmin = lwm2m_server_get_pmin(srv_obj_inst);
@@ -258,20 +385,15 @@ static int engine_observe_get_attributes(const struct lwm2m_obj_path *path,
 
 	/* check if resource exists */
 	if (path->level >= LWM2M_PATH_LEVEL_RESOURCE) {
-		for (i = 0; i < obj_inst->resource_count; i++) {
-			if (obj_inst->resources[i].res_id == path->res_id) {
-				break;
-			}
-		}
-
-		if (i == obj_inst->resource_count) {
+		res = lwm2m_engine_get_obj_inst_res(obj_inst, path->res_id);
+		if (!res) {
 			LOG_ERR("unable to find res_id: %u/%u/%u", path->obj_id, path->obj_inst_id,
 				path->res_id);
 			return -ENOENT;
 		}
 
 		/* load object field data */
-		obj_field = lwm2m_get_engine_obj_field(obj, obj_inst->resources[i].res_id);
+		obj_field = lwm2m_get_engine_obj_field(obj, res->res_id);
 		if (!obj_field) {
 			LOG_ERR("unable to find obj_field: %u/%u/%u", path->obj_id,
 				path->obj_inst_id, path->res_id);
@@ -283,7 +405,7 @@ static int engine_observe_get_attributes(const struct lwm2m_obj_path *path,
 			return -EPERM;
 		}
 
-		ret = update_attrs(&obj_inst->resources[i], attrs);
+		ret = update_attrs(res, attrs);
 		if (ret < 0) {
 			return ret;
 		}
@@ -351,12 +473,43 @@ int engine_observe_attribute_list_get(sys_slist_t *path_list, struct notificatio
 	return 0;
 }
 
-int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
+/* Schedule a notification of @a obs for a change of @a path, returns 1 */
+static int engine_observe_resource_update(struct lwm2m_ctx *ctx, struct observe_node *obs,
+					  const struct lwm2m_obj_path *path)
 {
-	struct observe_node *obs;
 	struct notification_attrs nattrs = {0};
 	int64_t timestamp;
+	int ret;
+
+	/* update the event time for this observer */
+	ret = engine_observe_attribute_list_get(&obs->path_list, &nattrs, ctx->srv_obj_inst);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (nattrs.pmin) {
+		timestamp = obs->last_timestamp + MSEC_PER_SEC * nattrs.pmin;
+	} else {
+		/* Trig immediately */
+		timestamp = k_uptime_get();
+	}
+
+	if (!obs->event_timestamp || obs->event_timestamp > timestamp) {
+		obs->resource_update = true;
+		obs->event_timestamp = timestamp;
+	}
+
+	LOG_DBG("NOTIFY EVENT %u/%u/%u", path->obj_id, path->obj_inst_id, path->res_id);
+	lwm2m_engine_wake_up();
+
+	return 1;
+}
+
+int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
+{
+	struct observe_node *obs;
 	int ret = 0;
+	int count = 0;
 	int i;
 	struct lwm2m_ctx **sock_ctx = lwm2m_sock_ctx();
 
@@ -364,39 +517,27 @@ int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
 		return 0;
 	}
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	if (path->level >= LWM2M_PATH_LEVEL_OBJECT_INST) {
+		return observe_index_foreach(path, engine_observe_resource_update);
+	}
+#endif
+
 	/* look for observers which match our resource */
 	for (i = 0; i < lwm2m_sock_nfds(); ++i) {
 		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
 			if (lwm2m_notify_observer_list(&obs->path_list, path)) {
-				/* update the event time for this observer */
-				ret = engine_observe_attribute_list_get(&obs->path_list, &nattrs,
-									sock_ctx[i]->srv_obj_inst);
+				ret = engine_observe_resource_update(sock_ctx[i], obs, path);
 				if (ret < 0) {
 					return ret;
 				}
 
-				if (nattrs.pmin) {
-					timestamp =
-						obs->last_timestamp + MSEC_PER_SEC * nattrs.pmin;
-				} else {
-					/* Trig immediately */
-					timestamp = k_uptime_get();
-				}
-
-				if (!obs->event_timestamp || obs->event_timestamp > timestamp) {
-					obs->resource_update = true;
-					obs->event_timestamp = timestamp;
-				}
-
-				LOG_DBG("NOTIFY EVENT %u/%u/%u", path->obj_id, path->obj_inst_id,
-					path->res_id);
-				ret++;
-				lwm2m_engine_wake_up();
+				count += ret;
 			}
 		}
 	}
 
-	return ret;
+	return count;
 }
 
 static struct observe_node *engine_allocate_observer(sys_slist_t *path_list, bool composite)
@@ -460,6 +601,7 @@ static void engine_observe_node_init(struct observe_node *obs, const uint8_t *to
 	obs->format = format;
 	obs->counter = OBSERVE_COUNTER_START;
 	sys_slist_append(&ctx->observer, &obs->node);
+	engine_observe_index_invalidate();
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&obs->path_list, tmp, node) {
 		LOG_DBG("OBSERVER ADDED %u/%u/%u/%u(%u)", tmp->path.obj_id, tmp->path.obj_inst_id,
@@ -486,6 +628,7 @@ static void remove_observer_path_from_list(struct lwm2m_ctx *ctx, struct observe
 	/* Remove from the list and add to free list */
 	sys_slist_remove(&obs->path_list, prev_node, &o_p->node);
 	sys_slist_append(&obs_obj_path_list, &o_p->node);
+	engine_observe_index_invalidate();
 }
 
 static void engine_observe_single_path_id_remove(struct lwm2m_ctx *ctx, struct observe_node *obs,
@@ -738,6 +881,7 @@ void remove_observer_from_list(struct lwm2m_ctx *ctx, sys_snode_t *prev_node,
 	}
 	sys_slist_remove(&ctx->observer, prev_node, &obs->node);
 	(void)memset(obs, 0, sizeof(*obs));
+	engine_observe_index_invalidate();
 }
 
 int engine_remove_observer_by_token(struct lwm2m_ctx *ctx, const uint8_t *token, uint8_t tkl)
@@ -1366,12 +1510,26 @@ int lwm2m_write_attr_handler(struct lwm2m_engine_obj *obj, struct lwm2m_message
 	return 0;
 }
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+static int engine_observe_count(struct lwm2m_ctx *ctx, struct observe_node *obs,
+				const struct lwm2m_obj_path *path)
+{
+	return 1;
+}
+#endif
+
 bool lwm2m_path_is_observed(const struct lwm2m_obj_path *path)
 {
 	int i;
 	struct observe_node *obs;
 	struct lwm2m_ctx **sock_ctx = lwm2m_sock_ctx();
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	if (path->level >= LWM2M_PATH_LEVEL_OBJECT_INST) {
+		return observe_index_foreach(path, engine_observe_count) > 0;
+	}
+#endif
+
 	for (i = 0; i < lwm2m_sock_nfds(); ++i) {
 		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
 
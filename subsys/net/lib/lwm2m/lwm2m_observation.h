@@ -12,6 +12,12 @@ int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path);
 
 #define MAX_TOKEN_LEN 8
 
+#ifdef CONFIG_LWM2M_VERSION_1_1
+#define LWM2M_ENGINE_MAX_OBSERVER_PATH CONFIG_LWM2M_ENGINE_MAX_OBSERVER * 3
+#else
+#define LWM2M_ENGINE_MAX_OBSERVER_PATH CONFIG_LWM2M_ENGINE_MAX_OBSERVER
+#endif
+
 struct observe_node {
 	sys_snode_t node;
 	sys_slist_t path_list;               /* List of Observation path */
@@ -54,6 +60,9 @@ int lwm2m_engine_observation_handler(struct lwm2m_message *msg, int observe, uin
 
 void engine_remove_observer_by_id(uint16_t obj_id, int32_t obj_inst_id);
 
+/* Rebuild the observer index before its next use, after the set of observed paths changed */
+void engine_observe_index_invalidate(void);
+
 /* path object list */
 struct lwm2m_obj_path_list {
 	sys_snode_t node;
@@ -89,6 +89,21 @@ static const struct default_obj_version default_obj_versions[] = {
 static sys_slist_t engine_obj_list;
 static sys_slist_t engine_obj_inst_list;
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+/* Objects and object instances hashed by their IDs */
+static sys_slist_t engine_obj_index[CONFIG_LWM2M_ENGINE_INDEX_BUCKETS];
+static sys_slist_t engine_obj_inst_index[CONFIG_LWM2M_ENGINE_INDEX_BUCKETS];
+
+static inline sys_slist_t *engine_index_bucket(sys_slist_t *index, uint16_t obj_id,
+					       uint16_t obj_inst_id)
+{
+	/* Knuth's multiplicative hash, instance IDs are mostly small and dense */
+	uint32_t hash = (((uint32_t)obj_id << 16) | obj_inst_id) * 2654435761U;
+
+	return &index[hash % CONFIG_LWM2M_ENGINE_INDEX_BUCKETS];
+}
+#endif
+
 /* Resource wrappers */
 sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
 
@@ -113,6 +128,10 @@ void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_list, &obj->node);
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	sys_slist_append(engine_index_bucket(engine_obj_index, obj->obj_id, 0),
+			 &obj->index_node);
+#endif
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -124,6 +143,10 @@ void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj)
 #endif
 	engine_remove_observer_by_id(obj->obj_id, -1);
 	sys_slist_find_and_remove(&engine_obj_list, &obj->node);
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	sys_slist_find_and_remove(engine_index_bucket(engine_obj_index, obj->obj_id, 0),
+				  &obj->index_node);
+#endif
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -131,11 +154,20 @@ struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 {
 	struct lwm2m_engine_obj *obj;
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	SYS_SLIST_FOR_EACH_CONTAINER(engine_index_bucket(engine_obj_index, obj_id, 0), obj,
+				     index_node) {
+		if (obj->obj_id == obj_id) {
+			return obj;
+		}
+	}
+#else
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_list, obj, node) {
 		if (obj->obj_id == obj_id) {
 			return obj;
 		}
 	}
+#endif
 
 	return NULL;
 }
@@ -145,6 +177,12 @@ struct lwm2m_engine_obj_field *lwm2m_get_engine_obj_field(struct lwm2m_engine_ob
 	int i;
 
 	if (obj && obj->fields && obj->field_count > 0) {
+		/* Fields are usually declared in resource ID order, starting at 0 */
+		if (res_id >= 0 && res_id < obj->field_count &&
+		    obj->fields[res_id].res_id == res_id) {
+			return &obj->fields[res_id];
+		}
+
 		for (i = 0; i < obj->field_count; i++) {
 			if (obj->fields[i].res_id == res_id) {
 				return &obj->fields[i];
@@ -176,6 +214,11 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	sys_slist_append(engine_index_bucket(engine_obj_inst_index, obj_inst->obj->obj_id,
+					     obj_inst->obj_inst_id),
+			 &obj_inst->index_node);
+#endif
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -185,17 +228,56 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	sys_slist_find_and_remove(engine_index_bucket(engine_obj_inst_index,
+						      obj_inst->obj->obj_id,
+						      obj_inst->obj_inst_id),
+				  &obj_inst->index_node);
+#endif
 }
 
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	SYS_SLIST_FOR_EACH_CONTAINER(engine_index_bucket(engine_obj_inst_index, obj_id, obj_inst_id),
+				     obj_inst, index_node) {
+		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
+			return obj_inst;
+		}
+	}
+#else
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
 		}
 	}
+#endif
+
+	return NULL;
+}
+
+struct lwm2m_engine_res *lwm2m_engine_get_obj_inst_res(struct lwm2m_engine_obj_inst *obj_inst,
+						       int res_id)
+{
+	int i;
+
+	if (!obj_inst->resources) {
+		return NULL;
+	}
+
+	/* Resources are usually initialized in resource ID order, starting at 0 */
+	if (res_id >= 0 && res_id < obj_inst->resource_count &&
+	    obj_inst->resources[res_id].res_id == res_id) {
+		return &obj_inst->resources[res_id];
+	}
+
+	for (i = 0; i < obj_inst->resource_count; i++) {
+		if (obj_inst->resources[i].res_id == res_id) {
+			return &obj_inst->resources[i];
+		}
+	}
 
 	return NULL;
 }
@@ -395,13 +477,7 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
-		if (oi->resources[i].res_id == path->res_id) {
-			r = &oi->resources[i];
-			break;
-		}
-	}
-
+	r = lwm2m_engine_get_obj_inst_res(oi, path->res_id);
 	if (!r) {
 		if (LWM2M_HAS_PERM(of, BIT(LWM2M_FLAG_OPTIONAL))) {
 			LOG_DBG("resource %d not found", path->res_id);
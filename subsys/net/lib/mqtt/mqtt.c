@@ -18,6 +18,154 @@ LOG_MODULE_REGISTER(net_mqtt, CONFIG_MQTT_LOG_LEVEL);
 #include "mqtt_internal.h"
 #include "mqtt_os.h"
 
+static int client_write_msg(struct mqtt_client *client,
+			    const struct msghdr *message);
+
+#if CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0
+static int inflight_find(const struct mqtt_client *client, uint16_t message_id)
+{
+	for (int i = 0; i < client->internal.inflight_count; i++) {
+		if (client->internal.inflight[i] == message_id) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/** @brief Check the in-flight window has room for a publish message. */
+static int inflight_check(const struct mqtt_client *client,
+			  const struct mqtt_publish_param *param)
+{
+	/* QoS 0 messages are not acknowledged, a retransmission is already in
+	 * the window.
+	 */
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE ||
+	    inflight_find(client, param->message_id) >= 0) {
+		return 0;
+	}
+
+	if (client->internal.inflight_count >= CONFIG_MQTT_PUBLISH_INFLIGHT_MAX) {
+		NET_DBG("[CID %p]: In-flight window full", client);
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+
+static void inflight_add(struct mqtt_client *client,
+			 const struct mqtt_publish_param *param)
+{
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE ||
+	    inflight_find(client, param->message_id) >= 0) {
+		return;
+	}
+
+	client->internal.inflight[client->internal.inflight_count++] =
+							param->message_id;
+}
+
+void publish_inflight_release(struct mqtt_client *client, uint16_t message_id)
+{
+	int i = inflight_find(client, message_id);
+
+	if (i < 0) {
+		NET_DBG("[CID %p]: Message id 0x%04x not in flight", client,
+			message_id);
+		return;
+	}
+
+	client->internal.inflight_count--;
+	client->internal.inflight[i] =
+		client->internal.inflight[client->internal.inflight_count];
+}
+
+static void inflight_reset(struct mqtt_client *client)
+{
+	client->internal.inflight_count = 0U;
+}
+#else
+static inline int inflight_check(const struct mqtt_client *client,
+				 const struct mqtt_publish_param *param)
+{
+	return 0;
+}
+
+static inline void inflight_add(struct mqtt_client *client,
+				const struct mqtt_publish_param *param)
+{
+}
+
+static inline void inflight_reset(struct mqtt_client *client)
+{
+}
+#endif /* CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0 */
+
+#if defined(CONFIG_MQTT_PUBLISH_BATCH)
+static void batch_reset(struct mqtt_client *client)
+{
+	client->internal.batch_len = 0U;
+	client->internal.batch_iovlen = 0U;
+}
+
+/** @brief Send the queued publish messages with a single transport write. */
+static int batch_send(struct mqtt_client *client)
+{
+	struct msghdr msg;
+	int err_code;
+
+	if (client->internal.batch_iovlen == 0U) {
+		return 0;
+	}
+
+	memset(&msg, 0, sizeof(msg));
+
+	msg.msg_iov = client->internal.batch_iov;
+	msg.msg_iovlen = client->internal.batch_iovlen;
+
+	NET_DBG("[CID %p]: Sending %u bytes of queued headers", client,
+		client->internal.batch_len);
+
+	err_code = client_write_msg(client, &msg);
+
+	batch_reset(client);
+
+	return err_code;
+}
+
+/** @brief Time until mqtt_live() sends the queued messages, -1 if never. */
+static int batch_time_left(const struct mqtt_client *client)
+{
+	uint32_t elapsed_time;
+
+	if (CONFIG_MQTT_PUBLISH_BATCH_TIMEOUT == 0 ||
+	    client->internal.batch_iovlen == 0U) {
+		return -1;
+	}
+
+	elapsed_time = mqtt_elapsed_time_in_ms_get(client->internal.batch_start);
+	if (elapsed_time >= CONFIG_MQTT_PUBLISH_BATCH_TIMEOUT) {
+		return 0;
+	}
+
+	return CONFIG_MQTT_PUBLISH_BATCH_TIMEOUT - elapsed_time;
+}
+#else
+static inline void batch_reset(struct mqtt_client *client)
+{
+}
+
+static inline int batch_send(struct mqtt_client *client)
+{
+	return 0;
+}
+
+static inline int batch_time_left(const struct mqtt_client *client)
+{
+	return -1;
+}
+#endif /* CONFIG_MQTT_PUBLISH_BATCH */
+
 static void client_reset(struct mqtt_client *client)
 {
 	MQTT_STATE_INIT(client);
@@ -25,11 +173,19 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+
+	batch_reset(client);
+	inflight_reset(client);
 }
 
-/** @brief Initialize tx buffer. */
+/** @brief Initialize tx buffer, sending the queued publish messages first. */
 static void tx_buf_init(struct mqtt_client *client, struct buf_ctx *buf)
 {
+	/* A failed write disconnects the client, which the state check that
+	 * follows reports.
+	 */
+	(void)batch_send(client);
+
 	memset(client->tx_buf, 0, client->tx_buf_size);
 	buf->cur = client->tx_buf;
 	buf->end = client->tx_buf + client->tx_buf_size;
@@ -261,6 +417,11 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
+	err_code = inflight_check(client, param);
+	if (err_code < 0) {
+		goto error;
+	}
+
 	err_code = publish_encode(param, &packet);
 	if (err_code < 0) {
 		goto error;
@@ -277,6 +438,11 @@ int mqtt_publish(struct mqtt_client *client,
 	msg.msg_iovlen = ARRAY_SIZE(io_vector);
 
 	err_code = client_write_msg(client, &msg);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	inflight_add(client, param);
 
 error:
 	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
@@ -287,6 +453,135 @@ error:
 	return err_code;
 }
 
+#if defined(CONFIG_MQTT_PUBLISH_BATCH)
+/** @brief Encode a publish message after the ones already queued. */
+static int batch_encode(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			struct buf_ctx *packet)
+{
+	size_t min_size = sizeof(uint16_t) + param->message.topic.topic.size;
+
+	if (param->message.topic.qos != MQTT_QOS_0_AT_MOST_ONCE) {
+		min_size += sizeof(uint16_t);
+	}
+
+	/* publish_encode() reserves the fixed header without checking the
+	 * buffer end, so make sure the whole header fits after the batch.
+	 */
+	if (client->tx_buf_size - client->internal.batch_len <=
+	    MQTT_FIXED_HEADER_MAX_SIZE + min_size) {
+		return -ENOMEM;
+	}
+
+	packet->cur = client->tx_buf + client->internal.batch_len;
+	packet->end = client->tx_buf + client->tx_buf_size;
+
+	return publish_encode(param, packet);
+}
+
+int mqtt_publish_queue(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param)
+{
+	struct mqtt_internal *internal;
+	struct buf_ctx packet;
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(param);
+
+	NET_DBG("[CID %p]:[State 0x%02x]: >> Topic size 0x%08x, "
+		 "Data size 0x%08x", client, client->internal.state,
+		 param->message.topic.topic.size,
+		 param->message.payload.len);
+
+	mqtt_mutex_lock(client);
+
+	internal = &client->internal;
+
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	err_code = inflight_check(client, param);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	if (internal->batch_iovlen + 2 > ARRAY_SIZE(internal->batch_iov)) {
+		err_code = batch_send(client);
+		if (err_code < 0) {
+			goto error;
+		}
+	}
+
+	err_code = batch_encode(client, param, &packet);
+	if (err_code == -ENOMEM && internal->batch_iovlen > 0) {
+		/* Make room in the TX buffer by sending the batch. */
+		err_code = batch_send(client);
+		if (err_code < 0) {
+			goto error;
+		}
+
+		err_code = batch_encode(client, param, &packet);
+	}
+
+	if (err_code < 0) {
+		goto error;
+	}
+
+	if (internal->batch_iovlen == 0U) {
+		internal->batch_start = mqtt_sys_tick_in_ms_get();
+	}
+
+	internal->batch_iov[internal->batch_iovlen].iov_base = packet.cur;
+	internal->batch_iov[internal->batch_iovlen].iov_len =
+							packet.end - packet.cur;
+	internal->batch_iovlen++;
+
+	if (param->message.payload.len > 0) {
+		internal->batch_iov[internal->batch_iovlen].iov_base =
+						param->message.payload.data;
+		internal->batch_iov[internal->batch_iovlen].iov_len =
+						param->message.payload.len;
+		internal->batch_iovlen++;
+	}
+
+	internal->batch_len = packet.end - client->tx_buf;
+
+	inflight_add(client, param);
+
+error:
+	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
+			 client, client->internal.state, err_code);
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
+int mqtt_publish_flush(struct mqtt_client *client)
+{
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	err_code = batch_send(client);
+
+error:
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+#endif /* CONFIG_MQTT_PUBLISH_BATCH */
+
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
 {
@@ -595,15 +890,22 @@ int mqtt_live(struct mqtt_client *client)
 {
 	int err_code = 0;
 	uint32_t elapsed_time;
+	bool batch_sent = false;
 	bool ping_sent = false;
 
 	NULL_PARAM_CHECK(client);
 
 	mqtt_mutex_lock(client);
 
+	if (batch_time_left(client) == 0) {
+		/* Do not hold a partial batch back for longer. */
+		err_code = batch_send(client);
+		batch_sent = true;
+	}
+
 	elapsed_time = mqtt_elapsed_time_in_ms_get(
 				client->internal.last_activity);
-	if ((client->keepalive > 0) &&
+	if ((err_code == 0) && (client->keepalive > 0) &&
 	    (elapsed_time >= (client->keepalive * 1000))) {
 		err_code = mqtt_ping(client);
 		ping_sent = true;
@@ -611,7 +913,7 @@ int mqtt_live(struct mqtt_client *client)
 
 	mqtt_mutex_unlock(client);
 
-	if (ping_sent) {
+	if (ping_sent || batch_sent) {
 		return err_code;
 	} else {
 		return -EAGAIN;
@@ -623,17 +925,23 @@ int mqtt_keepalive_time_left(const struct mqtt_client *client)
 	uint32_t elapsed_time = mqtt_elapsed_time_in_ms_get(
 					client->internal.last_activity);
 	uint32_t keepalive_ms = 1000U * client->keepalive;
+	int batch_ms = batch_time_left(client);
+	int keepalive_left;
 
 	if (client->keepalive == 0) {
 		/* Keep alive not enabled. */
-		return -1;
+		keepalive_left = -1;
+	} else if (keepalive_ms <= elapsed_time) {
+		keepalive_left = 0;
+	} else {
+		keepalive_left = keepalive_ms - elapsed_time;
 	}
 
-	if (keepalive_ms <= elapsed_time) {
-		return 0;
+	if (batch_ms >= 0 && (keepalive_left < 0 || batch_ms < keepalive_left)) {
+		return batch_ms;
 	}
 
-	return keepalive_ms - elapsed_time;
+	return keepalive_left;
 }
 
 int mqtt_input(struct mqtt_client *client)
@@ -35,8 +35,14 @@ int prometheus_collector_register_metric(struct prometheus_collector *collector,
 
 	k_mutex_lock(&collector->lock, K_FOREVER);
 
-	/* Node cannot be added to list twice */
-	(void)sys_slist_find_and_remove(&collector->metrics, &metric->node);
+	/* Node cannot be added to list twice. It is not moved either, as that
+	 * would invalidate the cursor of a chunked exposition in progress.
+	 */
+	if (sys_slist_find(&collector->metrics, &metric->node, NULL)) {
+		k_mutex_unlock(&collector->lock);
+		LOG_DBG("Metric \"%s\" already registered", metric->name);
+		return -EALREADY;
+	}
 
 	sys_slist_prepend(&collector->metrics, &metric->node);
 
@@ -16,35 +16,86 @@ LOG_MODULE_REGISTER(pm_counter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
 int prometheus_counter_add(struct prometheus_counter *counter, uint64_t value)
 {
+	k_spinlock_key_t key;
+
 	if (counter == NULL) {
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+	/* Being migrated after reading the CPU id only means updating the
+	 * shard of another CPU, which is still done under its lock.
+	 */
+	struct prometheus_counter_shard *shard = &counter->shards[arch_curr_cpu()->id];
+
+	key = k_spin_lock(&shard->lock);
+	shard->value += value;
+	k_spin_unlock(&shard->lock, key);
+#else
+	key = k_spin_lock(&counter->lock);
 	counter->value += value;
+	k_spin_unlock(&counter->lock, key);
+#endif
 
 	return 0;
 }
 
+/* Called with counter->lock held, which is taken before the shard locks */
+static uint64_t counter_value_locked(struct prometheus_counter *counter)
+{
+	uint64_t value = counter->value;
+
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+	k_spinlock_key_t key;
+
+	ARRAY_FOR_EACH_PTR(counter->shards, shard) {
+		key = k_spin_lock(&shard->lock);
+		value += shard->value;
+		k_spin_unlock(&shard->lock, key);
+	}
+#endif
+
+	return value;
+}
+
+uint64_t prometheus_counter_get(struct prometheus_counter *counter)
+{
+	k_spinlock_key_t key;
+	uint64_t value;
+
+	key = k_spin_lock(&counter->lock);
+	value = counter_value_locked(counter);
+	k_spin_unlock(&counter->lock, key);
+
+	return value;
+}
+
 int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value)
 {
+	k_spinlock_key_t key;
 	uint64_t old_value;
+	int ret = 0;
 
 	if (counter == NULL) {
 		return -EINVAL;
 	}
 
-	if (value == counter->value) {
-		return 0;
-	}
+	/* Concurrent calls must not both add the same difference */
+	key = k_spin_lock(&counter->lock);
 
-	old_value = counter->value;
+	old_value = counter_value_locked(counter);
 	if (value < old_value) {
+		ret = -EINVAL;
+	} else {
+		counter->value += (value - old_value);
+	}
+
+	k_spin_unlock(&counter->lock, key);
+
+	if (ret < 0) {
 		LOG_DBG("Cannot set counter to a lower value (%" PRIu64 " < %" PRIu64 ")",
 			value, old_value);
-		return -EINVAL;
 	}
 
-	counter->value += (value - old_value);
-
-	return 0;
+	return ret;
 }
@@ -24,220 +24,202 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_formatter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
-static int write_metric_to_buffer(char *buffer, size_t buffer_size, const char *format, ...)
+static int format_type_line(struct prometheus_metric *metric, char *buffer, size_t buffer_size)
 {
-	/* helper function to write formatted metric to buffer */
-	va_list args;
-	size_t len = strlen(buffer);
+	const char *type;
 
-	if (len >= buffer_size) {
-		return -ENOMEM;
-	}
-	buffer += len;
-	buffer_size -= len;
-
-	va_start(args, format);
-	len = vsnprintf(buffer, buffer_size, format, args);
-	va_end(args);
-	if (len >= buffer_size) {
-		return -ENOMEM;
+	switch (metric->type) {
+	case PROMETHEUS_COUNTER:
+		type = "counter";
+		break;
+	case PROMETHEUS_GAUGE:
+		type = "gauge";
+		break;
+	case PROMETHEUS_HISTOGRAM:
+		type = "histogram";
+		break;
+	case PROMETHEUS_SUMMARY:
+		type = "summary";
+		break;
+	default:
+		type = "untyped";
+		break;
 	}
 
-	return 0;
+	return snprintf(buffer, buffer_size, "# TYPE %s %s\n", metric->name, type);
 }
 
-int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
-				 size_t buffer_size, int *written)
+static int format_counter_line(struct prometheus_metric *metric, int line, char *buffer,
+			       size_t buffer_size)
 {
-	int ret = 0;
+	struct prometheus_counter *counter = CONTAINER_OF(metric, struct prometheus_counter, base);
+	uint64_t value;
 
-	/* write HELP line if available */
-	if (metric->description[0] != '\0') {
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# HELP %s %s\n", metric->name,
-					     metric->description);
-		if (ret < 0) {
-			LOG_ERR("Error writing to buffer");
-			goto out;
-		}
+	if (line >= metric->num_labels) {
+		return -ENOENT;
 	}
 
-	/* write TYPE line */
-	switch (metric->type) {
-	case PROMETHEUS_COUNTER:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s counter\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing counter");
-			goto out;
-		}
-
-		break;
-
-	case PROMETHEUS_GAUGE:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s gauge\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing gauge");
-			goto out;
-		}
+	value = prometheus_counter_get(counter);
 
-		break;
+	LOG_DBG("counter->value: %llu", value);
 
-	case PROMETHEUS_HISTOGRAM:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s histogram\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
-		}
+	return snprintf(buffer, buffer_size, "%s{%s=\"%s\"} %llu\n", metric->name,
+			metric->labels[line].key, metric->labels[line].value, value);
+}
 
-		break;
+static int format_gauge_line(struct prometheus_metric *metric, int line, char *buffer,
+			     size_t buffer_size)
+{
+	const struct prometheus_gauge *gauge = CONTAINER_OF(metric, struct prometheus_gauge, base);
 
-	case PROMETHEUS_SUMMARY:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s summary\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
-		}
+	if (line >= metric->num_labels) {
+		return -ENOENT;
+	}
 
-		break;
+	LOG_DBG("gauge->value: %f", gauge->value);
 
-	default:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s untyped\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing untyped");
-			goto out;
-		}
+	return snprintf(buffer, buffer_size, "%s{%s=\"%s\"} %f\n", metric->name,
+			metric->labels[line].key, metric->labels[line].value, gauge->value);
+}
 
-		break;
+static int format_histogram_line(struct prometheus_metric *metric, int line, char *buffer,
+				 size_t buffer_size)
+{
+	struct prometheus_histogram *histogram =
+		CONTAINER_OF(metric, struct prometheus_histogram, base);
+	size_t num_buckets = histogram->num_buckets;
+	unsigned long count;
+	k_spinlock_key_t key;
+	double sum;
+
+	if ((size_t)line < num_buckets) {
+		key = k_spin_lock(&histogram->lock);
+		count = histogram->buckets[line].count;
+		k_spin_unlock(&histogram->lock, key);
+
+		return snprintf(buffer, buffer_size, "%s_bucket{le=\"%f\"} %lu\n", metric->name,
+				histogram->buckets[line].upper_bound, count);
 	}
 
-	/* write metric-specific fields */
-	switch (metric->type) {
-	case PROMETHEUS_COUNTER: {
-		const struct prometheus_counter *counter =
-			CONTAINER_OF(metric, struct prometheus_counter, base);
+	key = k_spin_lock(&histogram->lock);
+	count = histogram->count;
+	sum = histogram->sum;
+	k_spin_unlock(&histogram->lock, key);
 
-		LOG_DBG("counter->value: %llu", counter->value);
+	LOG_DBG("histogram->count: %lu", count);
 
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %llu\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, counter->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing counter");
-				goto out;
-			}
-		}
+	if ((size_t)line == num_buckets) {
+		return snprintf(buffer, buffer_size, "%s_sum %f\n", metric->name, sum);
+	}
 
-		break;
+	if ((size_t)line == num_buckets + 1) {
+		return snprintf(buffer, buffer_size, "%s_count %lu\n", metric->name, count);
 	}
 
-	case PROMETHEUS_GAUGE: {
-		const struct prometheus_gauge *gauge =
-			CONTAINER_OF(metric, struct prometheus_gauge, base);
+	return -ENOENT;
+}
 
-		LOG_DBG("gauge->value: %f", gauge->value);
+static int format_summary_line(struct prometheus_metric *metric, int line, char *buffer,
+			       size_t buffer_size)
+{
+	const struct prometheus_summary *summary =
+		CONTAINER_OF(metric, struct prometheus_summary, base);
+	size_t num_quantiles = summary->num_quantiles;
 
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %f\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, gauge->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing gauge");
-				goto out;
-			}
-		}
+	LOG_DBG("summary->count: %lu", summary->count);
 
-		break;
+	if ((size_t)line < num_quantiles) {
+		return snprintf(buffer, buffer_size, "%s{%s=\"%f\"} %f\n", metric->name,
+				"quantile", summary->quantiles[line].quantile,
+				summary->quantiles[line].value);
 	}
 
-	case PROMETHEUS_HISTOGRAM: {
-		const struct prometheus_histogram *histogram =
-			CONTAINER_OF(metric, struct prometheus_histogram, base);
+	if ((size_t)line == num_quantiles) {
+		return snprintf(buffer, buffer_size, "%s_sum %f\n", metric->name, summary->sum);
+	}
 
-		LOG_DBG("histogram->count: %lu", histogram->count);
+	if ((size_t)line == num_quantiles + 1) {
+		return snprintf(buffer, buffer_size, "%s_count %lu\n", metric->name,
+				summary->count);
+	}
 
-		for (int i = 0; i < histogram->num_buckets; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s_bucket{le=\"%f\"} %lu\n", metric->name,
-				histogram->buckets[i].upper_bound,
-				histogram->buckets[i].count);
-			if (ret < 0) {
-				LOG_ERR("Error writing histogram");
-				goto out;
-			}
-		}
+	return -ENOENT;
+}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, histogram->sum);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
+/* Format the given line of the exposition of a metric. Returns the length of
+ * the line, which was truncated if it is not below buffer_size, 0 for a line
+ * that is left out, or -ENOENT past the last line of the metric.
+ */
+static int format_metric_line(struct prometheus_metric *metric, int line, char *buffer,
+			      size_t buffer_size)
+{
+	/* HELP line if available */
+	if (line == 0) {
+		if (metric->description[0] == '\0') {
+			return 0;
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     histogram->count);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
-		}
+		return snprintf(buffer, buffer_size, "# HELP %s %s\n", metric->name,
+				metric->description);
+	}
 
-		break;
+	if (line == 1) {
+		return format_type_line(metric, buffer, buffer_size);
 	}
 
-	case PROMETHEUS_SUMMARY: {
-		const struct prometheus_summary *summary =
-			CONTAINER_OF(metric, struct prometheus_summary, base);
+	/* metric-specific fields */
+	line -= 2;
 
-		LOG_DBG("summary->count: %lu", summary->count);
+	switch (metric->type) {
+	case PROMETHEUS_COUNTER:
+		return format_counter_line(metric, line, buffer, buffer_size);
+	case PROMETHEUS_GAUGE:
+		return format_gauge_line(metric, line, buffer, buffer_size);
+	case PROMETHEUS_HISTOGRAM:
+		return format_histogram_line(metric, line, buffer, buffer_size);
+	case PROMETHEUS_SUMMARY:
+		return format_summary_line(metric, line, buffer, buffer_size);
+	default:
+		/* should not happen */
+		LOG_ERR("Unsupported metric type %d", metric->type);
+		return -EINVAL;
+	}
+}
 
-		for (int i = 0; i < summary->num_quantiles; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%f\"} %f\n", metric->name, "quantile",
-				summary->quantiles[i].quantile,
-				summary->quantiles[i].value);
-			if (ret < 0) {
-				LOG_ERR("Error writing summary");
-				goto out;
-			}
+int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
+				 size_t buffer_size, int *written)
+{
+	size_t pos = *written;
+	int ret;
+
+	if (pos >= buffer_size) {
+		return -ENOMEM;
+	}
+
+	/* append to what is already in the buffer */
+	pos += strlen(buffer + pos);
+
+	for (int line = 0; ; line++) {
+		ret = format_metric_line(metric, line, buffer + pos, buffer_size - pos);
+		if (ret == -ENOENT) {
+			break;
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, summary->sum);
 		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+			return ret;
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     summary->count);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+		if ((size_t)ret >= buffer_size - pos) {
+			LOG_ERR("Error writing to buffer");
+			return -ENOMEM;
 		}
 
-		break;
+		pos += ret;
 	}
 
-	default:
-		/* should not happen */
-		LOG_ERR("Unsupported metric type %d", metric->type);
-		ret = -EINVAL;
-		goto out;
-	}
+	*written = pos;
 
-out:
-	return ret;
+	return 0;
 }
 
 int prometheus_format_exposition(struct prometheus_collector *collector, char *buffer,
@@ -263,6 +245,7 @@ int prometheus_format_exposition(struct prometheus_collector *collector, char *b
 			if (ret < 0) {
 				if (ret == -EAGAIN) {
 					/* Skip this metric for now */
+					ret = 0;
 					continue;
 				}
 
@@ -282,3 +265,115 @@ out:
 
 	return ret;
 }
+
+int prometheus_format_exposition_init(struct prometheus_format_context *ctx,
+				      struct prometheus_collector *collector)
+{
+	if (ctx == NULL || collector == NULL) {
+		return -EINVAL;
+	}
+
+	ctx->collector = collector;
+	ctx->metric = NULL;
+	ctx->line = 0;
+	ctx->state = PROMETHEUS_WALK_START;
+
+	return 0;
+}
+
+static void format_next_metric(struct prometheus_format_context *ctx)
+{
+	ctx->metric = SYS_SLIST_PEEK_NEXT_CONTAINER(ctx->metric, node);
+	ctx->line = 0;
+}
+
+int prometheus_format_exposition_chunk(struct prometheus_format_context *ctx, char *buffer,
+				       size_t buffer_size, size_t *len)
+{
+	struct prometheus_collector *collector;
+	size_t pos = 0;
+	int ret = 0;
+
+	if (ctx == NULL || ctx->collector == NULL || buffer == NULL || buffer_size == 0 ||
+	    len == NULL) {
+		LOG_ERR("Invalid arguments");
+		return -EINVAL;
+	}
+
+	*len = 0;
+
+	if (ctx->state == PROMETHEUS_WALK_STOP) {
+		return 0;
+	}
+
+	collector = ctx->collector;
+
+	/* The lock is only held while formatting one chunk. Metrics are never
+	 * removed from a collector nor moved within it, new ones are prepended,
+	 * so the cursor stays valid in between.
+	 */
+	k_mutex_lock(&collector->lock, K_FOREVER);
+
+	if (ctx->state == PROMETHEUS_WALK_START) {
+		ctx->metric = SYS_SLIST_PEEK_HEAD_CONTAINER(&collector->metrics, ctx->metric,
+							    node);
+		ctx->line = 0;
+		ctx->state = PROMETHEUS_WALK_CONTINUE;
+	}
+
+	while (ctx->metric != NULL) {
+		/* If there is a user callback, use it to update the metric data. */
+		if (ctx->line == 0 && collector->user_cb) {
+			ret = collector->user_cb(collector, ctx->metric, collector->user_data);
+			if (ret == -EAGAIN) {
+				/* Skip this metric for now */
+				format_next_metric(ctx);
+				continue;
+			}
+
+			if (ret < 0) {
+				LOG_ERR("Error in user callback (%d)", ret);
+				goto stop;
+			}
+		}
+
+		ret = format_metric_line(ctx->metric, ctx->line, buffer + pos, buffer_size - pos);
+		if (ret == -ENOENT) {
+			format_next_metric(ctx);
+			continue;
+		}
+
+		if (ret < 0) {
+			goto stop;
+		}
+
+		if ((size_t)ret >= buffer_size - pos) {
+			if (pos == 0) {
+				LOG_ERR("Buffer too small for a line of %s", ctx->metric->name);
+				ret = -ENOMEM;
+				goto stop;
+			}
+
+			/* The line is formatted again in the next chunk */
+			break;
+		}
+
+		pos += ret;
+		ctx->line++;
+	}
+
+	*len = pos;
+
+	if (ctx->metric != NULL) {
+		k_mutex_unlock(&collector->lock);
+		return -EAGAIN;
+	}
+
+	ret = 0;
+
+stop:
+	ctx->state = PROMETHEUS_WALK_STOP;
+	k_mutex_unlock(&collector->lock);
+
+	return ret;
+}
@@ -16,27 +16,43 @@ LOG_MODULE_REGISTER(pm_histogram, CONFIG_PROMETHEUS_LOG_LEVEL);
 
 int prometheus_histogram_observe(struct prometheus_histogram *histogram, double value)
 {
+	k_spinlock_key_t key;
+	size_t low = 0;
+	size_t high;
+
 	if (!histogram) {
 		return -EINVAL;
 	}
 
+	/* find the first bucket whose upper bound is not below the value */
+	high = histogram->num_buckets;
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+
+		if (value <= histogram->buckets[mid].upper_bound) {
+			high = mid;
+		} else {
+			low = mid + 1;
+		}
+	}
+
+	key = k_spin_lock(&histogram->lock);
+
 	/* increment count */
 	histogram->count++;
 
 	/* update sum */
 	histogram->sum += value;
 
-	/* find appropriate bucket */
-	for (size_t i = 0; i < histogram->num_buckets; ++i) {
-		if (value <= histogram->buckets[i].upper_bound) {
-			/* increment count for the bucket */
-			histogram->buckets[i].count++;
+	/* increment count for the bucket */
+	if (low < histogram->num_buckets) {
+		histogram->buckets[low].count++;
+	}
 
-			LOG_DBG("value: %f, bucket: %f, count: %lu", value,
-				histogram->buckets[i].upper_bound, histogram->buckets[i].count);
+	k_spin_unlock(&histogram->lock, key);
 
-			break;
-		}
+	if (low < histogram->num_buckets) {
+		LOG_DBG("value: %f, bucket: %f", value, histogram->buckets[low].upper_bound);
 	}
 
 	return 0;
@@ -710,6 +710,503 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static k_timeout_t mmsg_timeout(const struct timespec *ts)
+{
+	/* Clamped to the range of a millisecond timeout, so that neither the
+	 * microsecond value nor its conversion to ticks can overflow.
+	 */
+	if (ts->tv_sec >= INT32_MAX / MSEC_PER_SEC) {
+		return K_MSEC(INT32_MAX);
+	}
+
+	return K_USEC((int64_t)ts->tv_sec * USEC_PER_SEC + ts->tv_nsec / NSEC_PER_USEC);
+}
+
+/* Zero-length reads only mean the end of the stream on stream sockets, a
+ * datagram may be empty. Sockets whose type cannot be told are taken as
+ * streams, which at worst ends a batch early.
+ *
+ * Must be called with the socket lock held.
+ */
+static bool sock_is_stream(void *obj, const struct socket_op_vtable *vtable)
+{
+	socklen_t optlen = sizeof(int);
+	int saved_errno = errno;
+	int type;
+
+	if (vtable->getsockopt == NULL ||
+	    vtable->getsockopt(obj, SOL_SOCKET, SO_TYPE, &type, &optlen) < 0) {
+		errno = saved_errno;
+		return true;
+	}
+
+	return type == SOCK_STREAM;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags, struct timespec *timeout)
+{
+	const struct socket_op_vtable *vtable;
+	k_timepoint_t end = sys_timepoint_calc(K_FOREVER);
+	struct k_mutex *lock;
+	size_t bytes_received = 0;
+	unsigned int count = 0;
+	ssize_t ret = 0;
+	bool stream;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (timeout != NULL) {
+		if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+		    timeout->tv_nsec >= NSEC_PER_SEC) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		end = sys_timepoint_calc(mmsg_timeout(timeout));
+	}
+
+	vlen = MIN(vlen, CONFIG_NET_SOCKETS_MMSG_VLEN_MAX);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	stream = sock_is_stream(obj, vtable);
+
+	while (count < vlen) {
+		struct msghdr *msg = &msgvec[count].msg_hdr;
+		int recv_flags = flags & ~ZSOCK_MSG_WAITFORONE;
+
+		/* Only the first message is waited for with MSG_WAITFORONE */
+		if (count > 0 && (flags & ZSOCK_MSG_WAITFORONE)) {
+			recv_flags |= ZSOCK_MSG_DONTWAIT;
+		}
+
+		msg->msg_flags = 0;
+
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, recvmsg, sock, msg, recv_flags);
+
+		ret = vtable->recvmsg(obj, msg, recv_flags);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, recvmsg, sock, msg,
+					       ret < 0 ? -errno : ret);
+
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+		bytes_received += ret;
+		count++;
+
+		/* End of stream, do not wait for more */
+		if (stream && ret == 0) {
+			break;
+		}
+
+		if (timeout != NULL && sys_timepoint_expired(end)) {
+			break;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	if (count == 0) {
+		return ret < 0 ? -1 : 0;
+	}
+
+	sock_obj_core_update_recv_stats(sock, bytes_received);
+
+	return count;
+}
+
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	size_t bytes_sent = 0;
+	unsigned int count = 0;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	vlen = MIN(vlen, CONFIG_NET_SOCKETS_MMSG_VLEN_MAX);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	while (count < vlen) {
+		const struct msghdr *msg = &msgvec[count].msg_hdr;
+
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, sendmsg, sock, msg, flags);
+
+		ret = vtable->sendmsg(obj, msg, flags);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, sendmsg, sock,
+					       ret < 0 ? -errno : ret);
+
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+		bytes_sent += ret;
+		count++;
+
+		/* The dispatcher replaces itself with the offloaded socket
+		 * when first used, so the rest goes to the new object.
+		 */
+		if (IS_ENABLED(CONFIG_NET_SOCKETS_OFFLOAD_DISPATCHER) && count == 1) {
+			obj = get_sock_vtable(sock, &vtable, &lock);
+			if (obj == NULL || vtable->sendmsg == NULL) {
+				break;
+			}
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	if (count == 0) {
+		return ret < 0 ? -1 : 0;
+	}
+
+	sock_obj_core_update_send_stats(sock, bytes_sent);
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Make a kernel copy of a message header of a user mode zsock_recvmmsg() or
+ * zsock_sendmmsg() call. When receiving, the buffers are only checked for
+ * write access and allocated, the data is copied to them afterwards. The iovec
+ * array is allocated twice as long as the user one, the second half keeps the
+ * user buffers to copy the received data back to.
+ */
+static int mmsghdr_copy_from_user(struct msghdr *copy, const struct msghdr *msg,
+				  bool recv)
+{
+	struct iovec *user_iov;
+
+	*copy = (struct msghdr){
+		.msg_namelen = msg->msg_namelen,
+		.msg_controllen = msg->msg_controllen,
+	};
+
+	if (msg->msg_iovlen > 0) {
+		if (msg->msg_iov == NULL) {
+			return -EINVAL;
+		}
+
+		copy->msg_iov = k_calloc(msg->msg_iovlen, 2 * sizeof(struct iovec));
+		if (copy->msg_iov == NULL) {
+			return -ENOMEM;
+		}
+
+		copy->msg_iovlen = msg->msg_iovlen;
+		user_iov = copy->msg_iov + copy->msg_iovlen;
+
+		if (k_usermode_from_copy(user_iov, msg->msg_iov,
+					 msg->msg_iovlen * sizeof(struct iovec))) {
+			return -EFAULT;
+		}
+
+		for (size_t i = 0; i < msg->msg_iovlen; i++) {
+			void *base = NULL;
+
+			if (user_iov[i].iov_len == 0) {
+				continue;
+			}
+
+			if (recv) {
+				if (K_SYSCALL_MEMORY_WRITE(user_iov[i].iov_base,
+							   user_iov[i].iov_len)) {
+					return -EFAULT;
+				}
+
+				base = k_malloc(user_iov[i].iov_len);
+			} else {
+				base = k_usermode_alloc_from_copy(user_iov[i].iov_base,
+								  user_iov[i].iov_len);
+			}
+
+			if (base == NULL) {
+				return -ENOMEM;
+			}
+
+			copy->msg_iov[i].iov_base = base;
+			copy->msg_iov[i].iov_len = user_iov[i].iov_len;
+		}
+	}
+
+	if (msg->msg_namelen > 0) {
+		if (msg->msg_name == NULL) {
+			return -EINVAL;
+		}
+
+		if (recv) {
+			if (K_SYSCALL_MEMORY_WRITE(msg->msg_name, msg->msg_namelen)) {
+				return -EFAULT;
+			}
+
+			copy->msg_name = k_malloc(msg->msg_namelen);
+		} else {
+			copy->msg_name = k_usermode_alloc_from_copy(msg->msg_name,
+								    msg->msg_namelen);
+		}
+
+		if (copy->msg_name == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	if (msg->msg_controllen > 0) {
+		if (msg->msg_control == NULL) {
+			return -EINVAL;
+		}
+
+		if (recv) {
+			if (K_SYSCALL_MEMORY_WRITE(msg->msg_control, msg->msg_controllen)) {
+				return -EFAULT;
+			}
+
+			copy->msg_control = k_malloc(msg->msg_controllen);
+		} else {
+			copy->msg_control = k_usermode_alloc_from_copy(msg->msg_control,
+								       msg->msg_controllen);
+		}
+
+		if (copy->msg_control == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+/* Copy a received message back to the user mode message @p user_msg. The
+ * header @p msg holds the values the caller passed in. Returns non-zero if
+ * the user memory cannot be written, the caller then frees the copies and
+ * faults.
+ */
+static int mmsghdr_copy_to_user(struct mmsghdr *user_msg, const struct msghdr *msg,
+				 const struct msghdr *copy, unsigned int len)
+{
+	const struct iovec *user_iov = copy->msg_iov + msg->msg_iovlen;
+	struct mmsghdr out = {
+		.msg_hdr = *msg,
+		.msg_len = len,
+	};
+
+	/* The new iovlen cannot be bigger than the original one */
+	NET_ASSERT(copy->msg_iovlen <= msg->msg_iovlen);
+
+	for (size_t i = 0; i < msg->msg_iovlen; i++) {
+		size_t iov_len = 0;
+
+		if (i < copy->msg_iovlen) {
+			iov_len = copy->msg_iov[i].iov_len;
+			if (k_usermode_to_copy(user_iov[i].iov_base,
+					       copy->msg_iov[i].iov_base, iov_len)) {
+				return -EFAULT;
+			}
+		}
+
+		if (k_usermode_to_copy(&msg->msg_iov[i].iov_len, &iov_len,
+				       sizeof(iov_len))) {
+			return -EFAULT;
+		}
+	}
+
+	if (msg->msg_namelen > 0 &&
+	    k_usermode_to_copy(msg->msg_name, copy->msg_name,
+			       MIN(msg->msg_namelen, copy->msg_namelen))) {
+		return -EFAULT;
+	}
+
+	if (msg->msg_controllen > 0 &&
+	    k_usermode_to_copy(msg->msg_control, copy->msg_control,
+			       copy->msg_controllen)) {
+		return -EFAULT;
+	}
+
+	out.msg_hdr.msg_namelen = copy->msg_namelen;
+	out.msg_hdr.msg_controllen = copy->msg_controllen;
+	out.msg_hdr.msg_iovlen = copy->msg_iovlen;
+	out.msg_hdr.msg_flags = copy->msg_flags;
+
+	return k_usermode_to_copy(user_msg, &out, sizeof(out));
+}
+
+/* The iovec array of a received message may have been shortened, so it is
+ * freed according to the original length.
+ */
+static void mmsghdr_free_copy(struct msghdr *copy, size_t iovlen)
+{
+	k_free(copy->msg_name);
+	k_free(copy->msg_control);
+
+	if (copy->msg_iov != NULL) {
+		for (size_t i = 0; i < iovlen; i++) {
+			k_free(copy->msg_iov[i].iov_base);
+		}
+
+		k_free(copy->msg_iov);
+	}
+}
+
+/* Copies the message vector of a user mode call. The returned array holds
+ * the kernel copies in its first @p vlen elements, and the headers as passed
+ * by the caller in the following @p vlen elements.
+ */
+static struct mmsghdr *mmsghdr_vec_copy_from_user(struct mmsghdr *msgvec,
+						  unsigned int vlen, bool recv)
+{
+	struct mmsghdr *copy;
+	struct mmsghdr *user_vec;
+	int ret;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(struct mmsghdr)));
+
+	copy = k_calloc(2 * vlen, sizeof(struct mmsghdr));
+	if (copy == NULL) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	user_vec = copy + vlen;
+
+	if (k_usermode_from_copy(user_vec, msgvec, vlen * sizeof(struct mmsghdr))) {
+		k_free(copy);
+		K_OOPS(1);
+	}
+
+	for (unsigned int i = 0; i < vlen; i++) {
+		ret = mmsghdr_copy_from_user(&copy[i].msg_hdr, &user_vec[i].msg_hdr, recv);
+		if (ret < 0) {
+			errno = -ret;
+
+			for (unsigned int j = 0; j <= i; j++) {
+				mmsghdr_free_copy(&copy[j].msg_hdr, user_vec[j].msg_hdr.msg_iovlen);
+			}
+
+			k_free(copy);
+
+			return NULL;
+		}
+	}
+
+	return copy;
+}
+
+static void mmsghdr_vec_free_copy(struct mmsghdr *copy, unsigned int vlen)
+{
+	for (unsigned int i = 0; i < vlen; i++) {
+		mmsghdr_free_copy(&copy[i].msg_hdr, copy[vlen + i].msg_hdr.msg_iovlen);
+	}
+
+	k_free(copy);
+}
+
+int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags, struct timespec *timeout)
+{
+	struct timespec timeout_copy;
+	struct mmsghdr *copy;
+	struct mmsghdr *user_vec;
+	int ret;
+
+	if (timeout != NULL) {
+		K_OOPS(k_usermode_from_copy(&timeout_copy, timeout, sizeof(timeout_copy)));
+	}
+
+	vlen = MIN(vlen, CONFIG_NET_SOCKETS_MMSG_VLEN_MAX);
+	if (vlen == 0) {
+		return z_impl_zsock_recvmmsg(sock, NULL, 0, flags,
+					     timeout != NULL ? &timeout_copy : NULL);
+	}
+
+	copy = mmsghdr_vec_copy_from_user(msgvec, vlen, true);
+	if (copy == NULL) {
+		return -1;
+	}
+
+	user_vec = copy + vlen;
+
+	ret = z_impl_zsock_recvmmsg(sock, copy, vlen, flags,
+				    timeout != NULL ? &timeout_copy : NULL);
+
+	for (int i = 0; i < ret; i++) {
+		if (mmsghdr_copy_to_user(&msgvec[i], &user_vec[i].msg_hdr, &copy[i].msg_hdr,
+					 copy[i].msg_len)) {
+			goto oops_free;
+		}
+	}
+
+	mmsghdr_vec_free_copy(copy, vlen);
+
+	return ret;
+
+oops_free:
+	mmsghdr_vec_free_copy(copy, vlen);
+	K_OOPS(1);
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
+
+int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	struct mmsghdr *copy;
+	int ret;
+
+	vlen = MIN(vlen, CONFIG_NET_SOCKETS_MMSG_VLEN_MAX);
+	if (vlen == 0) {
+		return z_impl_zsock_sendmmsg(sock, NULL, 0, flags);
+	}
+
+	copy = mmsghdr_vec_copy_from_user(msgvec, vlen, false);
+	if (copy == NULL) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, copy, vlen, flags);
+
+	for (int i = 0; i < ret; i++) {
+		if (k_usermode_to_copy(&msgvec[i].msg_len, &copy[i].msg_len,
+				       sizeof(msgvec[i].msg_len))) {
+			goto oops_free;
+		}
+	}
+
+	mmsghdr_vec_free_copy(copy, vlen);
+
+	return ret;
+
+oops_free:
+	mmsghdr_vec_free_copy(copy, vlen);
+	K_OOPS(1);
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
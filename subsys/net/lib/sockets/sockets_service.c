@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(net_sock_svc, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/init.h>
 #include <zephyr/net/socket_service.h>
 #include <zephyr/zvfs/eventfd.h>
+#include <zephyr/zvfs/epoll.h>
 
 static int init_socket_service(void);
 
@@ -28,8 +29,17 @@ static K_CONDVAR_DEFINE(wait_start);
 STRUCT_SECTION_START_EXTERN(net_socket_service_desc);
 STRUCT_SECTION_END_EXTERN(net_socket_service_desc);
 
+/* Number of ready sockets handled per epoll wait */
+#define SOCKET_SERVICE_EPOLL_BATCH 4
+
 static struct service {
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	int epfd;
+	/* Service event that added each fd to the interest set */
+	struct net_socket_service_event *owner[CONFIG_ZVFS_OPEN_MAX];
+#else
 	struct zsock_pollfd events[CONFIG_ZVFS_POLL_MAX];
+#endif
 	int count;
 } ctx;
 
@@ -50,6 +60,64 @@ static void cleanup_svc_events(const struct net_socket_service_desc *svc)
 	}
 }
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+static void unwatch_svc_events(const struct net_socket_service_desc *svc)
+{
+	for (int i = 0; i < svc->pev_len; i++) {
+		int fd = svc->pev[i].event.fd;
+
+		/* If the socket was closed, closing it already removed it
+		 * from the interest set and the fd may now belong to someone
+		 * else, so only remove the entries we still own.
+		 */
+		if (fd < 0 || fd >= ARRAY_SIZE(ctx.owner) || ctx.owner[fd] != &svc->pev[i]) {
+			continue;
+		}
+
+		(void)zvfs_epoll_ctl(ctx.epfd, ZVFS_EPOLL_CTL_DEL, fd, NULL);
+		ctx.owner[fd] = NULL;
+	}
+}
+
+static int watch_svc_events(const struct net_socket_service_desc *svc)
+{
+	struct zvfs_epoll_event ev;
+	int ret;
+
+	for (int i = 0; i < svc->pev_len; i++) {
+		int fd = svc->pev[i].event.fd;
+
+		if (fd < 0) {
+			continue;
+		}
+
+		if (fd >= ARRAY_SIZE(ctx.owner)) {
+			return -EBADF;
+		}
+
+		ev.events = svc->pev[i].event.events;
+		ev.data.fd = fd;
+
+		ret = zvfs_epoll_ctl(ctx.epfd, ZVFS_EPOLL_CTL_ADD, fd, &ev);
+		if (ret < 0 && errno == EEXIST) {
+			/* Already watched on behalf of another service */
+			ret = zvfs_epoll_ctl(ctx.epfd, ZVFS_EPOLL_CTL_MOD, fd, &ev);
+		}
+
+		if (ret < 0) {
+			ret = -errno;
+			NET_DBG("Cannot watch fd %d for service %p (%d)", fd, svc, ret);
+			return ret;
+		}
+
+		svc->pev[i].svc = (struct net_socket_service_desc *)svc;
+		ctx.owner[fd] = &svc->pev[i];
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
+
 int z_impl_net_socket_service_register(const struct net_socket_service_desc *svc,
 				       struct zsock_pollfd *fds, int len,
 				       void *user_data)
@@ -71,26 +139,40 @@ int z_impl_net_socket_service_register(const struct net_socket_service_desc *svc
 		goto out;
 	}
 
+	if (fds != NULL && len > svc->pev_len) {
+		NET_DBG("Too many file descriptors, "
+			"max is %d for service %p",
+			svc->pev_len, svc);
+		ret = -ENOMEM;
+		goto out;
+	}
+
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	unwatch_svc_events(svc);
+#endif
+
 	if (fds == NULL) {
 		cleanup_svc_events(svc);
 	} else {
-		if (len > svc->pev_len) {
-			NET_DBG("Too many file descriptors, "
-				"max is %d for service %p",
-				svc->pev_len, svc);
-			ret = -ENOMEM;
-			goto out;
-		}
-
 		for (i = 0; i < len; i++) {
 			svc->pev[i].event = fds[i];
 			svc->pev[i].user_data = user_data;
 		}
 	}
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	/* The interest set is updated in place, the thread does not need
+	 * to be restarted.
+	 */
+	ret = watch_svc_events(svc);
+	if (ret < 0) {
+		unwatch_svc_events(svc);
+	}
+#else
 	/* Tell the thread to re-read the variables */
 	zvfs_eventfd_write(ctx.events[0].fd, 1);
 	ret = 0;
+#endif
 
 out:
 	k_mutex_unlock(&lock);
@@ -98,22 +180,6 @@ out:
 	return ret;
 }
 
-static struct net_socket_service_desc *find_svc_and_event(
-	struct zsock_pollfd *pev,
-	struct net_socket_service_event **event)
-{
-	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
-		for (int i = 0; i < svc->pev_len; i++) {
-			if (svc->pev[i].event.fd == pev->fd) {
-				*event = &svc->pev[i];
-				return svc;
-			}
-		}
-	}
-
-	return NULL;
-}
-
 /* We do not set the user callback to our work struct because we need to
  * hook into the flow and restore the global poll array so that the next poll
  * round will not notice it and call the callback again while we are
@@ -121,17 +187,127 @@ static struct net_socket_service_desc *find_svc_and_event(
  */
 void net_socket_service_callback(struct net_socket_service_event *pev)
 {
-	struct net_socket_service_desc *svc = pev->svc;
 	struct net_socket_service_event ev = *pev;
 
 	ev.callback(&ev);
 
+#if !defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	struct net_socket_service_desc *svc = pev->svc;
+
 	/* Copy back the socket fd to the global array because we marked
 	 * it as -1 when triggering the work.
 	 */
 	for (int i = 0; i < svc->pev_len; i++) {
 		ctx.events[get_idx(svc) + i] = svc->pev[i].event;
 	}
+#endif
+}
+
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+static void dispatch_event(struct zvfs_epoll_event *ev)
+{
+	struct net_socket_service_event *event;
+	int fd = ev->data.fd;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	/* An earlier callback of this batch may have unregistered the fd */
+	event = ctx.owner[fd];
+	if (event != NULL) {
+		event->event.revents = ev->events;
+	}
+
+	k_mutex_unlock(&lock);
+
+	if (event == NULL) {
+		return;
+	}
+
+	/* Synchronous call */
+	net_socket_service_callback(event);
+}
+
+static void socket_service_thread(void)
+{
+	struct zvfs_epoll_event events[SOCKET_SERVICE_EPOLL_BATCH];
+	int ret, count = 0;
+
+	STRUCT_SECTION_COUNT(net_socket_service_desc, &ret);
+	if (ret == 0) {
+		NET_INFO("No socket services found, service disabled.");
+		goto fail;
+	}
+
+	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
+		NET_DBG("Service %s has %d pollable sockets",
+			COND_CODE_1(CONFIG_NET_SOCKETS_LOG_LEVEL_DBG,
+				    (svc->owner), ("")),
+			svc->pev_len);
+		count += svc->pev_len;
+	}
+
+	if (count > CONFIG_ZVFS_EPOLL_ENTRIES_MAX) {
+		NET_ERR("You have %d services to monitor but "
+			"%d epoll entries configured.",
+			count, CONFIG_ZVFS_EPOLL_ENTRIES_MAX);
+		NET_ERR("Please increase value of %s to at least %d",
+			"CONFIG_ZVFS_EPOLL_ENTRIES_MAX", count);
+		goto fail;
+	}
+
+	NET_DBG("Monitoring %d socket entries", count);
+
+	ctx.count = count;
+
+	/* All sockets are kept in one persistent interest set, so a wakeup
+	 * only costs in proportion to the number of sockets with activity.
+	 */
+	ctx.epfd = zvfs_epoll_create(0);
+	if (ctx.epfd < 0) {
+		NET_ERR("zvfs_epoll_create failed (%d)", -errno);
+		goto fail;
+	}
+
+	thread_status = SOCKET_SERVICE_THREAD_RUNNING;
+	k_condvar_broadcast(&wait_start);
+
+	while (true) {
+		ret = zvfs_epoll_wait(ctx.epfd, events, ARRAY_SIZE(events), -1);
+		if (ret < 0) {
+			ret = -errno;
+			NET_ERR("epoll wait failed (%d)", ret);
+			break;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			dispatch_event(&events[i]);
+		}
+	}
+
+	NET_DBG("Socket service thread stopped");
+	thread_status = SOCKET_SERVICE_THREAD_STOPPED;
+
+	return;
+
+fail:
+	thread_status = SOCKET_SERVICE_THREAD_FAILED;
+	k_condvar_broadcast(&wait_start);
+}
+#else /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
+static struct net_socket_service_desc *find_svc_and_event(
+	struct zsock_pollfd *pev,
+	struct net_socket_service_event **event)
+{
+	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
+		for (int i = 0; i < svc->pev_len; i++) {
+			if (svc->pev[i].event.fd == pev->fd) {
+				*event = &svc->pev[i];
+				return svc;
+			}
+		}
+	}
+
+	return NULL;
 }
 
 static int call_work(struct zsock_pollfd *pev, struct net_socket_service_event *event)
@@ -276,6 +452,8 @@ fail:
 	k_condvar_broadcast(&wait_start);
 }
 
+#endif /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
+
 static int init_socket_service(void)
 {
 	k_tid_t ssm;
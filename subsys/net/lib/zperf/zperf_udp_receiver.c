@@ -312,14 +312,59 @@ static void udp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_UDP);
 }
 
+#if defined(CONFIG_NET_ZPERF_UDP_MMSG)
+#define UDP_RECEIVER_BATCH CONFIG_NET_ZPERF_UDP_MMSG_BATCH
+
+/* Only the zperf header of each datagram is kept, the rest of them is read
+ * into a shared buffer.
+ */
+static int udp_recv_batch(int sock)
+{
+	static struct zperf_udp_datagram hdrs[UDP_RECEIVER_BATCH];
+	static struct sockaddr addrs[UDP_RECEIVER_BATCH];
+	static struct iovec iov[UDP_RECEIVER_BATCH][2];
+	static struct mmsghdr msgs[UDP_RECEIVER_BATCH];
+	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
+	int ret;
+
+	/* Received lengths are stored in the headers, so set them again */
+	for (int i = 0; i < UDP_RECEIVER_BATCH; i++) {
+		iov[i][0].iov_base = &hdrs[i];
+		iov[i][0].iov_len = sizeof(hdrs[i]);
+		iov[i][1].iov_base = buf;
+		iov[i][1].iov_len = sizeof(buf);
+
+		msgs[i].msg_hdr = (struct msghdr){
+			.msg_name = &addrs[i],
+			.msg_namelen = sizeof(addrs[i]),
+			.msg_iov = iov[i],
+			.msg_iovlen = ARRAY_SIZE(iov[i]),
+		};
+	}
+
+	ret = zsock_recvmmsg(sock, msgs, UDP_RECEIVER_BATCH, ZSOCK_MSG_WAITFORONE, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		udp_received(sock, &addrs[i], (uint8_t *)&hdrs[i], msgs[i].msg_len);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_NET_ZPERF_UDP_MMSG */
+
 static int udp_recv_data(struct net_socket_service_event *pev)
 {
+#if !defined(CONFIG_NET_ZPERF_UDP_MMSG)
 	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+#endif
 	int ret = 0;
 	int family, sock_error;
-	struct sockaddr addr;
 	socklen_t optlen = sizeof(int);
-	socklen_t addrlen = sizeof(addr);
 
 	if (!udp_server_running) {
 		return -ENOENT;
@@ -341,8 +386,12 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		return 0;
 	}
 
+#if defined(CONFIG_NET_ZPERF_UDP_MMSG)
+	ret = udp_recv_batch(pev->event.fd);
+#else
 	ret = zsock_recvfrom(pev->event.fd, buf, sizeof(buf), 0,
 			     &addr, &addrlen);
+#endif
 	if (ret < 0) {
 		ret = -errno;
 		(void)zsock_getsockopt(pev->event.fd, SOL_SOCKET,
@@ -352,7 +401,9 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		goto error;
 	}
 
+#if !defined(CONFIG_NET_ZPERF_UDP_MMSG)
 	udp_received(pev->event.fd, &addr, buf, ret);
+#endif
 
 	return ret;
 
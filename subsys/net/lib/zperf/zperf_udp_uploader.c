@@ -138,6 +138,80 @@ static inline int zperf_upload_fin(int sock,
 	return 0;
 }
 
+/* Fill the zperf headers at the start of a datagram */
+static void udp_fill_header(uint8_t *packet, uint32_t id, uint32_t secs,
+			    uint32_t usecs, int port, uint32_t rate_in_kbps,
+			    uint32_t packet_size)
+{
+	struct zperf_udp_datagram *datagram;
+	struct zperf_client_hdr_v1 *hdr;
+
+	datagram = (struct zperf_udp_datagram *)packet;
+
+	datagram->id = htonl(id);
+	datagram->tv_sec = htonl(secs);
+	datagram->tv_usec = htonl(usecs);
+
+	hdr = (struct zperf_client_hdr_v1 *)(packet + sizeof(*datagram));
+	hdr->flags = 0;
+	hdr->num_of_threads = htonl(1);
+	hdr->port = htonl(port);
+	hdr->buffer_len = sizeof(sample_packet) -
+		sizeof(*datagram) - sizeof(*hdr);
+	hdr->bandwidth = htonl(rate_in_kbps);
+	hdr->num_of_bytes = htonl(packet_size);
+}
+
+#if defined(CONFIG_NET_ZPERF_UDP_MMSG)
+#define UDP_UPLOAD_BATCH CONFIG_NET_ZPERF_UDP_MMSG_BATCH
+
+/* Each datagram of a batch has its own headers, the payload is shared */
+static uint8_t batch_headers[UDP_UPLOAD_BATCH][sizeof(struct zperf_udp_datagram) +
+					       sizeof(struct zperf_client_hdr_v1)];
+
+static int udp_send_packets(int sock, uint32_t id, uint32_t secs,
+			    uint32_t usecs, int port, uint32_t rate_in_kbps,
+			    uint32_t packet_size)
+{
+	static struct iovec iov[UDP_UPLOAD_BATCH][2];
+	static struct mmsghdr msgs[UDP_UPLOAD_BATCH];
+	size_t header_len = MIN(packet_size, sizeof(batch_headers[0]));
+
+	for (int i = 0; i < UDP_UPLOAD_BATCH; i++) {
+		udp_fill_header(batch_headers[i], id + i, secs, usecs, port,
+				rate_in_kbps, packet_size);
+
+		iov[i][0].iov_base = batch_headers[i];
+		iov[i][0].iov_len = header_len;
+		iov[i][1].iov_base = sample_packet + header_len;
+		iov[i][1].iov_len = packet_size - header_len;
+
+		msgs[i].msg_hdr = (struct msghdr){
+			.msg_iov = iov[i],
+			.msg_iovlen = packet_size > header_len ? 2 : 1,
+		};
+	}
+
+	return zsock_sendmmsg(sock, msgs, UDP_UPLOAD_BATCH, 0);
+}
+#else
+#define UDP_UPLOAD_BATCH 1
+
+static int udp_send_packets(int sock, uint32_t id, uint32_t secs,
+			    uint32_t usecs, int port, uint32_t rate_in_kbps,
+			    uint32_t packet_size)
+{
+	int ret;
+
+	udp_fill_header(sample_packet, id, secs, usecs, port, rate_in_kbps,
+			packet_size);
+
+	ret = zsock_send(sock, sample_packet, packet_size, 0);
+
+	return ret < 0 ? ret : 1;
+}
+#endif /* CONFIG_NET_ZPERF_UDP_MMSG */
+
 static int udp_upload(int sock, int port,
 		      const struct zperf_upload_params *param,
 		      struct zperf_results *results)
@@ -145,7 +219,8 @@ static int udp_upload(int sock, int port,
 	uint32_t duration_in_ms = param->duration_ms;
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
-	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps);
+	uint32_t packet_duration_us =
+		zperf_packet_duration(packet_size, rate_in_kbps) * UDP_UPLOAD_BATCH;
 	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
 	uint32_t delay = packet_duration;
 	uint32_t nb_packets = 0U;
@@ -177,8 +252,6 @@ static int udp_upload(int sock, int port,
 	(void)memset(sample_packet, 'z', sizeof(sample_packet));
 
 	do {
-		struct zperf_udp_datagram *datagram;
-		struct zperf_client_hdr_v1 *hdr;
 		uint64_t usecs64;
 		uint32_t secs, usecs;
 		int64_t loop_time;
@@ -209,30 +282,14 @@ static int udp_upload(int sock, int port,
 		secs = usecs64 / USEC_PER_SEC;
 		usecs = usecs64 - (uint64_t)secs * USEC_PER_SEC;
 
-		/* Fill the packet header */
-		datagram = (struct zperf_udp_datagram *)sample_packet;
-
-		datagram->id = htonl(nb_packets);
-		datagram->tv_sec = htonl(secs);
-		datagram->tv_usec = htonl(usecs);
-
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
-						     sizeof(*datagram));
-		hdr->flags = 0;
-		hdr->num_of_threads = htonl(1);
-		hdr->port = htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
-			sizeof(*datagram) - sizeof(*hdr);
-		hdr->bandwidth = htonl(rate_in_kbps);
-		hdr->num_of_bytes = htonl(packet_size);
-
-		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
+		/* Send the packets */
+		ret = udp_send_packets(sock, nb_packets, secs, usecs, port,
+				       rate_in_kbps, packet_size);
 		if (ret < 0) {
 			NET_ERR("Failed to send the packet (%d)", errno);
 			return -errno;
 		} else {
-			nb_packets++;
+			nb_packets += ret;
 		}
 
 		if (IS_ENABLED(CONFIG_NET_ZPERF_LOG_LEVEL_DBG)) {
@@ -25,6 +25,123 @@ sys_slist_t settings_handlers;
 
 K_MUTEX_DEFINE(settings_lock);
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_SETTINGS_HANDLER_INDEX_SIZE),
+	     "Settings handler index size must be a power of two");
+
+#define SETTINGS_INDEX_MASK (CONFIG_SETTINGS_HANDLER_INDEX_SIZE - 1)
+#define SETTINGS_INDEX_FNV_OFFSET 2166136261U
+#define SETTINGS_INDEX_FNV_PRIME 16777619U
+
+/* Open addressing hash table of all registered handlers, keyed by the full
+ * handler name. A name is resolved by hashing each of its separator
+ * delimited prefixes, so the lookup cost depends on the depth of the name
+ * rather than on the number of registered handlers.
+ */
+static struct settings_handler_static *settings_index[CONFIG_SETTINGS_HANDLER_INDEX_SIZE];
+static size_t settings_index_cnt;
+/* Cleared until the index is built or when a handler could not be indexed,
+ * lookups then fall back to a linear scan of all handlers.
+ */
+static bool settings_index_valid;
+
+static inline uint32_t settings_index_hash_step(uint32_t hash, char c)
+{
+	return (hash ^ (uint8_t)c) * SETTINGS_INDEX_FNV_PRIME;
+}
+
+static void settings_index_add(struct settings_handler_static *handler)
+{
+	uint32_t hash = SETTINGS_INDEX_FNV_OFFSET;
+	size_t len = strlen(handler->name);
+	size_t pos;
+
+	if ((len == 0) ||
+	    (settings_index_cnt >= (CONFIG_SETTINGS_HANDLER_INDEX_SIZE * 3) / 4)) {
+		settings_index_valid = false;
+		return;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		hash = settings_index_hash_step(hash, handler->name[i]);
+	}
+
+	pos = hash & SETTINGS_INDEX_MASK;
+	while (settings_index[pos] != NULL) {
+		if (strcmp(settings_index[pos]->name, handler->name) == 0) {
+			/* Keep the last registered handler, as the scan does */
+			settings_index[pos] = handler;
+			return;
+		}
+		pos = (pos + 1) & SETTINGS_INDEX_MASK;
+	}
+
+	settings_index[pos] = handler;
+	settings_index_cnt++;
+}
+
+static struct settings_handler_static *settings_index_get(const char *name, size_t len,
+							   uint32_t hash)
+{
+	size_t pos = hash & SETTINGS_INDEX_MASK;
+
+	while (settings_index[pos] != NULL) {
+		const char *ch_name = settings_index[pos]->name;
+
+		if ((strncmp(ch_name, name, len) == 0) && (ch_name[len] == '\0')) {
+			return settings_index[pos];
+		}
+		pos = (pos + 1) & SETTINGS_INDEX_MASK;
+	}
+
+	return NULL;
+}
+
+static struct settings_handler_static *settings_index_lookup(const char *name,
+							      const char **next)
+{
+	struct settings_handler_static *bestmatch = NULL;
+	struct settings_handler_static *ch;
+	uint32_t hash = SETTINGS_INDEX_FNV_OFFSET;
+	size_t i;
+
+	for (i = 0; (name[i] != '\0') && (name[i] != SETTINGS_NAME_END); i++) {
+		if ((name[i] == SETTINGS_NAME_SEPARATOR) && (i > 0)) {
+			ch = settings_index_get(name, i, hash);
+			if (ch) {
+				bestmatch = ch;
+				if (next) {
+					*next = &name[i + 1];
+				}
+			}
+		}
+		hash = settings_index_hash_step(hash, name[i]);
+	}
+
+	if (i > 0) {
+		ch = settings_index_get(name, i, hash);
+		if (ch) {
+			bestmatch = ch;
+			if (next) {
+				*next = NULL;
+			}
+		}
+	}
+
+	return bestmatch;
+}
+
+static void settings_index_init(void)
+{
+	memset(settings_index, 0, sizeof(settings_index));
+	settings_index_cnt = 0;
+	settings_index_valid = true;
+
+	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		settings_index_add(ch);
+	}
+}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 
 void settings_store_init(void);
 
@@ -33,6 +150,9 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	settings_index_init();
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 	settings_store_init();
 }
 
@@ -59,6 +179,9 @@ int settings_register_with_cprio(struct settings_handler *handler, int cprio)
 
 	handler->cprio = cprio;
 	sys_slist_append(&settings_handlers, &handler->node);
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	settings_index_add((struct settings_handler_static *)handler);
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 
 end:
 	k_mutex_unlock(&settings_lock);
@@ -153,6 +276,12 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 		*next = NULL;
 	}
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	if (settings_index_valid && (name != NULL)) {
+		return settings_index_lookup(name, next);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
+
 	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
 			continue;
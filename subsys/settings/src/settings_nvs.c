@@ -28,6 +28,13 @@ struct settings_nvs_read_fn_arg {
 	uint16_t id;
 };
 
+#if CONFIG_SETTINGS_NVS_BULK_LOAD
+struct settings_nvs_buf_read_fn_arg {
+	const uint8_t *data;
+	size_t len;
+};
+#endif
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg);
 static int settings_nvs_save(struct settings_store *cs, const char *name,
@@ -57,6 +64,20 @@ static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 	return rc;
 }
 
+#if CONFIG_SETTINGS_NVS_BULK_LOAD
+static ssize_t settings_nvs_buf_read_fn(void *back_end, void *data, size_t len)
+{
+	struct settings_nvs_buf_read_fn_arg *rd_fn_arg;
+
+	rd_fn_arg = (struct settings_nvs_buf_read_fn_arg *)back_end;
+
+	len = MIN(len, rd_fn_arg->len);
+	memcpy(data, rd_fn_arg->data, len);
+
+	return len;
+}
+#endif /* CONFIG_SETTINGS_NVS_BULK_LOAD */
+
 int settings_nvs_src(struct settings_nvs *cf)
 {
 	cf->cf_store.cs_itf = &settings_nvs_itf;
@@ -127,7 +148,12 @@ static int settings_nvs_load(struct settings_store *cs,
 	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
 	struct settings_nvs_read_fn_arg read_fn_arg;
 	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+#if CONFIG_SETTINGS_NVS_BULK_LOAD
+	struct settings_nvs_buf_read_fn_arg buf_read_fn_arg;
+	uint8_t buf[SETTINGS_MAX_VAL_LEN];
+#else
 	char buf;
+#endif
 	ssize_t rc1, rc2;
 	uint16_t name_id = NVS_NAMECNT_ID;
 
@@ -152,7 +178,9 @@ static int settings_nvs_load(struct settings_store *cs,
 
 		/* In the NVS backend, each setting item is stored in two NVS
 		 * entries one for the setting's name and one with the
-		 * setting's value.
+		 * setting's value. With bulk load enabled the value is read
+		 * in the same pass and handed over to the handler from RAM,
+		 * instead of being looked up in flash a second time.
 		 */
 		rc1 = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
 		rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
@@ -201,6 +229,23 @@ static int settings_nvs_load(struct settings_store *cs,
 		cached++;
 #endif
 
+#if CONFIG_SETTINGS_NVS_BULK_LOAD
+		if ((size_t)rc2 <= sizeof(buf)) {
+			buf_read_fn_arg.data = buf;
+			buf_read_fn_arg.len = rc2;
+
+			ret = settings_call_set_handler(
+				name, rc2,
+				settings_nvs_buf_read_fn, &buf_read_fn_arg,
+				(void *)arg);
+			if (ret) {
+				break;
+			}
+
+			continue;
+		}
+#endif /* CONFIG_SETTINGS_NVS_BULK_LOAD */
+
 		ret = settings_call_set_handler(
 			name, rc2,
 			settings_nvs_read_fn, &read_fn_arg,
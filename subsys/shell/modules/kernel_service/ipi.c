@@ -0,0 +1,52 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/smp.h>
+
+#include <inttypes.h>
+
+static int cmd_kernel_ipi(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct k_ipi_stats stats;
+
+	shell_print(sh, "CPU  %10s  %10s  %10s", "SENT", "RECEIVED", "COALESCED");
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		if (k_ipi_stats_get(i, &stats) != 0) {
+			continue;
+		}
+
+		shell_print(sh, "%3u  %10" PRIu64 "  %10" PRIu64 "  %10" PRIu64, i, stats.sent,
+			    stats.received, stats.coalesced);
+	}
+
+	return 0;
+}
+
+static int cmd_kernel_ipi_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_ipi_stats_reset();
+
+	shell_print(sh, "IPI statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_ipi,
+	SHELL_CMD(reset, NULL, "Reset IPI statistics.", cmd_kernel_ipi_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+KERNEL_CMD_ADD(ipi, &sub_kernel_ipi, "Scheduler IPI statistics.", cmd_kernel_ipi);
@@ -0,0 +1,95 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <zephyr/kernel.h>
+
+static void latency_print(const struct shell *sh, const char *name,
+			  const struct k_latency_stats *stats)
+{
+	if (stats->count == 0U) {
+		shell_print(sh, "\t%-8s none", name);
+		return;
+	}
+
+	shell_print(sh, "\t%-8s n %u, min %u, avg %u, p50 %u, p90 %u, p99 %u, max %u",
+		    name, stats->count, stats->min,
+		    (uint32_t)(stats->total / stats->count),
+		    k_latency_stats_percentile(stats, 50),
+		    k_latency_stats_percentile(stats, 90),
+		    k_latency_stats_percentile(stats, 99), stats->max);
+}
+
+static void histogram_print(const struct shell *sh, const struct k_latency_stats *stats)
+{
+	for (unsigned int i = 0; i < CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS; i++) {
+		if (stats->buckets[i] == 0U) {
+			continue;
+		}
+
+		if (i == CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS - 1U) {
+			shell_print(sh, "\t\t>= %10u: %u", (uint32_t)BIT(i),
+				    stats->buckets[i]);
+		} else {
+			shell_print(sh, "\t\t<  %10u: %u", (uint32_t)((2ULL << i)),
+				    stats->buckets[i]);
+		}
+	}
+}
+
+static void thread_latency_print(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *sh = user_data;
+	k_thread_runtime_stats_t stats;
+	const char *tname;
+
+	if (k_thread_runtime_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	tname = k_thread_name_get(thread);
+
+	shell_print(sh, "%p %s", thread, (tname != NULL) ? tname : "NA");
+	latency_print(sh, "wakeup", &stats.wakeup_latency);
+	latency_print(sh, "preempt", &stats.preempt_latency);
+}
+
+static int cmd_kernel_latency(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "Latencies in cycles, percentiles rounded up to a power of 2");
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	k_thread_runtime_stats_t stats;
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		if (k_thread_runtime_stats_cpu_get(cpu, &stats) != 0) {
+			continue;
+		}
+
+		shell_print(sh, "CPU %u", cpu);
+		latency_print(sh, "wakeup", &stats.wakeup_latency);
+		histogram_print(sh, &stats.wakeup_latency);
+		latency_print(sh, "preempt", &stats.preempt_latency);
+		histogram_print(sh, &stats.preempt_latency);
+	}
+#endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
+
+	/*
+	 * Use the unlocked version as the callback itself might call
+	 * arch_irq_unlock.
+	 */
+	k_thread_foreach_unlocked(thread_latency_print, (void *)sh);
+
+	return 0;
+}
+
+KERNEL_CMD_ADD(latency, NULL, "Scheduling latency statistics.", cmd_kernel_latency);
@@ -0,0 +1,122 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/obj_core.h>
+
+#include <inttypes.h>
+
+struct lock_walk {
+	const struct shell *sh;
+	const char *type;
+	bool reset;
+};
+
+static const uint32_t lock_types[] = {
+	K_OBJ_TYPE_MUTEX_ID,
+	K_OBJ_TYPE_SEM_ID,
+	K_OBJ_TYPE_SPINLOCK_ID,
+};
+
+static int lock_stats_cb(struct k_obj_core *obj_core, void *data)
+{
+	struct lock_walk *walk = data;
+	struct k_lock_stats stats;
+
+	if (walk->reset) {
+		(void)k_obj_core_stats_reset(obj_core);
+		return 0;
+	}
+
+	if (k_obj_core_stats_raw(obj_core, &stats, sizeof(stats)) != 0) {
+		/* Not registered for statistics */
+		return 0;
+	}
+
+	if (stats.acquired == 0U && stats.contended == 0U) {
+		/* Never used since the last reset */
+		return 0;
+	}
+
+	shell_print(walk->sh,
+		    "%s  %p  %10" PRIu64 "  %10" PRIu64 "  %12" PRIu64 "  %10u  %10u"
+		    "  %10" PRIu64 "  %10" PRIu64, walk->type,
+		    (void *)((uint8_t *)obj_core - obj_core->type->obj_core_offset),
+		    stats.acquired, stats.contended, stats.total_wait, stats.max_wait,
+		    stats.max_hold, stats.spun, stats.spin_acquired);
+
+	return 0;
+}
+
+static void lock_stats_walk(struct lock_walk *walk)
+{
+	char type[5];
+
+	for (size_t i = 0; i < ARRAY_SIZE(lock_types); i++) {
+		struct k_obj_type *obj_type = k_obj_type_find(lock_types[i]);
+
+		if (obj_type == NULL) {
+			continue;
+		}
+
+		type[0] = (char)(lock_types[i] >> 24);
+		type[1] = (char)(lock_types[i] >> 16);
+		type[2] = (char)(lock_types[i] >> 8);
+		type[3] = (char)lock_types[i];
+		type[4] = '\0';
+		walk->type = type;
+
+		/* The shell may block, so the lists can't be locked while printing */
+		(void)k_obj_type_walk_unlocked(obj_type, lock_stats_cb, walk);
+	}
+}
+
+static int cmd_kernel_locks(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct lock_walk walk = {
+		.sh = sh,
+		.reset = false,
+	};
+
+	shell_print(sh, "Times in cycles, at %u cycles per second",
+		    sys_clock_hw_cycles_per_sec());
+	shell_print(sh, "TYPE  %-10s  %10s  %10s  %12s  %10s  %10s  %10s  %10s", "OBJECT",
+		    "ACQUIRED", "CONTENDED", "TOTAL WAIT", "MAX WAIT", "MAX HOLD", "SPUN",
+		    "SPIN ACQ");
+
+	lock_stats_walk(&walk);
+
+	return 0;
+}
+
+static int cmd_kernel_locks_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct lock_walk walk = {
+		.sh = sh,
+		.reset = true,
+	};
+
+	lock_stats_walk(&walk);
+
+	shell_print(sh, "Lock statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_locks,
+	SHELL_CMD(reset, NULL, "Reset lock statistics.", cmd_kernel_locks_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+KERNEL_CMD_ADD(locks, &sub_kernel_locks, "Lock contention statistics.", cmd_kernel_locks);
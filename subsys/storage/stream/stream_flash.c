@@ -74,7 +74,7 @@ static int settings_direct_loader(const char *key, size_t len,
 
 #ifdef CONFIG_STREAM_FLASH_ERASE
 
-int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
+static int erase_page(struct stream_flash_ctx *ctx, off_t off)
 {
 #if defined(CONFIG_FLASH_HAS_EXPLICIT_ERASE)
 	int rc;
@@ -120,25 +120,38 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 #endif
 }
 
+int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
+{
+	int rc;
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	/* The background work erases pages of the same context */
+	k_mutex_lock(&ctx->erase_lock, K_FOREVER);
+#endif
+
+	rc = erase_page(ctx, off);
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	k_mutex_unlock(&ctx->erase_lock);
+#endif
+
+	return rc;
+}
+
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+static int flash_sync_buf(struct stream_flash_ctx *ctx, uint8_t *buf,
+			  size_t buf_bytes, size_t write_addr)
 {
 	int rc = 0;
-	size_t write_addr = ctx->offset + ctx->bytes_written;
 	size_t buf_bytes_aligned;
 	size_t fill_length;
 	uint8_t filler;
 
-
-	if (ctx->buf_bytes == 0) {
-		return 0;
-	}
-
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
 		rc = stream_flash_erase_page(ctx,
-					     write_addr + ctx->buf_bytes - 1);
+					     write_addr + buf_bytes - 1);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
 				rc, write_addr);
@@ -147,17 +160,17 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	fill_length = ctx->write_block_size;
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (buf_bytes % fill_length) {
+		fill_length -= buf_bytes % fill_length;
 		filler = ctx->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + buf_bytes, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = buf_bytes + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -169,30 +182,230 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < buf_bytes; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf, buf_bytes);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, buf_bytes, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
 		}
 	}
 
+	return rc;
+}
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+	if (ctx->buf_bytes == 0) {
+		return 0;
+	}
+
+	rc = flash_sync_buf(ctx, ctx->buf, ctx->buf_bytes,
+			    ctx->offset + ctx->bytes_written);
+	if (rc != 0) {
+		return rc;
+	}
+
 	ctx->bytes_written += ctx->buf_bytes;
 	ctx->buf_bytes = 0U;
 
 	return rc;
 }
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC_ERASE_AHEAD
+/* Erase the page the next buffer, starting at @p next_start, will be
+ * written to while the caller is still filling it.
+ *
+ * Only the last erased page is tracked, and a buffer is flushed by erasing
+ * the page of its last byte. The next buffer may be flushed before it is
+ * full, so the page is only erased ahead when all of the buffer falls in
+ * it: moving the erase state to a later page would get the page of a short
+ * flush erased again, along with the data already written to it.
+ */
+static int stream_flash_async_erase_ahead(struct stream_flash_ctx *ctx, size_t next_start)
+{
+	size_t area_end = ctx->offset + ctx->available - 1;
+	struct flash_pages_info start_page;
+	struct flash_pages_info end_page;
+	int rc;
+
+	if (next_start > area_end) {
+		return 0;
+	}
+
+	rc = flash_get_page_info_by_offs(ctx->fdev, next_start, &start_page);
+	if (rc == 0) {
+		rc = flash_get_page_info_by_offs(ctx->fdev,
+						 MIN(next_start + ctx->buf_len - 1, area_end),
+						 &end_page);
+	}
+
+	if (rc != 0) {
+		LOG_ERR("Error %d while getting page info", rc);
+		return rc;
+	}
+
+	if (start_page.start_offset != end_page.start_offset) {
+		return 0;
+	}
+
+	return stream_flash_erase_page(ctx, next_start);
+}
+#endif /* CONFIG_STREAM_FLASH_ASYNC_ERASE_AHEAD */
+
+static void stream_flash_async_handler(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(work, struct stream_flash_ctx, async_work);
+	/* The submitter has reaped the previous buffer, so bytes_written
+	 * is stable until this buffer completes.
+	 */
+	size_t write_addr = ctx->offset + ctx->bytes_written;
+	int rc;
+
+	rc = flash_sync_buf(ctx, ctx->async_buf, ctx->async_buf_bytes,
+			    write_addr);
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC_ERASE_AHEAD
+	if (rc == 0) {
+		rc = stream_flash_async_erase_ahead(ctx, write_addr + ctx->async_buf_bytes);
+	}
+#endif /* CONFIG_STREAM_FLASH_ASYNC_ERASE_AHEAD */
+
+	ctx->async_rc = rc;
+	k_sem_give(&ctx->async_done);
+}
+
+/* Wait for the buffer being programmed in the background, if any, and
+ * account for its bytes.
+ */
+static int stream_flash_async_wait(struct stream_flash_ctx *ctx)
+{
+	struct k_work_q *work_q = (ctx->async_work_q != NULL) ? ctx->async_work_q : &k_sys_work_q;
+	int rc;
+
+	/* The work item could never run while its queue waits for it */
+	__ASSERT(k_current_get() != k_work_queue_thread_get(work_q),
+		 "stream flash written from its own work queue");
+	ARG_UNUSED(work_q);
+
+	if (!ctx->async_busy) {
+		return 0;
+	}
+
+	k_sem_take(&ctx->async_done, K_FOREVER);
+	ctx->async_busy = false;
+
+	rc = ctx->async_rc;
+	if (rc == 0) {
+		ctx->bytes_written += ctx->async_buf_bytes;
+	}
+	ctx->async_buf_bytes = 0U;
+
+	return rc;
+}
+
+/* Hand the full write buffer over to the background worker and continue
+ * filling the other one.
+ */
+static int stream_flash_async_sync(struct stream_flash_ctx *ctx)
+{
+	uint8_t *full = ctx->buf;
+	int rc;
+
+	rc = stream_flash_async_wait(ctx);
+	if (rc != 0) {
+		return rc;
+	}
+
+	ctx->buf = ctx->async_buf;
+	ctx->async_buf = full;
+	ctx->async_buf_bytes = ctx->buf_bytes;
+	ctx->buf_bytes = 0U;
+	ctx->async_busy = true;
+
+	if (ctx->async_work_q != NULL) {
+		rc = k_work_submit_to_queue(ctx->async_work_q, &ctx->async_work);
+	} else {
+		rc = k_work_submit(&ctx->async_work);
+	}
+
+	if (rc < 0) {
+		/* Not queued, program the buffer from the caller's context */
+		stream_flash_async_handler(&ctx->async_work);
+		return stream_flash_async_wait(ctx);
+	}
+
+	return 0;
+}
+
+int stream_flash_async_enable(struct stream_flash_ctx *ctx, uint8_t *buf,
+			      struct k_work_q *work_q)
+{
+	if (!ctx || !buf || !ctx->buf) {
+		return -EFAULT;
+	}
+
+	if (ctx->async_busy || ctx->buf_bytes != 0) {
+		return -EBUSY;
+	}
+
+	ctx->async_buf = buf;
+	ctx->async_buf_bytes = 0U;
+	ctx->async_work_q = work_q;
+	ctx->async_rc = 0;
+	k_work_init(&ctx->async_work, stream_flash_async_handler);
+	k_sem_init(&ctx->async_done, 0, 1);
+
+	return 0;
+}
+
+static inline bool stream_flash_async_enabled(const struct stream_flash_ctx *ctx)
+{
+	return ctx->async_buf != NULL;
+}
+
+static inline size_t stream_flash_async_pending(const struct stream_flash_ctx *ctx)
+{
+	return ctx->async_buf_bytes;
+}
+
+#else
+
+static inline bool stream_flash_async_enabled(const struct stream_flash_ctx *ctx)
+{
+	return false;
+}
+
+static inline size_t stream_flash_async_pending(const struct stream_flash_ctx *ctx)
+{
+	return 0;
+}
+
+static inline int stream_flash_async_sync(struct stream_flash_ctx *ctx)
+{
+	return -ENOTSUP;
+}
+
+static inline int stream_flash_async_wait(struct stream_flash_ctx *ctx)
+{
+	return 0;
+}
+
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush)
 {
@@ -204,7 +417,8 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (ctx->bytes_written + stream_flash_async_pending(ctx) +
+	    ctx->buf_bytes + len > ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -214,7 +428,11 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		       buf_empty_bytes);
 
 		ctx->buf_bytes = ctx->buf_len;
-		rc = flash_sync(ctx);
+		if (stream_flash_async_enabled(ctx)) {
+			rc = stream_flash_async_sync(ctx);
+		} else {
+			rc = flash_sync(ctx);
+		}
 
 		if (rc != 0) {
 			return rc;
@@ -230,8 +448,11 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		ctx->buf_bytes += len - processed;
 	}
 
-	if (flush && ctx->buf_bytes > 0) {
-		rc = flash_sync(ctx);
+	if (flush) {
+		rc = stream_flash_async_wait(ctx);
+		if (rc == 0 && ctx->buf_bytes > 0) {
+			rc = flash_sync(ctx);
+		}
 	}
 
 	return rc;
@@ -319,6 +540,13 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 				      size);
 	ctx->callback = cb;
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	ctx->async_buf = NULL;
+	ctx->async_buf_bytes = 0U;
+	ctx->async_busy = false;
+	k_mutex_init(&ctx->erase_lock);
+#endif
+
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	ctx->last_erased_page_start_offset = -1;
 #endif
@@ -145,6 +145,7 @@ extern "C" {
 	sys_trace_k_sem_take_blocking(sem, timeout)
 #define sys_port_trace_k_sem_take_exit(sem, timeout, ret)                      \
 	sys_trace_k_sem_take_exit(sem, timeout, ret)
+#define sys_port_trace_k_sem_take_contended(sem, wait)
 #define sys_port_trace_k_sem_reset(sem) sys_trace_k_sem_reset(sem)
 
 #define sys_port_trace_k_mutex_init(mutex, ret)                                \
@@ -155,6 +156,7 @@ extern "C" {
 	sys_trace_k_mutex_lock_blocking(mutex, timeout)
 #define sys_port_trace_k_mutex_lock_exit(mutex, timeout, ret)                  \
 	sys_trace_k_mutex_lock_exit(mutex, timeout, ret)
+#define sys_port_trace_k_mutex_lock_contended(mutex, wait)
 #define sys_port_trace_k_mutex_unlock_enter(mutex)                             \
 	sys_trace_k_mutex_unlock_enter(mutex)
 #define sys_port_trace_k_mutex_unlock_exit(mutex, ret)                         \
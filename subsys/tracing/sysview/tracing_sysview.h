@@ -294,6 +294,8 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_sem_take_exit(sem, timeout, ret)                                          \
 	SEGGER_SYSVIEW_RecordEndCallU32(TID_SEMA_TAKE, (int32_t)ret)
 
+#define sys_port_trace_k_sem_take_contended(sem, wait)
+
 #define sys_port_trace_k_sem_reset(sem)                                                            \
 	SEGGER_SYSVIEW_RecordU32(TID_SEMA_RESET, (uint32_t)(uintptr_t)sem)
 
@@ -309,6 +311,8 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_mutex_lock_exit(mutex, timeout, ret)                                      \
 	SEGGER_SYSVIEW_RecordEndCallU32(TID_MUTEX_LOCK, (int32_t)ret)
 
+#define sys_port_trace_k_mutex_lock_contended(mutex, wait)
+
 #define sys_port_trace_k_mutex_unlock_enter(mutex)                                                 \
 	SEGGER_SYSVIEW_RecordU32(TID_MUTEX_UNLOCK, (uint32_t)(uintptr_t)mutex)
 
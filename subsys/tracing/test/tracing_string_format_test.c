@@ -271,6 +271,11 @@ void sys_trace_k_sem_take_blocking(struct k_sem *sem, k_timeout_t timeout)
 	TRACING_STRING("%s: %p, timeout: %u\n", __func__, sem, (uint32_t)timeout.ticks);
 }
 
+void sys_trace_k_sem_take_contended(struct k_sem *sem, uint32_t wait)
+{
+	TRACING_STRING("%s: %p, wait: %u\n", __func__, sem, wait);
+}
+
 void sys_trace_k_sem_reset(struct k_sem *sem)
 {
 	TRACING_STRING("%s: %p\n", __func__, sem);
@@ -297,6 +302,11 @@ void sys_trace_k_mutex_lock_blocking(struct k_mutex *mutex, k_timeout_t timeout)
 	TRACING_STRING("%s: %p, timeout: %u\n", __func__, mutex, (uint32_t)timeout.ticks);
 }
 
+void sys_trace_k_mutex_lock_contended(struct k_mutex *mutex, uint32_t wait)
+{
+	TRACING_STRING("%s: %p, wait: %u\n", __func__, mutex, wait);
+}
+
 void sys_trace_k_mutex_unlock_enter(struct k_mutex *mutex)
 {
 	TRACING_STRING("%s: %p\n", __func__, mutex);
@@ -127,6 +127,7 @@
 #define sys_port_trace_k_sem_take_blocking(sem, timeout) sys_trace_k_sem_take_blocking(sem, timeout)
 #define sys_port_trace_k_sem_take_exit(sem, timeout, ret)                                          \
 	sys_trace_k_sem_take_exit(sem, timeout, ret)
+#define sys_port_trace_k_sem_take_contended(sem, wait) sys_trace_k_sem_take_contended(sem, wait)
 #define sys_port_trace_k_sem_reset(sem) sys_trace_k_sem_reset(sem)
 
 #define sys_port_trace_k_mutex_init(mutex, ret) sys_trace_k_mutex_init(mutex, ret)
@@ -136,6 +137,8 @@
 	sys_trace_k_mutex_lock_blocking(mutex, timeout)
 #define sys_port_trace_k_mutex_lock_exit(mutex, timeout, ret)                                      \
 	sys_trace_k_mutex_lock_exit(mutex, timeout, ret)
+#define sys_port_trace_k_mutex_lock_contended(mutex, wait)                                         \
+	sys_trace_k_mutex_lock_contended(mutex, wait)
 #define sys_port_trace_k_mutex_unlock_enter(mutex) sys_trace_k_mutex_unlock_enter(mutex)
 #define sys_port_trace_k_mutex_unlock_exit(mutex, ret) sys_trace_k_mutex_unlock_exit(mutex, ret)
 
@@ -509,12 +512,14 @@ void sys_trace_k_sem_give_enter(struct k_sem *sem);
 void sys_trace_k_sem_take_enter(struct k_sem *sem, k_timeout_t timeout);
 void sys_trace_k_sem_take_blocking(struct k_sem *sem, k_timeout_t timeout);
 void sys_trace_k_sem_take_exit(struct k_sem *sem, k_timeout_t timeout, int ret);
+void sys_trace_k_sem_take_contended(struct k_sem *sem, uint32_t wait);
 void sys_trace_k_sem_reset(struct k_sem *sem);
 
 void sys_trace_k_mutex_init(struct k_mutex *mutex, int ret);
 void sys_trace_k_mutex_lock_enter(struct k_mutex *mutex, k_timeout_t timeout);
 void sys_trace_k_mutex_lock_blocking(struct k_mutex *mutex, k_timeout_t timeout);
 void sys_trace_k_mutex_lock_exit(struct k_mutex *mutex, k_timeout_t timeout, int ret);
+void sys_trace_k_mutex_lock_contended(struct k_mutex *mutex, uint32_t wait);
 void sys_trace_k_mutex_unlock_enter(struct k_mutex *mutex);
 void sys_trace_k_mutex_unlock_exit(struct k_mutex *mutex, int ret);
 
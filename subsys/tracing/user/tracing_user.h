@@ -205,12 +205,14 @@ void sys_trace_gpio_fire_callback_user(const struct device *port, struct gpio_ca
 #define sys_port_trace_k_sem_take_enter(sem, timeout)
 #define sys_port_trace_k_sem_take_blocking(sem, timeout)
 #define sys_port_trace_k_sem_take_exit(sem, timeout, ret)
+#define sys_port_trace_k_sem_take_contended(sem, wait)
 #define sys_port_trace_k_sem_reset(sem)
 
 #define sys_port_trace_k_mutex_init(mutex, ret)
 #define sys_port_trace_k_mutex_lock_enter(mutex, timeout)
 #define sys_port_trace_k_mutex_lock_blocking(mutex, timeout)
 #define sys_port_trace_k_mutex_lock_exit(mutex, timeout, ret)
+#define sys_port_trace_k_mutex_lock_contended(mutex, wait)
 #define sys_port_trace_k_mutex_unlock_enter(mutex)
 #define sys_port_trace_k_mutex_unlock_exit(mutex, ret)
 
@@ -0,0 +1,227 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief CoAP message handling benchmark
+ *
+ * Builds and parses messages as a LwM2M client exchanges them with its
+ * server, a read request with Observe, a registration and a notification,
+ * and looks up their options the way a request handler does. Comparing runs
+ * with and without CONFIG_COAP_OPTION_INDEX shows what indexing the options
+ * saves on the lookups and what it costs when building and parsing.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/coap.h>
+
+#define BENCH_ITERATIONS     10000
+#define BENCH_BUF_SIZE       256
+#define BENCH_MAX_OPTIONS    8
+
+/* application/senml+cbor */
+#define BENCH_FORMAT_SENML_CBOR 112
+
+static const uint8_t token[] = { 0x8a, 0x31, 0x5e, 0x02, 0xc7, 0x44, 0x10, 0xfb };
+
+static const char register_payload[] =
+	"</>;rt=\"oma.lwm2m\";ct=11543,</1/0>,</3/0>,</3/0/0>,</3/0/1>,</4/0>,</5/0>";
+
+static const uint8_t notify_payload[] = {
+	0x81, 0xa3, 0x21, 0x66, 0x2f, 0x33, 0x2f, 0x30, 0x2f, 0x00, 0x61, 0x30,
+	0x03, 0x6c, 0x5a, 0x65, 0x70, 0x68, 0x79, 0x72, 0x20, 0x4c, 0x77, 0x4d,
+};
+
+static uint8_t msg_buf[BENCH_BUF_SIZE];
+
+typedef int (*bench_build_t)(struct coap_packet *cpkt, uint8_t *buf);
+typedef int (*bench_lookup_t)(const struct coap_packet *cpkt);
+
+/* GET /3/0/0 with Observe, as sent by the server */
+static int build_read(struct coap_packet *cpkt, uint8_t *buf)
+{
+	int r;
+
+	r = coap_packet_init(cpkt, buf, BENCH_BUF_SIZE, COAP_VERSION_1, COAP_TYPE_CON,
+			     sizeof(token), token, COAP_METHOD_GET, 0x1234);
+	r = r < 0 ? r : coap_append_option_int(cpkt, COAP_OPTION_OBSERVE, 0);
+	r = r < 0 ? r : coap_packet_set_path(cpkt, "3/0/0");
+	r = r < 0 ? r : coap_append_option_int(cpkt, COAP_OPTION_ACCEPT,
+					       BENCH_FORMAT_SENML_CBOR);
+
+	return r;
+}
+
+static int lookup_read(const struct coap_packet *cpkt)
+{
+	struct coap_option options[BENCH_MAX_OPTIONS];
+	int r;
+
+	r = coap_find_options(cpkt, COAP_OPTION_URI_PATH, options, ARRAY_SIZE(options));
+	if (r != 3) {
+		return -EINVAL;
+	}
+
+	if (coap_get_option_int(cpkt, COAP_OPTION_OBSERVE) != 0 ||
+	    coap_get_option_int(cpkt, COAP_OPTION_ACCEPT) != BENCH_FORMAT_SENML_CBOR ||
+	    coap_get_option_int(cpkt, COAP_OPTION_CONTENT_FORMAT) != -ENOENT) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* POST /rd?ep=..&lt=..&lwm2m=1.1&b=U, as sent by the client */
+static int build_register(struct coap_packet *cpkt, uint8_t *buf)
+{
+	static const char * const queries[] = {
+		"ep=zephyr-0123456789abcdef", "lt=86400", "lwm2m=1.1", "b=U",
+	};
+	int r;
+
+	r = coap_packet_init(cpkt, buf, BENCH_BUF_SIZE, COAP_VERSION_1, COAP_TYPE_CON,
+			     sizeof(token), token, COAP_METHOD_POST, 0x1235);
+	r = r < 0 ? r : coap_packet_set_path(cpkt, "rd");
+	r = r < 0 ? r : coap_append_option_int(cpkt, COAP_OPTION_CONTENT_FORMAT,
+					       COAP_CONTENT_FORMAT_APP_LINK_FORMAT);
+
+	for (int i = 0; r >= 0 && i < ARRAY_SIZE(queries); i++) {
+		r = coap_packet_append_option(cpkt, COAP_OPTION_URI_QUERY, queries[i],
+					      strlen(queries[i]));
+	}
+
+	r = r < 0 ? r : coap_packet_append_payload_marker(cpkt);
+	r = r < 0 ? r : coap_packet_append_payload(cpkt, register_payload,
+						   sizeof(register_payload) - 1);
+
+	return r;
+}
+
+static int lookup_register(const struct coap_packet *cpkt)
+{
+	struct coap_option options[BENCH_MAX_OPTIONS];
+	int r;
+
+	r = coap_find_options(cpkt, COAP_OPTION_URI_PATH, options, ARRAY_SIZE(options));
+	if (r != 1) {
+		return -EINVAL;
+	}
+
+	r = coap_find_options(cpkt, COAP_OPTION_URI_QUERY, options, ARRAY_SIZE(options));
+	if (r != 4) {
+		return -EINVAL;
+	}
+
+	if (coap_get_option_int(cpkt, COAP_OPTION_CONTENT_FORMAT) !=
+	    COAP_CONTENT_FORMAT_APP_LINK_FORMAT) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* 2.05 Content notification with the observed resource */
+static int build_notify(struct coap_packet *cpkt, uint8_t *buf)
+{
+	int r;
+
+	r = coap_packet_init(cpkt, buf, BENCH_BUF_SIZE, COAP_VERSION_1, COAP_TYPE_NON_CON,
+			     sizeof(token), token, COAP_RESPONSE_CODE_CONTENT, 0x1236);
+	r = r < 0 ? r : coap_append_option_int(cpkt, COAP_OPTION_OBSERVE, 42);
+	r = r < 0 ? r : coap_append_option_int(cpkt, COAP_OPTION_CONTENT_FORMAT,
+					       BENCH_FORMAT_SENML_CBOR);
+	r = r < 0 ? r : coap_packet_append_payload_marker(cpkt);
+	r = r < 0 ? r : coap_packet_append_payload(cpkt, notify_payload,
+						   sizeof(notify_payload));
+
+	return r;
+}
+
+static int lookup_notify(const struct coap_packet *cpkt)
+{
+	uint16_t len;
+
+	if (coap_get_option_int(cpkt, COAP_OPTION_OBSERVE) != 42 ||
+	    coap_get_option_int(cpkt, COAP_OPTION_CONTENT_FORMAT) != BENCH_FORMAT_SENML_CBOR ||
+	    coap_get_option_int(cpkt, COAP_OPTION_BLOCK2) != -ENOENT) {
+		return -EINVAL;
+	}
+
+	if (coap_packet_get_payload(cpkt, &len) == NULL || len != sizeof(notify_payload)) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void print_rate(const char *title, const char *step, uint64_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_ceil64(cycles);
+
+	TC_PRINT("%s, %s: %d in %llu us, %llu ns each\n", title, step, BENCH_ITERATIONS,
+		 (unsigned long long)(ns / NSEC_PER_USEC),
+		 (unsigned long long)(ns / BENCH_ITERATIONS));
+}
+
+static void run_message(const char *title, bench_build_t build, bench_lookup_t lookup)
+{
+	struct coap_packet cpkt;
+	uint16_t len;
+	uint64_t start;
+	uint64_t cycles;
+	int r;
+
+	start = k_cycle_get_64();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		r = build(&cpkt, msg_buf);
+		zassert_ok(r, "Could not build message (%d)", r);
+	}
+	cycles = k_cycle_get_64() - start;
+	print_rate(title, "build", cycles);
+
+	len = cpkt.offset;
+
+	start = k_cycle_get_64();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		r = coap_packet_parse(&cpkt, msg_buf, len, NULL, 0);
+		zassert_ok(r, "Could not parse message (%d)", r);
+	}
+	cycles = k_cycle_get_64() - start;
+	print_rate(title, "parse", cycles);
+
+	start = k_cycle_get_64();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		r = lookup(&cpkt);
+		zassert_ok(r, "Wrong options found (%d)", r);
+	}
+	cycles = k_cycle_get_64() - start;
+	print_rate(title, "lookup", cycles);
+}
+
+ZTEST(coap_bench, test_read)
+{
+	run_message("read", build_read, lookup_read);
+}
+
+ZTEST(coap_bench, test_register)
+{
+	run_message("register", build_register, lookup_register);
+}
+
+ZTEST(coap_bench, test_notify)
+{
+	run_message("notify", build_notify, lookup_notify);
+}
+
+static void *coap_bench_setup(void)
+{
+	TC_PRINT("Option index %s\n",
+		 IS_ENABLED(CONFIG_COAP_OPTION_INDEX) ? "enabled" : "disabled");
+
+	return NULL;
+}
+
+ZTEST_SUITE(coap_bench, NULL, coap_bench_setup, NULL, NULL, NULL);
@@ -0,0 +1,192 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief HTTP/2 header compression benchmark
+ *
+ * Encodes the response headers of a JSON API the way the HTTP/2 server does
+ * for each response of a connection, and decodes the request headers a
+ * client sends. Comparing runs with and without
+ * CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE shows what indexing the
+ * response headers saves in bytes sent and in encoding time.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/http/hpack.h>
+
+#define BENCH_ITERATIONS 10000
+#define BENCH_BUF_SIZE   512
+
+struct bench_header {
+	const char *name;
+	const char *value;
+};
+
+static const struct bench_header response_headers[] = {
+	{ ":status", "200" },
+	{ "content-type", "application/json" },
+	{ "content-encoding", "gzip" },
+	{ "cache-control", "no-store" },
+	{ "access-control-allow-origin", "*" },
+	{ "server", "zephyr" },
+	{ "content-length", "187" },
+};
+
+static const struct bench_header request_headers[] = {
+	{ ":method", "GET" },
+	{ ":scheme", "https" },
+	{ ":path", "/api/v1/sensors/temperature" },
+	{ ":authority", "zephyr-device.local" },
+	{ "user-agent", "curl/8.5.0" },
+	{ "accept", "application/json" },
+	{ "accept-encoding", "gzip, deflate" },
+};
+
+static const char huffman_str[] =
+	"Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0";
+
+static uint8_t block_buf[BENCH_BUF_SIZE];
+static uint8_t huffman_buf[BENCH_BUF_SIZE];
+static struct http_hpack_header_buf header;
+static struct http_hpack_table table;
+
+static void print_rate(const char *title, uint64_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_ceil64(cycles);
+
+	TC_PRINT("%s: %d in %llu us, %llu ns each\n", title, BENCH_ITERATIONS,
+		 (unsigned long long)(ns / NSEC_PER_USEC),
+		 (unsigned long long)(ns / BENCH_ITERATIONS));
+}
+
+static int encode_block(const struct bench_header *headers, size_t count,
+			bool use_table)
+{
+	size_t len = 0;
+	int ret;
+
+	for (size_t i = 0; i < count; i++) {
+		header.name = headers[i].name;
+		header.name_len = strlen(headers[i].name);
+		header.value = headers[i].value;
+		header.value_len = strlen(headers[i].value);
+
+		if (use_table) {
+			ret = http_hpack_table_encode_header(&table, block_buf + len,
+							     sizeof(block_buf) - len,
+							     &header);
+		} else {
+			ret = http_hpack_encode_header(block_buf + len,
+						       sizeof(block_buf) - len, &header);
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		len += ret;
+	}
+
+	return len;
+}
+
+ZTEST(http_hpack_bench, test_encode_response)
+{
+	uint64_t start;
+	uint64_t cycles;
+	size_t total = 0;
+	int first_len = 0;
+	int ret;
+
+	/* All the responses are sent on the same connection */
+	http_hpack_table_init(&table);
+
+	start = k_cycle_get_64();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		ret = encode_block(response_headers, ARRAY_SIZE(response_headers), true);
+		zassert_true(ret > 0, "Could not encode the headers (%d)", ret);
+
+		if (i == 0) {
+			first_len = ret;
+		}
+
+		total += ret;
+	}
+	cycles = k_cycle_get_64() - start;
+	print_rate("encode response", cycles);
+
+	TC_PRINT("encode response: first %d bytes, %zu bytes on average\n", first_len,
+		 total / BENCH_ITERATIONS);
+}
+
+ZTEST(http_hpack_bench, test_decode_request)
+{
+	uint64_t start;
+	uint64_t cycles;
+	int block_len;
+	int ret;
+
+	block_len = encode_block(request_headers, ARRAY_SIZE(request_headers), false);
+	zassert_true(block_len > 0, "Could not encode the headers (%d)", block_len);
+
+	start = k_cycle_get_64();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		size_t offset = 0;
+		int count = 0;
+
+		while (offset < block_len) {
+			ret = http_hpack_decode_header(block_buf + offset, block_len - offset,
+						       &header);
+			zassert_true(ret > 0, "Could not decode the headers (%d)", ret);
+
+			offset += ret;
+			count++;
+		}
+
+		zassert_equal(count, ARRAY_SIZE(request_headers), "Wrong header count");
+	}
+	cycles = k_cycle_get_64() - start;
+	print_rate("decode request", cycles);
+
+	TC_PRINT("decode request: %d bytes\n", block_len);
+}
+
+ZTEST(http_hpack_bench, test_huffman)
+{
+	uint64_t start;
+	uint64_t cycles;
+	int encoded_len;
+	int ret;
+
+	start = k_cycle_get_64();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		encoded_len = http_hpack_huffman_encode((const uint8_t *)huffman_str,
+							sizeof(huffman_str) - 1,
+							huffman_buf, sizeof(huffman_buf));
+		zassert_true(encoded_len > 0, "Could not encode (%d)", encoded_len);
+	}
+	cycles = k_cycle_get_64() - start;
+	print_rate("huffman encode", cycles);
+
+	start = k_cycle_get_64();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		ret = http_hpack_huffman_decode(huffman_buf, encoded_len, block_buf,
+						sizeof(block_buf));
+		zassert_equal(ret, sizeof(huffman_str) - 1, "Could not decode (%d)", ret);
+	}
+	cycles = k_cycle_get_64() - start;
+	print_rate("huffman decode", cycles);
+}
+
+static void *http_hpack_bench_setup(void)
+{
+	TC_PRINT("Dynamic table of %d bytes\n", CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+
+	return NULL;
+}
+
+ZTEST_SUITE(http_hpack_bench, NULL, http_hpack_bench_setup, NULL, NULL, NULL);
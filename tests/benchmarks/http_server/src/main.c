@@ -0,0 +1,368 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief HTTP server load benchmark
+ *
+ * Clients on the loopback interface fetch a static resource over fresh
+ * HTTP/1.1 connections, first on their own and then while another client
+ * keeps requesting a dynamic resource whose callback takes a while. The
+ * time the static requests take shows how much the slow resource holds up
+ * the other clients with CONFIG_HTTP_SERVER_NUM_WORKERS server workers.
+ *
+ * The clients then fetch a file through a static filesystem resource, which
+ * shows what CONFIG_HTTP_SERVER_STATIC_FS_CACHE saves, and revalidate it
+ * with If-None-Match when the cache is enabled.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/storage/flash_map.h>
+
+#define BENCH_SERVER_ADDR    "127.0.0.1"
+#define BENCH_SERVER_PORT    8080
+#define BENCH_CLIENTS        3
+#define BENCH_REQUESTS       20
+#define BENCH_SLOW_MS        10
+#define BENCH_STACK_SIZE     2048
+#define BENCH_TIMEOUT_S      5
+#define BENCH_FS_MOUNT       "/lfs"
+#define BENCH_FS_URL         "/app.js"
+#define BENCH_FS_FILE_SIZE   1024
+#define BENCH_ETAG_LEN       32
+
+static uint16_t bench_service_port = BENCH_SERVER_PORT;
+HTTP_SERVICE_DEFINE(bench_service, BENCH_SERVER_ADDR, &bench_service_port, 1, 10, NULL);
+
+static const char static_payload[] = "Hello, World!";
+static struct http_resource_detail_static static_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_STATIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		},
+	.static_data = static_payload,
+	.static_data_len = sizeof(static_payload) - 1,
+};
+
+HTTP_RESOURCE_DEFINE(static_resource, bench_service, "/", &static_detail);
+
+static uint8_t slow_payload[] = "Slow";
+
+static int slow_cb(struct http_client_ctx *client, enum http_data_status status,
+		   const struct http_request_ctx *request_ctx,
+		   struct http_response_ctx *response_ctx, void *user_data)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(request_ctx);
+	ARG_UNUSED(user_data);
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	/* Stands for a lengthy computation or a slow peripheral */
+	k_msleep(BENCH_SLOW_MS);
+
+	response_ctx->body = slow_payload;
+	response_ctx->body_len = sizeof(slow_payload) - 1;
+	response_ctx->final_chunk = true;
+
+	return 0;
+}
+
+static struct http_resource_detail_dynamic slow_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "text/plain",
+		},
+	.cb = slow_cb,
+	.user_data = NULL,
+};
+
+HTTP_RESOURCE_DEFINE(slow_resource, bench_service, "/slow", &slow_detail);
+
+static struct http_resource_detail_static_fs fs_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_STATIC_FS,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		},
+	.fs_path = BENCH_FS_MOUNT,
+};
+
+HTTP_RESOURCE_DEFINE(fs_resource, bench_service, BENCH_FS_URL, &fs_detail);
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(bench_lfs);
+static struct fs_mount_t bench_mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &bench_lfs,
+	.storage_dev = (void *)FIXED_PARTITION_ID(storage_partition),
+	.mnt_point = BENCH_FS_MOUNT,
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(client_stacks, BENCH_CLIENTS + 1, BENCH_STACK_SIZE);
+static struct k_thread client_threads[BENCH_CLIENTS + 1];
+
+static atomic_t static_ok;
+static atomic_t slow_ok;
+static atomic_t slow_running;
+
+/* GET @a path on a new connection, sending the extra request @a headers, and
+ * check the response status. The ETag of the response is copied to @a etag if
+ * not NULL.
+ */
+static int http_get_ext(const char *path, const char *headers, int status, char *etag)
+{
+	struct timeval timeo = {
+		.tv_sec = BENCH_TIMEOUT_S,
+	};
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(BENCH_SERVER_PORT),
+	};
+	char status_line[sizeof("HTTP/1.1 200")];
+	bool ok = false;
+	char buf[512];
+	char *field;
+	int fd;
+	int ret;
+
+	zsock_inet_pton(AF_INET, BENCH_SERVER_ADDR, &sa.sin_addr);
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	(void)zsock_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeo, sizeof(timeo));
+
+	ret = zsock_connect(fd, (struct sockaddr *)&sa, sizeof(sa));
+	if (ret < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	ret = snprintk(buf, sizeof(buf),
+		       "GET %s HTTP/1.1\r\nHost: " BENCH_SERVER_ADDR "\r\n"
+		       "%sConnection: close\r\n\r\n", path, headers);
+
+	ret = zsock_send(fd, buf, ret, 0);
+	if (ret < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	/* The status line and the headers come first, the server then closes
+	 * the connection once the response is out.
+	 */
+	ret = zsock_recv(fd, buf, sizeof(buf) - 1, 0);
+	if (ret > 0) {
+		buf[ret] = '\0';
+		snprintk(status_line, sizeof(status_line), "HTTP/1.1 %d", status);
+		ok = (strncmp(buf, status_line, strlen(status_line)) == 0);
+
+		field = strstr(buf, "ETag: ");
+		if (etag != NULL && field != NULL) {
+			field += strlen("ETag: ");
+			snprintk(etag, BENCH_ETAG_LEN, "%.*s", (int)strcspn(field, "\r"), field);
+		}
+	}
+
+	while (ret > 0) {
+		ret = zsock_recv(fd, buf, sizeof(buf), 0);
+	}
+
+	if (ret < 0) {
+		ret = -errno;
+	} else if (!ok) {
+		ret = -EBADMSG;
+	}
+
+out:
+	zsock_close(fd);
+
+	return ret;
+}
+
+/* GET @a path on a new connection, returns 0 on a 200 response */
+static int http_get(const char *path)
+{
+	return http_get_ext(path, "", 200, NULL);
+}
+
+/* Fill the file served by the static filesystem resource with @a c */
+static int bench_file_write(char c)
+{
+	static char data[BENCH_FS_FILE_SIZE];
+	struct fs_file_t file;
+	ssize_t written;
+	int ret;
+
+	memset(data, c, sizeof(data));
+
+	fs_file_t_init(&file);
+
+	ret = fs_open(&file, BENCH_FS_MOUNT BENCH_FS_URL, FS_O_CREATE | FS_O_WRITE);
+	if (ret < 0) {
+		return ret;
+	}
+
+	written = fs_write(&file, data, sizeof(data));
+	ret = fs_close(&file);
+
+	return (written == sizeof(data)) ? ret : -EIO;
+}
+
+static void static_client(void *p1, void *p2, void *p3)
+{
+	const char *path = p1;
+	const char *headers = p2;
+	int status = POINTER_TO_INT(p3);
+
+	for (int i = 0; i < BENCH_REQUESTS; i++) {
+		if (http_get_ext(path, headers, status, NULL) == 0) {
+			(void)atomic_inc(&static_ok);
+		}
+	}
+}
+
+static void slow_client(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (atomic_get(&slow_running) != 0) {
+		if (http_get("/slow") == 0) {
+			(void)atomic_inc(&slow_ok);
+		}
+	}
+}
+
+static void run_clients(const char *title, const char *path, const char *headers, int status)
+{
+	uint64_t start;
+	uint64_t us;
+
+	(void)atomic_set(&static_ok, 0);
+
+	start = k_cycle_get_64();
+
+	for (int i = 0; i < BENCH_CLIENTS; i++) {
+		k_thread_create(&client_threads[i], client_stacks[i], BENCH_STACK_SIZE,
+				static_client, (void *)path, (void *)headers,
+				INT_TO_POINTER(status), K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < BENCH_CLIENTS; i++) {
+		k_thread_join(&client_threads[i], K_FOREVER);
+	}
+
+	us = k_cyc_to_us_ceil64(k_cycle_get_64() - start);
+
+	zassert_equal(atomic_get(&static_ok), BENCH_CLIENTS * BENCH_REQUESTS,
+		      "only %ld of %d requests succeeded", (long)atomic_get(&static_ok),
+		      BENCH_CLIENTS * BENCH_REQUESTS);
+
+	TC_PRINT("%d worker(s), %s: %d requests in %llu us, %llu requests/s\n",
+		 CONFIG_HTTP_SERVER_NUM_WORKERS, title, BENCH_CLIENTS * BENCH_REQUESTS,
+		 (unsigned long long)us,
+		 (unsigned long long)(BENCH_CLIENTS * BENCH_REQUESTS * USEC_PER_SEC /
+				      MAX(us, 1)));
+}
+
+static void run_static_clients(const char *title)
+{
+	run_clients(title, "/", "", 200);
+}
+
+ZTEST(http_server_load, test_static)
+{
+	run_static_clients("static only");
+}
+
+ZTEST(http_server_load, test_static_with_slow_client)
+{
+	struct k_thread *slow = &client_threads[BENCH_CLIENTS];
+
+	(void)atomic_set(&slow_ok, 0);
+	(void)atomic_set(&slow_running, 1);
+
+	k_thread_create(slow, client_stacks[BENCH_CLIENTS], BENCH_STACK_SIZE,
+			slow_client, NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	/* Let the first slow request reach the server */
+	k_msleep(1);
+
+	run_static_clients("static with a slow client");
+
+	(void)atomic_set(&slow_running, 0);
+	k_thread_join(slow, K_FOREVER);
+
+	zassert_true(atomic_get(&slow_ok) > 0, "no slow request succeeded");
+}
+
+ZTEST(http_server_load, test_static_fs)
+{
+	run_clients(IS_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE) ? "static fs, cached" :
+								      "static fs",
+		    BENCH_FS_URL, "", 200);
+}
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+ZTEST(http_server_load, test_static_fs_not_modified)
+{
+	char etag[BENCH_ETAG_LEN] = "";
+	char new_etag[BENCH_ETAG_LEN] = "";
+	char headers[sizeof("If-None-Match: \r\n") + BENCH_ETAG_LEN];
+
+	zassert_ok(http_get_ext(BENCH_FS_URL, "", 200, etag), "GET failed");
+	zassert_true(strlen(etag) > 0, "no ETag");
+
+	snprintk(headers, sizeof(headers), "If-None-Match: %s\r\n", etag);
+
+	run_clients("static fs, not modified", BENCH_FS_URL, headers, 304);
+
+	/* A changed file gets a new ETag, and the old one no longer matches */
+	zassert_ok(bench_file_write('b'), "cannot change the file");
+	http_server_fs_cache_flush();
+
+	zassert_ok(http_get_ext(BENCH_FS_URL, headers, 200, new_etag), "GET failed");
+	zassert_true(strcmp(etag, new_etag) != 0, "ETag %s did not change", etag);
+
+	zassert_ok(bench_file_write('a'), "cannot restore the file");
+	http_server_fs_cache_flush();
+}
+#endif
+
+static void *http_server_load_setup(void)
+{
+	zassert_ok(fs_mount(&bench_mnt), "cannot mount the filesystem");
+	zassert_ok(bench_file_write('a'), "cannot write the file");
+
+	zassert_ok(http_server_start(), "failed to start the server");
+
+	/* Let the server set up its listening socket */
+	k_msleep(100);
+
+	return NULL;
+}
+
+static void http_server_load_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)http_server_stop();
+	(void)fs_unmount(&bench_mnt);
+}
+
+ZTEST_SUITE(http_server_load, NULL, http_server_load_setup, NULL, NULL,
+	    http_server_load_teardown);
@@ -0,0 +1,171 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/smp.h>
+#include <zephyr/sys/printk.h>
+
+/* This benchmark measures the scheduler IPIs needed to wake threads on
+ * other CPUs, and how long those threads take to run.  A "waker" thread
+ * pinned to CPU 0 wakes "wakee" threads pinned to the other CPUs by
+ * giving each one its own semaphore, and waits for them to block again
+ * before going on.  It does this in two ways:
+ *
+ * 1. single: one wakee at a time, so every wakeup needs its own IPI.
+ * 2. burst: all the wakees back to back, so several wakeups target the
+ *    same CPU before it has handled the first IPI.  This is the case
+ *    CONFIG_IPI_COALESCE is meant for.
+ *
+ * For each, it reports the number of wakeups, the IPIs sent, received
+ * and coalesced by all CPUs, and the average and maximum time in cycles
+ * from the semaphore being given to the wakee running.  The wakees
+ * waking the waker back count towards the IPIs too.
+ */
+
+#define N_RUNS 1000
+#define N_BURSTS (N_RUNS / N_WAKEES)
+
+#define WAKEES_PER_CPU 4
+#define N_WAKEES ((CONFIG_MP_MAX_NUM_CPUS - 1) * WAKEES_PER_CPU)
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define PRIORITY K_PRIO_PREEMPT(1)
+
+struct wakee {
+	struct k_thread thread;
+	struct k_sem sem;
+	volatile uint32_t stamp;
+	uint64_t total;
+	uint32_t max;
+	uint32_t count;
+};
+
+static struct wakee wakees[N_WAKEES];
+static K_THREAD_STACK_ARRAY_DEFINE(wakee_stacks, N_WAKEES, STACK_SIZE);
+
+static struct k_thread waker_thread;
+static K_THREAD_STACK_DEFINE(waker_stack, STACK_SIZE);
+
+static K_SEM_DEFINE(done, 0, N_WAKEES);
+
+static void wakee_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct wakee *w = p1;
+	uint32_t latency;
+
+	while (true) {
+		k_sem_take(&w->sem, K_FOREVER);
+
+		latency = k_cycle_get_32() - w->stamp;
+		w->total += latency;
+		w->max = MAX(w->max, latency);
+		w->count++;
+
+		k_sem_give(&done);
+	}
+}
+
+static void wake(struct wakee *w)
+{
+	w->stamp = k_cycle_get_32();
+	k_sem_give(&w->sem);
+}
+
+static void report_start(void)
+{
+	for (int i = 0; i < N_WAKEES; i++) {
+		wakees[i].total = 0;
+		wakees[i].max = 0;
+		wakees[i].count = 0;
+	}
+
+	k_ipi_stats_reset();
+}
+
+static void report(const char *name)
+{
+	struct k_ipi_stats total = { 0 };
+	struct k_ipi_stats stats;
+	uint64_t latency = 0;
+	uint32_t max = 0;
+	uint32_t count = 0;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		if (k_ipi_stats_get(i, &stats) == 0) {
+			total.sent += stats.sent;
+			total.received += stats.received;
+			total.coalesced += stats.coalesced;
+		}
+	}
+
+	for (int i = 0; i < N_WAKEES; i++) {
+		latency += wakees[i].total;
+		max = MAX(max, wakees[i].max);
+		count += wakees[i].count;
+	}
+
+	printk("%-6s wakeups %6u sent %6u received %6u coalesced %6u latency avg %6u max %6u\n",
+	       name, count, (uint32_t)total.sent, (uint32_t)total.received,
+	       (uint32_t)total.coalesced, (count != 0U) ? (uint32_t)(latency / count) : 0U,
+	       max);
+}
+
+static void waker_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	report_start();
+	for (int i = 0; i < N_RUNS; i++) {
+		wake(&wakees[i % N_WAKEES]);
+		k_sem_take(&done, K_FOREVER);
+	}
+	report("single");
+
+	report_start();
+	for (int i = 0; i < N_BURSTS; i++) {
+		for (int j = 0; j < N_WAKEES; j++) {
+			wake(&wakees[j]);
+		}
+		for (int j = 0; j < N_WAKEES; j++) {
+			k_sem_take(&done, K_FOREVER);
+		}
+	}
+	report("burst");
+}
+
+static void start_pinned(struct k_thread *thread, k_thread_stack_t *stack,
+			 k_thread_entry_t entry, void *arg, int cpu)
+{
+	k_thread_create(thread, stack, STACK_SIZE, entry, arg, NULL, NULL,
+			PRIORITY, 0, K_FOREVER);
+	k_thread_cpu_pin(thread, cpu);
+	k_thread_start(thread);
+}
+
+int main(void)
+{
+	printk("IPI benchmark: %u CPUs, %d wakees, coalescing %s, optimization %s\n",
+	       arch_num_cpus(), N_WAKEES, IS_ENABLED(CONFIG_IPI_COALESCE) ? "on" : "off",
+	       IS_ENABLED(CONFIG_IPI_OPTIMIZE) ? "on" : "off");
+
+	for (int i = 0; i < N_WAKEES; i++) {
+		k_sem_init(&wakees[i].sem, 0, 1);
+		start_pinned(&wakees[i].thread, wakee_stacks[i], wakee_fn, &wakees[i],
+			     1 + (i / WAKEES_PER_CPU));
+	}
+
+	start_pinned(&waker_thread, waker_stack, waker_fn, NULL, 0);
+	k_thread_join(&waker_thread, K_FOREVER);
+
+	printk("fin\n");
+
+	return 0;
+}
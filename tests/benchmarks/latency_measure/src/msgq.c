@@ -0,0 +1,186 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure time for various k_msgq operations
+ *
+ * This file contains the tests that measures the times for the following
+ * k_msgq operations from both kernel threads and user threads, per message:
+ *  1. Immediately adding a message to a k_msgq
+ *  2. Immediately removing a message from a k_msgq
+ *  3. Immediately adding a batch of messages to a k_msgq
+ *  4. Immediately removing a batch of messages from a k_msgq
+ *  5. Claiming and releasing a batch of messages in place (kernel only)
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+#include "timing_sc.h"
+
+#define BATCH_SIZE 16
+
+K_MSGQ_DEFINE(msgq, sizeof(uint32_t), BATCH_SIZE, 4);
+
+static BENCH_BMEM uint32_t msgq_data[BATCH_SIZE];
+
+/* Number of messages claimed, which stops at the end of the ring buffer */
+static uint32_t msgq_claimed;
+
+static void report(uint64_t sum)
+{
+	timestamp.cycles = sum;
+	k_sem_take(&pause_sem, K_FOREVER);
+}
+
+static void msgq_put_get_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t num_iterations = (uint32_t)(uintptr_t)p1;
+	uint32_t options = (uint32_t)(uintptr_t)p2;
+	timing_t start;
+	timing_t mid;
+	timing_t finish;
+	uint64_t put_sum = 0ULL;
+	uint64_t get_sum = 0ULL;
+
+	for (uint32_t i = 0; i < num_iterations; i++) {
+		start = timing_timestamp_get();
+
+		(void) k_msgq_put(&msgq, &msgq_data[0], K_NO_WAIT);
+
+		mid = timing_timestamp_get();
+
+		(void) k_msgq_get(&msgq, &msgq_data[0], K_NO_WAIT);
+
+		finish = timing_timestamp_get();
+
+		put_sum += timing_cycles_get(&start, &mid);
+		get_sum += timing_cycles_get(&mid, &finish);
+	}
+
+	report(put_sum);
+	report(get_sum);
+
+	put_sum = 0ULL;
+	get_sum = 0ULL;
+
+	for (uint32_t i = 0; i < num_iterations; i++) {
+		start = timing_timestamp_get();
+
+		(void) k_msgq_put_n(&msgq, msgq_data, BATCH_SIZE, K_NO_WAIT);
+
+		mid = timing_timestamp_get();
+
+		(void) k_msgq_get_n(&msgq, msgq_data, BATCH_SIZE, K_NO_WAIT);
+
+		finish = timing_timestamp_get();
+
+		put_sum += timing_cycles_get(&start, &mid);
+		get_sum += timing_cycles_get(&mid, &finish);
+	}
+
+	report(put_sum);
+
+	if ((options & K_USER) != 0) {
+		timestamp.cycles = get_sum;
+		return;
+	}
+
+	report(get_sum);
+
+	/* The ring buffer is kernel memory: only kernel threads can claim */
+	get_sum = 0ULL;
+	msgq_claimed = 0U;
+
+	for (uint32_t i = 0; i < num_iterations; i++) {
+		uint32_t *claimed;
+		int num_msgs;
+
+		/* Keep one entry free, a full queue can't be entirely claimed */
+		(void) k_msgq_put_n(&msgq, msgq_data, BATCH_SIZE - 1, K_NO_WAIT);
+
+		start = timing_timestamp_get();
+
+		num_msgs = k_msgq_get_claim(&msgq, (void **)&claimed, BATCH_SIZE);
+		(void) k_msgq_get_finish(&msgq, num_msgs);
+
+		finish = timing_timestamp_get();
+
+		get_sum += timing_cycles_get(&start, &finish);
+		msgq_claimed += num_msgs;
+
+		(void) k_msgq_get_n(&msgq, msgq_data, BATCH_SIZE, K_NO_WAIT);
+	}
+
+	timestamp.cycles = get_sum;
+}
+
+static void print_msgq_stats(const char *op, const char *what, uint32_t options,
+			     uint32_t num_msgs)
+{
+	char     tag[50];
+	char     description[120];
+	uint64_t cycles;
+
+	snprintf(tag, sizeof(tag), "msgq.%s.%s", op,
+		 options & K_USER ? "user" : "kernel");
+	snprintf(description, sizeof(description),
+		 "%-40s - %s", tag, what);
+
+	cycles = timestamp.cycles;
+	cycles -= timestamp_overhead_adjustment(options, options);
+	PRINT_STATS_AVG(description, (uint32_t)cycles, num_msgs, false, "");
+}
+
+int msgq_ops(uint32_t num_iterations, uint32_t options)
+{
+	int priority;
+
+	priority = k_thread_priority_get(k_current_get());
+
+	timing_start();
+
+	k_msgq_purge(&msgq);
+
+	k_thread_create(&start_thread, start_stack,
+			K_THREAD_STACK_SIZEOF(start_stack),
+			msgq_put_get_thread_entry,
+			(void *)(uintptr_t)num_iterations,
+			(void *)(uintptr_t)options, NULL,
+			priority - 1, options, K_FOREVER);
+
+	k_thread_access_grant(&start_thread, &pause_sem, &msgq);
+
+	k_thread_start(&start_thread);
+
+	print_msgq_stats("put.immediate", "Add message to k_msgq (no ctx switch)",
+			 options, num_iterations);
+	k_sem_give(&pause_sem);
+
+	print_msgq_stats("get.immediate", "Get message from k_msgq (no ctx switch)",
+			 options, num_iterations);
+	k_sem_give(&pause_sem);
+
+	print_msgq_stats("put_n.immediate", "Add batch to k_msgq, per message",
+			 options, num_iterations * BATCH_SIZE);
+	k_sem_give(&pause_sem);
+
+	print_msgq_stats("get_n.immediate", "Get batch from k_msgq, per message",
+			 options, num_iterations * BATCH_SIZE);
+
+	if ((options & K_USER) == 0) {
+		k_sem_give(&pause_sem);
+
+		print_msgq_stats("claim_finish", "Claim batch in k_msgq, per message",
+				 options, msgq_claimed);
+	}
+
+	k_thread_join(&start_thread, K_FOREVER);
+
+	timing_stop();
+
+	return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure time for waiting on many objects at once
+ * 1. Block in k_poll() on a set of semaphores
+ * 2. Give one of them, waking the k_poll() caller (with context switch)
+ * 3. Block in k_poll_set_wait() on the same semaphores, armed once
+ * 4. Give one of them, waking the k_poll_set_wait() caller
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+#include "timing_sc.h"
+
+#define NUM_POLL_EVENTS 16
+
+static struct k_sem poll_sems[NUM_POLL_EVENTS];
+static struct k_poll_event poll_events[NUM_POLL_EVENTS];
+static struct k_poll_set poll_set;
+
+static void poll_events_init(bool use_set)
+{
+	if (use_set) {
+		k_poll_set_init(&poll_set);
+	}
+
+	for (int i = 0; i < NUM_POLL_EVENTS; i++) {
+		k_sem_init(&poll_sems[i], 0, 1);
+		k_poll_event_init(&poll_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &poll_sems[i]);
+
+		if (use_set) {
+			k_poll_set_add_persistent(&poll_set, &poll_events[i]);
+		}
+	}
+}
+
+static void start_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t  num_iterations = (uint32_t)(uintptr_t)p1;
+	bool      use_set = (bool)(uintptr_t)p2;
+	struct k_poll_event *ready;
+	uint32_t  i;
+	timing_t  start;
+	timing_t  finish;
+	uint64_t  sum[2] = {0ull, 0ull};
+
+	ARG_UNUSED(p3);
+
+	k_thread_start(&alt_thread);
+
+	for (i = 0; i < num_iterations; i++) {
+		/* 1. Get the first timestamp and block on all the semaphores */
+
+		start = timing_timestamp_get();
+		if (use_set) {
+			(void)k_poll_set_wait(&poll_set, &ready, 1, K_FOREVER);
+		} else {
+			(void)k_poll(poll_events, NUM_POLL_EVENTS, K_FOREVER);
+			ready = &poll_events[NUM_POLL_EVENTS - 1];
+		}
+
+		/* 3. Get the final timestamp */
+
+		finish = timing_timestamp_get();
+
+		sum[0] += timing_cycles_get(&start, &timestamp.sample);
+		sum[1] += timing_cycles_get(&timestamp.sample, &finish);
+
+		if (use_set) {
+			(void)k_poll_set_state_take(&poll_set, ready);
+		} else {
+			ready->state = K_POLL_STATE_NOT_READY;
+		}
+		k_sem_take(ready->sem, K_NO_WAIT);
+	}
+
+	/* Wait for alt_thread to finish */
+
+	k_thread_join(&alt_thread, K_FOREVER);
+
+	timestamp.cycles = sum[0];
+	k_sem_take(&pause_sem, K_FOREVER);
+
+	timestamp.cycles = sum[1];
+}
+
+static void alt_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t  num_iterations = (uint32_t)(uintptr_t)p1;
+	uint32_t  i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < num_iterations; i++) {
+
+		/* 2. Get midpoint timestamp and give the last semaphore */
+
+		timestamp.sample = timing_timestamp_get();
+		k_sem_give(&poll_sems[NUM_POLL_EVENTS - 1]);
+	}
+}
+
+int poll_blocking_ops(uint32_t num_iterations, bool use_set)
+{
+	int       priority;
+	char      tag[50];
+	char      description[120];
+	uint64_t  cycles;
+
+	priority = k_thread_priority_get(k_current_get());
+
+	poll_events_init(use_set);
+
+	timing_start();
+
+	k_thread_create(&start_thread, start_stack,
+			K_THREAD_STACK_SIZEOF(start_stack),
+			start_thread_entry,
+			(void *)(uintptr_t)num_iterations,
+			(void *)(uintptr_t)use_set, NULL,
+			priority - 2, 0, K_FOREVER);
+
+	k_thread_create(&alt_thread, alt_stack,
+			K_THREAD_STACK_SIZEOF(alt_stack),
+			alt_thread_entry,
+			(void *)(uintptr_t)num_iterations,
+			NULL, NULL,
+			priority - 1, 0, K_FOREVER);
+
+	/* Start test thread */
+
+	k_thread_start(&start_thread);
+
+	/* Stats gathered. Display them. */
+
+	snprintf(tag, sizeof(tag), "%s.wait.blocking.k_to_k",
+		 use_set ? "poll_set" : "poll");
+	snprintf(description, sizeof(description),
+		 "%-40s - Wait on %d semaphores (context switch)", tag,
+		 NUM_POLL_EVENTS);
+
+	cycles = timestamp.cycles;
+	PRINT_STATS_AVG(description, (uint32_t)cycles,
+			num_iterations, false, "");
+
+	k_sem_give(&pause_sem);
+
+	snprintf(tag, sizeof(tag), "%s.give.wake+ctx.k_to_k",
+		 use_set ? "poll_set" : "poll");
+	snprintf(description, sizeof(description),
+		 "%-40s - Give one of %d semaphores (context switch)", tag,
+		 NUM_POLL_EVENTS);
+	cycles = timestamp.cycles;
+	PRINT_STATS_AVG(description, (uint32_t)cycles,
+			num_iterations, false, "");
+
+	k_thread_join(&start_thread, K_FOREVER);
+
+	timing_stop();
+
+	if (use_set) {
+		for (int i = 0; i < NUM_POLL_EVENTS; i++) {
+			k_poll_set_remove(&poll_set, &poll_events[i]);
+		}
+	}
+
+	return 0;
+}
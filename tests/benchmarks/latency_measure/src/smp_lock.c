@@ -0,0 +1,170 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure time for taking a lock object released from another CPU
+ * 1. A thread on another CPU takes a mutex and holds it for a short while
+ * 2. Lock the mutex, waiting for it to be released
+ * 3. A thread on another CPU gives a semaphore after a short while
+ * 4. Take the semaphore, waiting for it to be given
+ *
+ * This is where CONFIG_ADAPTIVE_SPIN makes a difference: without it the
+ * waiting thread pends and is woken up through an IPI, with it the waiting
+ * thread spins until the object is released.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+#include "timing_sc.h"
+
+#if (CONFIG_MP_MAX_NUM_CPUS > 1)
+
+/* How long the other CPU holds the object, in microseconds */
+#define SMP_LOCK_HOLD_US 1
+
+extern struct k_thread busy_thread[CONFIG_MP_MAX_NUM_CPUS - 1];
+
+static K_MUTEX_DEFINE(smp_mutex);
+static K_SEM_DEFINE(smp_sem, 0, 1);
+
+/* Round state: the holder makes the object busy, the waiter waits for it */
+#define SMP_ROUND_IDLE    0
+#define SMP_ROUND_BUSY    1
+#define SMP_ROUND_WAITING 2
+
+static atomic_t smp_round;
+
+static void start_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t  num_iterations = (uint32_t)(uintptr_t)p1;
+	bool      use_sem = (bool)(uintptr_t)p2;
+	uint32_t  i;
+	timing_t  start;
+	timing_t  finish;
+	uint64_t  sum = 0ull;
+
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < num_iterations; i++) {
+		/* 1. Wait for the other CPU to make the object busy */
+
+		while (!atomic_cas(&smp_round, SMP_ROUND_BUSY, SMP_ROUND_WAITING)) {
+		}
+
+		/* 2. Wait for the object to be released */
+
+		start = timing_timestamp_get();
+		if (use_sem) {
+			k_sem_take(&smp_sem, K_FOREVER);
+		} else {
+			k_mutex_lock(&smp_mutex, K_FOREVER);
+		}
+		finish = timing_timestamp_get();
+
+		sum += timing_cycles_get(&start, &finish);
+
+		if (!use_sem) {
+			k_mutex_unlock(&smp_mutex);
+		}
+
+		(void)atomic_set(&smp_round, SMP_ROUND_IDLE);
+	}
+
+	timestamp.cycles = sum;
+}
+
+static void alt_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t  num_iterations = (uint32_t)(uintptr_t)p1;
+	bool      use_sem = (bool)(uintptr_t)p2;
+	uint32_t  i;
+
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < num_iterations; i++) {
+		/* Wait for the previous round to be over */
+
+		while (atomic_get(&smp_round) != SMP_ROUND_IDLE) {
+		}
+
+		if (!use_sem) {
+			k_mutex_lock(&smp_mutex, K_FOREVER);
+		}
+
+		(void)atomic_set(&smp_round, SMP_ROUND_BUSY);
+		k_busy_wait(SMP_LOCK_HOLD_US);
+
+		if (use_sem) {
+			k_sem_give(&smp_sem);
+		} else {
+			k_mutex_unlock(&smp_mutex);
+		}
+	}
+}
+
+int smp_lock_ops(uint32_t num_iterations, bool use_sem)
+{
+	int       priority;
+	char      tag[50];
+	char      description[120];
+	uint64_t  cycles;
+
+	if (arch_num_cpus() < 2) {
+		return 0;
+	}
+
+	priority = k_thread_priority_get(k_current_get());
+
+	/* Free a CPU for the holder thread */
+
+	k_thread_suspend(&busy_thread[0]);
+
+	(void)atomic_set(&smp_round, SMP_ROUND_IDLE);
+
+	timing_start();
+
+	k_thread_create(&start_thread, start_stack,
+			K_THREAD_STACK_SIZEOF(start_stack),
+			start_thread_entry,
+			(void *)(uintptr_t)num_iterations,
+			(void *)(uintptr_t)use_sem, NULL,
+			priority - 1, 0, K_FOREVER);
+
+	k_thread_create(&alt_thread, alt_stack,
+			K_THREAD_STACK_SIZEOF(alt_stack),
+			alt_thread_entry,
+			(void *)(uintptr_t)num_iterations,
+			(void *)(uintptr_t)use_sem, NULL,
+			priority - 1, 0, K_FOREVER);
+
+	k_thread_start(&alt_thread);
+	k_thread_start(&start_thread);
+
+	k_thread_join(&start_thread, K_FOREVER);
+	k_thread_join(&alt_thread, K_FOREVER);
+
+	timing_stop();
+
+	k_thread_resume(&busy_thread[0]);
+
+	/* Stats gathered. Display them. */
+
+	snprintf(tag, sizeof(tag), "%s.smp.contended.k_to_k",
+		 use_sem ? "semaphore.take" : "mutex.lock");
+	snprintf(description, sizeof(description),
+		 "%-40s - %s released on another CPU (%s)", tag,
+		 use_sem ? "Take a semaphore" : "Lock a mutex",
+		 IS_ENABLED(CONFIG_ADAPTIVE_SPIN) ? "adaptive spin" : "pend");
+
+	cycles = timestamp.cycles;
+	PRINT_STATS_AVG(description, (uint32_t)cycles,
+			num_iterations, false, "");
+
+	return 0;
+}
+
+#endif /* CONFIG_MP_MAX_NUM_CPUS > 1 */
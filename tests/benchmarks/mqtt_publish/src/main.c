@@ -0,0 +1,292 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief MQTT publish benchmark
+ *
+ * A client on the loopback interface publishes small telemetry messages to a
+ * broker stand-in, which acknowledges the QoS 1 messages as they come. Up to
+ * CONFIG_MQTT_PUBLISH_INFLIGHT_MAX messages wait for their acknowledgment at
+ * a time. With CONFIG_MQTT_PUBLISH_BATCH the messages are queued and sent
+ * several at a time, which shows what coalescing the writes saves compared
+ * to one transport write per message.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/mqtt.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "mqtt_internal.h"
+
+#define BENCH_BROKER_ADDR    "127.0.0.1"
+#define BENCH_BROKER_PORT    1883
+#define BENCH_MESSAGES       2000
+#define BENCH_STACK_SIZE     2048
+#define BENCH_BUF_SIZE       1024
+#define BENCH_TIMEOUT_MS     5000
+#define BENCH_TOPIC          "sensors/temperature"
+
+static uint8_t rx_buffer[256];
+static uint8_t tx_buffer[BENCH_BUF_SIZE];
+static struct mqtt_client client_ctx;
+static struct sockaddr_in broker_addr;
+static bool connected;
+static int acked;
+
+static uint8_t broker_buf[BENCH_BUF_SIZE];
+static int broker_sock = -1;
+
+K_THREAD_STACK_DEFINE(broker_stack, BENCH_STACK_SIZE);
+static struct k_thread broker_thread;
+
+static const char payload[] = "{\"temperature\":21.5}";
+static const uint8_t connack[] = { MQTT_PKT_TYPE_CONNACK, 0x02, 0x00, 0x00 };
+
+/* Acknowledges the QoS 1 messages, with one write per batch of packets read */
+static void broker_serve(int sock)
+{
+	uint8_t acks[BENCH_BUF_SIZE];
+	size_t offset = 0;
+
+	while (true) {
+		struct buf_ctx buf = {
+			.cur = broker_buf,
+		};
+		size_t acks_len = 0;
+		uint8_t *consumed = broker_buf;
+		uint8_t type_and_flags;
+		uint32_t length;
+		ssize_t ret;
+
+		ret = zsock_recv(sock, broker_buf + offset, sizeof(broker_buf) - offset, 0);
+		if (ret <= 0) {
+			return;
+		}
+
+		offset += ret;
+		buf.end = broker_buf + offset;
+
+		while (acks_len + 4 <= sizeof(acks) &&
+		       fixed_header_decode(&buf, &type_and_flags, &length) == 0 &&
+		       length <= buf.end - buf.cur) {
+			uint8_t type = type_and_flags & 0xF0;
+			uint8_t qos = (type_and_flags & MQTT_HEADER_QOS_MASK) >> 1;
+
+			if (type == MQTT_PKT_TYPE_CONNECT) {
+				(void)zsock_send(sock, connack, sizeof(connack), 0);
+			} else if (type == MQTT_PKT_TYPE_PUBLISH &&
+				   qos == MQTT_QOS_1_AT_LEAST_ONCE) {
+				uint16_t topic_len = sys_get_be16(buf.cur);
+
+				/* Packet ID follows the topic */
+				acks[acks_len++] = MQTT_PKT_TYPE_PUBACK;
+				acks[acks_len++] = 0x02;
+				memcpy(&acks[acks_len], buf.cur + 2 + topic_len, 2);
+				acks_len += 2;
+			} else if (type == MQTT_PKT_TYPE_DISCONNECT) {
+				return;
+			}
+
+			buf.cur += length;
+			consumed = buf.cur;
+		}
+
+		if (acks_len > 0 && zsock_send(sock, acks, acks_len, 0) < 0) {
+			return;
+		}
+
+		offset = buf.end - consumed;
+		memmove(broker_buf, consumed, offset);
+	}
+}
+
+static void broker_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		int sock = zsock_accept(broker_sock, NULL, NULL);
+
+		if (sock < 0) {
+			return;
+		}
+
+		broker_serve(sock);
+		zsock_close(sock);
+	}
+}
+
+static void mqtt_evt_handler(struct mqtt_client *const client, const struct mqtt_evt *evt)
+{
+	ARG_UNUSED(client);
+
+	if (evt->type == MQTT_EVT_CONNACK) {
+		connected = (evt->result == 0);
+	} else if (evt->type == MQTT_EVT_PUBACK) {
+		acked++;
+	}
+}
+
+static void client_wait_input(void)
+{
+	struct zsock_pollfd fds = {
+		.fd = client_ctx.transport.tcp.sock,
+		.events = ZSOCK_POLLIN,
+	};
+	int ret;
+
+	ret = zsock_poll(&fds, 1, BENCH_TIMEOUT_MS);
+	zassert_equal(ret, 1, "No input from the broker (%d)", ret);
+
+	ret = mqtt_input(&client_ctx);
+	zassert_ok(ret, "MQTT input failed (%d)", ret);
+}
+
+static void client_connect(void)
+{
+	int ret;
+
+	mqtt_client_init(&client_ctx);
+
+	client_ctx.broker = &broker_addr;
+	client_ctx.evt_cb = mqtt_evt_handler;
+	client_ctx.client_id.utf8 = (uint8_t *)"zephyr_bench";
+	client_ctx.client_id.size = strlen("zephyr_bench");
+	client_ctx.protocol_version = MQTT_VERSION_3_1_1;
+	client_ctx.transport.type = MQTT_TRANSPORT_NON_SECURE;
+	client_ctx.rx_buf = rx_buffer;
+	client_ctx.rx_buf_size = sizeof(rx_buffer);
+	client_ctx.tx_buf = tx_buffer;
+	client_ctx.tx_buf_size = sizeof(tx_buffer);
+
+	ret = mqtt_connect(&client_ctx);
+	zassert_ok(ret, "MQTT connect failed (%d)", ret);
+
+	client_wait_input();
+	zassert_true(connected, "MQTT client not connected");
+}
+
+static int publish(const struct mqtt_publish_param *param)
+{
+#if defined(CONFIG_MQTT_PUBLISH_BATCH)
+	return mqtt_publish_queue(&client_ctx, param);
+#else
+	return mqtt_publish(&client_ctx, param);
+#endif
+}
+
+static int flush(void)
+{
+#if defined(CONFIG_MQTT_PUBLISH_BATCH)
+	return mqtt_publish_flush(&client_ctx);
+#else
+	return 0;
+#endif
+}
+
+static void run_publish(enum mqtt_qos qos)
+{
+	struct mqtt_publish_param param = { 0 };
+	uint64_t start;
+	uint64_t us;
+	int sent = 0;
+	int ret;
+
+	acked = 0;
+	client_connect();
+
+	param.message.topic.qos = qos;
+	param.message.topic.topic.utf8 = (uint8_t *)BENCH_TOPIC;
+	param.message.topic.topic.size = strlen(BENCH_TOPIC);
+	param.message.payload.data = (uint8_t *)payload;
+	param.message.payload.len = strlen(payload);
+
+	start = k_cycle_get_64();
+
+	while (sent < BENCH_MESSAGES) {
+		param.message_id = (qos == MQTT_QOS_0_AT_MOST_ONCE) ? 0 : (sent % UINT16_MAX) + 1;
+
+		ret = publish(&param);
+		if (ret == -EAGAIN) {
+			/* Wait for acknowledgments to open the window */
+			ret = flush();
+			zassert_ok(ret, "MQTT flush failed (%d)", ret);
+			client_wait_input();
+			continue;
+		}
+
+		zassert_ok(ret, "MQTT publish failed (%d)", ret);
+		sent++;
+	}
+
+	ret = flush();
+	zassert_ok(ret, "MQTT flush failed (%d)", ret);
+
+	while (qos != MQTT_QOS_0_AT_MOST_ONCE && acked < BENCH_MESSAGES) {
+		client_wait_input();
+	}
+
+	us = k_cyc_to_us_ceil64(k_cycle_get_64() - start);
+
+	TC_PRINT("QoS %d, %s: %d messages in %llu us, %llu messages/s\n", qos,
+		 IS_ENABLED(CONFIG_MQTT_PUBLISH_BATCH) ? "batched" : "one by one",
+		 BENCH_MESSAGES, (unsigned long long)us,
+		 (unsigned long long)(BENCH_MESSAGES * USEC_PER_SEC / MAX(us, 1)));
+
+	ret = mqtt_disconnect(&client_ctx);
+	zassert_ok(ret, "MQTT disconnect failed (%d)", ret);
+}
+
+ZTEST(mqtt_publish, test_qos0)
+{
+	run_publish(MQTT_QOS_0_AT_MOST_ONCE);
+}
+
+ZTEST(mqtt_publish, test_qos1)
+{
+	run_publish(MQTT_QOS_1_AT_LEAST_ONCE);
+}
+
+static void *mqtt_publish_setup(void)
+{
+	struct sockaddr_in bind_addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(BENCH_BROKER_PORT),
+	};
+	int ret;
+
+	broker_addr.sin_family = AF_INET;
+	broker_addr.sin_port = htons(BENCH_BROKER_PORT);
+	zsock_inet_pton(AF_INET, BENCH_BROKER_ADDR, &broker_addr.sin_addr);
+	bind_addr.sin_addr = broker_addr.sin_addr;
+
+	broker_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(broker_sock >= 0, "Failed to create broker socket (%d)", -errno);
+
+	ret = zsock_bind(broker_sock, (struct sockaddr *)&bind_addr, sizeof(bind_addr));
+	zassert_ok(ret, "Failed to bind broker socket (%d)", -errno);
+
+	ret = zsock_listen(broker_sock, 1);
+	zassert_ok(ret, "Failed to listen on broker socket (%d)", -errno);
+
+	k_thread_create(&broker_thread, broker_stack, K_THREAD_STACK_SIZEOF(broker_stack),
+			broker_fn, NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+#if defined(CONFIG_MQTT_PUBLISH_BATCH)
+	TC_PRINT("In-flight window of %d messages, batches of %d messages\n",
+		 CONFIG_MQTT_PUBLISH_INFLIGHT_MAX, CONFIG_MQTT_PUBLISH_BATCH_SIZE);
+#else
+	TC_PRINT("In-flight window of %d messages\n", CONFIG_MQTT_PUBLISH_INFLIGHT_MAX);
+#endif
+
+	return NULL;
+}
+
+ZTEST_SUITE(mqtt_publish, NULL, mqtt_publish_setup, NULL, NULL, NULL);
@@ -116,6 +116,39 @@ static int exec_test(uint8_t nb_threads)
 	return yielder_status;
 }
 
+static const char *const read_names[NB_READ_KINDS] = {
+	[READ_UPTIME_QUERY] = "k_uptime_ticks_query()",
+	[READ_UPTIME] = "k_uptime_ticks()",
+	[READ_CURRENT_QUERY] = "k_sched_current_thread_query()",
+	[READ_CURRENT] = "k_current_get()",
+	[READ_CPU_QUERY] = "k_sched_current_cpu_query()",
+	[READ_CPU] = "k_current_cpu_get()",
+};
+
+static void exec_read_test(uint32_t kind)
+{
+	k_tid_t reader;
+
+	/* The reader stays in the default memory domain, which is all the
+	 * shared page needs.
+	 */
+	reader = k_thread_create(&app_threads[0].thread, app_thread_stacks[0],
+				 APP_STACKSIZE, kernel_data_read,
+				 (void *)(uintptr_t)kind, NULL, NULL,
+				 THREADS_PRIO, K_USER, K_FOREVER);
+
+	stamp(MEAS_START);
+	k_thread_start(reader);
+	k_thread_join(reader, K_FOREVER);
+	stamp(MEAS_END);
+
+	uint32_t full_time = stamps[MEAS_END] - stamps[MEAS_START];
+	uint64_t time_ns = k_cyc_to_ns_near64(full_time) / NB_READS;
+
+	printk("%-32s: %8" PRIu32 " cyc & %6" PRIu32 " calls -> %6"
+				PRIu64 " ns per call\n", read_names[kind], full_time,
+				NB_READS, time_ns);
+}
 
 int main(void)
 {
@@ -136,6 +169,14 @@ int main(void)
 		}
 	}
 
+	printk("============================\n");
+	printk("user mode kernel data reads (shared page %s)\n",
+	       IS_ENABLED(CONFIG_USERSPACE_SHARED_PAGE) ? "on" : "off");
+
+	for (uint32_t kind = 0; kind < NB_READ_KINDS; kind++) {
+		exec_read_test(kind);
+	}
+
 	printk("SUCCESS\n");
 	return 0;
 }
@@ -19,3 +19,32 @@ void context_switch_yield(void *p1, void *p2, void *p3)
 		k_yield();
 	}
 }
+
+void kernel_data_read(void *p1, void *p2, void *p3)
+{
+	uint32_t kind = (uint32_t)(uintptr_t) p1;
+	volatile uintptr_t sink;
+
+	for (uint32_t i = 0; i < NB_READS; i++) {
+		switch (kind) {
+		case READ_UPTIME_QUERY:
+			sink = (uintptr_t)k_uptime_ticks_query();
+			break;
+		case READ_UPTIME:
+			sink = (uintptr_t)k_uptime_ticks();
+			break;
+		case READ_CURRENT_QUERY:
+			sink = (uintptr_t)k_sched_current_thread_query();
+			break;
+		case READ_CURRENT:
+			sink = (uintptr_t)k_current_get();
+			break;
+		case READ_CPU_QUERY:
+			sink = (uintptr_t)k_sched_current_cpu_query();
+			break;
+		default:
+			sink = (uintptr_t)k_current_cpu_get();
+			break;
+		}
+	}
+}
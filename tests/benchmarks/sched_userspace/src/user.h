@@ -5,5 +5,17 @@
  */
 
 #define NB_YIELDS UINT32_C(1000000)
+#define NB_READS UINT32_C(100000)
+
+enum {
+	READ_UPTIME_QUERY,
+	READ_UPTIME,
+	READ_CURRENT_QUERY,
+	READ_CURRENT,
+	READ_CPU_QUERY,
+	READ_CPU,
+	NB_READ_KINDS
+};
 
 void context_switch_yield(void *p1, void *p2, void *p3);
+void kernel_data_read(void *p1, void *p2, void *p3);
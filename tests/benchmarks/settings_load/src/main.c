@@ -0,0 +1,93 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Boot-time settings load benchmark
+ *
+ * Stores a number of settings items spread over many dynamic handlers in
+ * the NVS back-end and measures how long settings_load() takes to read
+ * them back and dispatch each one to its handler.
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/settings/settings.h>
+
+#define BENCH_HANDLERS   16
+#define BENCH_ITEMS      128
+#define BENCH_ITERATIONS 5
+
+static char handler_names[BENCH_HANDLERS][sizeof("bench/hXX")];
+static struct settings_handler handlers[BENCH_HANDLERS];
+static uint32_t set_calls;
+
+static int bench_set(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg)
+{
+	uint32_t val;
+	ssize_t rc;
+
+	rc = read_cb(cb_arg, &val, sizeof(val));
+	if (rc != sizeof(val)) {
+		return -EINVAL;
+	}
+
+	set_calls++;
+
+	return 0;
+}
+
+static void *settings_load_setup(void)
+{
+	char name[SETTINGS_MAX_NAME_LEN];
+	int rc;
+
+	rc = settings_subsys_init();
+	zassert_equal(rc, 0, "settings_subsys_init failed (err %d)", rc);
+
+	for (int i = 0; i < BENCH_HANDLERS; i++) {
+		snprintf(handler_names[i], sizeof(handler_names[i]), "bench/h%02d", i);
+		handlers[i].name = handler_names[i];
+		handlers[i].h_set = bench_set;
+
+		rc = settings_register(&handlers[i]);
+		zassert_equal(rc, 0, "settings_register failed (err %d)", rc);
+	}
+
+	for (uint32_t i = 0; i < BENCH_ITEMS; i++) {
+		snprintf(name, sizeof(name), "bench/h%02d/k%03d", i % BENCH_HANDLERS, i);
+
+		rc = settings_save_one(name, &i, sizeof(i));
+		zassert_equal(rc, 0, "settings_save_one failed (err %d)", rc);
+	}
+
+	return NULL;
+}
+
+ZTEST(settings_load, test_settings_load_time)
+{
+	uint64_t total_cycles = 0;
+	uint32_t start;
+	int rc;
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		set_calls = 0;
+
+		start = k_cycle_get_32();
+		rc = settings_load();
+		total_cycles += k_cycle_get_32() - start;
+
+		zassert_equal(rc, 0, "settings_load failed (err %d)", rc);
+		zassert_equal(set_calls, BENCH_ITEMS, "Loaded %u items, expected %u",
+			      set_calls, BENCH_ITEMS);
+	}
+
+	TC_PRINT("settings_load() of %u items over %u handlers: %llu us\n",
+		 BENCH_ITEMS, BENCH_HANDLERS,
+		 (unsigned long long)k_cyc_to_us_floor64(total_cycles / BENCH_ITERATIONS));
+}
+
+ZTEST_SUITE(settings_load, NULL, settings_load_setup, NULL, NULL, NULL);
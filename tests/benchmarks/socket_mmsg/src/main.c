@@ -0,0 +1,172 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief UDP socket batching benchmark
+ *
+ * Small telemetry datagrams are sent in bursts over the loopback interface
+ * and read back, either with one zsock_sendto() and zsock_recvfrom() call
+ * per datagram or with zsock_sendmmsg() and zsock_recvmmsg() moving a whole
+ * burst per call. Only the time spent in the socket calls is measured, which
+ * shows what looking up and locking the socket once per burst saves.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+
+#define BENCH_ADDR           "127.0.0.1"
+#define BENCH_PORT           4242
+#define BENCH_BURSTS         200
+#define BENCH_BURST_SIZE     32
+#define BENCH_PAYLOAD_SIZE   32
+#define BENCH_SETTLE_MS      5
+
+static int rx_sock = -1;
+static int tx_sock = -1;
+
+static uint8_t payload[BENCH_PAYLOAD_SIZE];
+static uint8_t rx_bufs[BENCH_BURST_SIZE][BENCH_PAYLOAD_SIZE];
+static struct iovec rx_iov[BENCH_BURST_SIZE];
+static struct iovec tx_iov[BENCH_BURST_SIZE];
+static struct mmsghdr rx_msgs[BENCH_BURST_SIZE];
+static struct mmsghdr tx_msgs[BENCH_BURST_SIZE];
+
+static void print_rate(const char *title, const char *step, uint64_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_ceil64(cycles);
+	int count = BENCH_BURSTS * BENCH_BURST_SIZE;
+
+	TC_PRINT("%s, %s: %d datagrams in %llu us, %llu ns each\n", title, step, count,
+		 (unsigned long long)(ns / NSEC_PER_USEC), (unsigned long long)(ns / count));
+}
+
+static uint64_t send_one_by_one(void)
+{
+	uint64_t start = k_cycle_get_64();
+
+	for (int i = 0; i < BENCH_BURST_SIZE; i++) {
+		ssize_t ret = zsock_send(tx_sock, payload, sizeof(payload), 0);
+
+		zassert_equal(ret, sizeof(payload), "send failed (%d)", -errno);
+	}
+
+	return k_cycle_get_64() - start;
+}
+
+static uint64_t recv_one_by_one(void)
+{
+	uint64_t start = k_cycle_get_64();
+
+	for (int i = 0; i < BENCH_BURST_SIZE; i++) {
+		ssize_t ret = zsock_recv(rx_sock, rx_bufs[i], sizeof(rx_bufs[i]),
+					 ZSOCK_MSG_DONTWAIT);
+
+		zassert_equal(ret, sizeof(payload), "recv failed (%d)", -errno);
+	}
+
+	return k_cycle_get_64() - start;
+}
+
+static uint64_t send_batched(void)
+{
+	uint64_t start = k_cycle_get_64();
+	int ret;
+
+	ret = zsock_sendmmsg(tx_sock, tx_msgs, BENCH_BURST_SIZE, 0);
+	zassert_equal(ret, BENCH_BURST_SIZE, "sendmmsg failed (%d)", -errno);
+
+	return k_cycle_get_64() - start;
+}
+
+static uint64_t recv_batched(void)
+{
+	uint64_t start;
+	int ret;
+
+	/* Received lengths are stored in the headers, so set them again */
+	for (int i = 0; i < BENCH_BURST_SIZE; i++) {
+		rx_iov[i].iov_base = rx_bufs[i];
+		rx_iov[i].iov_len = sizeof(rx_bufs[i]);
+		rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	start = k_cycle_get_64();
+
+	ret = zsock_recvmmsg(rx_sock, rx_msgs, BENCH_BURST_SIZE,
+			     ZSOCK_MSG_WAITFORONE | ZSOCK_MSG_DONTWAIT, NULL);
+	zassert_equal(ret, BENCH_BURST_SIZE, "recvmmsg failed (%d)", ret < 0 ? -errno : ret);
+
+	return k_cycle_get_64() - start;
+}
+
+static void run_bursts(const char *title, uint64_t (*send_burst)(void),
+		       uint64_t (*recv_burst)(void))
+{
+	uint64_t send_cycles = 0;
+	uint64_t recv_cycles = 0;
+
+	for (int i = 0; i < BENCH_BURSTS; i++) {
+		send_cycles += send_burst();
+
+		/* Let the loopback interface queue the whole burst */
+		k_msleep(BENCH_SETTLE_MS);
+
+		recv_cycles += recv_burst();
+	}
+
+	print_rate(title, "send", send_cycles);
+	print_rate(title, "recv", recv_cycles);
+}
+
+ZTEST(socket_mmsg, test_one_by_one)
+{
+	run_bursts("one by one", send_one_by_one, recv_one_by_one);
+}
+
+ZTEST(socket_mmsg, test_batched)
+{
+	run_bursts("batched", send_batched, recv_batched);
+}
+
+static void *socket_mmsg_setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(BENCH_PORT),
+	};
+	int ret;
+
+	zsock_inet_pton(AF_INET, BENCH_ADDR, &addr.sin_addr);
+
+	rx_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(rx_sock >= 0, "Failed to create receiving socket (%d)", -errno);
+
+	ret = zsock_bind(rx_sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_ok(ret, "Failed to bind receiving socket (%d)", -errno);
+
+	tx_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(tx_sock >= 0, "Failed to create sending socket (%d)", -errno);
+
+	ret = zsock_connect(tx_sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_ok(ret, "Failed to connect sending socket (%d)", -errno);
+
+	memset(payload, 'z', sizeof(payload));
+
+	for (int i = 0; i < BENCH_BURST_SIZE; i++) {
+		tx_iov[i].iov_base = payload;
+		tx_iov[i].iov_len = sizeof(payload);
+		tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	TC_PRINT("Bursts of %d datagrams of %d bytes\n", BENCH_BURST_SIZE, BENCH_PAYLOAD_SIZE);
+
+	return NULL;
+}
+
+ZTEST_SUITE(socket_mmsg, NULL, socket_mmsg_setup, NULL, NULL, NULL);
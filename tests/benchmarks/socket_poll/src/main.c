@@ -0,0 +1,156 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Socket readiness wait benchmark
+ *
+ * Opens 8, 64 and 256 socket pairs, makes one of them readable at a time and
+ * measures how long it takes to find the ready socket, either with
+ * zsock_poll() over all sockets or with zvfs_epoll_wait() on a persistent
+ * interest set holding the same sockets.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/zvfs/epoll.h>
+
+#define BENCH_MAX_SOCKETS 256
+#define BENCH_ITERATIONS  1000
+
+int zvfs_close(int fd);
+
+static const int bench_sizes[] = {8, 64, BENCH_MAX_SOCKETS};
+
+static int sv[BENCH_MAX_SOCKETS][2];
+static struct zsock_pollfd pfds[BENCH_MAX_SOCKETS];
+
+static void open_pairs(int n)
+{
+	for (int i = 0; i < n; i++) {
+		zassert_ok(zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv[i]),
+			   "socketpair failed (err %d)", errno);
+	}
+}
+
+static void close_pairs(int n)
+{
+	for (int i = 0; i < n; i++) {
+		zsock_close(sv[i][0]);
+		zsock_close(sv[i][1]);
+	}
+}
+
+static void make_ready(int idx)
+{
+	char c = 'x';
+
+	zassert_equal(zsock_send(sv[idx][1], &c, 1, 0), 1, "send failed (err %d)", errno);
+}
+
+static void consume(int idx)
+{
+	char c;
+
+	zassert_equal(zsock_recv(sv[idx][0], &c, 1, 0), 1, "recv failed (err %d)", errno);
+}
+
+static uint64_t bench_poll(int n)
+{
+	uint64_t total_cycles = 0;
+	uint32_t start;
+	int ready;
+	int ret;
+
+	for (int i = 0; i < n; i++) {
+		pfds[i].fd = sv[i][0];
+		pfds[i].events = ZSOCK_POLLIN;
+	}
+
+	for (int it = 0; it < BENCH_ITERATIONS; it++) {
+		make_ready(it % n);
+
+		start = k_cycle_get_32();
+		ret = zsock_poll(pfds, n, -1);
+
+		/* Finding the ready socket is part of the cost of poll() */
+		for (ready = 0; ready < n; ready++) {
+			if (pfds[ready].revents & ZSOCK_POLLIN) {
+				break;
+			}
+		}
+		total_cycles += k_cycle_get_32() - start;
+
+		zassert_equal(ret, 1, "poll returned %d", ret);
+		zassert_equal(ready, it % n, "socket %d reported, expected %d", ready, it % n);
+
+		consume(ready);
+	}
+
+	return total_cycles / BENCH_ITERATIONS;
+}
+
+static uint64_t bench_epoll(int n)
+{
+	struct zvfs_epoll_event ev;
+	uint64_t total_cycles = 0;
+	uint32_t start;
+	int epfd;
+	int ret;
+
+	epfd = zvfs_epoll_create(0);
+	zassert_true(epfd >= 0, "epoll_create failed (err %d)", errno);
+
+	for (int i = 0; i < n; i++) {
+		ev.events = ZVFS_EPOLLIN;
+		ev.data.u32 = i;
+
+		zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, sv[i][0], &ev),
+			   "epoll_ctl failed (err %d)", errno);
+	}
+
+	for (int it = 0; it < BENCH_ITERATIONS; it++) {
+		make_ready(it % n);
+
+		start = k_cycle_get_32();
+		ret = zvfs_epoll_wait(epfd, &ev, 1, -1);
+		total_cycles += k_cycle_get_32() - start;
+
+		zassert_equal(ret, 1, "epoll_wait returned %d", ret);
+		zassert_equal(ev.data.u32, it % n, "socket %u reported, expected %d",
+			      ev.data.u32, it % n);
+
+		consume(ev.data.u32);
+	}
+
+	/* Nothing left to report once every socket has been drained */
+	zassert_equal(zvfs_epoll_wait(epfd, &ev, 1, 0), 0, "stale readiness reported");
+
+	zvfs_close(epfd);
+
+	return total_cycles / BENCH_ITERATIONS;
+}
+
+ZTEST(socket_poll, test_wait_one_ready)
+{
+	uint64_t poll_cycles;
+	uint64_t epoll_cycles;
+
+	for (int i = 0; i < ARRAY_SIZE(bench_sizes); i++) {
+		int n = bench_sizes[i];
+
+		open_pairs(n);
+		poll_cycles = bench_poll(n);
+		epoll_cycles = bench_epoll(n);
+		close_pairs(n);
+
+		TC_PRINT("%3d sockets, one ready: poll %llu ns, epoll %llu ns\n", n,
+			 (unsigned long long)k_cyc_to_ns_floor64(poll_cycles),
+			 (unsigned long long)k_cyc_to_ns_floor64(epoll_cycles));
+	}
+}
+
+ZTEST_SUITE(socket_poll, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,90 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fcb.h>
+
+#include "storage_perf.h"
+
+#define FCB_PERF_MAGIC 0xb3c4f00d
+#define FCB_PERF_SECTORS 32
+
+static struct fcb fcb;
+static struct flash_sector sectors[FCB_PERF_SECTORS];
+
+static int fcb_perf_write(void *ctx, uint32_t record, const uint8_t *buf)
+{
+	struct fcb *fcbp = ctx;
+	struct fcb_entry loc;
+	int rc;
+
+	ARG_UNUSED(record);
+
+	rc = fcb_append(fcbp, BENCH_RECORD_SIZE, &loc);
+	if (rc == -ENOSPC) {
+		/* The log is full, drop the oldest sector */
+		rc = fcb_rotate(fcbp);
+		if (rc == 0) {
+			rc = fcb_append(fcbp, BENCH_RECORD_SIZE, &loc);
+		}
+	}
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = flash_area_write(fcbp->fap, FCB_ENTRY_FA_DATA_OFF(loc), buf, BENCH_RECORD_SIZE);
+	if (rc != 0) {
+		return rc;
+	}
+
+	return fcb_append_finish(fcbp, &loc);
+}
+
+static void fcb_perf_setup(void)
+{
+	uint32_t sector_cnt = ARRAY_SIZE(sectors);
+	int rc;
+
+	rc = flash_area_get_sectors(BENCH_PARTITION_ID, &sector_cnt, sectors);
+	zassert_true(rc == 0 || rc == -ENOMEM, "Unable to get sectors (err %d)", rc);
+
+	memset(&fcb, 0, sizeof(fcb));
+	fcb.f_magic = FCB_PERF_MAGIC;
+	fcb.f_sectors = sectors;
+	fcb.f_sector_cnt = sector_cnt;
+	fcb.f_scratch_cnt = 1;
+}
+
+ZTEST(storage_perf, test_fcb)
+{
+	struct storage_perf_result res = { 0 };
+	uint8_t buf[BENCH_RECORD_SIZE];
+	uint32_t start;
+	int rc;
+
+	storage_perf_prepare();
+
+	fcb_perf_setup();
+	rc = fcb_init(BENCH_PARTITION_ID, &fcb);
+	zassert_equal(rc, 0, "fcb_init failed (err %d)", rc);
+
+	for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+		for (uint32_t record = 0; record < BENCH_RECORDS; record++) {
+			storage_perf_record_fill(buf, record, round);
+			rc = storage_perf_timed_write(&res, fcb_perf_write, &fcb, record, buf);
+			zassert_equal(rc, 0, "fcb append failed (err %d)", rc);
+		}
+	}
+
+	fcb_perf_setup();
+	start = k_cycle_get_32();
+	rc = fcb_init(BENCH_PARTITION_ID, &fcb);
+	res.mount_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+	zassert_equal(rc, 0, "fcb_init failed (err %d)", rc);
+
+	storage_perf_report("fcb", &res);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+
+#include "storage_perf.h"
+
+#define LFS_PERF_MNT "/lfs"
+#define LFS_PERF_SEQ_FILE LFS_PERF_MNT "/seq"
+#define LFS_PERF_SEQ_SIZE (16 * 1024)
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_perf_data);
+
+static struct fs_mount_t mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &lfs_perf_data,
+	.storage_dev = (void *)BENCH_PARTITION_ID,
+	.mnt_point = LFS_PERF_MNT,
+};
+
+/* Each record is a small file rewritten in place */
+static int lfs_perf_write(void *ctx, uint32_t record, const uint8_t *buf)
+{
+	char path[sizeof(LFS_PERF_MNT "/rXXX")];
+	struct fs_file_t file;
+	ssize_t wr;
+	int rc;
+
+	ARG_UNUSED(ctx);
+
+	snprintf(path, sizeof(path), LFS_PERF_MNT "/r%03u", record);
+
+	fs_file_t_init(&file);
+	rc = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE);
+	if (rc != 0) {
+		return rc;
+	}
+
+	wr = fs_write(&file, buf, BENCH_RECORD_SIZE);
+	rc = fs_close(&file);
+
+	if (wr < 0) {
+		return wr;
+	}
+
+	return rc;
+}
+
+ZTEST(storage_perf, test_littlefs)
+{
+	struct storage_perf_result res = { 0 };
+	uint8_t buf[BENCH_RECORD_SIZE];
+	uint32_t start;
+	int rc;
+
+	storage_perf_prepare();
+
+	rc = fs_mount(&mnt);
+	zassert_equal(rc, 0, "fs_mount failed (err %d)", rc);
+
+	for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+		for (uint32_t record = 0; record < BENCH_RECORDS; record++) {
+			storage_perf_record_fill(buf, record, round);
+			rc = storage_perf_timed_write(&res, lfs_perf_write, NULL, record, buf);
+			zassert_equal(rc, 0, "file write failed (err %d)", rc);
+		}
+	}
+
+	rc = fs_unmount(&mnt);
+	zassert_equal(rc, 0, "fs_unmount failed (err %d)", rc);
+
+	start = k_cycle_get_32();
+	rc = fs_mount(&mnt);
+	res.mount_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+	zassert_equal(rc, 0, "fs_mount failed (err %d)", rc);
+
+	storage_perf_report("littlefs", &res);
+
+	rc = fs_unmount(&mnt);
+	zassert_equal(rc, 0, "fs_unmount failed (err %d)", rc);
+}
+
+/* Sequential read of a large file in small chunks, as a log reader does */
+ZTEST(storage_perf, test_littlefs_seq_read)
+{
+	uint8_t buf[BENCH_RECORD_SIZE];
+	struct fs_file_t file;
+	uint32_t start;
+	uint32_t time_us;
+	ssize_t len;
+	int rc;
+
+	storage_perf_prepare();
+
+	rc = fs_mount(&mnt);
+	zassert_equal(rc, 0, "fs_mount failed (err %d)", rc);
+
+	fs_file_t_init(&file);
+	rc = fs_open(&file, LFS_PERF_SEQ_FILE, FS_O_CREATE | FS_O_WRITE);
+	zassert_equal(rc, 0, "fs_open failed (err %d)", rc);
+
+	for (uint32_t i = 0; i < LFS_PERF_SEQ_SIZE / sizeof(buf); i++) {
+		storage_perf_record_fill(buf, i, 0);
+		len = fs_write(&file, buf, sizeof(buf));
+		zassert_equal(len, sizeof(buf), "fs_write failed (err %d)", (int)len);
+	}
+
+	rc = fs_close(&file);
+	zassert_equal(rc, 0, "fs_close failed (err %d)", rc);
+
+	/* Remount so that nothing is left in RAM */
+	rc = fs_unmount(&mnt);
+	zassert_equal(rc, 0, "fs_unmount failed (err %d)", rc);
+	rc = fs_mount(&mnt);
+	zassert_equal(rc, 0, "fs_mount failed (err %d)", rc);
+
+	fs_file_t_init(&file);
+	rc = fs_open(&file, LFS_PERF_SEQ_FILE, FS_O_READ);
+	zassert_equal(rc, 0, "fs_open failed (err %d)", rc);
+
+	storage_perf_reset_stats();
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < LFS_PERF_SEQ_SIZE / sizeof(buf); i++) {
+		len = fs_read(&file, buf, sizeof(buf));
+		zassert_equal(len, sizeof(buf), "fs_read failed (err %d)", (int)len);
+	}
+	time_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+
+	rc = fs_close(&file);
+	zassert_equal(rc, 0, "fs_close failed (err %d)", rc);
+
+	TC_PRINT("littlefs: sequential read of %u B in %u B chunks: %u us, "
+		 "%u flash reads\n",
+		 LFS_PERF_SEQ_SIZE, (uint32_t)sizeof(buf), time_us,
+		 storage_perf_flash_stat("flash_read_calls"));
+
+	rc = fs_unmount(&mnt);
+	zassert_equal(rc, 0, "fs_unmount failed (err %d)", rc);
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Storage back-end performance benchmark
+ *
+ * Runs the same record update workload on each enabled storage back-end on
+ * top of the timing-accurate flash simulator, and reports mount time,
+ * write amplification and the worst write latency, which is dominated by
+ * garbage collection.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/stats/stats.h>
+
+#include "storage_perf.h"
+
+struct stat_lookup {
+	const char *name;
+	uint32_t value;
+};
+
+static int stat_find(struct stats_hdr *hdr, void *arg, const char *name, uint16_t off)
+{
+	struct stat_lookup *lookup = arg;
+
+	if (strcmp(name, lookup->name) == 0) {
+		lookup->value = *(uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+uint32_t storage_perf_flash_stat(const char *name)
+{
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+	struct stat_lookup lookup = {
+		.name = name,
+	};
+
+	if (hdr != NULL) {
+		stats_walk(hdr, stat_find, &lookup);
+	}
+
+	return lookup.value;
+}
+
+void storage_perf_reset_stats(void)
+{
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+
+	if (hdr != NULL) {
+		stats_reset(hdr);
+	}
+}
+
+void storage_perf_prepare(void)
+{
+	const struct flash_area *fa;
+	int rc;
+
+	rc = flash_area_open(BENCH_PARTITION_ID, &fa);
+	zassert_equal(rc, 0, "Unable to open partition (err %d)", rc);
+
+	rc = flash_area_flatten(fa, 0, fa->fa_size);
+	zassert_equal(rc, 0, "Unable to erase partition (err %d)", rc);
+
+	flash_area_close(fa);
+
+	storage_perf_reset_stats();
+}
+
+void storage_perf_record_fill(uint8_t *buf, uint32_t record, uint32_t round)
+{
+	for (size_t i = 0; i < BENCH_RECORD_SIZE; i++) {
+		buf[i] = (uint8_t)(record * 31U + round * 7U + i);
+	}
+}
+
+int storage_perf_timed_write(struct storage_perf_result *res,
+			     int (*write_fn)(void *ctx, uint32_t record, const uint8_t *buf),
+			     void *ctx, uint32_t record, const uint8_t *buf)
+{
+	uint32_t start;
+	uint32_t time_us;
+	int rc;
+
+	start = k_cycle_get_32();
+	rc = write_fn(ctx, record, buf);
+	time_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+
+	res->writes++;
+	res->payload_bytes += BENCH_RECORD_SIZE;
+	res->total_write_us += time_us;
+	res->max_write_us = MAX(res->max_write_us, time_us);
+
+	return rc;
+}
+
+void storage_perf_report(const char *name, const struct storage_perf_result *res)
+{
+	uint32_t written = storage_perf_flash_stat("bytes_written");
+
+	TC_PRINT("%s: mount %u us, %u writes, avg write %u us, max write %u us\n",
+		 name, res->mount_us, res->writes,
+		 (uint32_t)(res->total_write_us / MAX(res->writes, 1)),
+		 res->max_write_us);
+	TC_PRINT("%s: payload %u B, flash written %u B (amplification x%u.%02u), "
+		 "%u erases\n",
+		 name, res->payload_bytes, written,
+		 written / MAX(res->payload_bytes, 1),
+		 (uint32_t)((written % MAX(res->payload_bytes, 1)) * 100ULL /
+			    MAX(res->payload_bytes, 1)),
+		 storage_perf_flash_stat("flash_erase_calls"));
+}
+
+ZTEST_SUITE(storage_perf, NULL, NULL, NULL, NULL, NULL);
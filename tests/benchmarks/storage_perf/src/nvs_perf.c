@@ -0,0 +1,61 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fs/nvs.h>
+
+#include "storage_perf.h"
+
+static struct nvs_fs fs;
+
+static int nvs_perf_write(void *ctx, uint32_t record, const uint8_t *buf)
+{
+	ssize_t rc = nvs_write(ctx, record + 1, buf, BENCH_RECORD_SIZE);
+
+	return rc < 0 ? rc : 0;
+}
+
+ZTEST(storage_perf, test_nvs)
+{
+	struct storage_perf_result res = { 0 };
+	uint8_t buf[BENCH_RECORD_SIZE];
+	const struct flash_area *fa;
+	struct flash_pages_info info;
+	uint32_t start;
+	int rc;
+
+	storage_perf_prepare();
+
+	rc = flash_area_open(BENCH_PARTITION_ID, &fa);
+	zassert_equal(rc, 0, "Unable to open partition (err %d)", rc);
+
+	rc = flash_get_page_info_by_offs(flash_area_get_device(fa), fa->fa_off, &info);
+	zassert_equal(rc, 0, "Unable to get page info (err %d)", rc);
+
+	fs.flash_device = flash_area_get_device(fa);
+	fs.offset = fa->fa_off;
+	fs.sector_size = info.size;
+	fs.sector_count = fa->fa_size / info.size;
+
+	rc = nvs_mount(&fs);
+	zassert_equal(rc, 0, "nvs_mount failed (err %d)", rc);
+
+	for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+		for (uint32_t record = 0; record < BENCH_RECORDS; record++) {
+			storage_perf_record_fill(buf, record, round);
+			rc = storage_perf_timed_write(&res, nvs_perf_write, &fs, record, buf);
+			zassert_equal(rc, 0, "nvs_write failed (err %d)", rc);
+		}
+	}
+
+	fs.ready = false;
+	start = k_cycle_get_32();
+	rc = nvs_mount(&fs);
+	res.mount_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+	zassert_equal(rc, 0, "nvs_mount failed (err %d)", rc);
+
+	storage_perf_report("nvs", &res);
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STORAGE_PERF_H_
+#define STORAGE_PERF_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+
+#define BENCH_PARTITION_ID FIXED_PARTITION_ID(bench_partition)
+
+/* Workload: a set of records, each rewritten once per round */
+#define BENCH_RECORDS     32
+#define BENCH_RECORD_SIZE 64
+#define BENCH_ROUNDS      100
+
+struct storage_perf_result {
+	/* Time to mount the populated storage */
+	uint32_t mount_us;
+	/* Bytes handed to the storage back-end */
+	uint32_t payload_bytes;
+	/* Duration of the longest single write, garbage collection included */
+	uint32_t max_write_us;
+	/* Total duration of all writes */
+	uint64_t total_write_us;
+	/* Number of writes */
+	uint32_t writes;
+};
+
+/* Reset the flash simulator statistics */
+void storage_perf_reset_stats(void);
+
+/* Erase the benchmark partition and reset the flash simulator statistics */
+void storage_perf_prepare(void);
+
+/* Fill @p buf with the content of record @p record in round @p round */
+void storage_perf_record_fill(uint8_t *buf, uint32_t record, uint32_t round);
+
+/* Time a single write done by @p write_fn and account for it in @p res */
+int storage_perf_timed_write(struct storage_perf_result *res,
+			     int (*write_fn)(void *ctx, uint32_t record, const uint8_t *buf),
+			     void *ctx, uint32_t record, const uint8_t *buf);
+
+/* Get a flash simulator statistic, 0 if statistics are not available */
+uint32_t storage_perf_flash_stat(const char *name);
+
+/* Print the results of back-end @p name along with the flash statistics */
+void storage_perf_report(const char *name, const struct storage_perf_result *res);
+
+#endif /* STORAGE_PERF_H_ */
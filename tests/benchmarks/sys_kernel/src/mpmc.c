@@ -0,0 +1,197 @@
+/* mpmc.c */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "syskernel.h"
+
+#include <zephyr/sys/mpmc.h>
+
+#define MPMC_SIZE 16
+#define MPMC_STACK_SIZE 1024
+
+SYS_MPMC_DEFINE(mpmc_ring, sizeof(uint32_t), MPMC_SIZE);
+K_MSGQ_DEFINE(mpmc_msgq, sizeof(uint32_t), MPMC_SIZE, sizeof(uint32_t));
+
+static K_THREAD_STACK_ARRAY_DEFINE(mpmc_stacks, 2 * MPMC_MAX_PAIRS, MPMC_STACK_SIZE);
+static struct k_thread mpmc_threads[2 * MPMC_MAX_PAIRS];
+
+static atomic_t mpmc_received;
+
+/* Elements handled by each of @a pairs producers or consumers, so that
+ * they add up to number_of_loops.
+ */
+static int mpmc_share(int pairs, int id)
+{
+	return (number_of_loops - id + pairs - 1) / pairs;
+}
+
+/**
+ *
+ * @brief MPMC ring producer thread
+ *
+ * @param par1   Number of elements to put.
+ * @param par2   Unused
+ * @param par3   Unused
+ *
+ */
+static void ring_producer(void *par1, void *par2, void *par3)
+{
+	int num_loops = POINTER_TO_INT(par1);
+	uint32_t data;
+
+	ARG_UNUSED(par2);
+	ARG_UNUSED(par3);
+
+	for (int i = 0; i < num_loops; i++) {
+		data = i;
+		(void)sys_mpmc_put(&mpmc_ring, &data, K_FOREVER);
+	}
+}
+
+/**
+ *
+ * @brief MPMC ring consumer thread
+ *
+ * @param par1   Number of elements to get.
+ * @param par2   Unused
+ * @param par3   Unused
+ *
+ */
+static void ring_consumer(void *par1, void *par2, void *par3)
+{
+	int num_loops = POINTER_TO_INT(par1);
+	uint32_t data;
+
+	ARG_UNUSED(par2);
+	ARG_UNUSED(par3);
+
+	for (int i = 0; i < num_loops; i++) {
+		if (sys_mpmc_get(&mpmc_ring, &data, K_FOREVER) == 0) {
+			(void)atomic_inc(&mpmc_received);
+		}
+	}
+}
+
+/**
+ *
+ * @brief Message queue producer thread
+ *
+ * @param par1   Number of elements to put.
+ * @param par2   Unused
+ * @param par3   Unused
+ *
+ */
+static void msgq_producer(void *par1, void *par2, void *par3)
+{
+	int num_loops = POINTER_TO_INT(par1);
+	uint32_t data;
+
+	ARG_UNUSED(par2);
+	ARG_UNUSED(par3);
+
+	for (int i = 0; i < num_loops; i++) {
+		data = i;
+		(void)k_msgq_put(&mpmc_msgq, &data, K_FOREVER);
+	}
+}
+
+/**
+ *
+ * @brief Message queue consumer thread
+ *
+ * @param par1   Number of elements to get.
+ * @param par2   Unused
+ * @param par3   Unused
+ *
+ */
+static void msgq_consumer(void *par1, void *par2, void *par3)
+{
+	int num_loops = POINTER_TO_INT(par1);
+	uint32_t data;
+
+	ARG_UNUSED(par2);
+	ARG_UNUSED(par3);
+
+	for (int i = 0; i < num_loops; i++) {
+		if (k_msgq_get(&mpmc_msgq, &data, K_FOREVER) == 0) {
+			(void)atomic_inc(&mpmc_received);
+		}
+	}
+}
+
+/**
+ *
+ * @brief Move number_of_loops elements through a queue
+ *
+ * @return 1 if success and 0 on failure
+ *
+ * @param pairs      Number of producer and of consumer threads.
+ * @param producer   Producer thread entry point.
+ * @param consumer   Consumer thread entry point.
+ *
+ */
+static int mpmc_run(int pairs, k_thread_entry_t producer, k_thread_entry_t consumer)
+{
+	uint32_t t;
+
+	(void)atomic_set(&mpmc_received, 0);
+
+	t = BENCH_START();
+
+	for (int i = 0; i < pairs; i++) {
+		k_thread_create(&mpmc_threads[2 * i], mpmc_stacks[2 * i], MPMC_STACK_SIZE,
+				consumer, INT_TO_POINTER(mpmc_share(pairs, i)), NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+		k_thread_create(&mpmc_threads[2 * i + 1], mpmc_stacks[2 * i + 1],
+				MPMC_STACK_SIZE, producer,
+				INT_TO_POINTER(mpmc_share(pairs, i)), NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < 2 * pairs; i++) {
+		k_thread_join(&mpmc_threads[i], K_FOREVER);
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	return check_result((int)atomic_get(&mpmc_received), t);
+}
+
+/**
+ *
+ * @brief The main test entry
+ *
+ * @return number of successful tests
+ *
+ */
+int mpmc_test(void)
+{
+	char title[40];
+	int return_value = 0;
+
+	for (int pairs = 1; pairs <= MPMC_MAX_PAIRS; pairs++) {
+		snprintf(title, sizeof(title), "MPMC ring, %d:%d", pairs, pairs);
+		fprintf(output_file, sz_test_case_fmt, title);
+		fprintf(output_file, sz_description,
+			"\n\tsys_mpmc_put(K_FOREVER)"
+			"\n\tsys_mpmc_get(K_FOREVER)");
+		printf(sz_test_start_fmt);
+
+		return_value += mpmc_run(pairs, ring_producer, ring_consumer);
+
+		snprintf(title, sizeof(title), "Message queue, %d:%d", pairs, pairs);
+		fprintf(output_file, sz_test_case_fmt, title);
+		fprintf(output_file, sz_description,
+			"\n\tk_msgq_put(K_FOREVER)"
+			"\n\tk_msgq_get(K_FOREVER)");
+		printf(sz_test_start_fmt);
+
+		return_value += mpmc_run(pairs, msgq_producer, msgq_consumer);
+	}
+
+	return return_value;
+}
@@ -124,6 +124,7 @@ int main(void)
 {
 	int	    continuously = 0;
 	int	    test_result;
+	int	    test_count;
 
 	number_of_loops = NUMBER_OF_LOOPS;
 
@@ -156,16 +157,27 @@ int main(void)
 			number_of_loops);
 
 		test_result = 0;
+		test_count = 0;
+
+		/* These pass items between threads expecting them to
+		 * alternate on a single CPU
+		 */
+		if (arch_num_cpus() == 1) {
+			test_result += sema_test();
+			test_result += lifo_test();
+			test_result += fifo_test();
+			test_result += stack_test();
+			test_result += mem_slab_test();
 
-		test_result += sema_test();
-		test_result += lifo_test();
-		test_result += fifo_test();
-		test_result += stack_test();
-		test_result += mem_slab_test();
+			/* sema/lifo/fifo/stack/mem_slab account for 14 tests in total */
+			test_count += 14;
+		}
+
+		test_result += mpmc_test();
+		test_count += 2 * MPMC_MAX_PAIRS;
 
 		if (test_result) {
-			/* sema/lifo/fifo/stack/mem_slab account for 14 tests in total */
-			if (test_result == 14) {
+			if (test_result == test_count) {
 				fprintf(output_file, sz_module_result_fmt,
 					sz_success);
 			} else {
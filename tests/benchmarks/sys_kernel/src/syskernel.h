@@ -21,6 +21,13 @@
 #define NUMBER_OF_LOOPS 1000
 #endif
 
+/* Most producer/consumer pairs the MPMC ring is measured with */
+#if CONFIG_SRAM_SIZE <= 32
+#define MPMC_MAX_PAIRS 1
+#else
+#define MPMC_MAX_PAIRS 4
+#endif
+
 
 K_THREAD_STACK_DECLARE(thread_stack1, STACK_SIZE);
 K_THREAD_STACK_DECLARE(thread_stack2, STACK_SIZE);
@@ -57,6 +64,7 @@ int lifo_test(void);
 int fifo_test(void);
 int stack_test(void);
 int mem_slab_test(void);
+int mpmc_test(void);
 void begin_test(void);
 
 static inline uint32_t BENCH_START(void)
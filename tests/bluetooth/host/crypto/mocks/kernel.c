@@ -7,4 +7,4 @@
 #include <zephyr/kernel.h>
 #include "mocks/kernel.h"
 
-DEFINE_FAKE_VALUE_FUNC(int64_t, k_uptime_ticks);
+DEFINE_FAKE_VALUE_FUNC(int64_t, k_uptime_ticks_query);
@@ -9,6 +9,6 @@
 
 /* List of fakes used by this unit tester */
 #define KERNEL_FFF_FAKES_LIST(FAKE)         \
-		FAKE(k_uptime_ticks)                \
+		FAKE(k_uptime_ticks_query)          \
 
-DECLARE_FAKE_VALUE_FUNC(int64_t, k_uptime_ticks);
+DECLARE_FAKE_VALUE_FUNC(int64_t, k_uptime_ticks_query);
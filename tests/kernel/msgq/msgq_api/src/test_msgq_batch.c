@@ -0,0 +1,178 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 8
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) bbuffer[MSG_SIZE * BATCH_LEN];
+static ZTEST_DMEM uint32_t out[BATCH_LEN];
+static ZTEST_DMEM uint32_t in[BATCH_LEN];
+
+static void fill(uint32_t *buf, uint32_t first, int num)
+{
+	for (int i = 0; i < num; i++) {
+		buf[i] = first + i;
+	}
+}
+
+static void check(const uint32_t *buf, uint32_t first, int num)
+{
+	for (int i = 0; i < num; i++) {
+		zassert_equal(buf[i], first + i, "message %d is %u, expected %u",
+			      i, buf[i], first + i);
+	}
+}
+
+static void get_n_entry(void *p1, void *p2, void *p3)
+{
+	int ret = k_msgq_get_n((struct k_msgq *)p1, in, BATCH_LEN, K_FOREVER);
+
+	/* a blocked receiver gets the first message of the batch */
+	zassert_equal(ret, 1);
+	check(in, 100, 1);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test sending and receiving batches of messages
+ * @see k_msgq_put_n(), k_msgq_get_n()
+ */
+ZTEST(msgq_api, test_msgq_put_get_n)
+{
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	fill(out, 0, BATCH_LEN);
+	zassert_equal(k_msgq_put_n(&msgq, out, 5, K_NO_WAIT), 5);
+
+	/* only part of the batch fits */
+	fill(out, 5, BATCH_LEN);
+	zassert_equal(k_msgq_put_n(&msgq, out, 5, K_NO_WAIT), 3);
+	zassert_equal(k_msgq_num_free_get(&msgq), 0);
+	zassert_equal(k_msgq_put_n(&msgq, out, 1, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_put_n(&msgq, out, 1, TIMEOUT), -EAGAIN);
+
+	zassert_equal(k_msgq_get_n(&msgq, in, 6, K_NO_WAIT), 6);
+	check(in, 0, 6);
+
+	/* the write pointer wraps around the ring buffer */
+	fill(out, 8, BATCH_LEN);
+	zassert_equal(k_msgq_put_n(&msgq, out, 4, K_NO_WAIT), 4);
+	zassert_equal(k_msgq_num_used_get(&msgq), 6);
+
+	/* and so does the read pointer */
+	zassert_equal(k_msgq_get_n(&msgq, in, BATCH_LEN, K_NO_WAIT), 6);
+	check(in, 6, 6);
+
+	zassert_equal(k_msgq_get_n(&msgq, in, BATCH_LEN, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_get_n(&msgq, in, 1, TIMEOUT), -EAGAIN);
+	zassert_equal(k_msgq_put_n(&msgq, out, 0, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_get_n(&msgq, in, 0, K_NO_WAIT), 0);
+}
+
+/**
+ * @brief Test sending a batch to a blocked receiver
+ * @see k_msgq_put_n(), k_msgq_get_n()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_put_n_to_waiting_receiver)
+{
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, get_n_entry, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	fill(out, 100, 3);
+	zassert_equal(k_msgq_put_n(&msgq, out, 3, K_NO_WAIT), 3);
+	k_thread_join(&tdata, K_FOREVER);
+
+	/* the other messages were queued */
+	zassert_equal(k_msgq_get_n(&msgq, in, BATCH_LEN, K_NO_WAIT), 2);
+	check(in, 101, 2);
+}
+
+/**
+ * @brief Test processing messages in place
+ * @see k_msgq_get_claim(), k_msgq_get_finish()
+ */
+ZTEST(msgq_api, test_msgq_claim_finish)
+{
+	uint32_t *claimed;
+	uint32_t msg;
+
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	zassert_equal(k_msgq_get_claim(&msgq, (void **)&claimed, BATCH_LEN), -ENOMSG);
+
+	/* move the read pointer so that the queued messages wrap around */
+	fill(out, 0, BATCH_LEN);
+	zassert_equal(k_msgq_put_n(&msgq, out, 5, K_NO_WAIT), 5);
+	zassert_equal(k_msgq_get_n(&msgq, in, 5, K_NO_WAIT), 5);
+	fill(out, 10, BATCH_LEN);
+	zassert_equal(k_msgq_put_n(&msgq, out, 6, K_NO_WAIT), 6);
+
+	/* only the messages up to the end of the ring buffer are claimed */
+	zassert_equal(k_msgq_get_claim(&msgq, (void **)&claimed, BATCH_LEN), 3);
+	check(claimed, 10, 3);
+	zassert_equal(k_msgq_num_used_get(&msgq), 3);
+	zassert_equal(k_msgq_num_free_get(&msgq), 2);
+
+	/* receiving is refused while the claim is outstanding, sending isn't */
+	zassert_equal(k_msgq_get_claim(&msgq, (void **)&claimed, 1), -EBUSY);
+	zassert_equal(k_msgq_get(&msgq, &msg, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_get_n(&msgq, in, 1, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_put_n(&msgq, out, BATCH_LEN, K_NO_WAIT), 2);
+	zassert_equal(k_msgq_put(&msgq, &msg, K_NO_WAIT), -ENOMSG);
+
+	/* consume one message, give the two other ones back */
+	zassert_equal(k_msgq_get_finish(&msgq, 4), -EINVAL);
+	zassert_ok(k_msgq_get_finish(&msgq, 1));
+	zassert_equal(k_msgq_num_used_get(&msgq), 7);
+	zassert_equal(k_msgq_get_n(&msgq, in, 5, K_NO_WAIT), 5);
+	check(in, 11, 5);
+
+	/* the remaining messages are contiguous */
+	zassert_equal(k_msgq_get_claim(&msgq, (void **)&claimed, BATCH_LEN), 2);
+	check(claimed, 10, 2);
+	zassert_ok(k_msgq_get_finish(&msgq, 2));
+	zassert_equal(k_msgq_num_used_get(&msgq), 0);
+	zassert_equal(k_msgq_num_free_get(&msgq), BATCH_LEN);
+}
+
+/**
+ * @brief Test that a full queue can't be entirely claimed
+ * @see k_msgq_get_claim(), k_msgq_get_finish()
+ */
+ZTEST(msgq_api, test_msgq_claim_full)
+{
+	uint32_t *claimed;
+
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	fill(out, 0, BATCH_LEN);
+	zassert_equal(k_msgq_put_n(&msgq, out, BATCH_LEN, K_NO_WAIT), BATCH_LEN);
+
+	zassert_equal(k_msgq_get_claim(&msgq, (void **)&claimed, BATCH_LEN), BATCH_LEN - 1);
+	check(claimed, 0, BATCH_LEN - 1);
+	zassert_ok(k_msgq_get_finish(&msgq, BATCH_LEN - 1));
+
+	zassert_equal(k_msgq_get_n(&msgq, in, BATCH_LEN, K_NO_WAIT), 1);
+	check(in, BATCH_LEN - 1, 1);
+
+	zassert_equal(k_msgq_put(&msgq, &out[0], K_NO_WAIT), 0);
+	zassert_equal(k_msgq_get_claim(&msgq, (void **)&claimed, 0), -EINVAL);
+}
+
+/**
+ * @}
+ */
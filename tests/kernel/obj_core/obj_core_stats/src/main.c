@@ -11,6 +11,14 @@ SYS_MEM_BLOCKS_DEFINE(mem_block, 32, 4, 16);  /* Four 32 byte blocks */
 
 K_MEM_SLAB_DEFINE(mem_slab, 32, 4, 16);       /* Four 32 byte blocks */
 
+#ifdef CONFIG_LOCK_STATS
+K_MUTEX_DEFINE(lock_mutex);
+K_SEM_DEFINE(lock_sem, 1, 1);
+
+K_THREAD_STACK_DEFINE(lock_thread_stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+struct k_thread lock_thread;
+#endif /* CONFIG_LOCK_STATS */
+
 #if !defined(CONFIG_ARCH_POSIX) && !defined(CONFIG_SPARC) && !defined(CONFIG_MIPS)
 static void test_thread_entry(void *, void *, void *);
 K_THREAD_DEFINE(test_thread, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE,
@@ -693,6 +701,128 @@ ZTEST(obj_core_stats_mem_slab, test_obj_core_stats_mem_slab)
 	k_mem_slab_free(&mem_slab, mem2);
 }
 
+/***************** LOCKS *********************/
+
+#ifdef CONFIG_LOCK_STATS
+static void test_lock_raw(const char *str, struct k_obj_core *obj_core,
+			  uint64_t acquired, uint64_t contended)
+{
+	struct k_lock_stats raw;
+	int  status;
+
+	status = k_obj_core_stats_raw(obj_core, &raw, sizeof(raw));
+	zassert_equal(status, 0,
+		      "%s: Failed to get raw stats (%d)\n", str, status);
+
+	zassert_equal(raw.acquired, acquired,
+		      "%s: Expected %llu acquisitions, got %llu\n", str,
+		      (unsigned long long)acquired,
+		      (unsigned long long)raw.acquired);
+	zassert_equal(raw.contended, contended,
+		      "%s: Expected %llu contended, got %llu\n", str,
+		      (unsigned long long)contended,
+		      (unsigned long long)raw.contended);
+	zassert_true((raw.contended != 0U) || (raw.total_wait == 0U),
+		     "%s: Wait time recorded without contention\n", str);
+	zassert_true(raw.max_wait <= raw.total_wait,
+		     "%s: Longest wait exceeds total wait\n", str);
+}
+
+static void lock_mutex_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&lock_mutex, K_FOREVER);
+	k_mutex_unlock(&lock_mutex);
+}
+
+static void lock_sem_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&lock_sem, K_FOREVER);
+}
+
+/* Run @a entry in a thread that blocks on the lock held by the caller */
+static k_tid_t lock_thread_start(k_thread_entry_t entry)
+{
+	k_tid_t tid;
+
+	tid = k_thread_create(&lock_thread, lock_thread_stack,
+			      K_THREAD_STACK_SIZEOF(lock_thread_stack),
+			      entry, NULL, NULL, NULL,
+			      K_HIGHEST_THREAD_PRIO, 0, K_NO_WAIT);
+
+	/* Let it block */
+	k_sleep(K_MSEC(10));
+
+	return tid;
+}
+
+ZTEST(obj_core_stats_locks, test_obj_core_stats_mutex)
+{
+	struct k_obj_core *obj_core = K_OBJ_CORE(&lock_mutex);
+	k_tid_t tid;
+	int  status;
+
+	status = k_obj_core_stats_reset(obj_core);
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+	test_lock_raw("Reset", obj_core, 0, 0);
+
+	/* Recursive locking is not a new acquisition */
+
+	k_mutex_lock(&lock_mutex, K_FOREVER);
+	k_mutex_lock(&lock_mutex, K_FOREVER);
+	k_mutex_unlock(&lock_mutex);
+	k_mutex_unlock(&lock_mutex);
+	test_lock_raw("Recursive", obj_core, 1, 0);
+
+	/* A thread that has to wait is counted as contended right away */
+
+	k_mutex_lock(&lock_mutex, K_FOREVER);
+	tid = lock_thread_start(lock_mutex_entry);
+	test_lock_raw("Blocked", obj_core, 2, 1);
+
+	/* Unlocking hands the mutex over to the waiting thread */
+
+	k_mutex_unlock(&lock_mutex);
+	k_thread_join(tid, K_FOREVER);
+	test_lock_raw("Handed over", obj_core, 3, 1);
+}
+
+ZTEST(obj_core_stats_locks, test_obj_core_stats_sem)
+{
+	struct k_obj_core *obj_core = K_OBJ_CORE(&lock_sem);
+	k_tid_t tid;
+	int  status;
+
+	status = k_obj_core_stats_reset(obj_core);
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+	test_lock_raw("Reset", obj_core, 0, 0);
+
+	status = k_sem_take(&lock_sem, K_NO_WAIT);
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+	test_lock_raw("Take", obj_core, 1, 0);
+
+	status = k_sem_take(&lock_sem, K_NO_WAIT);
+	zassert_equal(status, -EBUSY, "Expected %d, got %d\n", -EBUSY, status);
+	test_lock_raw("Busy", obj_core, 1, 0);
+
+	tid = lock_thread_start(lock_sem_entry);
+	test_lock_raw("Blocked", obj_core, 1, 1);
+
+	k_sem_give(&lock_sem);
+	k_thread_join(tid, K_FOREVER);
+	test_lock_raw("Given", obj_core, 2, 1);
+
+	k_sem_give(&lock_sem);
+}
+#endif /* CONFIG_LOCK_STATS */
+
 ZTEST_SUITE(obj_core_stats_system, NULL, NULL,
 	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
 
@@ -704,3 +834,8 @@ ZTEST_SUITE(obj_core_stats_mem_block, NULL, NULL,
 
 ZTEST_SUITE(obj_core_stats_mem_slab, NULL, NULL,
 	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
+
+#ifdef CONFIG_LOCK_STATS
+ZTEST_SUITE(obj_core_stats_locks, NULL, NULL,
+	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
+#endif /* CONFIG_LOCK_STATS */
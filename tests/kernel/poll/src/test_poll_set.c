@@ -0,0 +1,226 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define NUM_SET_EVENTS 3
+
+static struct k_poll_set set;
+static struct k_sem set_sems[NUM_SET_EVENTS];
+static struct k_poll_event set_events[NUM_SET_EVENTS];
+
+static void set_events_init(bool persistent)
+{
+	k_poll_set_init(&set);
+
+	for (int i = 0; i < NUM_SET_EVENTS; i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+
+		if (persistent) {
+			k_poll_set_add_persistent(&set, &set_events[i]);
+		} else {
+			k_poll_set_add(&set, &set_events[i]);
+		}
+	}
+}
+
+static void set_events_remove(void)
+{
+	for (int i = 0; i < NUM_SET_EVENTS; i++) {
+		k_poll_set_remove(&set, &set_events[i]);
+	}
+}
+
+/**
+ * @brief Test that a delivered poll set event is disarmed
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_oneshot)
+{
+	struct k_poll_event *ready[NUM_SET_EVENTS];
+
+	set_events_init(false);
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), -EAGAIN,
+		      "nothing should be ready");
+
+	k_sem_give(&set_sems[1]);
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), 1,
+		      "one event should be ready");
+	zassert_equal_ptr(ready[0], &set_events[1], "wrong event");
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE, "wrong state");
+	zassert_ok(k_sem_take(&set_sems[1], K_NO_WAIT));
+
+	/* Not armed anymore */
+	k_sem_give(&set_sems[1]);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), -EAGAIN,
+		      "a delivered event should not be reported again");
+	zassert_ok(k_sem_take(&set_sems[1], K_NO_WAIT));
+
+	set_events_remove();
+}
+
+/**
+ * @brief Test that a persistent poll set event stays armed
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add_persistent(), k_poll_set_wait(), k_poll_set_remove()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_persistent)
+{
+	struct k_poll_event *ready[NUM_SET_EVENTS];
+
+	set_events_init(true);
+
+	for (int round = 0; round < 3; round++) {
+		k_sem_give(&set_sems[0]);
+		k_sem_give(&set_sems[2]);
+
+		zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), 2,
+			      "two events should be ready in round %d", round);
+		zassert_equal_ptr(ready[0], &set_events[0], "wrong first event");
+		zassert_equal_ptr(ready[1], &set_events[2], "wrong second event");
+
+		for (int i = 0; i < 2; i++) {
+			zassert_equal(k_poll_set_state_take(&set, ready[i]),
+				      K_POLL_STATE_SEM_AVAILABLE, "wrong state");
+			zassert_equal(ready[i]->state, K_POLL_STATE_NOT_READY,
+				      "state should be cleared");
+		}
+
+		zassert_ok(k_sem_take(&set_sems[0], K_NO_WAIT));
+		zassert_ok(k_sem_take(&set_sems[2], K_NO_WAIT));
+
+		zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), -EAGAIN,
+			      "nothing should be left ready");
+	}
+
+	/* Removed events are not reported anymore */
+	k_poll_set_remove(&set, &set_events[0]);
+	k_sem_give(&set_sems[0]);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_NO_WAIT), -EAGAIN,
+		      "a removed event should not be reported");
+	zassert_ok(k_sem_take(&set_sems[0], K_NO_WAIT));
+
+	set_events_remove();
+}
+
+static struct k_thread set_thread;
+static K_THREAD_STACK_DEFINE(set_stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+
+static void set_giver(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	int rounds = POINTER_TO_INT(p1);
+
+	for (int i = 0; i < rounds; i++) {
+		k_sleep(K_MSEC(1));
+		k_sem_give(&set_sems[i % NUM_SET_EVENTS]);
+	}
+}
+
+/**
+ * @brief Test waiting repeatedly on a persistent poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add_persistent(), k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_persistent_wait)
+{
+	struct k_poll_event *ready[NUM_SET_EVENTS];
+	int rounds = 3 * NUM_SET_EVENTS;
+	int ret;
+
+	set_events_init(true);
+
+	k_thread_create(&set_thread, set_stack, K_THREAD_STACK_SIZEOF(set_stack),
+			set_giver, INT_TO_POINTER(rounds), NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	for (int i = 0; i < rounds; i++) {
+		ret = k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_MSEC(1000));
+		zassert_equal(ret, 1, "one event should be ready in round %d", i);
+		zassert_equal_ptr(ready[0], &set_events[i % NUM_SET_EVENTS], "wrong event");
+
+		(void)k_poll_set_state_take(&set, ready[0]);
+		zassert_ok(k_sem_take(&set_sems[i % NUM_SET_EVENTS], K_NO_WAIT));
+	}
+
+	k_thread_join(&set_thread, K_FOREVER);
+
+	set_events_remove();
+}
+
+static bool poller_stop;
+
+static void sem_poller(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct k_sem *sem = p1;
+	struct k_poll_event event;
+
+	while (!poller_stop) {
+		k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, sem);
+
+		(void)k_poll(&event, 1, K_FOREVER);
+		(void)k_sem_take(sem, K_NO_WAIT);
+	}
+}
+
+/**
+ * @brief Test that a poll set is signalled while a thread keeps polling the
+ * same object
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add_persistent(), k_poll_set_wait(), k_poll()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_shared_with_thread)
+{
+	struct k_poll_event *ready[NUM_SET_EVENTS];
+	int rounds = 3;
+
+	set_events_init(true);
+	poller_stop = false;
+
+	k_thread_create(&set_thread, set_stack, K_THREAD_STACK_SIZEOF(set_stack),
+			sem_poller, &set_sems[0], NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the thread register on the semaphore ahead of the set */
+	k_sleep(K_MSEC(10));
+
+	for (int i = 0; i < rounds; i++) {
+		k_sem_give(&set_sems[0]);
+
+		zassert_equal(k_poll_set_wait(&set, ready, NUM_SET_EVENTS, K_MSEC(100)), 1,
+			      "set not signalled in round %d", i);
+		zassert_equal_ptr(ready[0], &set_events[0], "wrong event");
+		(void)k_poll_set_state_take(&set, ready[0]);
+
+		/* The thread takes the semaphore and polls it again */
+		k_sleep(K_MSEC(1));
+	}
+
+	poller_stop = true;
+	k_sem_give(&set_sems[0]);
+	k_thread_join(&set_thread, K_FOREVER);
+
+	set_events_remove();
+}
@@ -541,5 +541,89 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+#define LATENCY_WAKEUPS 10
+
+static K_SEM_DEFINE(latency_sem, 0, 1);
+
+/**
+ * @brief Helper thread to test_thread_stats_latency()
+ */
+void latency_helper(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < LATENCY_WAKEUPS; i++) {
+		k_sem_take(&latency_sem, K_FOREVER);
+	}
+}
+
+/**
+ * @brief Check that a latency distribution is consistent
+ */
+static void latency_check(const char *str, const struct k_latency_stats *stats,
+			  uint32_t count)
+{
+	uint32_t in_buckets = 0U;
+
+	zassert_true(stats->count >= count, "%s: %u latencies, expected %u",
+		     str, stats->count, count);
+
+	for (int i = 0; i < CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS; i++) {
+		in_buckets += stats->buckets[i];
+	}
+
+	zassert_equal(in_buckets, stats->count, "%s: %u in buckets, not %u",
+		      str, in_buckets, stats->count);
+	zassert_true(stats->min <= stats->max, "%s: min above max", str);
+	zassert_true(stats->total >= stats->max, "%s: total below max", str);
+	zassert_true(k_latency_stats_percentile(stats, 50) <=
+		     k_latency_stats_percentile(stats, 99), "%s: p50 above p99", str);
+	zassert_equal(k_latency_stats_percentile(stats, 100), stats->max,
+		      "%s: p100 is not max", str);
+}
+
+/**
+ * @brief Test the scheduling latency histograms
+ *
+ * A higher priority helper thread is woken up several times by the main
+ * thread, which it preempts every time. Both the wakeups of the helper and
+ * the preemptions of the main thread must be recorded, per thread and for
+ * the CPU.
+ */
+ZTEST(usage_api, test_thread_stats_latency)
+{
+	k_thread_runtime_stats_t  main_stats;
+	k_thread_runtime_stats_t  helper_stats;
+	k_thread_runtime_stats_t  cpu_stats;
+	int  priority;
+	k_tid_t  tid;
+
+	main_thread = k_current_get();
+	priority = k_thread_priority_get(main_thread);
+	k_thread_priority_set(main_thread, K_PRIO_PREEMPT(5));
+
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      latency_helper, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(4), 0, K_NO_WAIT);
+
+	for (int i = 0; i < LATENCY_WAKEUPS; i++) {
+		k_sem_give(&latency_sem);
+	}
+
+	k_thread_join(tid, K_FOREVER);
+
+	k_thread_runtime_stats_get(main_thread, &main_stats);
+	k_thread_runtime_stats_get(tid, &helper_stats);
+	k_thread_runtime_stats_cpu_get(0, &cpu_stats);
+
+	latency_check("helper wakeup", &helper_stats.wakeup_latency, LATENCY_WAKEUPS);
+	latency_check("main preempt", &main_stats.preempt_latency, LATENCY_WAKEUPS);
+	latency_check("CPU wakeup", &cpu_stats.wakeup_latency, LATENCY_WAKEUPS);
+	latency_check("CPU preempt", &cpu_stats.preempt_latency, LATENCY_WAKEUPS);
+
+	k_thread_priority_set(main_thread, priority);
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 ZTEST_SUITE(usage_api, NULL, NULL,
 		ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
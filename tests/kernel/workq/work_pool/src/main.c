@@ -0,0 +1,269 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define NUM_WORKERS 4
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKER_PRIORITY K_PRIO_PREEMPT(1)
+
+#define NUM_ITEMS 16
+
+K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_work_q_worker pool_workers[NUM_WORKERS];
+static struct k_work_q pool;
+
+static struct k_work items[NUM_ITEMS];
+static struct k_work self_work;
+
+/* Work synchronization objects must be in cache-coherent memory,
+ * which excludes stacks on some architectures.
+ */
+static struct k_work_sync work_sync;
+
+static K_SEM_DEFINE(started_sem, 0, NUM_ITEMS);
+static K_SEM_DEFINE(release_sem, 0, NUM_ITEMS);
+
+static atomic_t executed;
+static atomic_t active;
+static atomic_t max_active;
+
+static void reset_counters(void)
+{
+	atomic_clear(&executed);
+	atomic_clear(&active);
+	atomic_clear(&max_active);
+	k_sem_reset(&started_sem);
+	k_sem_reset(&release_sem);
+	(void)k_work_queue_pool_stats_reset(&pool);
+}
+
+static void track_enter(void)
+{
+	atomic_val_t now = atomic_inc(&active) + 1;
+	atomic_val_t max = atomic_get(&max_active);
+
+	while ((now > max) && !atomic_cas(&max_active, max, now)) {
+		max = atomic_get(&max_active);
+	}
+}
+
+static void track_exit(void)
+{
+	atomic_dec(&active);
+	atomic_inc(&executed);
+}
+
+static void count_handler(struct k_work *work)
+{
+	atomic_inc(&executed);
+}
+
+static void blocking_handler(struct k_work *work)
+{
+	track_enter();
+	k_sem_give(&started_sem);
+	k_sem_take(&release_sem, K_FOREVER);
+	track_exit();
+}
+
+static void sleeping_handler(struct k_work *work)
+{
+	track_enter();
+	k_sleep(K_MSEC(10));
+	track_exit();
+}
+
+static uint32_t stats_sum_executed(uint32_t *stolen)
+{
+	struct k_work_q_worker_stats stats;
+	uint32_t sum = 0;
+
+	*stolen = 0;
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_ok(k_work_queue_pool_stats_get(&pool, i, &stats));
+		sum += stats.executed;
+		*stolen += stats.stolen;
+	}
+
+	return sum;
+}
+
+/* All the workers can run items at the same time. */
+ZTEST(work_pool, test_parallel)
+{
+	reset_counters();
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_work_init(&items[i], blocking_handler);
+		zassert_equal(k_work_submit_to_queue(&pool, &items[i]), 1);
+	}
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_ok(k_sem_take(&started_sem, K_SECONDS(1)),
+			   "only %d items started", i);
+	}
+	zassert_equal(atomic_get(&max_active), NUM_WORKERS);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_sem_give(&release_sem);
+	}
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		(void)k_work_flush(&items[i], &work_sync);
+		zassert_false(k_work_is_pending(&items[i]));
+	}
+	zassert_equal(atomic_get(&executed), NUM_WORKERS);
+}
+
+/* An item resubmitted while running waits for the run to complete. */
+ZTEST(work_pool, test_no_self_concurrency)
+{
+	reset_counters();
+
+	k_work_init(&self_work, sleeping_handler);
+
+	for (int i = 0; i < 10; i++) {
+		zassert_true(k_work_submit_to_queue(&pool, &self_work) >= 0);
+		k_sleep(K_MSEC(3));
+	}
+
+	(void)k_work_flush(&self_work, &work_sync);
+	zassert_false(k_work_is_pending(&self_work));
+	zassert_equal(atomic_get(&max_active), 1, "item ran concurrently with itself");
+	zassert_true(atomic_get(&executed) >= 2);
+}
+
+/* Flush and cancel wait for the worker running the item. */
+ZTEST(work_pool, test_flush_cancel_sync)
+{
+	reset_counters();
+
+	k_work_init(&self_work, sleeping_handler);
+
+	zassert_equal(k_work_submit_to_queue(&pool, &self_work), 1);
+	zassert_true(k_work_flush(&self_work, &work_sync));
+	zassert_equal(atomic_get(&executed), 1);
+	zassert_false(k_work_is_pending(&self_work));
+
+	zassert_equal(k_work_submit_to_queue(&pool, &self_work), 1);
+	k_sleep(K_MSEC(2));
+	zassert_equal(k_work_busy_get(&self_work), K_WORK_RUNNING);
+	zassert_true(k_work_cancel_sync(&self_work, &work_sync));
+	zassert_false(k_work_is_pending(&self_work));
+	zassert_equal(atomic_get(&active), 0);
+	zassert_equal(atomic_get(&executed), 2);
+}
+
+/* A queued item can be canceled before any worker picks it up. */
+ZTEST(work_pool, test_cancel_queued)
+{
+	reset_counters();
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_work_init(&items[i], blocking_handler);
+		zassert_equal(k_work_submit_to_queue(&pool, &items[i]), 1);
+	}
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_ok(k_sem_take(&started_sem, K_SECONDS(1)));
+	}
+
+	/* All the workers are busy, so this one stays queued. */
+	k_work_init(&self_work, count_handler);
+	zassert_equal(k_work_submit_to_queue(&pool, &self_work), 1);
+	zassert_equal(k_work_busy_get(&self_work), K_WORK_QUEUED);
+	zassert_equal(k_work_cancel(&self_work), 0);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_sem_give(&release_sem);
+	}
+	(void)k_work_queue_drain(&pool, false);
+	zassert_equal(atomic_get(&executed), NUM_WORKERS);
+}
+
+static void chaining_handler(struct k_work *work)
+{
+	/* Items submitted from a worker go to its local queue, the idle
+	 * workers have to steal them.
+	 */
+	for (int i = 1; i < NUM_ITEMS; i++) {
+		zassert_equal(k_work_submit_to_queue(&pool, &items[i]), 1);
+	}
+
+	k_sleep(K_MSEC(20));
+	atomic_inc(&executed);
+}
+
+/* Idle workers steal from busy ones, drain waits for all of them. */
+ZTEST(work_pool, test_steal_and_drain)
+{
+	uint32_t stolen;
+
+	reset_counters();
+
+	k_work_init(&items[0], chaining_handler);
+	for (int i = 1; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], count_handler);
+	}
+
+	zassert_equal(k_work_submit_to_queue(&pool, &items[0]), 1);
+	(void)k_work_queue_drain(&pool, true);
+	zassert_equal(atomic_get(&executed), NUM_ITEMS);
+
+	/* Plugged: submissions are rejected until unplugged. */
+	zassert_equal(k_work_submit_to_queue(&pool, &items[1]), -EBUSY);
+	zassert_ok(k_work_queue_unplug(&pool));
+
+	zassert_equal(stats_sum_executed(&stolen), NUM_ITEMS);
+	zassert_true(stolen > 0, "no item was stolen");
+}
+
+/* Items submitted from outside are spread over all the workers. */
+ZTEST(work_pool, test_stats)
+{
+	struct k_work_q_worker_stats stats;
+	uint32_t stolen;
+
+	reset_counters();
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], sleeping_handler);
+		zassert_equal(k_work_submit_to_queue(&pool, &items[i]), 1);
+	}
+	(void)k_work_queue_drain(&pool, false);
+
+	zassert_equal(stats_sum_executed(&stolen), NUM_ITEMS);
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_ok(k_work_queue_pool_stats_get(&pool, i, &stats));
+		zassert_true(stats.executed > 0, "worker %d did not run any item", i);
+		zassert_equal(stats.depth, 0);
+		zassert_true(stats.max_depth > 0);
+		zassert_true(stats.max_run_cycles > 0);
+		zassert_true(stats.total_run_cycles >= stats.max_run_cycles);
+	}
+
+	zassert_equal(k_work_queue_pool_stats_get(&pool, NUM_WORKERS, &stats), -EINVAL);
+	zassert_equal(k_work_queue_pool_stats_get(&k_sys_work_q, 0, &stats), -EINVAL);
+}
+
+static void *work_pool_setup(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "wq.pool",
+		.pin_workers = IS_ENABLED(CONFIG_SCHED_CPU_MASK),
+	};
+
+	k_work_queue_init(&pool);
+	k_work_queue_pool_start(&pool, pool_workers, pool_stacks[0], NUM_WORKERS,
+				STACK_SIZE, WORKER_PRIORITY, &cfg);
+
+	zassert_equal(k_work_queue_thread_get(&pool), &pool_workers[0].thread);
+
+	return NULL;
+}
+
+ZTEST_SUITE(work_pool, NULL, work_pool_setup, NULL, NULL, NULL);
@@ -0,0 +1,219 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zvfs/epoll.h>
+#include <zephyr/zvfs/eventfd.h>
+
+int zvfs_close(int fd);
+
+static int epfd = -1;
+static int efd = -1;
+
+static void epoll_add(int fd, uint32_t events, uint32_t data)
+{
+	struct zvfs_epoll_event ev = {
+		.events = events,
+		.data.u32 = data,
+	};
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, fd, &ev), "add failed (%d)", errno);
+}
+
+static void epoll_mod(int fd, uint32_t events, uint32_t data)
+{
+	struct zvfs_epoll_event ev = {
+		.events = events,
+		.data.u32 = data,
+	};
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_MOD, fd, &ev), "mod failed (%d)", errno);
+}
+
+/* Returns the number of ready fds, the first one is checked against @p data */
+static int epoll_check(uint32_t data, int timeout)
+{
+	struct zvfs_epoll_event ev[2];
+	int ret;
+
+	ret = zvfs_epoll_wait(epfd, ev, ARRAY_SIZE(ev), timeout);
+	zassert_true(ret >= 0, "wait failed (%d)", errno);
+
+	if (ret > 0) {
+		zassert_equal(ev[0].events, ZVFS_EPOLLIN, "wrong events 0x%x", ev[0].events);
+		zassert_equal(ev[0].data.u32, data, "wrong data %u", ev[0].data.u32);
+	}
+
+	return ret;
+}
+
+static void efd_write(void)
+{
+	zassert_ok(zvfs_eventfd_write(efd, 1));
+}
+
+static void efd_read(void)
+{
+	zvfs_eventfd_t val;
+
+	zassert_ok(zvfs_eventfd_read(efd, &val));
+}
+
+ZTEST(epoll, test_epoll_ctl)
+{
+	struct zvfs_epoll_event ev = {
+		.events = ZVFS_EPOLLIN,
+	};
+
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_MOD, efd, &ev), -1);
+	zassert_equal(errno, ENOENT);
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, efd, NULL), -1);
+	zassert_equal(errno, ENOENT);
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, epfd, &ev), -1);
+	zassert_equal(errno, EINVAL);
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, -1, &ev), -1);
+	zassert_equal(errno, EBADF);
+
+	epoll_add(efd, ZVFS_EPOLLIN, 1);
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, efd, &ev), -1);
+	zassert_equal(errno, EEXIST);
+
+	efd_write();
+	zassert_equal(epoll_check(1, 0), 1, "fd not reported");
+
+	/* The new user data is returned from now on */
+	epoll_mod(efd, ZVFS_EPOLLIN, 2);
+	zassert_equal(epoll_check(2, 0), 1, "fd not reported after mod");
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, efd, NULL));
+	zassert_equal(epoll_check(0, 0), 0, "removed fd reported");
+}
+
+ZTEST(epoll, test_epoll_level_triggered)
+{
+	epoll_add(efd, ZVFS_EPOLLIN, 1);
+
+	zassert_equal(epoll_check(1, 0), 0, "fd reported before a write");
+
+	efd_write();
+
+	/* Reported for as long as it can be read */
+	zassert_equal(epoll_check(1, 0), 1, "fd not reported");
+	zassert_equal(epoll_check(1, 0), 1, "fd not reported again");
+
+	efd_read();
+	zassert_equal(epoll_check(1, 0), 0, "fd reported after a read");
+}
+
+ZTEST(epoll, test_epoll_edge_triggered)
+{
+	epoll_add(efd, ZVFS_EPOLLIN | ZVFS_EPOLLET, 1);
+
+	efd_write();
+	zassert_equal(epoll_check(1, 0), 1, "fd not reported");
+
+	/* Still readable, but nothing happened since */
+	zassert_equal(epoll_check(1, 0), 0, "fd reported without a new write");
+
+	efd_write();
+	zassert_equal(epoll_check(1, 0), 1, "fd not reported on a new write");
+
+	efd_read();
+	zassert_equal(epoll_check(1, 0), 0, "fd reported after a read");
+}
+
+ZTEST(epoll, test_epoll_oneshot)
+{
+	epoll_add(efd, ZVFS_EPOLLIN | ZVFS_EPOLLONESHOT, 1);
+
+	efd_write();
+	zassert_equal(epoll_check(1, 0), 1, "fd not reported");
+
+	/* Disabled once reported, even on new writes */
+	zassert_equal(epoll_check(1, 0), 0, "disabled fd reported");
+	efd_write();
+	zassert_equal(epoll_check(1, 0), 0, "disabled fd reported on a write");
+
+	/* Re-armed by a modification, and reported once more */
+	epoll_mod(efd, ZVFS_EPOLLIN | ZVFS_EPOLLONESHOT, 2);
+	zassert_equal(epoll_check(2, 0), 1, "re-armed fd not reported");
+	zassert_equal(epoll_check(2, 0), 0, "disabled fd reported");
+}
+
+ZTEST(epoll, test_epoll_close_registered)
+{
+	epoll_add(efd, ZVFS_EPOLLIN, 1);
+	efd_write();
+
+	/* Closing the fd drops it from the interest set */
+	zassert_ok(zvfs_close(efd));
+	zassert_equal(epoll_check(1, 0), 0, "closed fd reported");
+
+	efd = zvfs_eventfd(0, 0);
+	zassert_true(efd >= 0, "eventfd failed (%d)", errno);
+
+	/* A new fd with the same number is not in the set */
+	epoll_add(efd, ZVFS_EPOLLIN, 2);
+	zassert_equal(epoll_check(2, 0), 0, "new fd reported");
+}
+
+static struct k_thread writer_thread;
+static K_THREAD_STACK_DEFINE(writer_stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+
+static void writer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sleep(K_MSEC(10));
+	(void)zvfs_eventfd_write(efd, 1);
+}
+
+ZTEST(epoll, test_epoll_wait_blocking)
+{
+	epoll_add(efd, ZVFS_EPOLLIN, 1);
+
+	zassert_equal(epoll_check(1, 10), 0, "fd reported before a write");
+
+	k_thread_create(&writer_thread, writer_stack, K_THREAD_STACK_SIZEOF(writer_stack),
+			writer, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(epoll_check(1, 1000), 1, "fd not reported");
+
+	zassert_ok(k_thread_join(&writer_thread, K_FOREVER));
+}
+
+static void epoll_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	epfd = zvfs_epoll_create(0);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	efd = zvfs_eventfd(0, 0);
+	zassert_true(efd >= 0, "eventfd failed (%d)", errno);
+}
+
+static void epoll_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	if (efd >= 0) {
+		(void)zvfs_close(efd);
+		efd = -1;
+	}
+
+	if (epfd >= 0) {
+		(void)zvfs_close(epfd);
+		epfd = -1;
+	}
+}
+
+ZTEST_SUITE(epoll, NULL, NULL, epoll_before, epoll_after, NULL);
@@ -0,0 +1,193 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/irq_offload.h>
+#include <zephyr/sys/mpmc.h>
+
+#define MPMC_SIZE 4
+
+SYS_MPMC_DEFINE(mpmc_q, sizeof(uint32_t), MPMC_SIZE);
+
+static void mpmc_drain(void)
+{
+	uint32_t val;
+
+	while (sys_mpmc_get(&mpmc_q, &val, K_NO_WAIT) == 0) {
+	}
+}
+
+/*
+ * @brief Fill and empty the ring a few times to cover wrapping around
+ *
+ * @see sys_mpmc_put(), sys_mpmc_get(), sys_mpmc_num_used_get()
+ *
+ * @ingroup tests
+ */
+ZTEST(mpmc, test_put_get_wrap_around)
+{
+	uint32_t val;
+
+	for (uint32_t lap = 0; lap < 3; lap++) {
+		for (uint32_t i = 0; i < MPMC_SIZE; i++) {
+			val = lap * MPMC_SIZE + i;
+			zassert_ok(sys_mpmc_put(&mpmc_q, &val, K_NO_WAIT), "put should succeed");
+		}
+
+		zassert_equal(sys_mpmc_num_used_get(&mpmc_q), MPMC_SIZE, "ring should be full");
+		zassert_equal(sys_mpmc_put(&mpmc_q, &val, K_NO_WAIT), -ENOMSG,
+			      "put should fail when full");
+		zassert_equal(sys_mpmc_put(&mpmc_q, &val, K_MSEC(10)), -EAGAIN,
+			      "put should time out when full");
+
+		for (uint32_t i = 0; i < MPMC_SIZE; i++) {
+			zassert_ok(sys_mpmc_get(&mpmc_q, &val, K_NO_WAIT), "get should succeed");
+			zassert_equal(val, lap * MPMC_SIZE + i, "elements should be in order");
+		}
+
+		zassert_equal(sys_mpmc_num_used_get(&mpmc_q), 0, "ring should be empty");
+		zassert_equal(sys_mpmc_get(&mpmc_q, &val, K_NO_WAIT), -ENOMSG,
+			      "get should fail when empty");
+	}
+
+	zassert_equal(sys_mpmc_get(&mpmc_q, &val, K_MSEC(10)), -EAGAIN,
+		      "get should time out when empty");
+}
+
+/*
+ * @brief Check the parameters sys_mpmc_init() refuses
+ *
+ * @see sys_mpmc_init()
+ *
+ * @ingroup tests
+ */
+ZTEST(mpmc, test_init)
+{
+	static atomic_t buf[SYS_MPMC_BUF_SIZE(sizeof(uint64_t), 8) / sizeof(atomic_t)];
+	struct sys_mpmc ring;
+	uint64_t val = 0x0123456789abcdefULL;
+	uint64_t out;
+
+	zassert_equal(sys_mpmc_init(&ring, buf, sizeof(val), 1), -EINVAL,
+		      "a single slot should be refused");
+	zassert_equal(sys_mpmc_init(&ring, buf, sizeof(val), 6), -EINVAL,
+		      "a size that isn't a power of two should be refused");
+	zassert_equal(sys_mpmc_init(&ring, buf, 0, 8), -EINVAL,
+		      "empty elements should be refused");
+	zassert_ok(sys_mpmc_init(&ring, buf, sizeof(val), 8), "init should succeed");
+
+	zassert_ok(sys_mpmc_put(&ring, &val, K_NO_WAIT), "put should succeed");
+	zassert_ok(sys_mpmc_get(&ring, &out, K_NO_WAIT), "get should succeed");
+	zassert_equal(out, val, "element should be copied whole");
+}
+
+static void mpmc_isr(const void *arg)
+{
+	uint32_t val = POINTER_TO_UINT(arg);
+
+	zassert_ok(sys_mpmc_put(&mpmc_q, &val, K_NO_WAIT), "put from ISR should succeed");
+}
+
+/*
+ * @brief Put an element from an ISR and get it from a thread
+ *
+ * @see sys_mpmc_put(), sys_mpmc_get()
+ *
+ * @ingroup tests
+ */
+ZTEST(mpmc, test_put_from_isr)
+{
+	uint32_t val;
+
+	mpmc_drain();
+
+	irq_offload(mpmc_isr, UINT_TO_POINTER(0x55aa));
+
+	zassert_ok(sys_mpmc_get(&mpmc_q, &val, K_FOREVER), "get should succeed");
+	zassert_equal(val, 0x55aa, "element should come from the ISR");
+}
+
+#define MPMC_PRODUCERS 2
+#define MPMC_CONSUMERS 2
+#define MPMC_THREADS_NUM (MPMC_PRODUCERS + MPMC_CONSUMERS)
+#define MPMC_ITERATIONS 1000
+#define MPMC_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_thread mpmc_thread[MPMC_THREADS_NUM];
+static K_THREAD_STACK_ARRAY_DEFINE(mpmc_stack, MPMC_THREADS_NUM, MPMC_STACK_SIZE);
+
+/* Times each element was received, elements are (producer << 16) | count */
+static atomic_t mpmc_seen[MPMC_PRODUCERS][MPMC_ITERATIONS];
+
+static void mpmc_producer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	uint32_t id = POINTER_TO_UINT(p1);
+	uint32_t val;
+
+	for (uint32_t i = 0; i < MPMC_ITERATIONS; i++) {
+		val = (id << 16) | i;
+		zassert_ok(sys_mpmc_put(&mpmc_q, &val, K_FOREVER), "put should succeed");
+	}
+}
+
+static void mpmc_consumer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	uint32_t val;
+
+	for (uint32_t i = 0; i < MPMC_ITERATIONS * MPMC_PRODUCERS / MPMC_CONSUMERS; i++) {
+		zassert_ok(sys_mpmc_get(&mpmc_q, &val, K_FOREVER), "get should succeed");
+		zassert_true((val >> 16) < MPMC_PRODUCERS, "bad producer");
+		zassert_true((val & 0xffff) < MPMC_ITERATIONS, "bad count");
+
+		(void)atomic_inc(&mpmc_seen[val >> 16][val & 0xffff]);
+	}
+}
+
+/**
+ * @brief Test that every element gets through exactly once with several
+ * producers and consumers blocking on a small ring
+ *
+ * This can and should be validated on SMP machines where incoherent
+ * memory could cause issues.
+ */
+ZTEST(mpmc, test_mpmc_threaded)
+{
+	mpmc_drain();
+	memset(mpmc_seen, 0, sizeof(mpmc_seen));
+
+	for (int i = 0; i < MPMC_THREADS_NUM; i++) {
+		bool producer = i < MPMC_PRODUCERS;
+
+		k_thread_create(&mpmc_thread[i], mpmc_stack[i], MPMC_STACK_SIZE,
+				producer ? mpmc_producer : mpmc_consumer,
+				UINT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(5), K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < MPMC_THREADS_NUM; i++) {
+		k_thread_join(&mpmc_thread[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < MPMC_PRODUCERS; i++) {
+		for (int j = 0; j < MPMC_ITERATIONS; j++) {
+			zassert_equal(atomic_get(&mpmc_seen[i][j]), 1,
+				      "element %d of producer %d seen %ld times", j, i,
+				      (long)atomic_get(&mpmc_seen[i][j]));
+		}
+	}
+
+	zassert_equal(sys_mpmc_num_used_get(&mpmc_q), 0, "ring should be empty");
+}
+
+ZTEST_SUITE(mpmc, NULL, NULL, NULL, NULL, NULL);
@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_test, LOG_LEVEL_DBG);
 #include <zephyr/kernel.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/net/coap.h>
+#include <zephyr/net_buf.h>
 
 #include <zephyr/tc_util.h>
 #include <zephyr/ztest.h>
@@ -1855,4 +1856,127 @@ ZTEST(coap, test_age_is_newer)
 		     "Max age should be marked as newer");
 }
 
+static void assert_find_option(const struct coap_packet *cpkt, uint16_t code,
+			       const char *value)
+{
+	struct coap_option options[2] = {};
+	int r;
+
+	r = coap_find_options(cpkt, code, options, ARRAY_SIZE(options));
+	zassert_equal(r, 1, "Unexpected number of options %d", r);
+	zassert_equal(options[0].delta, code, "Wrong option code");
+	zassert_equal(options[0].len, strlen(value), "Wrong option length");
+	zassert_mem_equal(options[0].value, value, strlen(value), "Wrong option value");
+}
+
+ZTEST(coap, test_find_options_after_changes)
+{
+	struct coap_option options[4] = {};
+	struct coap_packet parsed;
+	struct coap_packet cpkt;
+	uint8_t *data = data_buf[0];
+	int r;
+
+	init_basic_test_msg(&cpkt, data);
+
+	r = coap_find_options(&cpkt, COAP_OPTION_URI_QUERY, options, ARRAY_SIZE(options));
+	zassert_equal(r, 2, "Unexpected number of options %d", r);
+	zassert_mem_equal(options[0].value, "query0", options[0].len, "Wrong first query");
+	zassert_mem_equal(options[1].value, "query1", options[1].len, "Wrong second query");
+
+	/* Only as many options as there is room for */
+	r = coap_find_options(&cpkt, COAP_OPTION_URI_QUERY, options, 1);
+	zassert_equal(r, 1, "Unexpected number of options %d", r);
+
+	zassert_equal(coap_get_option_int(&cpkt, COAP_OPTION_ACCEPT),
+		      COAP_CONTENT_FORMAT_APP_CBOR, "Wrong accept option");
+	zassert_equal(coap_get_option_int(&cpkt, COAP_OPTION_SIZE1), 64, "Wrong size1 option");
+	zassert_equal(coap_get_option_int(&cpkt, COAP_OPTION_ETAG), -ENOENT,
+		      "Unexpected etag option");
+
+	/* Options added out of order and removed options are found as well */
+	r = coap_packet_append_option(&cpkt, COAP_OPTION_IF_MATCH, "tag", strlen("tag"));
+	zassert_equal(r, 0, "Could not append option");
+	assert_find_option(&cpkt, COAP_OPTION_IF_MATCH, "tag");
+	assert_find_option(&cpkt, COAP_OPTION_URI_HOST, "hostname");
+
+	r = coap_packet_remove_option(&cpkt, COAP_OPTION_URI_HOST);
+	zassert_equal(r, 0, "Could not remove option");
+	r = coap_find_options(&cpkt, COAP_OPTION_URI_HOST, options, ARRAY_SIZE(options));
+	zassert_equal(r, 0, "Removed option found");
+	assert_find_option(&cpkt, COAP_OPTION_URI_PATH, "path");
+
+	/* The same options are found once the packet is parsed */
+	r = coap_packet_parse(&parsed, cpkt.data, cpkt.offset, NULL, 0);
+	zassert_equal(r, 0, "Could not parse packet");
+	assert_find_option(&parsed, COAP_OPTION_IF_MATCH, "tag");
+	assert_find_option(&parsed, COAP_OPTION_URI_PATH, "path");
+	zassert_equal(coap_get_option_int(&parsed, COAP_OPTION_MAX_AGE), 3,
+		      "Wrong max age option");
+	r = coap_find_options(&parsed, COAP_OPTION_URI_QUERY, options, ARRAY_SIZE(options));
+	zassert_equal(r, 2, "Unexpected number of options %d", r);
+}
+
+NET_BUF_POOL_DEFINE(coap_test_buf_pool, 2, COAP_BUF_SIZE, 0, NULL);
+
+ZTEST(coap, test_net_buf_build_and_parse)
+{
+	static const char token[] = "token";
+	static const uint8_t payload[] = { 0xde, 0xad, 0xbe, 0xef };
+	struct coap_packet request;
+	struct coap_packet cpkt;
+	struct net_buf *frag;
+	struct net_buf *buf;
+	const uint8_t *data;
+	uint16_t len;
+	int r;
+
+	buf = net_buf_alloc(&coap_test_buf_pool, K_NO_WAIT);
+	zassert_not_null(buf, "Could not allocate buffer");
+
+	/* Leave room in front, as for the headers of lower layers */
+	net_buf_reserve(buf, 8);
+
+	r = coap_packet_init_net_buf(&request, buf, COAP_VERSION_1, COAP_TYPE_CON,
+				     strlen(token), token, COAP_METHOD_GET, 0x1234);
+	zassert_equal(r, 0, "Could not initialize packet");
+	zassert_equal_ptr(request.data, buf->data, "Packet not built in the buffer");
+
+	r = coap_packet_set_path(&request, "3/0/0");
+	zassert_equal(r, 0, "Could not append path");
+	r = coap_append_option_int(&request, COAP_OPTION_ACCEPT, COAP_CONTENT_FORMAT_APP_CBOR);
+	zassert_equal(r, 0, "Could not append option");
+	r = coap_packet_append_payload_marker(&request);
+	zassert_equal(r, 0, "Could not append payload marker");
+	r = coap_packet_append_payload(&request, payload, sizeof(payload));
+	zassert_equal(r, 0, "Could not append payload");
+
+	zassert_equal(buf->len, 0, "Packet added before commit");
+	r = coap_packet_net_buf_commit(&request, buf);
+	zassert_equal(r, 0, "Could not commit packet");
+	zassert_equal(buf->len, request.offset, "Packet not added to the buffer");
+
+	r = coap_packet_parse_net_buf(&cpkt, buf, NULL, 0);
+	zassert_equal(r, 0, "Could not parse packet");
+	zassert_equal_ptr(cpkt.data, buf->data, "Packet was copied");
+	zassert_equal(coap_header_get_id(&cpkt), 0x1234, "Wrong message id");
+	zassert_equal(coap_get_option_int(&cpkt, COAP_OPTION_ACCEPT),
+		      COAP_CONTENT_FORMAT_APP_CBOR, "Wrong accept option");
+
+	data = coap_packet_get_payload(&cpkt, &len);
+	zassert_equal(len, sizeof(payload), "Wrong payload length");
+	zassert_mem_equal(data, payload, sizeof(payload), "Wrong payload");
+
+	/* A packet split over fragments cannot be used in place */
+	frag = net_buf_alloc(&coap_test_buf_pool, K_NO_WAIT);
+	zassert_not_null(frag, "Could not allocate fragment");
+	net_buf_add_u8(frag, 0);
+	net_buf_frag_add(buf, frag);
+
+	r = coap_packet_parse_net_buf(&cpkt, buf, NULL, 0);
+	zassert_equal(r, -EMSGSIZE, "Fragmented packet parsed in place");
+
+	net_buf_unref(buf);
+}
+
 ZTEST_SUITE(coap, NULL, NULL, NULL, NULL, NULL);
@@ -133,3 +133,55 @@ ZTEST(net_dns_cache_test, test_expired_entries_removed)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, info_read, 3));
 	zassert_equal(AF_INET, info_read[0].ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	zassert_equal(-ENOENT, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example2.com", &info_read, 1));
+
+	/* An address replaces the negative entry */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_many_queries)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	char query[sizeof("host-00.example.com")];
+
+	/* Queries get distinct TTLs, so the ones expiring first get replaced */
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE * 2; i++) {
+		snprintk(query, sizeof(query), "host-%02u.example.com", (unsigned int)i);
+		info_write.ai_addrlen = i;
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL + TEST_DNS_CACHE_SIZE * 2 - i),
+			   "Cache entry adding should work.");
+	}
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE * 2; i++) {
+		bool cached = i < TEST_DNS_CACHE_SIZE - 1 || i == TEST_DNS_CACHE_SIZE * 2 - 1;
+
+		snprintk(query, sizeof(query), "host-%02u.example.com", (unsigned int)i);
+		zassert_equal(cached ? 1 : 0,
+			      dns_cache_find(&test_dns_cache, query, &info_read, 1),
+			      "Unexpected lookup result for %s", query);
+		if (cached) {
+			zassert_equal(i, info_read.ai_addrlen);
+		}
+	}
+}
@@ -345,6 +345,27 @@ ZTEST(http_service, test_HTTP_RESOURCE_WILDCARD)
 	zassert_not_null(res, "Cannot find resource");
 	zassert_true(len > 0, "Length not set");
 	zassert_equal(res, RES(5), "Resource mismatch");
+
+	res = CHECK_PATH("/index.html?lang=en", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/index.html"), "Length mismatch");
+	zassert_equal(res, RES(1), "Resource mismatch");
+
+	res = CHECK_PATH("/bar/baz.php/extra", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/bar/baz.php"), "Length mismatch");
+	zassert_equal(res, RES(3), "Resource mismatch");
+
+	/* The websocket resource of service B is skipped for "/fo*" */
+	res = CHECK_PATH("/foo.htm", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/fo*"), "Length mismatch");
+	zassert_equal(res, RES(1), "Resource mismatch");
+
+	res = get_resource_detail("/foo.htm", &len, true);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/foo.htm"), "Length mismatch");
+	zassert_equal(res, RES(2), "Resource mismatch");
 }
 
 extern void http_server_get_content_type_from_extension(char *url, char *content_type,
@@ -406,4 +427,15 @@ ZTEST(http_service, test_HTTP_SERVER_CONTENT_TYPE)
 	zassert_str_equal(content_type, "video/mpeg");
 }
 
-ZTEST_SUITE(http_service, NULL, NULL, NULL, NULL, NULL);
+extern void http_server_route_table_build(void);
+
+static void *http_service_setup(void)
+{
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_ROUTE_TABLE)) {
+		http_server_route_table_build();
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(http_service, NULL, http_service_setup, NULL, NULL, NULL);
@@ -1045,6 +1045,90 @@ ZTEST(server_function_tests, test_http1_connection_close)
 	zassert_equal(ret, 0, "Connection should've been closed");
 }
 
+/* Send a static GET on @a fd, returns the number of response bytes read */
+static int test_http1_static_get_fd(int fd)
+{
+	static const char request[] =
+		"GET / HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"\r\n";
+	static const char expected_response[] =
+		"HTTP/1.1 200 OK\r\n"
+		"Content-Type: text/html\r\n"
+		"Content-Length: 13\r\n"
+		"\r\n"
+		TEST_STATIC_PAYLOAD;
+	size_t offset = 0;
+	int ret;
+
+	ret = zsock_send(fd, request, strlen(request), 0);
+	if (ret < 0) {
+		return 0;
+	}
+
+	while (offset < sizeof(expected_response) - 1) {
+		ret = zsock_recv(fd, buf + offset, sizeof(buf) - offset, 0);
+		if (ret <= 0) {
+			break;
+		}
+
+		offset += ret;
+	}
+
+	if (offset > 0) {
+		zassert_mem_equal(buf, expected_response, MIN(offset, sizeof(expected_response) - 1),
+				  "Received data doesn't match expected response");
+	}
+
+	return offset;
+}
+
+ZTEST(server_function_tests, test_http1_max_clients)
+{
+	struct timeval optval = {
+		.tv_sec = TIMEOUT_S,
+		.tv_usec = 0,
+	};
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int fds[CONFIG_HTTP_SERVER_MAX_CLIENTS];
+	int ret;
+
+	ret = zsock_inet_pton(AF_INET, SERVER_IPV4_ADDR, &sa.sin_addr);
+	zassert_equal(ret, 1, "inet_pton() failed");
+
+	/* The first client is the one connected by the test setup */
+	ret = test_http1_static_get_fd(client_fd);
+	zassert_true(ret > 0, "First client not served");
+
+	/* With several workers, each of them can take a rounded up share of
+	 * the clients, the server as a whole still takes no more than the
+	 * limit.
+	 */
+	for (int i = 0; i < ARRAY_SIZE(fds); i++) {
+		fds[i] = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		zassert_true(fds[i] >= 0, "socket() failed (%d)", errno);
+
+		(void)zsock_setsockopt(fds[i], SOL_SOCKET, SO_RCVTIMEO, &optval, sizeof(optval));
+
+		ret = zsock_connect(fds[i], (struct sockaddr *)&sa, sizeof(sa));
+		zassert_ok(ret, "connect() failed (%d)", errno);
+
+		ret = test_http1_static_get_fd(fds[i]);
+		if (i < ARRAY_SIZE(fds) - 1) {
+			zassert_true(ret > 0, "Client %d not served", i + 1);
+		} else {
+			zassert_equal(ret, 0, "Client over the limit served");
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(fds); i++) {
+		(void)zsock_close(fds[i]);
+	}
+}
+
 ZTEST(server_function_tests, test_http2_post_data_with_padding)
 {
 	static const uint8_t request_post_dynamic[] = {
@@ -0,0 +1,224 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/storage/flash_map.h>
+
+#define SERVER_ADDR   "127.0.0.1"
+#define SERVER_PORT   8080
+#define TIMEOUT_S     1
+#define FS_MOUNT      "/lfs"
+#define FS_URL        "/index.html"
+#define ETAG_LEN      32
+
+#define TEST_PAYLOAD_1 "<html>first</html>"
+#define TEST_PAYLOAD_2 "<html>second</html>"
+
+static uint16_t test_service_port = SERVER_PORT;
+HTTP_SERVICE_DEFINE(test_fs_service, SERVER_ADDR, &test_service_port, 1, 1, NULL);
+
+static struct http_resource_detail_static_fs fs_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_STATIC_FS,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		},
+	.fs_path = FS_MOUNT,
+};
+
+HTTP_RESOURCE_DEFINE(fs_resource, test_fs_service, FS_URL, &fs_detail);
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(test_lfs);
+static struct fs_mount_t test_mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &test_lfs,
+	.storage_dev = (void *)FIXED_PARTITION_ID(storage_partition),
+	.mnt_point = FS_MOUNT,
+};
+
+struct test_response {
+	int status;
+	char etag[ETAG_LEN];
+	const char *body;
+	size_t body_len;
+};
+
+static char response_buf[1024];
+
+/* GET @a path on a new connection, sending the extra request @a headers, and
+ * parse the complete response into @a rsp.
+ */
+static void http_get(const char *path, const char *headers, struct test_response *rsp)
+{
+	struct timeval timeo = {
+		.tv_sec = TIMEOUT_S,
+	};
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	size_t offset = 0;
+	char *field;
+	char *end;
+	int fd;
+	int ret;
+
+	memset(rsp, 0, sizeof(*rsp));
+
+	zsock_inet_pton(AF_INET, SERVER_ADDR, &sa.sin_addr);
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(fd >= 0, "socket failed (%d)", errno);
+
+	(void)zsock_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeo, sizeof(timeo));
+
+	ret = zsock_connect(fd, (struct sockaddr *)&sa, sizeof(sa));
+	zassert_ok(ret, "connect failed (%d)", errno);
+
+	ret = snprintk(response_buf, sizeof(response_buf),
+		       "GET %s HTTP/1.1\r\nHost: " SERVER_ADDR "\r\n"
+		       "%sConnection: close\r\n\r\n", path, headers);
+
+	ret = zsock_send(fd, response_buf, ret, 0);
+	zassert_true(ret > 0, "send failed (%d)", errno);
+
+	/* The server closes the connection once the response is out */
+	do {
+		ret = zsock_recv(fd, response_buf + offset, sizeof(response_buf) - 1 - offset, 0);
+		zassert_true(ret >= 0, "recv failed (%d)", errno);
+		offset += ret;
+	} while (ret > 0 && offset < sizeof(response_buf) - 1);
+
+	zsock_close(fd);
+
+	response_buf[offset] = '\0';
+
+	zassert_ok(strncmp(response_buf, "HTTP/1.1 ", strlen("HTTP/1.1 ")), "no status line");
+	rsp->status = strtol(response_buf + strlen("HTTP/1.1 "), NULL, 10);
+
+	field = strstr(response_buf, "ETag: ");
+	if (field != NULL) {
+		field += strlen("ETag: ");
+		snprintk(rsp->etag, sizeof(rsp->etag), "%.*s", (int)strcspn(field, "\r"), field);
+	}
+
+	end = strstr(response_buf, "\r\n\r\n");
+	zassert_not_null(end, "incomplete response headers");
+
+	rsp->body = end + strlen("\r\n\r\n");
+	rsp->body_len = response_buf + offset - rsp->body;
+}
+
+static void expect_body(const struct test_response *rsp, const char *payload)
+{
+	zassert_equal(rsp->status, 200, "unexpected status %d", rsp->status);
+	zassert_equal(rsp->body_len, strlen(payload), "unexpected body length %zu",
+		      rsp->body_len);
+	zassert_mem_equal(rsp->body, payload, rsp->body_len, "unexpected body");
+}
+
+/* Replace the file served by the static filesystem resource */
+static void test_file_write(const char *payload)
+{
+	struct fs_file_t file;
+	ssize_t written;
+
+	fs_file_t_init(&file);
+
+	zassert_ok(fs_open(&file, FS_MOUNT FS_URL, FS_O_CREATE | FS_O_WRITE));
+	zassert_ok(fs_truncate(&file, 0));
+	written = fs_write(&file, payload, strlen(payload));
+	zassert_ok(fs_close(&file));
+	zassert_equal(written, strlen(payload), "short write");
+}
+
+ZTEST(server_fs_cache, test_get_miss_then_hit)
+{
+	struct test_response miss;
+	struct test_response hit;
+
+	/* The first request loads the file into the cache */
+	http_get(FS_URL, "", &miss);
+	expect_body(&miss, TEST_PAYLOAD_1);
+	zassert_true(strlen(miss.etag) > 0, "no ETag");
+
+	/* The cache is not revalidated, so a hit still serves the old
+	 * contents after the file changed.
+	 */
+	test_file_write(TEST_PAYLOAD_2);
+
+	http_get(FS_URL, "", &hit);
+	expect_body(&hit, TEST_PAYLOAD_1);
+	zassert_str_equal(hit.etag, miss.etag, "ETag changed on a hit");
+
+	/* Until the cache is flushed */
+	http_server_fs_cache_flush();
+
+	http_get(FS_URL, "", &miss);
+	expect_body(&miss, TEST_PAYLOAD_2);
+	zassert_true(strcmp(miss.etag, hit.etag) != 0, "ETag did not change");
+}
+
+ZTEST(server_fs_cache, test_if_none_match)
+{
+	char headers[sizeof("If-None-Match: \r\n") + ETAG_LEN];
+	struct test_response rsp;
+	char etag[ETAG_LEN];
+
+	http_get(FS_URL, "", &rsp);
+	expect_body(&rsp, TEST_PAYLOAD_1);
+	strcpy(etag, rsp.etag);
+
+	/* A matching ETag gets a 304 without a body */
+	snprintk(headers, sizeof(headers), "If-None-Match: %s\r\n", etag);
+
+	http_get(FS_URL, headers, &rsp);
+	zassert_equal(rsp.status, 304, "unexpected status %d", rsp.status);
+	zassert_str_equal(rsp.etag, etag, "unexpected ETag");
+	zassert_equal(rsp.body_len, 0, "304 with a body");
+
+	/* Another one gets the file */
+	http_get(FS_URL, "If-None-Match: \"0\"\r\n", &rsp);
+	expect_body(&rsp, TEST_PAYLOAD_1);
+}
+
+static void *server_fs_cache_setup(void)
+{
+	zassert_ok(fs_mount(&test_mnt), "cannot mount the filesystem");
+	zassert_ok(http_server_start(), "failed to start the server");
+
+	/* Let the server set up its listening socket */
+	k_msleep(100);
+
+	return NULL;
+}
+
+static void server_fs_cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	test_file_write(TEST_PAYLOAD_1);
+	http_server_fs_cache_flush();
+}
+
+static void server_fs_cache_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)http_server_stop();
+	(void)fs_unmount(&test_mnt);
+}
+
+ZTEST_SUITE(server_fs_cache, NULL, server_fs_cache_setup, server_fs_cache_before, NULL,
+	    server_fs_cache_teardown);
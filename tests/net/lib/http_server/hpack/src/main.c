@@ -494,4 +494,139 @@ ZTEST(http2_hpack, test_http2_hpack_literal_not_indexed_decode)
 				 ARRAY_SIZE(test_enc_literal_not_indexed_headers));
 }
 
+/* Responses encoded with a 256 bytes dynamic table. The first header carries
+ * the table size update, content-length is never added to the table.
+ */
+static const struct example_headers test_enc_table_first_response[] = {
+	{ ":status", "200", { 0x3f, 0xe1, 0x01, 0x88 }, 4 },
+	{ "content-type", "text/html", /* Huffman encoded */
+	  { 0x5f, 0x87, 0x49, 0x7c, 0xa5, 0x89, 0xd3, 0x4d, 0x1f },
+	  9 },
+	{ "server", "zephyr", /* Huffman encoded */
+	  { 0x76, 0x85, 0xf6, 0x5a, 0xe7, 0xf5, 0x67 },
+	  7 },
+	{ "content-length", "42", { 0x1f, 0x0d, 0x02, 0x34, 0x32 }, 5 },
+};
+
+static const struct example_headers test_enc_table_next_response[] = {
+	{ ":status", "200", { 0x88 }, 1 },
+	{ "content-type", "text/html", { 0xbf }, 1 },
+	{ "server", "zephyr", { 0xbe }, 1 },
+	{ "content-length", "1337", /* Huffman encoded */
+	  { 0x1f, 0x0d, 0x83, 0x0b, 0x2c, 0xbb },
+	  6 },
+};
+
+/* After the peer limited the table to 60 bytes, only one of the entries fits. */
+static const struct example_headers test_enc_table_evicted[] = {
+	{ "server", "zephyr", { 0x3f, 0x1d, 0xbe }, 3 },
+	{ "content-type", "text/html",
+	  { 0x5f, 0x87, 0x49, 0x7c, 0xa5, 0x89, 0xd3, 0x4d, 0x1f },
+	  9 },
+	{ "server", "zephyr",
+	  { 0x76, 0x85, 0xf6, 0x5a, 0xe7, 0xf5, 0x67 },
+	  7 },
+};
+
+/* After a reset, the peer is told to evict all the entries. */
+static const struct example_headers test_enc_table_reset[] = {
+	{ "server", "zephyr",
+	  { 0x20, 0x3f, 0x1d, 0x76, 0x85, 0xf6, 0x5a, 0xe7, 0xf5, 0x67 },
+	  10 },
+	{ "server", "zephyr", { 0xbe }, 1 },
+};
+
+/* With the table disabled by the peer, headers are sent as literals. */
+static const struct example_headers test_enc_table_disabled[] = {
+	{ "content-type", "text/html",
+	  { 0x20, 0x1f, 0x10, 0x87, 0x49, 0x7c, 0xa5, 0x89, 0xd3, 0x4d, 0x1f },
+	  11 },
+	{ "content-type", "text/html",
+	  { 0x1f, 0x10, 0x87, 0x49, 0x7c, 0xa5, 0x89, 0xd3, 0x4d, 0x1f },
+	  10 },
+};
+
+static void test_hpack_verify_table_encode(struct http_hpack_table *table,
+					   const struct example_headers *example,
+					   size_t num_examples)
+{
+	for (int i = 0; i < num_examples; i++) {
+		struct http_hpack_header_buf hdr = {
+			.name = example[i].name,
+			.value = example[i].value,
+			.name_len = strlen(example[i].name),
+			.value_len = strlen(example[i].value)
+		};
+		int ret;
+
+		ret = http_hpack_table_encode_header(table, test_buf, sizeof(test_buf), &hdr);
+		zassert_equal(ret, example[i].encoded_len, "Wrong encoding length");
+		zassert_mem_equal(test_buf, example[i].encoded, ret,
+				  "Header wrongly encoded");
+	}
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_encode)
+{
+	struct http_hpack_table table;
+
+	if (CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE != 256) {
+		ztest_test_skip();
+	}
+
+	http_hpack_table_init(&table);
+
+	test_hpack_verify_table_encode(&table, test_enc_table_first_response,
+				       ARRAY_SIZE(test_enc_table_first_response));
+	test_hpack_verify_table_encode(&table, test_enc_table_next_response,
+				       ARRAY_SIZE(test_enc_table_next_response));
+
+	http_hpack_table_set_max_size(&table, 60);
+	test_hpack_verify_table_encode(&table, test_enc_table_evicted,
+				       ARRAY_SIZE(test_enc_table_evicted));
+
+	http_hpack_table_reset(&table);
+	test_hpack_verify_table_encode(&table, test_enc_table_reset,
+				       ARRAY_SIZE(test_enc_table_reset));
+
+	http_hpack_table_set_max_size(&table, 0);
+	test_hpack_verify_table_encode(&table, test_enc_table_disabled,
+				       ARRAY_SIZE(test_enc_table_disabled));
+}
+
+static const struct example_headers test_enc_table_resize_first[] = {
+	{ "server", "zephyr",
+	  { 0x3f, 0xe1, 0x01, 0x76, 0x85, 0xf6, 0x5a, 0xe7, 0xf5, 0x67 },
+	  10 },
+};
+
+/* The table was emptied and enabled again before the next header block, the
+ * peer is told about both sizes.
+ */
+static const struct example_headers test_enc_table_resize_next[] = {
+	{ "server", "zephyr",
+	  { 0x20, 0x3f, 0xe1, 0x01, 0x76, 0x85, 0xf6, 0x5a, 0xe7, 0xf5, 0x67 },
+	  11 },
+	{ "server", "zephyr", { 0xbe }, 1 },
+};
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_resize)
+{
+	struct http_hpack_table table;
+
+	if (CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE != 256) {
+		ztest_test_skip();
+	}
+
+	http_hpack_table_init(&table);
+
+	test_hpack_verify_table_encode(&table, test_enc_table_resize_first,
+				       ARRAY_SIZE(test_enc_table_resize_first));
+
+	http_hpack_table_set_max_size(&table, 0);
+	http_hpack_table_set_max_size(&table, 256);
+	test_hpack_verify_table_encode(&table, test_enc_table_resize_next,
+				       ARRAY_SIZE(test_enc_table_resize_next));
+}
+
 ZTEST_SUITE(http2_hpack, NULL, NULL, NULL, NULL, NULL);
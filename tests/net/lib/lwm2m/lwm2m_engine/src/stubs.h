@@ -59,6 +59,7 @@ DECLARE_FAKE_VALUE_FUNC(int, lwm2m_security_mode, struct lwm2m_ctx *);
 DECLARE_FAKE_VALUE_FUNC(int, z_impl_zsock_setsockopt, int, int, int, const void *, socklen_t);
 DECLARE_FAKE_VOID_FUNC(engine_update_tx_time);
 DECLARE_FAKE_VALUE_FUNC(bool, coap_block_has_more, struct coap_packet *);
+DECLARE_FAKE_VOID_FUNC(engine_observe_index_invalidate);
 
 #define DO_FOREACH_FAKE(FUNC)                                                                      \
 	do {                                                                                       \
@@ -91,6 +92,7 @@ DECLARE_FAKE_VALUE_FUNC(bool, coap_block_has_more, struct coap_packet *);
 		FUNC(z_impl_zsock_setsockopt)                                                      \
 		FUNC(engine_update_tx_time)                                                        \
 		FUNC(coap_block_has_more)							   \
+		FUNC(engine_observe_index_invalidate)                                              \
 	} while (0)
 
 #endif /* STUBS_H */
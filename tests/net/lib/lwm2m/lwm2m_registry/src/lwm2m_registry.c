@@ -458,6 +458,37 @@ ZTEST(lwm2m_registry, test_next_engine_obj_inst)
 	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 1)));
 }
 
+ZTEST(lwm2m_registry, test_obj_inst_lookup)
+{
+	const uint16_t ids[] = {7, 0, 65534, 64};
+	struct lwm2m_engine_obj_inst *oi;
+
+	/* Instances sharing hash buckets must all be found */
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, ids[i])), 0);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		oi = get_engine_obj_inst(3303, ids[i]);
+		zassert_not_null(oi);
+		zassert_equal(oi->obj_inst_id, ids[i]);
+		zassert_equal(oi->obj->obj_id, 3303);
+		zassert_not_null(lwm2m_engine_get_obj_inst_res(oi, 5700));
+	}
+
+	zassert_is_null(get_engine_obj_inst(3303, 1));
+	zassert_is_null(get_engine_obj_inst(3304, 7));
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 0)), 0);
+	zassert_is_null(get_engine_obj_inst(3303, 0));
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		if (ids[i] != 0) {
+			zassert_equal(get_engine_obj_inst(3303, ids[i])->obj_inst_id, ids[i]);
+			zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, ids[i])), 0);
+		}
+	}
+}
+
 ZTEST(lwm2m_registry, test_null_strings)
 {
 	int ret;
@@ -41,6 +41,9 @@ static struct mqtt_test_ctx {
 	bool suback_handled;
 	bool unsuback_handled;
 	uint16_t msg_id;
+	/* Number of consecutive message IDs in use, from msg_id */
+	uint16_t msg_count;
+	uint16_t puback_count;
 	int payload_left;
 	const uint8_t *payload;
 } test_ctx;
@@ -497,9 +500,11 @@ static void mqtt_evt_handler(struct mqtt_client *const client,
 
 	case MQTT_EVT_PUBACK:
 		zassert_ok(evt->result, "MQTT PUBACK error %d", evt->result);
-		zassert_equal(evt->param.puback.message_id, test_ctx.msg_id,
-			      "Invalid packet ID received.");
+		zassert_true((uint16_t)(evt->param.puback.message_id - test_ctx.msg_id) <
+			     MAX(test_ctx.msg_count, 1),
+			     "Invalid packet ID received.");
 		test_ctx.puback_handled = true;
+		test_ctx.puback_count++;
 
 		break;
 
@@ -801,6 +806,198 @@ ZTEST(mqtt_client, test_mqtt_pubsub_long)
 	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
 }
 
+static void publish_param_init(struct mqtt_publish_param *param, enum mqtt_qos qos,
+			       uint16_t message_id)
+{
+	memset(param, 0, sizeof(*param));
+
+	param->message.topic.qos = qos;
+	param->message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+	param->message.topic.topic.size = strlen(param->message.topic.topic.utf8);
+	param->message.payload.data = (uint8_t *)test_ctx.payload;
+	param->message.payload.len = strlen(test_ctx.payload);
+	param->message_id = message_id;
+}
+
+static void wait_for_pubacks(uint16_t count)
+{
+	int ret;
+
+	while (test_ctx.puback_count < count) {
+		client_wait(false);
+		ret = mqtt_input(&client_ctx);
+		zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+	}
+}
+
+#define BATCH_MSG_COUNT 3
+
+#if defined(CONFIG_MQTT_PUBLISH_BATCH_TIMEOUT)
+#define BATCH_TIMEOUT CONFIG_MQTT_PUBLISH_BATCH_TIMEOUT
+#else
+#define BATCH_TIMEOUT 0
+#endif
+
+ZTEST(mqtt_client, test_mqtt_publish_batch)
+{
+	struct mqtt_publish_param param;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_MQTT_PUBLISH_BATCH);
+
+	test_ctx.payload = payload_short;
+	test_ctx.msg_id = 1;
+	test_ctx.msg_count = BATCH_MSG_COUNT;
+
+	test_connect();
+
+	for (int i = 0; i < BATCH_MSG_COUNT; i++) {
+		publish_param_init(&param, MQTT_QOS_1_AT_LEAST_ONCE, test_ctx.msg_id + i);
+		ret = mqtt_publish_queue(&client_ctx, &param);
+		zassert_ok(ret, "MQTT client failed to queue publish (%d)", ret);
+	}
+
+	ret = mqtt_publish_flush(&client_ctx);
+	zassert_ok(ret, "MQTT client failed to flush publish batch (%d)", ret);
+
+	for (int i = 0; i < BATCH_MSG_COUNT; i++) {
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	wait_for_pubacks(BATCH_MSG_COUNT);
+	test_disconnect();
+}
+
+ZTEST(mqtt_client, test_mqtt_publish_batch_timeout)
+{
+	struct mqtt_publish_param param;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_MQTT_PUBLISH_BATCH);
+
+	if (BATCH_TIMEOUT == 0) {
+		ztest_test_skip();
+	}
+
+	test_ctx.payload = payload_short;
+	test_ctx.msg_id = 1;
+	test_ctx.msg_count = 1;
+
+	test_connect();
+
+	publish_param_init(&param, MQTT_QOS_1_AT_LEAST_ONCE, test_ctx.msg_id);
+	ret = mqtt_publish_queue(&client_ctx, &param);
+	zassert_ok(ret, "MQTT client failed to queue publish (%d)", ret);
+
+	ret = mqtt_keepalive_time_left(&client_ctx);
+	zassert_true(ret >= 0 && ret <= BATCH_TIMEOUT,
+		     "Queued message not accounted for (%d)", ret);
+
+	/* A partial batch is sent once it has waited for the timeout */
+	k_msleep(BATCH_TIMEOUT);
+
+	ret = mqtt_live(&client_ctx);
+	zassert_ok(ret, "MQTT client failed to send the batch (%d)", ret);
+
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	wait_for_pubacks(1);
+	test_disconnect();
+}
+
+/* Each QoS 0 publish takes the reserved fixed header, the topic length and
+ * the topic in the TX buffer. Leave less than a fixed header after 4 of them.
+ */
+#define BATCH_FULL_MSG_SIZE (MQTT_FIXED_HEADER_MAX_SIZE + 2 + sizeof("sensors") - 1)
+#define BATCH_FULL_TX_SIZE  (4 * BATCH_FULL_MSG_SIZE + 3)
+#define BATCH_FULL_MSG_COUNT 6
+#define TX_GUARD_PATTERN    0xA5
+
+ZTEST(mqtt_client, test_mqtt_publish_batch_tx_buf_full)
+{
+	struct mqtt_publish_param param;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_MQTT_PUBLISH_BATCH);
+
+	BUILD_ASSERT(BATCH_FULL_TX_SIZE < BUFFER_SIZE);
+
+	test_ctx.payload = payload_short;
+
+	test_connect();
+
+	/* Use only the start of the TX buffer, the rest must stay untouched */
+	client_ctx.tx_buf_size = BATCH_FULL_TX_SIZE;
+	memset(tx_buffer + BATCH_FULL_TX_SIZE, TX_GUARD_PATTERN,
+	       sizeof(tx_buffer) - BATCH_FULL_TX_SIZE);
+
+	for (int i = 0; i < BATCH_FULL_MSG_COUNT; i++) {
+		publish_param_init(&param, MQTT_QOS_0_AT_MOST_ONCE, 0);
+		ret = mqtt_publish_queue(&client_ctx, &param);
+		zassert_ok(ret, "MQTT client failed to queue publish (%d)", ret);
+	}
+
+	ret = mqtt_publish_flush(&client_ctx);
+	zassert_ok(ret, "MQTT client failed to flush publish batch (%d)", ret);
+
+	for (int i = BATCH_FULL_TX_SIZE; i < sizeof(tx_buffer); i++) {
+		zassert_equal(tx_buffer[i], TX_GUARD_PATTERN,
+			      "TX buffer overrun at offset %d", i);
+	}
+
+	for (int i = 0; i < BATCH_FULL_MSG_COUNT; i++) {
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	test_disconnect();
+}
+
+ZTEST(mqtt_client, test_mqtt_publish_inflight_window)
+{
+	struct mqtt_publish_param param;
+	int ret;
+
+	if (CONFIG_MQTT_PUBLISH_INFLIGHT_MAX == 0) {
+		ztest_test_skip();
+	}
+
+	test_ctx.payload = payload_short;
+	test_ctx.msg_id = 1;
+	test_ctx.msg_count = CONFIG_MQTT_PUBLISH_INFLIGHT_MAX + 1;
+
+	test_connect();
+
+	for (int i = 0; i < CONFIG_MQTT_PUBLISH_INFLIGHT_MAX; i++) {
+		publish_param_init(&param, MQTT_QOS_1_AT_LEAST_ONCE, test_ctx.msg_id + i);
+		ret = mqtt_publish(&client_ctx, &param);
+		zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	/* The window is full until the messages are acknowledged */
+	publish_param_init(&param, MQTT_QOS_1_AT_LEAST_ONCE,
+			   test_ctx.msg_id + CONFIG_MQTT_PUBLISH_INFLIGHT_MAX);
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_equal(ret, -EAGAIN, "Publish should wait for the window (%d)", ret);
+
+	/* but for QoS 0 messages */
+	publish_param_init(&param, MQTT_QOS_0_AT_MOST_ONCE, 0);
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	wait_for_pubacks(CONFIG_MQTT_PUBLISH_INFLIGHT_MAX);
+
+	publish_param_init(&param, MQTT_QOS_1_AT_LEAST_ONCE,
+			   test_ctx.msg_id + CONFIG_MQTT_PUBLISH_INFLIGHT_MAX);
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	wait_for_pubacks(CONFIG_MQTT_PUBLISH_INFLIGHT_MAX + 1);
+	test_disconnect();
+}
+
 static void mqtt_tests_before(void *fixture)
 {
 	ARG_UNUSED(fixture);
@@ -21,17 +21,17 @@ ZTEST(test_counter, test_prometheus_counter_01_inc)
 {
 	int ret;
 
-	zassert_equal(test_counter_m.value, 0, "Counter value is not 0");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 0, "Counter value is not 0");
 
 	ret = prometheus_counter_inc(&test_counter_m);
 	zassert_ok(ret, "Error incrementing counter");
 
-	zassert_equal(test_counter_m.value, 1, "Counter value is not 1");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 1, "Counter value is not 1");
 
 	ret = prometheus_counter_inc(&test_counter_m);
 	zassert_ok(ret, "Error incrementing counter");
 
-	zassert_equal(test_counter_m.value, 2, "Counter value is not 2");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 2, "Counter value is not 2");
 }
 
 /**
@@ -46,12 +46,12 @@ ZTEST(test_counter, test_prometheus_counter_02_add)
 	ret = prometheus_counter_add(&test_counter_m, 2);
 	zassert_ok(ret, "Error adding counter");
 
-	zassert_equal(test_counter_m.value, 4, "Counter value is not 4");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 4, "Counter value is not 4");
 
 	ret = prometheus_counter_add(&test_counter_m, 0);
 	zassert_ok(ret, "Error adding counter");
 
-	zassert_equal(test_counter_m.value, 4, "Counter value is not 4");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 4, "Counter value is not 4");
 }
 
 /**
@@ -66,12 +66,54 @@ ZTEST(test_counter, test_prometheus_counter_03_set)
 	ret = prometheus_counter_set(&test_counter_m, 20);
 	zassert_ok(ret, "Error setting counter");
 
-	zassert_equal(test_counter_m.value, 20, "Counter value is not 20");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 20, "Counter value is not 20");
 
 	ret = prometheus_counter_set(&test_counter_m, 15);
 	zassert_equal(ret, -EINVAL, "Error setting counter");
 
-	zassert_equal(test_counter_m.value, 20, "Counter value is not 20");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 20, "Counter value is not 20");
+}
+
+#define UPDATE_THREADS 3
+#define UPDATES_PER_THREAD 1000
+
+static K_THREAD_STACK_ARRAY_DEFINE(update_stacks, UPDATE_THREADS, 1024);
+static struct k_thread update_threads[UPDATE_THREADS];
+
+static void update_counter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < UPDATES_PER_THREAD; i++) {
+		(void)prometheus_counter_inc(p1);
+		k_yield();
+	}
+}
+
+/**
+ * @brief Test concurrent prometheus_counter_inc
+ * @details The test shall increment the counter from several threads and
+ * check that no increment is lost.
+ */
+ZTEST(test_counter, test_prometheus_counter_04_threads)
+{
+	uint64_t start = prometheus_counter_get(&test_counter_m);
+
+	zassert_equal(start, 20, "Counter value is not 20");
+
+	for (int i = 0; i < UPDATE_THREADS; i++) {
+		k_thread_create(&update_threads[i], update_stacks[i],
+				K_THREAD_STACK_SIZEOF(update_stacks[i]), update_counter,
+				&test_counter_m, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < UPDATE_THREADS; i++) {
+		zassert_ok(k_thread_join(&update_threads[i], K_FOREVER));
+	}
+
+	zassert_equal(prometheus_counter_get(&test_counter_m),
+		      start + UPDATE_THREADS * UPDATES_PER_THREAD, "Increments were lost");
 }
 
 ZTEST_SUITE(test_counter, NULL, NULL, NULL, NULL, NULL);
@@ -7,6 +7,7 @@
 #include <zephyr/ztest.h>
 
 #include <zephyr/net/prometheus/counter.h>
+#include <zephyr/net/prometheus/histogram.h>
 #include <zephyr/net/prometheus/collector.h>
 #include <zephyr/net/prometheus/formatter.h>
 
@@ -19,6 +20,13 @@ PROMETHEUS_COUNTER_DEFINE(test_counter2, "Test counter 2",
 
 PROMETHEUS_COLLECTOR_DEFINE(test_custom_collector);
 
+PROMETHEUS_COUNTER_DEFINE(test_chunk_counter, "Test chunk counter",
+			  ({ .key = "test", .value = "chunk" }), NULL);
+PROMETHEUS_HISTOGRAM_DEFINE(test_chunk_histogram, "Test chunk histogram",
+			    ({ .key = "test", .value = "chunk" }), NULL);
+
+PROMETHEUS_COLLECTOR_DEFINE(test_chunk_collector);
+
 /**
  * @brief Test Prometheus formatter
  * @details The test shall increment the counter value by 1 and check if the
@@ -45,7 +53,7 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 
 	zassert_equal(counter, &test_counter, "Counter not found in collector");
 
-	zassert_equal(test_counter.value, 0, "Counter value is not 0");
+	zassert_equal(prometheus_counter_get(&test_counter), 0, "Counter value is not 0");
 
 	ret = prometheus_counter_inc(&test_counter);
 	zassert_ok(ret, "Error incrementing counter");
@@ -53,7 +61,7 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 	ret = prometheus_counter_inc(&test_counter2);
 	zassert_ok(ret, "Error incrementing counter 2");
 
-	zassert_equal(counter->value, 1, "Counter value is not 1");
+	zassert_equal(prometheus_counter_get(counter), 1, "Counter value is not 1");
 
 	ret = prometheus_format_exposition(&test_custom_collector, formatted, sizeof(formatted));
 	zassert_ok(ret, "Error formatting exposition data");
@@ -63,4 +71,76 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 		      exposed, formatted);
 }
 
+/**
+ * @brief Test Prometheus chunked formatter
+ * @details The test shall format the exposition of a collector in chunks
+ * using a buffer smaller than the whole exposition and check that the chunks
+ * add up to the exposition formatted at once. It shall then check that a
+ * buffer smaller than a line is refused.
+ */
+ZTEST(test_formatter, test_prometheus_formatter_chunks)
+{
+	static char formatted[1024];
+	static char chunked[1024];
+	static struct prometheus_histogram_bucket buckets[] = {
+		{ .upper_bound = 0.5 },
+		{ .upper_bound = 1.0 },
+		{ .upper_bound = 2.0 },
+	};
+	struct prometheus_format_context ctx;
+	char chunk[48];
+	size_t total = 0;
+	size_t chunks = 0;
+	size_t len;
+	int ret;
+
+	test_chunk_histogram.buckets = buckets;
+	test_chunk_histogram.num_buckets = ARRAY_SIZE(buckets);
+
+	prometheus_collector_register_metric(&test_chunk_collector, &test_chunk_counter.base);
+	prometheus_collector_register_metric(&test_chunk_collector, &test_chunk_histogram.base);
+
+	zassert_ok(prometheus_counter_add(&test_chunk_counter, 42));
+	zassert_ok(prometheus_histogram_observe(&test_chunk_histogram, 0.7));
+	zassert_ok(prometheus_histogram_observe(&test_chunk_histogram, 1.5));
+
+	ret = prometheus_format_exposition(&test_chunk_collector, formatted, sizeof(formatted));
+	zassert_ok(ret, "Error formatting exposition data");
+	zassert_true(strlen(formatted) > sizeof(chunk), "Exposition fits into one chunk");
+
+	zassert_ok(prometheus_format_exposition_init(&ctx, &test_chunk_collector));
+
+	do {
+		ret = prometheus_format_exposition_chunk(&ctx, chunk, sizeof(chunk), &len);
+		zassert_true(ret == 0 || ret == -EAGAIN, "Error formatting chunk (%d)", ret);
+		zassert_true(total + len < sizeof(chunked), "Too much data");
+
+		memcpy(&chunked[total], chunk, len);
+		total += len;
+		chunks++;
+
+		/* Registering a metric again must not move it under the cursor */
+		zassert_equal(prometheus_collector_register_metric(&test_chunk_collector,
+								   &test_chunk_counter.base),
+			      -EALREADY, "Metric registered twice");
+	} while (ret == -EAGAIN);
+
+	chunked[total] = '\0';
+
+	zassert_true(chunks > 1, "Exposition was not split");
+	zassert_equal(strcmp(formatted, chunked), 0,
+		      "Chunked exposition is not as expected (expected\n\"%s\", got\n\"%s\")",
+		      formatted, chunked);
+
+	/* A finished context has nothing more to format */
+	ret = prometheus_format_exposition_chunk(&ctx, chunk, sizeof(chunk), &len);
+	zassert_ok(ret, "Error formatting after the last chunk");
+	zassert_equal(len, 0, "Data after the last chunk");
+
+	zassert_ok(prometheus_format_exposition_init(&ctx, &test_chunk_collector));
+
+	ret = prometheus_format_exposition_chunk(&ctx, chunk, 8, &len);
+	zassert_equal(ret, -ENOMEM, "Line did fit into the buffer");
+}
+
 ZTEST_SUITE(test_formatter, NULL, NULL, NULL, NULL, NULL);
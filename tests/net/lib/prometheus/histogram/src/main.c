@@ -37,4 +37,43 @@ ZTEST(test_histogram, test_histogram_observe)
 	zassert_equal(test_histogram_m.sum, 3.0, "Histogram value is not 2");
 }
 
+PROMETHEUS_HISTOGRAM_DEFINE(test_histogram_buckets_m, "Test histogram buckets",
+			    ({ .key = "test", .value = "buckets" }), NULL);
+
+/**
+ * @brief Test prometheus_histogram_observe bucket selection
+ *
+ * @details The test shall observe values below, on and above the bucket
+ * bounds and check that each is counted in the first bucket whose upper
+ * bound is not below the value.
+ */
+ZTEST(test_histogram, test_histogram_buckets)
+{
+	struct prometheus_histogram_bucket buckets[] = {
+		{ .upper_bound = 0.1 },
+		{ .upper_bound = 0.5 },
+		{ .upper_bound = 1.0 },
+		{ .upper_bound = 5.0 },
+		{ .upper_bound = 10.0 },
+	};
+	const double values[] = { 0.0, 0.1, 0.2, 0.5, 0.7, 1.0, 4.0, 10.0, 11.0 };
+	const unsigned long expected[] = { 2, 2, 2, 1, 1 };
+
+	test_histogram_buckets_m.buckets = buckets;
+	test_histogram_buckets_m.num_buckets = ARRAY_SIZE(buckets);
+
+	ARRAY_FOR_EACH(values, i) {
+		zassert_ok(prometheus_histogram_observe(&test_histogram_buckets_m, values[i]),
+			   "Error observing histogram");
+	}
+
+	ARRAY_FOR_EACH(buckets, i) {
+		zassert_equal(buckets[i].count, expected[i], "Bucket %zu count is %lu", i,
+			      buckets[i].count);
+	}
+
+	zassert_equal(test_histogram_buckets_m.count, ARRAY_SIZE(values),
+		      "Histogram count is not %zu", ARRAY_SIZE(values));
+}
+
 ZTEST_SUITE(test_histogram, NULL, NULL, NULL, NULL, NULL);
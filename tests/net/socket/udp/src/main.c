@@ -3092,6 +3092,149 @@ ZTEST(net_socket_udp, test_40_clamp_udp_tcp_port_range)
 #endif
 }
 
+ZTEST_USER(net_socket_udp, test_41_v4_sendmmsg_recvmmsg)
+{
+	static const char * const payloads[] = {
+		"first", "second datagram", "3rd", "fourth one", "5",
+	};
+	char bufs[ARRAY_SIZE(payloads) + 1][32];
+	struct sockaddr_in addrs[ARRAY_SIZE(payloads) + 1];
+	struct iovec iov[ARRAY_SIZE(payloads) + 1];
+	struct mmsghdr msgs[ARRAY_SIZE(payloads) + 1];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	int client_sock;
+	int server_sock;
+	int received = 0;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = zsock_bind(client_sock, (struct sockaddr *)&client_addr,
+			sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		iov[i].iov_base = (void *)payloads[i];
+		iov[i].iov_len = strlen(payloads[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgs, ARRAY_SIZE(payloads), 0);
+	zassert_equal(rv, ARRAY_SIZE(payloads), "sendmmsg failed (%d)", -errno);
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(payloads[i]),
+			      "Invalid length sent (%u)", msgs[i].msg_len);
+	}
+
+	/* The datagrams may be queued one by one, so receive until all of
+	 * them are in. Only the first one of each call is waited for.
+	 */
+	while (received < ARRAY_SIZE(payloads)) {
+		unsigned int vlen = ARRAY_SIZE(msgs) - received;
+
+		memset(msgs, 0, sizeof(msgs));
+
+		for (int i = 0; i < vlen; i++) {
+			iov[i].iov_base = bufs[received + i];
+			iov[i].iov_len = sizeof(bufs[0]);
+			msgs[i].msg_hdr.msg_iov = &iov[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+			msgs[i].msg_hdr.msg_name = &addrs[i];
+			msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+		}
+
+		rv = zsock_recvmmsg(server_sock, msgs, vlen, ZSOCK_MSG_WAITFORONE, NULL);
+		zassert_true(rv > 0, "recvmmsg failed (%d)", -errno);
+		zassert_true(received + rv <= ARRAY_SIZE(payloads),
+			     "Too many datagrams received (%d)", rv);
+
+		for (int i = 0; i < rv; i++) {
+			const char *payload = payloads[received + i];
+
+			zassert_equal(msgs[i].msg_len, strlen(payload),
+				      "Invalid length received (%u)", msgs[i].msg_len);
+			zassert_equal(iov[i].iov_len, strlen(payload),
+				      "Invalid iovec length (%zu)", iov[i].iov_len);
+			zassert_mem_equal(bufs[received + i], payload, strlen(payload),
+					  "Invalid data received");
+			zassert_equal(msgs[i].msg_hdr.msg_namelen, sizeof(client_addr),
+				      "Invalid address length");
+			zassert_equal(addrs[i].sin_port, client_addr.sin_port,
+				      "Invalid source port");
+		}
+
+		received += rv;
+	}
+
+	/* An empty datagram does not end the batch */
+	memset(msgs, 0, sizeof(msgs));
+	iov[0].iov_base = NULL;
+	iov[0].iov_len = 0;
+	iov[1].iov_base = (void *)payloads[0];
+	iov[1].iov_len = strlen(payloads[0]);
+
+	for (int i = 0; i < 2; i++) {
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgs, 2, 0);
+	zassert_equal(rv, 2, "sendmmsg failed (%d)", -errno);
+
+	/* Let both datagrams be queued */
+	k_msleep(100);
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < 2; i++) {
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = sizeof(bufs[0]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgs, 2, ZSOCK_MSG_WAITFORONE, NULL);
+	zassert_equal(rv, 2, "recvmmsg stopped at the empty datagram (%d)", rv);
+	zassert_equal(msgs[0].msg_len, 0, "Invalid length received (%u)", msgs[0].msg_len);
+	zassert_equal(msgs[1].msg_len, strlen(payloads[0]),
+		      "Invalid length received (%u)", msgs[1].msg_len);
+
+	memset(msgs, 0, sizeof(msgs));
+	iov[0].iov_base = bufs[0];
+	iov[0].iov_len = sizeof(bufs[0]);
+	msgs[0].msg_hdr.msg_iov = &iov[0];
+	msgs[0].msg_hdr.msg_iovlen = 1;
+
+	rv = zsock_recvmmsg(server_sock, msgs, 1,
+			    ZSOCK_MSG_WAITFORONE | ZSOCK_MSG_DONTWAIT, NULL);
+	zassert_true(rv < 0 && errno == EAGAIN, "recvmmsg did not fail (%d)", rv);
+
+	rv = zsock_recvmmsg(server_sock, msgs, 0, 0, NULL);
+	zassert_equal(rv, 0, "recvmmsg of no messages failed (%d)", -errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+
+	rv = zsock_sendmmsg(client_sock, msgs, 1, 0);
+	zassert_true(rv < 0 && errno == EBADF, "sendmmsg on closed socket (%d)", rv);
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -887,3 +887,196 @@ ZTEST_F(zms, test_zms_cache_hash_quality)
 
 #endif
 }
+
+#ifdef CONFIG_ZMS_TRANSACTION
+#define TEST_TX_FIRST_ID 100
+#define TEST_TX_ENTRIES  10
+#define TEST_TX_DATA_LEN 16
+
+/* Odd entries are small enough to be stored in their ATE */
+#define TEST_TX_LEN(i) (((i) % 2) ? ZMS_DATA_IN_ATE_SIZE : TEST_TX_DATA_LEN)
+
+static void tx_fill(uint8_t *buf, uint32_t id, uint8_t gen)
+{
+	for (int i = 0; i < TEST_TX_DATA_LEN; i++) {
+		buf[i] = (uint8_t)(id + gen + i);
+	}
+}
+
+/* Store the initial values: all IDs of the transaction except the last one */
+static void tx_write_old(struct zms_fs *fs)
+{
+	uint8_t buf[TEST_TX_DATA_LEN];
+	ssize_t len;
+
+	for (uint32_t i = 0; i < TEST_TX_ENTRIES - 1; i++) {
+		tx_fill(buf, TEST_TX_FIRST_ID + i, 0);
+		len = zms_write(fs, TEST_TX_FIRST_ID + i, buf, TEST_TX_LEN(i));
+		zassert_equal(len, TEST_TX_LEN(i), "zms_write failed: %d", len);
+	}
+}
+
+/* Stage new values for all IDs of the transaction and delete the first one */
+static void tx_stage_new(struct zms_tx *tx, uint8_t data[][TEST_TX_DATA_LEN])
+{
+	int err;
+
+	for (uint32_t i = 1; i < TEST_TX_ENTRIES; i++) {
+		tx_fill(data[i], TEST_TX_FIRST_ID + i, 1);
+		err = zms_tx_write(tx, TEST_TX_FIRST_ID + i, data[i], TEST_TX_LEN(i));
+		zassert_equal(err, 0, "zms_tx_write failed: %d", err);
+	}
+
+	err = zms_tx_delete(tx, TEST_TX_FIRST_ID);
+	zassert_equal(err, 0, "zms_tx_delete failed: %d", err);
+}
+
+static void tx_check(struct zms_fs *fs, bool committed)
+{
+	uint8_t expected[TEST_TX_DATA_LEN];
+	uint8_t rd_buf[TEST_TX_DATA_LEN];
+	ssize_t len;
+
+	for (uint32_t i = 0; i < TEST_TX_ENTRIES; i++) {
+		len = zms_read(fs, TEST_TX_FIRST_ID + i, rd_buf, sizeof(rd_buf));
+
+		if ((committed && (i == 0)) || (!committed && (i == TEST_TX_ENTRIES - 1))) {
+			zassert_equal(len, -ENOENT, "ID %u should not exist", i);
+			continue;
+		}
+
+		zassert_equal(len, TEST_TX_LEN(i), "zms_read failed: %d", len);
+		tx_fill(expected, TEST_TX_FIRST_ID + i, committed ? 1 : 0);
+		zassert_mem_equal(rd_buf, expected, TEST_TX_LEN(i), "Unexpected data for ID %u",
+				  i);
+	}
+}
+#endif
+
+/*
+ * Test that a transaction is applied as a whole and that the staging area
+ * behaves as expected.
+ */
+ZTEST_F(zms, test_zms_transaction)
+{
+#ifdef CONFIG_ZMS_TRANSACTION
+	struct zms_tx_entry entries[TEST_TX_ENTRIES];
+	uint8_t data[TEST_TX_ENTRIES][TEST_TX_DATA_LEN];
+	uint8_t extra = 0;
+	struct zms_tx tx;
+	int err;
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	tx_write_old(&fixture->fs);
+
+	zms_tx_init(&tx, &fixture->fs, entries, ARRAY_SIZE(entries));
+
+	/* Staging the same ID again replaces the first write */
+	err = zms_tx_write(&tx, TEST_TX_FIRST_ID + 1, &extra, sizeof(extra));
+	zassert_equal(err, 0, "zms_tx_write failed: %d", err);
+
+	tx_stage_new(&tx, data);
+	zassert_equal(tx.count, TEST_TX_ENTRIES, "Unexpected number of staged entries");
+
+	err = zms_tx_write(&tx, TEST_TX_FIRST_ID + TEST_TX_ENTRIES, &extra, sizeof(extra));
+	zassert_equal(err, -ENOMEM, "Staging area overflow not detected: %d", err);
+
+	err = zms_tx_write(&tx, ZMS_HEAD_ID, &extra, sizeof(extra));
+	zassert_equal(err, -EINVAL, "Reserved ID accepted: %d", err);
+
+	/* Nothing is visible before the commit */
+	tx_check(&fixture->fs, false);
+
+	err = zms_tx_commit(&tx);
+	zassert_equal(err, 0, "zms_tx_commit failed: %d", err);
+	zassert_equal(tx.count, 0, "Staging area not emptied by the commit");
+
+	tx_check(&fixture->fs, true);
+
+	/* Reinitialize the ZMS. */
+	memset(&fixture->fs, 0, sizeof(fixture->fs));
+	(void)setup();
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	tx_check(&fixture->fs, true);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that a transaction interrupted at any flash write is rolled back when
+ * ZMS is mounted again.
+ */
+ZTEST_F(zms, test_zms_transaction_power_loss)
+{
+#ifdef CONFIG_ZMS_TRANSACTION
+	struct zms_tx_entry entries[TEST_TX_ENTRIES];
+	uint8_t data[TEST_TX_ENTRIES][TEST_TX_DATA_LEN];
+	uint32_t *flash_write_stat;
+	uint32_t *flash_max_write_calls;
+	uint32_t tx_write_calls;
+	struct zms_tx tx;
+	int err;
+
+	stats_walk(fixture->sim_thresholds, flash_sim_max_write_calls_find,
+		   &flash_max_write_calls);
+	stats_walk(fixture->sim_stats, flash_sim_write_calls_find, &flash_write_stat);
+
+	/* Uninterrupted transaction, used to count its flash writes */
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	tx_write_old(&fixture->fs);
+	zms_tx_init(&tx, &fixture->fs, entries, ARRAY_SIZE(entries));
+	tx_stage_new(&tx, data);
+
+	*flash_write_stat = 0;
+	err = zms_tx_commit(&tx);
+	zassert_equal(err, 0, "zms_tx_commit failed: %d", err);
+	tx_write_calls = *flash_write_stat;
+	TC_PRINT("Transaction of %u entries: %u flash writes\n", TEST_TX_ENTRIES,
+		 tx_write_calls);
+
+	for (uint32_t cut = 1; cut <= tx_write_calls; cut++) {
+		err = zms_clear(&fixture->fs);
+		zassert_true(err == 0, "zms_clear call failure: %d", err);
+		err = zms_mount(&fixture->fs);
+		zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+		tx_write_old(&fixture->fs);
+		zms_tx_init(&tx, &fixture->fs, entries, ARRAY_SIZE(entries));
+		tx_stage_new(&tx, data);
+
+		/* Simulate a power loss: this write and the following ones are lost */
+		*flash_write_stat = 0;
+		*flash_max_write_calls = cut;
+
+		err = zms_tx_commit(&tx);
+		zassert_equal(err, 0, "zms_tx_commit failed: %d", err);
+
+		*flash_max_write_calls = 0;
+
+		/* Reinitialize the ZMS. */
+		memset(&fixture->fs, 0, sizeof(fixture->fs));
+		(void)setup();
+		err = zms_mount(&fixture->fs);
+		zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+		tx_check(&fixture->fs, false);
+
+		/* Mounting again after the roll back does not change anything */
+		memset(&fixture->fs, 0, sizeof(fixture->fs));
+		(void)setup();
+		err = zms_mount(&fixture->fs);
+		zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+		tx_check(&fixture->fs, false);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
@@ -286,6 +286,99 @@ ZTEST(lib_stream_flash, test_stream_flash_buf_size_greater_than_page_size)
 	zassert_true(rc < 0, "expected failure");
 }
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+static uint8_t async_buf[BUF_LEN];
+
+ZTEST(lib_stream_flash, test_stream_flash_async_write)
+{
+	int rc;
+	size_t len = page_size * (MAX_NUM_PAGES - 1) + 128;
+
+	init_target();
+
+	rc = stream_flash_async_enable(&ctx, NULL, NULL);
+	zassert_true(rc < 0, "should fail as buffer is NULL");
+
+	rc = stream_flash_async_enable(&ctx, async_buf, NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Write in chunks not aligned to the buffer size */
+	for (size_t off = 0; off < len; off += 100) {
+		rc = stream_flash_buffered_write(&ctx, write_buf + off,
+						 MIN(100, len - off), false);
+		zassert_equal(rc, 0, "expected success");
+	}
+
+	/* Buffers may still be in flight, flushing waits for all of them */
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, 0, "expected success");
+
+	zassert_equal(stream_flash_bytes_written(&ctx), len,
+		      "all data should be accounted for");
+	VERIFY_WRITTEN(0, len);
+	VERIFY_ERASED(len, page_size - 128);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_write_callback)
+{
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_async_enable(&ctx, async_buf, NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Errors reported by the background write are returned on the next
+	 * buffer hand-over or on flush.
+	 */
+	cb_ret = -EFAULT;
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, -EFAULT, "expected failure from callback");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0,
+		      "failed buffer should not be accounted for");
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_write_short_flush)
+{
+	int rc;
+	/* A buffer size which does not divide the page size, so that one of
+	 * the buffers spans two pages.
+	 */
+	size_t buf_len = BUF_LEN / 4 * 3;
+	size_t straddle = page_size / buf_len * buf_len;
+	size_t len = straddle + (page_size % buf_len) / 2;
+
+	if (page_size % buf_len == 0) {
+		ztest_test_skip();
+	}
+
+	init_target();
+
+	rc = stream_flash_init(&ctx, fdev, generic_buf, buf_len, FLASH_BASE, 0, NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_async_enable(&ctx, async_buf, NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	/* The buffer starting at straddle would end in the second page, but
+	 * is flushed before it leaves the first one.
+	 */
+	rc = stream_flash_buffered_write(&ctx, write_buf, len, true);
+	zassert_equal(rc, 0, "expected success");
+
+	zassert_equal(stream_flash_bytes_written(&ctx), len,
+		      "all data should be accounted for");
+	/* Erasing the first page again on the flush would wipe the buffers
+	 * already written to it.
+	 */
+	VERIFY_WRITTEN(0, len);
+	VERIFY_ERASED(len, page_size - len);
+}
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
 static int bad_read(const struct device *dev, off_t off, void *data, size_t len)
 {
 	return -EINVAL;